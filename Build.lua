@@ -21,4 +21,10 @@ group "Euclid-App"
 	include "Euclid-App/Build-Euclid-App.lua"
 	
 group "Euclid-Lib-Debug"
-	include "Euclid-Lib-Debug/Build-Euclid-Lib-Debug.lua"
\ No newline at end of file
+	include "Euclid-Lib-Debug/Build-Euclid-Lib-Debug.lua"
+
+group "Euclid-Thumbs"
+	include "Euclid-Thumbs/Build-Euclid-Thumbs.lua"
+
+group "Euclid-Bench"
+	include "Euclid-Bench/Build-Euclid-Bench.lua"
\ No newline at end of file
@@ -3,6 +3,7 @@ project "Euclid-App"
 	language "C#"
 	targetdir "Binaries/%{cfg.buildcfg}"
 	staticruntime "off"
+	clr "Unsafe"
 	
 files { "./**.h", "./**.cpp", "./**.cs", "./**.axaml", "./**.csproj", "./**.user"}
 
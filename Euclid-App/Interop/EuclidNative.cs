@@ -28,7 +28,8 @@ namespace EuclidApp.Interop
         EUCLID_OK = 0,
         EUCLID_ERR_INIT = -1,
         EUCLID_ERR_BAD_PARAM = -2,
-        EUCLID_ERR_GLAD = -3
+        EUCLID_ERR_GLAD = -3,
+        EUCLID_ERR_BUSY = -4
     }
 
     public enum EuclidMouseButton : int
@@ -58,7 +59,8 @@ namespace EuclidApp.Interop
         EUCLID_SHAPE_CYLINDER = 5,
         EUCLID_SHAPE_PRISM = 6,
         EUCLID_SHAPE_CIRCLE = 7,
-        EUCLID_SHAPE_CUSTOM = 8
+        EUCLID_SHAPE_CUSTOM = 8,
+        EUCLID_SHAPE_GROUP = 9
     }
 
     public enum EuclidGizmoMode : int
@@ -106,6 +108,181 @@ namespace EuclidApp.Interop
         public EuclidTransform xform;
     }
 
+    public enum EuclidEventType : int
+    {
+        EUCLID_EVENT_NONE = 0,
+        EUCLID_EVENT_SELECTION_CHANGED = 1,
+        EUCLID_EVENT_TRANSFORM_CHANGED = 2,
+        EUCLID_EVENT_OBJECT_CREATED = 3,
+        EUCLID_EVENT_OBJECT_DELETED = 4,
+        EUCLID_EVENT_SCENE_CLEARED = 5,
+        EUCLID_EVENT_IMPORT_PROGRESS = 6,
+        EUCLID_EVENT_OVERFLOW = 7
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct EuclidInputStats
+    {
+        public ulong events_received;
+        public ulong events_applied;
+        public ulong gizmo_solves;
+        public ulong frames_with_input;
+        public double last_latency_ms;
+        public double avg_latency_ms;
+        public double max_latency_ms;
+    }
+
+    public enum EuclidGLCapture : int { Off = 0, Count = 1, Record = 2 }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct EuclidGLCallStats
+    {
+        public ulong total_calls;
+        public ulong draw_calls;
+        public ulong binds;
+        public ulong state_changes;
+        public ulong uniform_updates;
+        public ulong uploads;
+        public ulong queries;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct EuclidStats
+    {
+        public float fps;
+        public int draw_calls;
+        public int triangles;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct EuclidStreamingStats
+    {
+        public ulong budget_bytes;
+        public ulong resident_bytes;
+        public ulong proxy_bytes;
+        public uint chunks;
+        public uint resident_chunks;
+        public uint loading_chunks;
+        public ulong loads, evictions;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct EuclidPassTiming
+    {
+        public IntPtr name;   // static UTF-8 string
+        public double cpu_ms;
+        public double gpu_ms;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct EuclidMemoryCategoryStats
+    {
+        public ulong bytes;
+        public ulong peak_bytes;
+        public ulong allocations;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct EuclidMemoryStats
+    {
+        public ulong gpu_bytes, gpu_peak_bytes;
+        public ulong cpu_bytes, cpu_peak_bytes;
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 10)]
+        public EuclidMemoryCategoryStats[] categories;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct EuclidGLMessage
+    {
+        public int source;     // EuclidGLMessageSource
+        public int type;       // EuclidGLMessageType
+        public int severity;   // 0 notification .. 3 high
+        public uint id;
+        public ulong count;
+        public ulong first_frame;
+        public ulong last_frame;
+        public IntPtr scope;   // UTF-8, owned by the library
+        public IntPtr text;    // UTF-8, valid until Euclid_ClearGLMessages
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct EuclidGLDebugStats
+    {
+        public ulong frame;
+        public ulong total;
+        public ulong unique;
+        public ulong last_frame;
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 4)]
+        public ulong[] by_severity;
+        public ulong performance;
+        public ulong dropped;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct EuclidEvent
+    {
+        public EuclidEventType type;
+        public int dragging;
+        public ulong id;
+        public EuclidTransform transform;
+        public float progress;
+    }
+
+    // Engine-owned arrays; valid until version changes. Read on the render thread.
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct EuclidSceneView
+    {
+        public ulong version;
+        public ulong change_seq;
+        public UIntPtr count;
+        public ulong* ids;
+        public EuclidShapeType* types;
+        public EuclidTransform* transforms;
+        public ulong* seqs;
+        public float* world_matrices; // 16 per object, column-major
+
+        public int Count => (int)count;
+        public ReadOnlySpan<ulong> Ids => new(ids, Count);
+        public ReadOnlySpan<EuclidShapeType> Types => new(types, Count);
+        public ReadOnlySpan<EuclidTransform> Transforms => new(transforms, Count);
+        public ReadOnlySpan<ulong> Seqs => new(seqs, Count);
+        public ReadOnlySpan<float> WorldMatrices => new(world_matrices, Count * 16);
+    }
+
+    public enum EuclidCommandType : int
+    {
+        EUCLID_CMD_NONE = 0,
+        EUCLID_CMD_SET_TRANSFORM = 1,
+        EUCLID_CMD_CREATE_SHAPE = 2,
+        EUCLID_CMD_DELETE_OBJECT = 3,
+        EUCLID_CMD_SET_PARENT = 4,
+        EUCLID_CMD_SELECT = 5,
+        EUCLID_CMD_CLEAR_SCENE = 6
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct EuclidCommand
+    {
+        public EuclidCommandType type;
+        public EuclidShapeType shape;
+        public ulong id;
+        public ulong parent;
+        public EuclidTransform transform;
+        public int has_params;
+        public fixed byte @params[16]; // bytes of the matching Euclid*Params struct
+    }
+
+    // one pane of Euclid_RenderViewports; matrices column-major
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct EuclidViewport
+    {
+        public int x, y, width, height; // pixels, origin bottom-left
+        public fixed float view[16];
+        public fixed float projection[16];
+        public int draw_grid;
+        public int draw_gizmo;
+    }
+
     // loader: const char* -> IntPtr, CC = Cdecl
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
     public delegate IntPtr Euclid_GetProcAddr([MarshalAs(UnmanagedType.LPUTF8Str)] string name);
@@ -121,6 +298,10 @@ namespace EuclidApp.Interop
         [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
         public static extern void Euclid_Destroy(IntPtr h);
 
+        // another view on the same scene and GPU resources; render it on the same GL context
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_CreateView(IntPtr sharedWith, ref EuclidConfig cfg, out IntPtr outView);
+
         [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
         public static extern void Euclid_Resize(IntPtr h, int w, int hgt);
 
@@ -155,6 +336,12 @@ namespace EuclidApp.Interop
         [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
         public static extern void Euclid_OnMods(IntPtr h, byte mods);
 
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Euclid_FramePresented(IntPtr h);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_GetInputStats(IntPtr h, out EuclidInputStats stats);
+
         // --- scene / objects
         [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
         public static extern EuclidResult Euclid_ClearScene(IntPtr h);
@@ -162,12 +349,67 @@ namespace EuclidApp.Interop
         [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
         public static extern EuclidResult Euclid_CreateShape(IntPtr h, ref EuclidCreateShapeDesc desc, out ulong outId);
 
+        // batched: one transition for many objects (stride 0 = packed EuclidTransform[])
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_CreateShapesBatch(IntPtr h, [In] EuclidCreateShapeDesc[] descs, UIntPtr count, [Out] ulong[] outIds);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_SetTransformsBatch(IntPtr h, [In] ulong[] ids, UIntPtr count, [In] EuclidTransform[] transforms, UIntPtr stride);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_GetTransformsBatch(IntPtr h, [In] ulong[] ids, UIntPtr count, [Out] EuclidTransform[] transforms, UIntPtr stride);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_GetSceneView(IntPtr h, out EuclidSceneView view);
+
+        // Hierarchy: parent 0 = root; deleting a parent deletes its subtree
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_SetParent(IntPtr h, ulong child, ulong parent);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_SetParentsBatch(IntPtr h, [In] ulong[] ids, UIntPtr count, ulong parent);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_GetParent(IntPtr h, ulong id, out ulong parent);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_GetWorldMatrix(IntPtr h, ulong id, [Out] float[] matrix);
+
         [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
         public static extern EuclidResult Euclid_DeleteObject(IntPtr h, ulong id);
 
         [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
         public static extern EuclidResult Euclid_GetSelection(IntPtr h, out ulong outId);
 
+        // --- scene events (drain once per frame instead of polling)
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_EnableEvents(IntPtr h, uint capacity);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int Euclid_PollEvents(IntPtr h, [Out] EuclidEvent[] events, int max);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr Euclid_GetEventRing(IntPtr h);
+
+        // Command queue + snapshot: callable from any thread once enabled
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_EnableCommandQueue(IntPtr h, uint capacity);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_SubmitCommands(IntPtr h, [In] EuclidCommand[] cmds, UIntPtr count);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_SubmitCommands(IntPtr h, ref EuclidCommand cmd, UIntPtr count);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_ReserveObjectIDs(IntPtr h, UIntPtr count, out ulong first);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_AcquireSceneSnapshot(IntPtr h, out EuclidSceneView view, out uint token);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_ReleaseSceneSnapshot(IntPtr h, uint token);
+
         [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
         public static extern void Euclid_SetSelection(IntPtr h, ulong id);
 
@@ -199,6 +441,100 @@ namespace EuclidApp.Interop
             out ulong outId,
             int normalize);
 
+        // out-of-core: convert once (blocking, no GL), then load; chunks stream within the budget
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_BuildPagedMesh(
+            IntPtr h,
+            [MarshalAs(UnmanagedType.LPUTF8Str)] string objPath,
+            [MarshalAs(UnmanagedType.LPUTF8Str)] string pagePath,
+            int normalize);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_LoadPagedMesh(
+            IntPtr h,
+            [MarshalAs(UnmanagedType.LPUTF8Str)] string pagePath,
+            out ulong outId);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_SetStreamingBudget(IntPtr h, ulong bytes);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_GetStreamingStats(IntPtr h, out EuclidStreamingStats stats);
+
+        // multi-view: up to 16 panes, one scene walk per frame
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_RenderViewports(IntPtr h, [In] EuclidViewport[] viewports, int count);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern unsafe EuclidResult Euclid_GetCameraMatrices(IntPtr h, float* view, float* projection);
+
+        // profiler: process-wide, off by default; export writes Chrome trace JSON
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Euclid_ProfilerEnable(int enabled);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Euclid_ProfilerSetThreadName([MarshalAs(UnmanagedType.LPUTF8Str)] string name);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_ProfilerExportChromeTrace([MarshalAs(UnmanagedType.LPUTF8Str)] string path);
+
+        // GL call accounting (process-wide)
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Euclid_SetGLCapture(EuclidGLCapture mode);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_GetGLCallStats(out EuclidGLCallStats stats);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Euclid_ResetGLCallStats();
+
+        // Session recording (replay with Euclid-Bench --replay)
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_RecordStart(IntPtr h, [MarshalAs(UnmanagedType.LPUTF8Str)] string path);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Euclid_RecordStop(IntPtr h);
+
+        // Frame stats and live per-pass timings
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Euclid_GetStats(IntPtr h, out EuclidStats stats);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Euclid_SetPassTimings(IntPtr h, int enabled);
+
+        // GL 4.3+: compute culling + one indirect draw for the scene
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_SetGpuDriven(IntPtr h, int enabled);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_SetOcclusionCulling(IntPtr h, int enabled);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_SetBackfaceCulling(IntPtr h, int enabled);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int Euclid_GetPassTimings(IntPtr h, [Out] EuclidPassTiming[] timings, int max);
+
+        // Memory accounting (process-wide)
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_GetMemoryStats(out EuclidMemoryStats stats);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Euclid_ResetMemoryPeaks();
+
+        // GL debug output (process-wide log)
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_EnableGLDebug(IntPtr h, int enabled);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int Euclid_GetGLMessages([Out] EuclidGLMessage[] messages, int max);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern EuclidResult Euclid_GetGLDebugStats(out EuclidGLDebugStats stats);
+
+        [DllImport(Dll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Euclid_ClearGLMessages();
+
        
 
         // --- helpers ---
@@ -35,6 +35,7 @@ namespace EuclidApp.Views
 
         private bool _lastTfValid;
         private EuclidTransform _lastTf;
+        private readonly EuclidEvent[] _events = new EuclidEvent[256];
 
         public event Action? EngineReady;
         public event Action<ulong>? SelectionChanged;
@@ -88,6 +89,11 @@ namespace EuclidApp.Views
             _sentW = _sentH = 0;
             SendResizeIfNeeded();
 
+            // selection/transform changes are pushed by the engine, see DrainEngineEvents
+            EuclidNative.Euclid_EnableEvents(_euclid, 1024);
+            // scene edits from the UI thread go through the engine's queue, see Submit
+            EuclidNative.Euclid_EnableCommandQueue(_euclid, 4096);
+
             _timer.Restart();
             _lastT = 0;
             _lastSelection = 0;
@@ -148,56 +154,61 @@ namespace EuclidApp.Views
                 }
             }
 
-            if (EuclidNative.Euclid_GetSelection(_euclid, out var sel) == EuclidResult.EUCLID_OK)
-            {
-                if (sel != _lastSelection)
-                {
-                    _lastSelection = sel;
-                    _lastTfValid = false; 
-                    SelectionChanged?.Invoke(sel);
-                }
-            }
+            DrainEngineEvents();
 
-            bool draggingGizmo = EuclidNative.Euclid_IsDraggingGizmo(_euclid) != 0;
+            RequestNextFrameRendering();
+        }
 
-            if (_lastSelection != 0 &&
-                EuclidNative.Euclid_GetObjectTransform(_euclid, _lastSelection, out var tf) == EuclidResult.EUCLID_OK)
+        // Engine -> host changes since the last frame. Nothing to do (and no further
+        // interop) when the scene is idle.
+        private void DrainEngineEvents()
+        {
+            int n;
+            while ((n = EuclidNative.Euclid_PollEvents(_euclid, _events, _events.Length)) > 0)
             {
-                if (draggingGizmo)
-                {
-                    _lastTf = tf;
-                    _lastTfValid = true;
-                    Avalonia.Threading.Dispatcher.UIThread.Post(() => TransformPolled?.Invoke(_lastSelection, tf));
-                }
-                else
+                for (int i = 0; i < n; i++)
                 {
-                    const float Eps = 1e-5f;
-                    bool changed =
-                        !_lastTfValid ||
-                        Math.Abs(tf.posX - _lastTf.posX) > Eps ||
-                        Math.Abs(tf.posY - _lastTf.posY) > Eps ||
-                        Math.Abs(tf.posZ - _lastTf.posZ) > Eps ||
-                        Math.Abs(tf.rotX - _lastTf.rotX) > Eps ||
-                        Math.Abs(tf.rotY - _lastTf.rotY) > Eps ||
-                        Math.Abs(tf.rotZ - _lastTf.rotZ) > Eps ||
-                        Math.Abs(tf.sclX - _lastTf.sclX) > Eps ||
-                        Math.Abs(tf.sclY - _lastTf.sclY) > Eps ||
-                        Math.Abs(tf.sclZ - _lastTf.sclZ) > Eps;
-
-                    if (changed)
+                    ref readonly var e = ref _events[i];
+                    switch (e.type)
                     {
-                        _lastTf = tf;
-                        _lastTfValid = true;
-                        Avalonia.Threading.Dispatcher.UIThread.Post(() => TransformPolled?.Invoke(_lastSelection, tf));
+                        case EuclidEventType.EUCLID_EVENT_SELECTION_CHANGED:
+                            OnEngineSelection(e.id);
+                            break;
+
+                        case EuclidEventType.EUCLID_EVENT_TRANSFORM_CHANGED:
+                            if (e.id == _lastSelection) PublishTransform(e.id, e.transform);
+                            break;
+
+                        case EuclidEventType.EUCLID_EVENT_OVERFLOW:
+                            // lost some events: re-read what we show
+                            _lastTfValid = false;
+                            if (EuclidNative.Euclid_GetSelection(_euclid, out var sel) == EuclidResult.EUCLID_OK)
+                                OnEngineSelection(sel);
+                            break;
                     }
                 }
+                if (n < _events.Length) break;
             }
-            else
+        }
+
+        private void OnEngineSelection(ulong sel)
+        {
+            if (sel != _lastSelection)
             {
+                _lastSelection = sel;
                 _lastTfValid = false;
+                SelectionChanged?.Invoke(sel);
             }
+            if (sel != 0 && !_lastTfValid &&
+                EuclidNative.Euclid_GetObjectTransform(_euclid, sel, out var tf) == EuclidResult.EUCLID_OK)
+                PublishTransform(sel, tf);
+        }
 
-            RequestNextFrameRendering();
+        private void PublishTransform(ulong id, EuclidTransform tf)
+        {
+            _lastTf = tf;
+            _lastTfValid = true;
+            Avalonia.Threading.Dispatcher.UIThread.Post(() => TransformPolled?.Invoke(id, tf));
         }
 
         private void SendResizeIfNeeded()
@@ -216,54 +227,40 @@ namespace EuclidApp.Views
 
         public ulong GetSelection() => _lastSelection;
 
-        public void SetSelection(ulong id)
+        // Queued for the engine; applied at the start of the next frame. No GL-thread hop
+        // and no closure per edit.
+        private bool Submit(in EuclidCommand cmd)
         {
-            if (!IsReady) return;
-            EuclidNative.Euclid_SetSelection(_euclid, id);
+            if (!IsReady) return false;
+            var c = cmd;
+            var r = EuclidNative.Euclid_SubmitCommands(_euclid, ref c, (UIntPtr)1);
+            if (r == EuclidResult.EUCLID_OK) RequestNextFrameRendering();
+            return r == EuclidResult.EUCLID_OK;
         }
 
+        public void SetSelection(ulong id)
+            => Submit(new EuclidCommand { type = EuclidCommandType.EUCLID_CMD_SELECT, id = id });
+
         public Task ClearSceneAsync()
         {
-            var tcs = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
-
-            EnqueueGlJob(() =>
+            if (Submit(new EuclidCommand { type = EuclidCommandType.EUCLID_CMD_CLEAR_SCENE }))
             {
-                if (_euclid != IntPtr.Zero)
-                {
-                    EuclidNative.Euclid_ClearScene(_euclid);
-                    EuclidNative.Euclid_SetSelection(_euclid, 0);
-                    _lastSelection = 0;
-                    _lastTfValid = false;
-                }
-                tcs.TrySetResult();
-            });
-
-            return tcs.Task;
+                _lastSelection = 0;
+                _lastTfValid = false;
+            }
+            return Task.CompletedTask;
         }
 
         public Task<bool> DeleteSelectedAsync()
         {
-            var tcs = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
-
-            EnqueueGlJob(() =>
+            var sel = _lastSelection;
+            var ok = sel != 0 && Submit(new EuclidCommand { type = EuclidCommandType.EUCLID_CMD_DELETE_OBJECT, id = sel });
+            if (ok)
             {
-                if (_euclid == IntPtr.Zero) { tcs.TrySetResult(false); return; }
-
-                ulong sel = 0;
-                if (EuclidNative.Euclid_GetSelection(_euclid, out var id) == EuclidResult.EUCLID_OK)
-                    sel = id;
-
-                var ok = sel != 0 && EuclidNative.Euclid_DeleteObject(_euclid, sel) == EuclidResult.EUCLID_OK;
-                if (ok)
-                {
-                    EuclidNative.Euclid_SetSelection(_euclid, 0);
-                    _lastSelection = 0;
-                    _lastTfValid = false;
-                }
-                tcs.TrySetResult(ok);
-            });
-
-            return tcs.Task;
+                _lastSelection = 0;
+                _lastTfValid = false;
+            }
+            return Task.FromResult(ok);
         }
 
 
@@ -293,6 +290,17 @@ namespace EuclidApp.Views
         public ulong CreateCircle(float r = 0.5f, int seg = 64, EuclidTransform? tf = null)
             => CreateWithParams(EuclidShapeType.EUCLID_SHAPE_CIRCLE, new EuclidCircleParams { radius = r, segments = seg }, tf);
 
+        // Empty transform node; parent parts to it and move them all with one SetObjectTransform
+        public ulong CreateGroup(EuclidTransform? tf = null)
+        {
+            if (!IsReady) return 0;
+            var desc = new EuclidCreateShapeDesc { type = EuclidShapeType.EUCLID_SHAPE_GROUP, @params = IntPtr.Zero, xform = tf ?? DefaultTF() };
+            return EuclidNative.Euclid_CreateShape(_euclid, ref desc, out var id) == EuclidResult.EUCLID_OK ? id : 0;
+        }
+
+        public bool SetParent(ulong[] children, ulong parent)
+            => IsReady && EuclidNative.Euclid_SetParentsBatch(_euclid, children, (UIntPtr)children.Length, parent) == EuclidResult.EUCLID_OK;
+
         private static EuclidTransform DefaultTF() => new EuclidTransform
         {
             posX = 0,
@@ -377,18 +385,34 @@ namespace EuclidApp.Views
         public EuclidGizmoMode GetGizmo() =>
             IsReady ? EuclidNative.Euclid_GetGizmoMode(_euclid) : EuclidGizmoMode.EUCLID_GIZMO_NONE;
 
+        // Reads the engine's last published snapshot, so it is safe off the GL thread
         public bool TryGetTransform(ulong id, out EuclidTransform tf)
         {
             tf = default;
             if (!IsReady || id == 0) return false;
-            return EuclidNative.Euclid_GetObjectTransform(_euclid, id, out tf) == EuclidResult.EUCLID_OK;
+            if (EuclidNative.Euclid_AcquireSceneSnapshot(_euclid, out var view, out var token) != EuclidResult.EUCLID_OK)
+                return false;
+            try
+            {
+                var ids = view.Ids;
+                for (int i = 0; i < ids.Length; i++)
+                {
+                    if (ids[i] != id) continue;
+                    tf = view.Transforms[i];
+                    return true;
+                }
+                return false;
+            }
+            finally
+            {
+                EuclidNative.Euclid_ReleaseSceneSnapshot(_euclid, token);
+            }
         }
 
         public bool TrySetTransform(ulong id, in EuclidTransform tf)
         {
-            if (!IsReady || id == 0) return false;
-            var t = tf;
-            return EuclidNative.Euclid_SetObjectTransform(_euclid, id, ref t) == EuclidResult.EUCLID_OK;
+            if (id == 0) return false;
+            return Submit(new EuclidCommand { type = EuclidCommandType.EUCLID_CMD_SET_TRANSFORM, id = id, transform = tf });
         }
 
         // ===== Input from host =====
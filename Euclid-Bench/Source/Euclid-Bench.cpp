@@ -0,0 +1,396 @@
+// Euclid-Bench: headless benchmark suite for the engine's hot paths.
+//
+//   Euclid-Bench [--out results.json] [--max-objects N] [--frames N] [--picks N] [--size WxH] [--quick] [--null] [--gpu-driven [--no-occlusion]]
+//   Euclid-Bench --replay session.erec [--realtime] [--out results.json] [--null]
+//
+// Scenes of 1k..1M mixed primitives: batch create, frame time (render + readback, so the
+// GPU work is included), GL calls per frame, RayPick latency, delete. Then OBJ import
+// throughput on generated files of growing size. --null runs on the null GL backend:
+// the same work minus the driver, i.e. the engine's own CPU cost. --gpu-driven asks for a
+// GL 4.3 context, so the scene pass culls in a compute shader and draws with one
+// multi-draw-indirect (Euclid_SetGpuDriven), occlusion-culled unless --no-occlusion.
+// Everything is seeded, so two runs measure the same work; results go to JSON for
+// tracking across versions, a short summary to stdout.
+//
+// --replay runs a session recorded with Euclid_RecordStart instead: as fast as possible
+// (throughput), or with --realtime at the recorded pace (latency under real input rates).
+
+#include "Euclid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+static constexpr int    kMinPicks = 20;
+static constexpr double kPickBudgetMs = 10000.0;
+
+struct Options {
+    std::string out = "euclid-bench.json";
+    size_t maxObjects = 1000000;
+    int    frames = 120;
+    int    picks = 2000;
+    int    width = 1280, height = 720;
+    size_t maxImportTris = 2000000;
+    bool   null = false;
+    bool   gpuDriven = false;
+    bool   occlusion = true;   // with gpuDriven
+    std::string replay;   // session log, replaces the suites
+    bool   realtime = false;
+};
+
+// -------- Helpers --------
+static double MsSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// xorshift: same scene + pick points every run
+struct Rng {
+    uint64_t s;
+    explicit Rng(uint64_t seed) : s(seed) {}
+    uint64_t Next() { s ^= s << 13; s ^= s >> 7; s ^= s << 17; return s; }
+    float Unit() { return float(Next() >> 40) / float(1u << 24); }
+};
+
+struct Percentiles {
+    double p50 = 0, p90 = 0, p99 = 0, max = 0, mean = 0;
+};
+
+static Percentiles Summarize(std::vector<double> v) {
+    Percentiles p;
+    if (v.empty()) return p;
+    std::sort(v.begin(), v.end());
+    auto at = [&](double q) { return v[std::min(v.size() - 1, (size_t)(q * double(v.size() - 1) + 0.5))]; };
+    p.p50 = at(0.50); p.p90 = at(0.90); p.p99 = at(0.99); p.max = v.back();
+    for (double x : v) p.mean += x;
+    p.mean /= double(v.size());
+    return p;
+}
+
+static void WritePercentiles(FILE* f, const char* key, const Percentiles& p) {
+    std::fprintf(f, "\"%s\": {\"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f, \"mean\": %.4f}",
+                 key, p.p50, p.p90, p.p99, p.max, p.mean);
+}
+
+// -------- Args --------
+static bool ParseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if      (a == "--out"         && i + 1 < argc) opt.out = argv[++i];
+        else if (a == "--max-objects" && i + 1 < argc) opt.maxObjects = (size_t)std::strtoull(argv[++i], nullptr, 10);
+        else if (a == "--frames"      && i + 1 < argc) opt.frames = std::atoi(argv[++i]);
+        else if (a == "--picks"       && i + 1 < argc) opt.picks = std::atoi(argv[++i]);
+        else if (a == "--size"        && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%dx%d", &opt.width, &opt.height) != 2) return false;
+        }
+        else if (a == "--null")  opt.null = true;
+        else if (a == "--gpu-driven") opt.gpuDriven = true;
+        else if (a == "--no-occlusion") opt.occlusion = false;
+        else if (a == "--replay" && i + 1 < argc) opt.replay = argv[++i];
+        else if (a == "--realtime") opt.realtime = true;
+        else if (a == "--quick") { opt.maxObjects = 10000; opt.frames = 30; opt.picks = 500; opt.maxImportTris = 200000; }
+        else return false;
+    }
+    return opt.maxObjects > 0 && opt.frames > 0 && opt.picks > 0 && opt.width > 0 && opt.height > 0;
+}
+
+// -------- Scene suite --------
+struct SceneResult {
+    size_t      objects = 0;
+    double      createMs = 0, deleteMs = 0;
+    Percentiles frameMs, submitMs, pickUs;
+    double      pickHitRate = 0;
+    int         picks = 0;
+    EuclidGLCallStats gl{};   // one frame
+    EuclidMemoryStats mem{};  // peaks while the scene was alive
+};
+
+// Mixed primitives on a 9x9 patch around the origin (what the default camera sees),
+// sized so the patch stays about equally full at every count.
+static std::vector<EuclidCreateShapeDesc> MakeScene(size_t n, Rng& rng) {
+    std::vector<EuclidCreateShapeDesc> d(n);
+    const float scale = std::max(0.002f, 0.35f / std::sqrt(float(n) / 1000.0f));
+    for (size_t i = 0; i < n; ++i) {
+        EuclidCreateShapeDesc& s = d[i];
+        s = {};
+        s.type = (EuclidShapeType)(i % 8);
+        s.xform.position[0] = rng.Unit() * 9.0f - 4.5f;
+        s.xform.position[1] = rng.Unit() * 1.5f;
+        s.xform.position[2] = rng.Unit() * 9.0f - 4.5f;
+        s.xform.rotation[1] = rng.Unit() * 360.0f;
+        s.xform.scale[0] = s.xform.scale[1] = s.xform.scale[2] = scale * (0.5f + rng.Unit());
+    }
+    return d;
+}
+
+static bool RunScene(EuclidHandle h, const Options& opt, size_t n, SceneResult& r) {
+    Rng rng(0x9e3779b97f4a7c15ull ^ n);
+    const std::vector<EuclidCreateShapeDesc> descs = MakeScene(n, rng);
+    std::vector<EuclidObjectID> ids(n);
+    r.objects = n;
+
+    Euclid_ResetMemoryPeaks();
+    auto t0 = Clock::now();
+    if (Euclid_CreateShapesBatch(h, descs.data(), n, ids.data()) != EUCLID_OK) return false;
+    r.createMs = MsSince(t0);
+
+    std::vector<uint8_t> px((size_t)opt.width * opt.height * 4);
+    for (int i = 0; i < 3; ++i) { Euclid_Render(h); Euclid_ReadPixels(h, px.data(), px.size()); }   // warm-up
+
+    std::vector<double> frame, submit;
+    for (int i = 0; i < opt.frames; ++i) {
+        t0 = Clock::now();
+        Euclid_Render(h);
+        submit.push_back(MsSince(t0));
+        Euclid_ReadPixels(h, px.data(), px.size());
+        frame.push_back(MsSince(t0));
+    }
+    r.frameMs = Summarize(frame);
+    r.submitMs = Summarize(submit);
+
+    Euclid_SetGLCapture(EUCLID_GL_CAPTURE_COUNT);
+    Euclid_ResetGLCallStats();
+    Euclid_Render(h);
+    Euclid_GetGLCallStats(&r.gl);
+    Euclid_SetGLCapture(EUCLID_GL_CAPTURE_OFF);
+
+    // brute-force picking on big scenes is slow: stop at the time budget once there's a sample
+    std::vector<double> pick;
+    int hits = 0;
+    const auto pickStart = Clock::now();
+    for (int i = 0; i < opt.picks && (i < kMinPicks || MsSince(pickStart) < kPickBudgetMs); ++i) {
+        const float x = rng.Unit() * float(opt.width), y = rng.Unit() * float(opt.height);
+        t0 = Clock::now();
+        if (Euclid_RayPick(h, x, y)) ++hits;
+        pick.push_back(MsSince(t0) * 1000.0);
+    }
+    r.pickUs = Summarize(pick);
+    r.pickHitRate = pick.empty() ? 0.0 : double(hits) / double(pick.size());
+    r.picks = (int)pick.size();
+    Euclid_GetMemoryStats(&r.mem);
+
+    t0 = Clock::now();
+    for (EuclidObjectID id : ids) Euclid_DeleteObject(h, id);
+    r.deleteMs = MsSince(t0);
+    return true;
+}
+
+// -------- Import suite --------
+struct ImportResult {
+    size_t triangles = 0;
+    size_t bytes = 0;
+    double ms = 0;   // best of the runs
+};
+
+// UV sphere with normals, 4*seg*seg triangles; roughly what scanned/exported meshes look like
+static bool WriteSphereOBJ(const fs::path& path, int seg, size_t& tris) {
+    FILE* f = std::fopen(path.string().c_str(), "wb");
+    if (!f) return false;
+    std::vector<char> buf(1 << 20);
+    std::setvbuf(f, buf.data(), _IOFBF, buf.size());
+
+    const int rings = seg, sides = 2 * seg;
+    for (int i = 0; i <= rings; ++i) {
+        const float th = 3.14159265f * float(i) / float(rings);
+        for (int j = 0; j <= sides; ++j) {
+            const float ph = 6.28318531f * float(j) / float(sides);
+            const float x = std::sin(th) * std::cos(ph), y = std::cos(th), z = std::sin(th) * std::sin(ph);
+            std::fprintf(f, "v %.6f %.6f %.6f\nvn %.6f %.6f %.6f\n", x, y, z, x, y, z);
+        }
+    }
+    tris = 0;
+    for (int i = 0; i < rings; ++i)
+        for (int j = 0; j < sides; ++j) {
+            const int a = i * (sides + 1) + j + 1, b = a + sides + 1;
+            std::fprintf(f, "f %d//%d %d//%d %d//%d\nf %d//%d %d//%d %d//%d\n", a, a, b, b, a + 1, a + 1, a + 1, a + 1, b, b, b + 1, b + 1);
+            tris += 2;
+        }
+    return std::fclose(f) == 0;
+}
+
+static bool RunImport(EuclidHandle h, const fs::path& dir, int seg, ImportResult& r) {
+    const fs::path path = dir / ("sphere-" + std::to_string(seg) + ".obj");
+    if (!WriteSphereOBJ(path, seg, r.triangles)) return false;
+    std::error_code ec;
+    r.bytes = (size_t)fs::file_size(path, ec);
+
+    const int runs = r.triangles > 500000 ? 1 : 3;
+    r.ms = 0;
+    for (int i = 0; i < runs; ++i) {
+        EuclidObjectID id = 0;
+        const auto t0 = Clock::now();
+        if (Euclid_LoadOBJ(h, path.string().c_str(), &id, /*normalize*/1) != EUCLID_OK) return false;
+        const double ms = MsSince(t0);
+        r.ms = (i == 0) ? ms : std::min(r.ms, ms);
+        Euclid_DeleteObject(h, id);
+    }
+    fs::remove(path, ec);
+    return true;
+}
+
+// -------- Output --------
+// A JSON string, quotes included: \ and " escaped (Windows paths), control bytes as \uXXXX
+static void WriteString(FILE* f, const char* s) {
+    std::fputc('"', f);
+    for (; *s; ++s) {
+        const unsigned char c = (unsigned char)*s;
+        if      (c == '"' || c == '\\') { std::fputc('\\', f); std::fputc(c, f); }
+        else if (c == '\n') std::fputs("\\n", f);
+        else if (c == '\t') std::fputs("\\t", f);
+        else if (c < 0x20)  std::fprintf(f, "\\u%04x", c);
+        else                std::fputc(c, f);
+    }
+    std::fputc('"', f);
+}
+
+static void WriteHeader(FILE* f) {
+    std::fputs("{\n  \"version\": ", f);
+    WriteString(f, Euclid_Version());
+    std::fprintf(f, ",\n  \"timestamp\": %lld,\n  \"hardware_threads\": %u,\n",
+                 (long long)std::time(nullptr), std::thread::hardware_concurrency());
+}
+
+static bool WriteJSON(const Options& opt, const std::vector<SceneResult>& scenes, const std::vector<ImportResult>& imports) {
+    FILE* f = std::fopen(opt.out.c_str(), "wb");
+    if (!f) return false;
+    WriteHeader(f);
+    std::fprintf(f, "  \"config\": {\"width\": %d, \"height\": %d, \"frames\": %d, \"picks\": %d, \"backend\": \"%s\", \"gpu_driven\": %s, \"occlusion\": %s},\n",
+                 opt.width, opt.height, opt.frames, opt.picks, opt.null ? "null" : "headless", opt.gpuDriven ? "true" : "false",
+                 opt.gpuDriven && opt.occlusion ? "true" : "false");
+
+    std::fprintf(f, "  \"scenes\": [\n");
+    for (size_t i = 0; i < scenes.size(); ++i) {
+        const SceneResult& s = scenes[i];
+        std::fprintf(f, "    {\"objects\": %zu, \"create_ms\": %.3f, \"create_per_s\": %.0f, \"delete_ms\": %.3f, \"delete_per_s\": %.0f,\n     ",
+                     s.objects, s.createMs, s.createMs > 0 ? double(s.objects) * 1000.0 / s.createMs : 0.0,
+                     s.deleteMs, s.deleteMs > 0 ? double(s.objects) * 1000.0 / s.deleteMs : 0.0);
+        WritePercentiles(f, "frame_ms", s.frameMs);   std::fprintf(f, ",\n     ");
+        WritePercentiles(f, "submit_ms", s.submitMs); std::fprintf(f, ",\n     ");
+        WritePercentiles(f, "pick_us", s.pickUs);   std::fprintf(f, ",\n     ");
+        std::fprintf(f, "\"gl_calls_per_frame\": {\"total\": %llu, \"draws\": %llu, \"binds\": %llu, \"state\": %llu, \"uniforms\": %llu, \"uploads\": %llu, \"queries\": %llu}",
+                     (unsigned long long)s.gl.total_calls, (unsigned long long)s.gl.draw_calls, (unsigned long long)s.gl.binds,
+                     (unsigned long long)s.gl.state_changes, (unsigned long long)s.gl.uniform_updates,
+                     (unsigned long long)s.gl.uploads, (unsigned long long)s.gl.queries);
+        std::fprintf(f, ",\n     \"memory_peak\": {\"gpu_bytes\": %llu, \"cpu_bytes\": %llu}",
+                     (unsigned long long)s.mem.gpu_peak_bytes, (unsigned long long)s.mem.cpu_peak_bytes);
+        std::fprintf(f, ", \"picks\": %d, \"pick_hit_rate\": %.4f}%s\n", s.picks, s.pickHitRate, i + 1 < scenes.size() ? "," : "");
+    }
+    std::fprintf(f, "  ],\n  \"import\": [\n");
+    for (size_t i = 0; i < imports.size(); ++i) {
+        const ImportResult& m = imports[i];
+        std::fprintf(f, "    {\"triangles\": %zu, \"bytes\": %zu, \"ms\": %.3f, \"mb_per_s\": %.2f}%s\n",
+                     m.triangles, m.bytes, m.ms, m.ms > 0 ? double(m.bytes) / (1024.0 * 1024.0) / (m.ms / 1000.0) : 0.0,
+                     i + 1 < imports.size() ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+    return std::fclose(f) == 0;
+}
+
+// -------- Replay --------
+static int RunReplay(EuclidHandle h, const Options& opt) {
+    const EuclidReplayDesc desc{ opt.realtime ? 1 : 0, 1 };
+    EuclidReplayStats st{};
+    const EuclidResult res = Euclid_Replay(h, opt.replay.c_str(), &desc, &st);
+    if (res != EUCLID_OK && st.events == 0) { std::fprintf(stderr, "cannot replay %s\n", opt.replay.c_str()); return 1; }
+    if (res != EUCLID_OK) std::fprintf(stderr, "%s: damaged after %llu events\n", opt.replay.c_str(), (unsigned long long)st.events);
+
+    std::printf("%llu events, %llu frames  recorded %.1f ms  replayed %.1f ms  frame p50 %.2f p95 %.2f p99 %.2f max %.2f ms\n",
+                (unsigned long long)st.events, (unsigned long long)st.frames, st.recorded_ms, st.replay_ms,
+                st.frame_p50_ms, st.frame_p95_ms, st.frame_p99_ms, st.frame_max_ms);
+    if (st.unknown_ids) std::printf("%llu references to objects the replay didn't create\n", (unsigned long long)st.unknown_ids);
+
+    FILE* f = std::fopen(opt.out.c_str(), "wb");
+    if (!f) { std::fprintf(stderr, "cannot write %s\n", opt.out.c_str()); return 1; }
+    WriteHeader(f);
+    std::fputs("  \"config\": {\"replay\": ", f);
+    WriteString(f, opt.replay.c_str());
+    std::fprintf(f, ", \"realtime\": %s, \"backend\": \"%s\"},\n", opt.realtime ? "true" : "false", opt.null ? "null" : "headless");
+    std::fprintf(f, "  \"replay\": {\"complete\": %s, \"events\": %llu, \"frames\": %llu, \"unknown_ids\": %llu, \"recorded_ms\": %.3f, \"replay_ms\": %.3f,\n",
+                 res == EUCLID_OK ? "true" : "false", (unsigned long long)st.events, (unsigned long long)st.frames,
+                 (unsigned long long)st.unknown_ids, st.recorded_ms, st.replay_ms);
+    std::fprintf(f, "    \"frame_ms\": {\"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f},\n    \"ops\": {",
+                 st.frame_p50_ms, st.frame_p95_ms, st.frame_p99_ms, st.frame_max_ms);
+    const char* sep = "";
+    for (int op = 1; op < EUCLID_REC_OP_COUNT; ++op) {
+        const EuclidReplayOpStats& o = st.ops[op];
+        if (!o.count) continue;
+        std::fprintf(f, "%s\n      ", sep);
+        WriteString(f, Euclid_RecordOpName((EuclidRecordOp)op));
+        std::fprintf(f, ": {\"count\": %llu, \"total_ms\": %.4f, \"max_ms\": %.4f}", (unsigned long long)o.count, o.total_ms, o.max_ms);
+        sep = ",";
+    }
+    std::fprintf(f, "\n    }\n  }\n}\n");
+    if (std::fclose(f) != 0) return 1;
+    std::printf("results: %s\n", opt.out.c_str());
+    return res == EUCLID_OK ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--out results.json] [--max-objects N] [--frames N] [--picks N] [--size WxH] [--quick] [--null] [--gpu-driven [--no-occlusion]]\n"
+                             "       %s --replay session.erec [--realtime] [--out results.json] [--null]\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    // leave the user's shader cache alone
+    Euclid_SetShaderCacheDir("");
+
+    EuclidConfig cfg{opt.width, opt.height, opt.gpuDriven ? 4 : 3, 3};
+    EuclidHandle h = nullptr;
+    if ((opt.null ? Euclid_CreateNull(&cfg, &h) : Euclid_CreateHeadless(&cfg, &h)) != EUCLID_OK) {
+        std::fprintf(stderr, "%s context: %s\n", opt.null ? "null" : "headless", Euclid_GetLastError());
+        return 1;
+    }
+    if (opt.gpuDriven && Euclid_SetGpuDriven(h, 1) != EUCLID_OK) {
+        std::fprintf(stderr, "--gpu-driven: the context has no compute shaders / indirect draws\n");
+        Euclid_Destroy(h);
+        return 1;
+    }
+    Euclid_SetOcclusionCulling(h, opt.occlusion ? 1 : 0);
+
+    if (!opt.replay.empty()) {
+        const int rc = RunReplay(h, opt);
+        Euclid_Destroy(h);
+        return rc;
+    }
+
+    std::vector<SceneResult> scenes;
+    for (size_t n = 1000; n <= opt.maxObjects; n *= 10) {
+        SceneResult r;
+        if (!RunScene(h, opt, n, r)) { std::fprintf(stderr, "scene %zu: %s\n", n, Euclid_GetLastError()); Euclid_Destroy(h); return 1; }
+        std::printf("%8zu objects  frame p50 %7.2f ms p99 %7.2f ms  %7llu GL calls  pick p50 %8.1f us  create %8.0f/s  delete %8.0f/s\n",
+                    n, r.frameMs.p50, r.frameMs.p99, (unsigned long long)r.gl.total_calls, r.pickUs.p50,
+                    double(n) * 1000.0 / std::max(r.createMs, 1e-6), double(n) * 1000.0 / std::max(r.deleteMs, 1e-6));
+        scenes.push_back(r);
+    }
+
+    std::error_code ec;
+    const fs::path dir = fs::temp_directory_path(ec) / ("euclid-bench-" + std::to_string((long long)std::time(nullptr)));
+    fs::create_directories(dir, ec);
+    std::vector<ImportResult> imports;
+    for (int seg : {32, 100, 320, 1000}) {
+        if (size_t(4) * seg * seg > opt.maxImportTris) break;
+        ImportResult r;
+        if (!RunImport(h, dir, seg, r)) { std::fprintf(stderr, "import %d: failed\n", seg); Euclid_Destroy(h); return 1; }
+        std::printf("%8zu tris     import %7.2f ms  %7.2f MB/s\n", r.triangles, r.ms,
+                    double(r.bytes) / (1024.0 * 1024.0) / std::max(r.ms / 1000.0, 1e-9));
+        imports.push_back(r);
+    }
+    fs::remove_all(dir, ec);
+    Euclid_Destroy(h);
+
+    if (!WriteJSON(opt, scenes, imports)) { std::fprintf(stderr, "cannot write %s\n", opt.out.c_str()); return 1; }
+    std::printf("results: %s\n", opt.out.c_str());
+    return 0;
+}
@@ -11,6 +11,11 @@
 
 #include <unordered_map>
 #include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <cstring> // std::strlen, std::strncpy
 #include <cctype>  // std::tolower
 
@@ -157,12 +162,252 @@ static void DoImportOBJ(const char* path, bool normalize) {
     }
 }
 
+// Out-of-core: converts to <path>.epg next to the OBJ (blocks until done), then streams it
+static void DoImportPaged(const char* path, bool normalize) {
+    if (!path || !*path || !EndsWithNoCase(path, ".obj")) return;
+    const std::string paged = std::string(path) + ".epg";
+    EuclidObjectID id = 0;
+    if (Euclid_BuildPagedMesh(H, path, paged.c_str(), normalize ? 1 : 0) == EUCLID_OK &&
+        Euclid_LoadPagedMesh(H, paged.c_str(), &id) == EUCLID_OK && id)
+        SetSelectionBoth(id);
+}
+
+// =======================
+// Performance panel + stress generator
+// =======================
+struct History {
+    static constexpr int kSize = 240;
+    float v[kSize] = {};
+    int   head = 0;
+    void  Push(float x) { v[head] = x; head = (head + 1) % kSize; }
+    float Max() const { return *std::max_element(v, v + kSize); }
+    float Avg() const { float s = 0; for (float x : v) s += x; return s / kSize; }
+    void  Plot(const char* label, float height) const {
+        char overlay[64];
+        std::snprintf(overlay, sizeof(overlay), "avg %.2f  max %.2f ms", Avg(), Max());
+        ImGui::PlotLines(label, v, kSize, head, overlay, 0.0f, std::max(16.7f, Max() * 1.1f), ImVec2(0, height));
+    }
+};
+
+struct StressObject { EuclidObjectID id; EuclidTransform base; float spin, phase; };
+
+static struct {
+    History frameMs, engineMs;           // whole frame (dt) / Euclid_Update + Euclid_Render on the CPU
+    int     spawnCount = 1000;
+    int     spawnMode = 0;               // 0 primitives, 1 OBJ instances (gObjPath)
+    bool    animate = false;
+    float   animSpeed = 1.0f;
+    float   animTime = 0.0f;
+    bool    grid = true;
+    bool    vsync = true;
+    bool    multiView = false;           // draw through Euclid_RenderViewports (instanced path)
+    bool    passTimings = true;
+    bool    countGL = false;
+    bool    trace = false;
+    bool    glDebug = false;
+    bool    gpuDriven = false;           // needs a 4.3 context; the window asks for 3.3 but usually gets more
+    bool    occlusion = true;
+    bool    backfaces = false;
+    int     streamingMB = 256;
+    EuclidGLCallStats gl{};
+    std::vector<StressObject>    objects;
+    std::vector<EuclidObjectID>  ids;    // same order as objects, for the batch calls
+    std::vector<EuclidTransform> xforms;
+    std::mt19937 rng{1234};
+} gPerf;
+
+static float Rand01() { return std::uniform_real_distribution<float>(0.0f, 1.0f)(gPerf.rng); }
+
+// Spread over a square that grows with the count, so density stays about the same
+static void RandomTransform(EuclidTransform& t, float extent, float scale) {
+    MakeDefaultTransform(t, (Rand01() - 0.5f) * extent, Rand01() * 2.0f, (Rand01() - 0.5f) * extent);
+    t.rotation[1] = Rand01() * 360.0f;
+    t.scale[0] = t.scale[1] = t.scale[2] = scale * (0.5f + Rand01());
+}
+
+static void AddStress(EuclidObjectID id, const EuclidTransform& t) {
+    gPerf.objects.push_back({ id, t, (Rand01() - 0.5f) * 180.0f, Rand01() * 6.2831853f });
+    gPerf.ids.push_back(id);
+    gPerf.xforms.push_back(t);
+}
+
+static void SpawnStress(int n) {
+    const float extent = 4.0f * std::sqrt(float(gPerf.objects.size() + n) / 100.0f) + 2.0f;
+    if (gPerf.spawnMode == 0) {
+        std::vector<EuclidCreateShapeDesc> descs(n);
+        std::vector<EuclidObjectID> ids(n);
+        for (auto& d : descs) {
+            d = {};
+            d.type = (EuclidShapeType)(gPerf.rng() % 8);
+            RandomTransform(d.xform, extent, 0.3f);
+        }
+        if (Euclid_CreateShapesBatch(H, descs.data(), descs.size(), ids.data()) != EUCLID_OK) return;
+        for (int i = 0; i < n; ++i) AddStress(ids[i], descs[i].xform);
+    } else {
+        // every instance is a separate import (no mesh sharing for custom meshes yet)
+        for (int i = 0; i < n; ++i) {
+            EuclidObjectID id = 0;
+            if (Euclid_LoadOBJ(H, gObjPath, &id, 1) != EUCLID_OK || !id) break;
+            EuclidTransform t; RandomTransform(t, extent, 0.5f);
+            Euclid_SetObjectTransform(H, id, &t);
+            AddStress(id, t);
+        }
+    }
+}
+
+static void ClearStress() {
+    for (EuclidObjectID id : gPerf.ids) Euclid_DeleteObject(H, id);
+    gPerf.objects.clear();
+    gPerf.ids.clear();
+    gPerf.xforms.clear();
+}
+
+// Spin + bob every stress object, one batch call per frame
+static void AnimateStress(float dt) {
+    if (!gPerf.animate || gPerf.objects.empty()) return;
+    gPerf.animTime += dt * gPerf.animSpeed;
+    for (size_t i = 0; i < gPerf.objects.size(); ++i) {
+        const StressObject& o = gPerf.objects[i];
+        EuclidTransform& t = gPerf.xforms[i];
+        t = o.base;
+        t.rotation[1] += o.spin * gPerf.animTime;
+        t.position[1] += 0.25f * std::sin(gPerf.animTime * 2.0f + o.phase);
+    }
+    Euclid_SetTransformsBatch(H, gPerf.ids.data(), gPerf.ids.size(), gPerf.xforms.data(), 0);
+}
+
+static void RenderScene(GLFWwindow* win) {
+    if (!gPerf.multiView) { Euclid_Render(H); return; }
+    int fbw = 1, fbh = 1; glfwGetFramebufferSize(win, &fbw, &fbh);
+    EuclidViewport vp{};
+    vp.width = fbw; vp.height = fbh;
+    vp.draw_grid = gPerf.grid ? 1 : 0;
+    vp.draw_gizmo = 1;
+    Euclid_GetCameraMatrices(H, vp.view, vp.projection);
+    Euclid_RenderViewports(H, &vp, 1);
+}
+
+static void PerfWindow() {
+    ImGui::SetNextWindowSize(ImVec2(420, 640), ImGuiCond_FirstUseEver);
+    ImGui::Begin("Performance");
+
+    EuclidStats st{}; Euclid_GetStats(H, &st);
+    ImGui::Text("FPS %.1f   draws %d   triangles %d   stress objects %zu", st.fps, st.draw_calls, st.triangles, gPerf.objects.size());
+    gPerf.frameMs.Plot("frame", 60.0f);
+    gPerf.engineMs.Plot("engine CPU", 60.0f);
+
+    if (ImGui::CollapsingHeader("Passes", ImGuiTreeNodeFlags_DefaultOpen)) {
+        EuclidPassTiming passes[16];
+        const int n = Euclid_GetPassTimings(H, passes, 16);
+        if (ImGui::BeginTable("passes", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+            ImGui::TableSetupColumn("pass"); ImGui::TableSetupColumn("CPU ms"); ImGui::TableSetupColumn("GPU ms");
+            ImGui::TableHeadersRow();
+            for (int i = 0; i < n; ++i) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(passes[i].name);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", passes[i].cpu_ms);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", passes[i].gpu_ms);
+            }
+            ImGui::EndTable();
+        }
+        if (!n) ImGui::TextDisabled("Enable pass timings below.");
+    }
+
+    if (ImGui::CollapsingHeader("GL calls / memory")) {
+        if (gPerf.countGL)
+            ImGui::Text("per frame: %llu calls, %llu draws, %llu binds, %llu state, %llu uniforms, %llu uploads",
+                        (unsigned long long)gPerf.gl.total_calls, (unsigned long long)gPerf.gl.draw_calls,
+                        (unsigned long long)gPerf.gl.binds, (unsigned long long)gPerf.gl.state_changes,
+                        (unsigned long long)gPerf.gl.uniform_updates, (unsigned long long)gPerf.gl.uploads);
+        else
+            ImGui::TextDisabled("GL call counting is off.");
+        EuclidMemoryStats mem{};
+        if (Euclid_GetMemoryStats(&mem) == EUCLID_OK) {
+            ImGui::Text("GPU %.2f MB (peak %.2f)   CPU %.2f MB (peak %.2f)",
+                        mem.gpu_bytes / 1048576.0, mem.gpu_peak_bytes / 1048576.0,
+                        mem.cpu_bytes / 1048576.0, mem.cpu_peak_bytes / 1048576.0);
+            for (int c = 0; c < EUCLID_MEM_CATEGORY_COUNT; ++c)
+                ImGui::BulletText("%-20s %9.1f KB", Euclid_MemoryCategoryName((EuclidMemoryCategory)c),
+                                  mem.categories[c].bytes / 1024.0);
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Streaming (paged imports)")) {
+        if (ImGui::SliderInt("Budget MB", &gPerf.streamingMB, 8, 4096, "%d", ImGuiSliderFlags_Logarithmic))
+            Euclid_SetStreamingBudget(H, (uint64_t)gPerf.streamingMB << 20);
+        EuclidStreamingStats ss{};
+        Euclid_GetStreamingStats(H, &ss);
+        ImGui::Text("chunks %u resident, %u loading, of %u", ss.resident_chunks, ss.loading_chunks, ss.chunks);
+        ImGui::Text("resident %.1f MB of %.1f   proxies %.2f MB", ss.resident_bytes / 1048576.0,
+                    ss.budget_bytes / 1048576.0, ss.proxy_bytes / 1048576.0);
+        ImGui::Text("loads %llu   evictions %llu", (unsigned long long)ss.loads, (unsigned long long)ss.evictions);
+    }
+
+    if (ImGui::CollapsingHeader("GL debug output")) {
+        if (ImGui::Checkbox("Capture", &gPerf.glDebug) && Euclid_EnableGLDebug(H, gPerf.glDebug ? 1 : 0) != EUCLID_OK)
+            gPerf.glDebug = false;
+        ImGui::SameLine();
+        if (ImGui::Button("Clear")) Euclid_ClearGLMessages();
+        EuclidGLDebugStats ds{};
+        Euclid_GetGLDebugStats(&ds);
+        ImGui::Text("%llu received, %llu distinct, %llu last frame, %llu performance",
+                    (unsigned long long)ds.total, (unsigned long long)ds.unique,
+                    (unsigned long long)ds.last_frame, (unsigned long long)ds.performance);
+        static const char* const kSeverity[4] = { "note", "low", "medium", "high" };
+        EuclidGLMessage msgs[64];
+        const int n = Euclid_GetGLMessages(msgs, 64);
+        for (int i = 0; i < n; ++i)
+            ImGui::TextWrapped("[%s x%llu] %s%s%s", kSeverity[msgs[i].severity], (unsigned long long)msgs[i].count,
+                               *msgs[i].scope ? msgs[i].scope : "", *msgs[i].scope ? ": " : "", msgs[i].text);
+        if (!gPerf.glDebug && !n) ImGui::TextDisabled("Off. Needs GL 4.3 or GL_KHR_debug.");
+    }
+
+    if (ImGui::CollapsingHeader("Stress", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::RadioButton("Primitives", &gPerf.spawnMode, 0); ImGui::SameLine();
+        ImGui::RadioButton("OBJ instances (import path)", &gPerf.spawnMode, 1);
+        ImGui::SliderInt("Count", &gPerf.spawnCount, 1, gPerf.spawnMode == 0 ? 100000 : 500, "%d", ImGuiSliderFlags_Logarithmic);
+        if (ImGui::Button("Spawn")) SpawnStress(gPerf.spawnCount);
+        ImGui::SameLine();
+        if (ImGui::Button("Clear stress objects")) ClearStress();
+        ImGui::Checkbox("Animate", &gPerf.animate); ImGui::SameLine();
+        ImGui::SliderFloat("Speed", &gPerf.animSpeed, 0.0f, 4.0f);
+    }
+
+    if (ImGui::CollapsingHeader("Renderer", ImGuiTreeNodeFlags_DefaultOpen)) {
+        if (ImGui::Checkbox("Grid", &gPerf.grid)) Euclid_SetGridVisible(H, gPerf.grid ? 1 : 0);
+        ImGui::SameLine();
+        if (ImGui::Checkbox("VSync", &gPerf.vsync)) glfwSwapInterval(gPerf.vsync ? 1 : 0);
+        ImGui::SameLine();
+        ImGui::Checkbox("Instanced (multi-view) path", &gPerf.multiView);
+        if (ImGui::Checkbox("GPU-driven (compute cull + MDI)", &gPerf.gpuDriven) &&
+            Euclid_SetGpuDriven(H, gPerf.gpuDriven ? 1 : 0) != EUCLID_OK)
+            gPerf.gpuDriven = false;
+        if (gPerf.gpuDriven) {
+            ImGui::SameLine();
+            if (ImGui::Checkbox("Occlusion culling", &gPerf.occlusion)) Euclid_SetOcclusionCulling(H, gPerf.occlusion ? 1 : 0);
+        }
+        if (ImGui::Checkbox("Backface culling (imports)", &gPerf.backfaces)) Euclid_SetBackfaceCulling(H, gPerf.backfaces ? 1 : 0);
+        if (ImGui::Checkbox("Pass timings", &gPerf.passTimings)) Euclid_SetPassTimings(H, gPerf.passTimings ? 1 : 0);
+        ImGui::SameLine();
+        if (ImGui::Checkbox("Count GL calls", &gPerf.countGL))
+            Euclid_SetGLCapture(gPerf.countGL ? EUCLID_GL_CAPTURE_COUNT : EUCLID_GL_CAPTURE_OFF);
+        if (ImGui::Checkbox("Trace", &gPerf.trace)) {
+            if (!gPerf.trace) Euclid_ProfilerExportChromeTrace("euclid_trace.json");
+            Euclid_ProfilerEnable(gPerf.trace ? 1 : 0);
+        }
+        ImGui::SameLine();
+        ImGui::TextDisabled(gPerf.trace ? "untick to write euclid_trace.json" : "zones -> Chrome trace");
+    }
+    ImGui::End();
+}
+
 int main(){
     // --- GLFW / GL ---
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR,3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR,3);
     glfwWindowHint(GLFW_OPENGL_PROFILE,GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT,GLFW_TRUE);   // drivers only say much on a debug context
 #ifdef __APPLE__
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT,GL_TRUE);
 #endif
@@ -173,6 +418,7 @@ int main(){
     // --- Euclid init ---
     EuclidConfig cfg{1280, 720, 3, 3};
     if (Euclid_Create(&cfg, Loader, &H) != EUCLID_OK) return -1;
+    Euclid_SetPassTimings(H, gPerf.passTimings ? 1 : 0);
 
     // --- ImGui init (no auto-install callbacks) ---
     IMGUI_CHECKVERSION();
@@ -280,8 +526,17 @@ int main(){
         double now=glfwGetTime(); float dt=float(now-last); last=now;
         fpsAvg = 0.9f*fpsAvg + 0.1f*(1.f/dt);
 
+        AnimateStress(dt);
+        const double engineStart = glfwGetTime();
         Euclid_Update(H, dt);
-        Euclid_Render(H);
+        RenderScene(win);
+        gPerf.engineMs.Push(float((glfwGetTime() - engineStart) * 1000.0));
+        gPerf.frameMs.Push(dt * 1000.0f);
+        if (gPerf.countGL) {
+            // everything since the last read: this frame's engine calls
+            Euclid_GetGLCallStats(&gPerf.gl);
+            Euclid_ResetGLCallStats();
+        }
 
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
@@ -390,6 +645,8 @@ int main(){
         if (ImGui::Button("Import")) {
             DoImportOBJ(gObjPath, gNormalizeOBJ);
         }
+        ImGui::SameLine();
+        if (ImGui::Button("Import paged")) DoImportPaged(gObjPath, gNormalizeOBJ);
         ImGui::TextDisabled("Tip: Drag & drop .obj files anywhere on the window to import.");
 
         // Engine selection (may be 0) and fallback to local
@@ -486,6 +743,7 @@ int main(){
         if (ImGui::Button("Clear Scene")) {
             Euclid_ClearScene(H);
             gParamsById.clear();
+            gPerf.objects.clear(); gPerf.ids.clear(); gPerf.xforms.clear();
             SetSelectionBoth(0);
         }
         ImGui::SameLine();
@@ -493,6 +751,8 @@ int main(){
 
         ImGui::End();
 
+        PerfWindow();
+
         ImGui::Render();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
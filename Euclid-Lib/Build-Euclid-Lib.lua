@@ -35,6 +35,9 @@ filter "system:macosx"
         "CoreVideo.framework",
         "CoreFoundation.framework"
 	}
+
+filter "system:linux"
+       links   { "dl", "pthread" }   -- libEGL is dlopen'ed for headless contexts
 filter {} 
 
 filter "configurations:Debug"
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Euclid_Commands.h"
+#include "MemoryStats.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Euclid
+{
+// Bounded multi-producer queue behind Euclid_SubmitCommands (Vyukov-style: every cell
+// carries a sequence number saying whose turn it is). Producers claim a whole batch
+// with one CAS and publish it back to front, so the consumer sees either none or all
+// of it. One consumer: the GL thread, in Drain.
+class CommandQueue {
+public:
+    void Enable(uint32_t capacity);       // GL thread, while nobody submits
+    bool Enabled() const { return mCells != nullptr; }
+
+    bool Submit(const EuclidCommand* cmds, size_t count);   // any thread; false = full
+
+    // Hands every command published so far to fn, in submission order
+    template <class Fn> size_t Drain(Fn&& fn);
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<uint64_t> seq{0};
+        EuclidCommand         cmd{};
+    };
+    std::unique_ptr<Cell[]> mCells;
+    uint64_t mMask = 0;
+    MemoryCharge mMem{EUCLID_MEM_CPU_QUEUES};
+
+    alignas(64) std::atomic<uint64_t> mEnqueue{0};
+    alignas(64) uint64_t mDequeue = 0;    // consumer only
+};
+
+template <class Fn>
+size_t CommandQueue::Drain(Fn&& fn) {
+    if (!mCells) return 0;
+    // stop at what was claimed on entry: submitters can't keep the frame from starting
+    const uint64_t end = mEnqueue.load(std::memory_order_acquire);
+    size_t n = 0;
+    while (mDequeue != end) {
+        Cell& c = mCells[mDequeue & mMask];
+        if (c.seq.load(std::memory_order_acquire) != mDequeue + 1) break;   // still being written
+        const EuclidCommand cmd = c.cmd;
+        c.seq.store(mDequeue + mMask + 1, std::memory_order_release);      // free for the next lap
+        ++mDequeue;
+        fn(cmd);
+        ++n;
+    }
+    return n;
+}
+}
@@ -2,23 +2,112 @@
 
 #include "Graphics.hpp"
 #include "Objects.hpp"
+#include "Renderer.hpp"
+#include "IndirectScene.hpp"
+#include "PagedMesh.hpp"
+#include "EventQueue.hpp"
+#include "CommandQueue.hpp"
+#include "SceneSnapshot.hpp"
+#include "InputQueue.hpp"
+#include "Profiler.hpp"
+#include "MemoryStats.hpp"
+#include "Euclid_Core.h"
+#include "Euclid_Renderer.h"
+#include "Euclid_Input.h"
 
 #include "Glad/glad.h"
+#include <chrono>
 #include <iostream>
+#include <memory>
 
 namespace Euclid
 {
+// What views created from one instance (Euclid_CreateView) have in common: the
+// programs, the gizmo/primitive/imported geometry and the scene itself. Everything
+// here lives on the GL context of the first view and stays until the last view is gone.
+struct SharedContext {
+    bool initialized = false;             // programs are built (first view's Init)
+
+    ProgramCache  programCache;
+    ShaderProgram mainShader;
+    ShaderProgram gridShader;
+    ShaderProgram translationShader;
+    ShaderProgram rotationShader;
+    ShaderProgram transformationShader;
+    bool parallelCompile = false;
+    bool gizmoProgramsStarted = false;
+    bool gizmoPending[3] = {};
+    bool gizmoReady = false;
+    bool glDebug = false;                 // KHR_debug output on for this context
+
+    unsigned int dummyVAO = 0;
+    unsigned int translationVAO = 0;
+    unsigned int transformationVAO = 0;
+    unsigned int translationVBO = 0;
+    unsigned int transformationVBO = 0;
+    MemoryCharge gizmoMem{EUCLID_MEM_GPU_STREAMING};
+
+    // multi-view (RenderViewports), built on first use
+    ShaderProgram multiViewShader;
+    int           multiViewPath = 0;      // 0 = not built yet, else Core::MultiViewPath
+    unsigned int  multiViewVBO = 0;       // per-instance model matrices
+    MemoryCharge  multiViewMem{EUCLID_MEM_GPU_STREAMING};
+
+    // GPU-driven scene pass (GL 4.3), built on first use
+    IndirectScene indirect;
+    // out-of-core imports: which chunks are on the GPU, reads on a worker
+    PageStreamer  streaming;
+
+    ObjectStore   objs;
+    EventQueue    events;
+    CommandQueue  commands;
+    SceneSnapshot snapshot;
+
+    // GL objects go with the last view (its context is current, see Euclid_Destroy)
+    ~SharedContext();
+};
+
 class Core {
 public:
-    bool Init(int width, int height, int gl_major, int gl_minor);
+    // shared == nullptr: a fresh instance with its own context; otherwise another view on it
+    explicit Core(std::shared_ptr<SharedContext> shared = nullptr);
+    ~Core();
+    const std::shared_ptr<SharedContext>& Shared() const { return mShared; }
+
+    // loader is only used to look up optional entry points glad doesn't know about
+    bool Init(int width, int height, int gl_major, int gl_minor, Euclid_GetProcAddr loader = nullptr);
     void CleanUp();
 
     void Resize(int width, int height);
     void Update(float dtSeconds);
     void Render();
+    void GetInitStats(EuclidInitStats& out) const;
+    void GetStats(EuclidStats& out) const { out = mStats; }
+    // live per-pass timings (Euclid_GetPassTimings)
+    void SetPassTimings(bool on) { mGpuProfiler.SetLive(on); }
+    bool EnableGLDebug(bool on);   // this view's context (Euclid_EnableGLDebug)
+    bool SetGpuDriven(bool on);    // false if the context can't (Euclid_SetGpuDriven)
+    void SetOcclusionCulling(bool on) { mOcclusion = on; }
+    void SetBackfaceCulling(bool on) { mBackfaceCulling = on; }
+    int  PassTimings(EuclidPassTiming* out, int max) const { return mGpuProfiler.PassTimings(out, max); }
+    // Draws the scene with explicit matrices into whatever FBO/viewport is bound
+    void RenderView(const glm::mat4& view, const glm::mat4& projection, bool drawGrid, bool drawGizmo);
+    // Several panes of the bound FBO in one frame: one scene walk, one cull, one draw per mesh
+    EuclidResult RenderViewports(const EuclidViewport* viewports, int count);
+    void GetCameraMatrices(float view[16], float projection[16]);   // applies queued input first
+
+    // Poster export: renders width x height (any size) in tiles and streams it to a PNG
+    EuclidResult RenderTiled(const char* path, int width, int height, int tileSize, bool drawGrid);
+    // Turntable / keyframed image sequence with render, readback and encode overlapped
+    EuclidResult RenderSequence(const EuclidSequenceDesc& desc);
     
+    void InitShared(Euclid_GetProcAddr loader);   // first view on a context: compiler threads, programs
     void InitShader();
     void UseShader();
+    // gizmo programs are compiled (or queued with parallel compile) off the startup path
+    void BeginGizmoPrograms();
+    void FinishGizmoPrograms();
+    void EnsureGizmo();   // programs + buffers, on first selection
     
     // Gizmo Draw (0_o)
     void BuildTranslationGizmo(const glm::vec3& origin, float L);
@@ -37,51 +126,120 @@ public:
                                  float lengthWorld,
                                  float tipSizePx);
     
-    // Mouse input coming from the host via wrapper
+    // Mouse input coming from the host via wrapper. Any thread: it is queued and
+    // applied (coalesced) once per frame, right before drawing.
     void OnMouseMove(double x, double y);                    // absolute window coords
     void OnMouseButton(int button, bool down, unsigned mods);
     void OnScroll(double dx, double dy);
     void OnMods(unsigned mods);
+    void ProcessInput();                                     // applies what is queued now
+    void FramePresented();                                   // host: the last frame is on screen
+    void GetInputStats(EuclidInputStats& out) const { out = mInputStats; }
     
     // Scene API (called from wrapper)
     Object* CreateObject(EuclidShapeType t, const void* params, const EuclidTransform& xform, EuclidObjectID id);
     void    DestroyObjectGPU(EuclidObjectID id);
     void    SetSelection(EuclidObjectID id);
+    EuclidObjectID GetSelection() const { return mObjs.GetSelection(); }
     EuclidObjectID RayPick(float x, float y);
     EuclidResult GetObjectTransform(EuclidObjectID id, EuclidTransform& out);
     EuclidResult SetObjectTransform(EuclidObjectID id, const EuclidTransform& in);
+    // batched variants (transforms at base + i*stride)
+    EuclidResult CreateObjects(const EuclidCreateShapeDesc* descs, size_t count, EuclidObjectID* outIDs);
+    EuclidResult SetObjectTransforms(const EuclidObjectID* ids, size_t count, const void* src, size_t stride);
+    EuclidResult GetObjectTransforms(const EuclidObjectID* ids, size_t count, void* dst, size_t stride);
+    void GetSceneView(EuclidSceneView& out) const;
+
+    // Hierarchy (parent 0 = root)
+    EuclidResult SetParents(const EuclidObjectID* ids, size_t count, EuclidObjectID parent);
+    EuclidResult GetParent(EuclidObjectID id, EuclidObjectID& out) const;
+    EuclidResult GetWorldMatrix(EuclidObjectID id, float out[16]) const;
     void SetGizmoMode(EuclidGizmoMode m) { mGizmoMode = m; }
+    void SetGridVisible(bool visible) { mShowGrid = visible; }
+    bool GridVisible() const { return mShowGrid; }
+    EuclidResult FrameObject(EuclidObjectID id);   // pivot on the object and pull back until it fits
     void RequestRebuildScene();
-    bool IsDraggingGizmo() const { return mDraggingGizmo; }
+    bool IsDraggingGizmo() { ProcessInput(); return mDraggingGizmo; }
     EuclidResult LoadOBJ(const char* path, EuclidObjectID* outID, bool normalize);
     EuclidResult CreateFromRawMesh(const float* pos, size_t vcount,
                                        const unsigned* idx, size_t icount,
                                        EuclidObjectID* outID, bool normalize);
+    // Out-of-core imports (Euclid_BuildPagedMesh); the build posts IMPORT_PROGRESS like LoadOBJ
+    EuclidResult BuildPagedMesh(const char* objPath, const char* pagePath, bool normalize);
+    EuclidResult LoadPagedMesh(const char* path, EuclidObjectID* outID);
+    void         SetStreamingBudget(uint64_t bytes) { mShared->streaming.SetBudget(bytes); }
+    void         GetStreamingStats(EuclidStreamingStats& out) const { mShared->streaming.GetStats(mObjs, out); }
+    // File a paged object was loaded from (sessions record the load, not the geometry)
+    EuclidResult PagedMeshPath(EuclidObjectID id, std::string& out) const;
     
     EuclidResult DeleteObject(EuclidObjectID id);
     EuclidResult ClearScene();
 
+    // Session snapshots (Euclid_RecordStart). GetCameraState applies queued input first.
+    struct CameraState { float target[3]; float radius, yaw, pitch, zoom; };
+    CameraState  GetCameraState();
+    void         SetCameraState(const CameraState& c);
+    // Custom mesh of id read back from the GPU (positions xyz, indices)
+    EuclidResult ReadCustomMesh(EuclidObjectID id, std::vector<float>& positions, std::vector<unsigned>& indices) const;
+
+    // Scene events (see Euclid_Events.h)
+    EuclidResult EnableEvents(uint32_t capacity);
+    EventQueue&  Events() { return mEvents; }
+
+    // Cross-thread command queue + scene snapshot (see Euclid_Commands.h)
+    EuclidResult   EnableCommandQueue(uint32_t capacity);
+    bool           SubmitCommands(const EuclidCommand* cmds, size_t count) { return mCommands.Submit(cmds, count); }
+    bool           CommandQueueEnabled() const { return mCommands.Enabled(); }
+    EuclidObjectID ReserveObjectIDs(size_t count) { return mObjs.ReserveIDs(count); }
+    SceneSnapshot& Snapshot() { return mSnapshot; }
+
     
 private:
     void DrawObject(const Object& o, const glm::mat4& view, const glm::mat4& proj);
+    void DrawMeshlets(const SharedMesh& mesh, const glm::mat4& model, const glm::mat4& viewProj);
+    void DrawPaged(const PagedMesh& pm, const glm::mat4& model, const glm::mat4& viewProj);
+    void UpdateStreaming(const glm::vec3* eyes, const glm::mat4* viewProjs, int count);
+    void SettleStreaming(const glm::mat4& view, const glm::mat4& proj);   // exports, before drawing
     void DrawScene (const glm::mat4& view, const glm::mat4& proj);
     void DrawGizmoForSelection(const glm::mat4& viewProj);
+    void DrawGrid(const glm::mat4& view, const glm::mat4& projection);   // full-viewport pass, depth test on
+
+    enum MultiViewPath { kMultiViewLayered = 1, kMultiViewBatched = 2 };
+    void EnsureMultiView();
+    void DrawMultiViewRange(const SharedMesh& mesh, uint32_t first, uint32_t count);
 
     void EndGizmoDrag();
+    void ApplyMouseMove(double x, double y);
+    void ApplyMouseButton(int button, bool down, unsigned mods);
+    void ApplyScroll(double dx, double dy);
+    void ApplyMods(unsigned mods);
+    void EndFrameInput();                 // latency bookkeeping at the end of a frame
+    void RecordInputLatency(uint64_t sinceNs);
+    void ApplyCommand(const EuclidCommand& c);
+    void PostEvent(EuclidEventType type, EuclidObjectID id, const EuclidTransform* tf = nullptr,
+                   float progress = 0.0f, bool dragging = false);
+    void FlushDragEvent(bool final);
     
     void FocusOnObject(const Object& o, bool adjustRadius=false);
+    glm::mat4 ProjectionMatrix() const;   // main camera, current viewport aspect
     bool mPivotFollowsSelection = true; // keep pivot on the selected object while dragging
     
 private:
+    static constexpr float kNearPlane = 0.1f;
+    static constexpr float kFarPlane  = 100.0f;
+    static constexpr float kFrameMargin = 1.1f;   // FrameObject leaves ~10% around the bounds
+
     int mWidth;
     int mHeight;
-    unsigned int mVAO = 0;
-    unsigned int mVBO = 0;
-    unsigned int mDummyVAO = 0;
-    unsigned int mTranslationVAO = 0;
-    unsigned int mTransformationVAO = 0;
-    unsigned int mTranslationVBO = 0;
-    unsigned int mTransformationVBO = 0;
+
+    // Shared state is reached through these references, so code reads the same
+    // whether or not this view is the only one.
+    std::shared_ptr<SharedContext> mShared;
+    unsigned int& mDummyVAO          = mShared->dummyVAO;
+    unsigned int& mTranslationVAO    = mShared->translationVAO;
+    unsigned int& mTransformationVAO = mShared->transformationVAO;
+    unsigned int& mTranslationVBO    = mShared->translationVBO;
+    unsigned int& mTransformationVBO = mShared->transformationVBO;
     
     Camera mainCamera;
     float mLastMouseX = 0.f, mLastMouseY = 0.f;
@@ -90,29 +248,68 @@ private:
     float mTargetAngleX = 0.0f, mTargetAngleY = 0.0f; // targets
     glm::mat4 mModel = glm::mat4(1.0f);
     
-    Shader mainVertex;
-    Shader mainFragment;
-    ShaderProgram mainShader;
-    
-    Shader gridVertex;
-    Shader gridFragment;
-    ShaderProgram gridShader;
-    
-    Shader translationVertex;
-    Shader translationFragment;
-    ShaderProgram translationShader;
-    
-    Shader rotationVertex;
-    Shader rotationFragment;
-    ShaderProgram rotationShader;
-    
-    Shader transformationVertex;
-    Shader transformationFragment;
-    ShaderProgram transformationShader;
+    ProgramCache&  mProgramCache        = mShared->programCache;
+    ShaderProgram& mainShader           = mShared->mainShader;
+    ShaderProgram& gridShader           = mShared->gridShader;
+    ShaderProgram& translationShader    = mShared->translationShader;
+    ShaderProgram& rotationShader       = mShared->rotationShader;
+    ShaderProgram& transformationShader = mShared->transformationShader;
+    ShaderProgram& multiViewShader      = mShared->multiViewShader;
+    bool& mParallelCompile      = mShared->parallelCompile;        // KHR/ARB_parallel_shader_compile available
+    bool& mGizmoProgramsStarted = mShared->gizmoProgramsStarted;
+    bool (&mGizmoPending)[3]    = mShared->gizmoPending;           // translation, rotation, transformation still compiling
+    bool& mGizmoReady           = mShared->gizmoReady;
+
+    // startup timings (Euclid_GetInitStats)
+    std::chrono::steady_clock::time_point mInitStart;
+    EuclidInitStats mInitStats{};
+    bool mFirstFrameDone = false;
+
+    // Euclid_GetStats: counted while drawing, published when a frame is done
+    void BeginFrameStats();
+    void EndFrameStats();
+    int         mDraws = 0, mTriangles = 0;
+    uint64_t    mLastFrameNs = 0;
+    EuclidStats mStats{};
     
     // Objects Logic Data
-    ObjectStore mObjs;
+    ObjectStore&   mObjs      = mShared->objs;
+    EventQueue&    mEvents    = mShared->events;
+    CommandQueue&  mCommands  = mShared->commands;
+    SceneSnapshot& mSnapshot  = mShared->snapshot;
+    bool        mDragDirty = false;   // gizmo moved the object since the last TRANSFORM_CHANGED
     
+    bool mShowGrid = true;
+    bool mIndirect = false;   // scene pass through IndirectScene (compute cull + one MDI)
+    bool mOcclusion = true;   // ... with the depth-pyramid pass
+    bool mBackfaceCulling = false;   // imports drawn single-sided, clusters facing away skipped
+
+    // meshlet runs that survived culling, for one glMultiDrawElements
+    std::vector<int>         mClusterCounts;
+    std::vector<const void*> mClusterOffsets;
+    MemoryCharge             mClusterMem{EUCLID_MEM_CPU_FRAME};
+
+    // multi-view scratch, reused between frames
+    std::vector<glm::mat4> mMVInstances;   // sorted by (mesh, viewport)
+    std::vector<uint32_t>  mMVCounts;      // per (mesh, viewport), then prefix sums
+    std::vector<uint32_t>  mMVKeys;        // per drawn object: mesh bucket
+    std::vector<uint16_t>  mMVMasks;       // per drawn object: viewports it is visible in
+    MemoryCharge           mMVMem{EUCLID_MEM_CPU_FRAME};
+
+    // input (per view: each one has its own pointer and modifier state)
+    bool     mCtrlDown = false;
+    bool     mMMBDown  = false;
+    bool     mFirstMoveWhileOrbit = true;
+    double   mLastX = 0.0, mLastY = 0.0;
+    unsigned mMods  = 0;   // last known modifiers
+    GpuProfiler             mGpuProfiler;           // GL timestamps for this view's passes
+    InputQueue              mInput;
+    std::vector<InputEvent> mInputBatch;            // scratch for ProcessInput
+    uint64_t                mFrameInputNs = 0;      // oldest input applied for the frame being built
+    uint64_t                mUnpresentedInputNs = 0;// ... for the rendered frame not yet presented
+    bool                    mPresentReported = false;
+    EuclidInputStats        mInputStats{};
+
     // gizmo state
     EuclidGizmoMode mGizmoMode = EUCLID_GIZMO_TRANSLATE;
     bool        mDraggingGizmo=false;
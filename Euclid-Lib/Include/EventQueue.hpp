@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Euclid_Events.h"
+#include "MemoryStats.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace Euclid
+{
+// SPSC ring behind the scene event API. The memory layout is the public
+// EuclidEventRing, so hosts can also read it directly. Push from the engine thread
+// only, Drain from one consumer thread only.
+class EventQueue {
+public:
+    void Enable(uint32_t capacity);       // 0 = off; not safe while someone drains
+    bool Enabled() const { return mRing != nullptr; }
+
+    void   Push(const EuclidEvent& e);    // drops (and later reports OVERFLOW) when full
+    size_t Drain(EuclidEvent* out, size_t max);
+
+    EuclidEventRing* Ring() { return mRing; }
+
+private:
+    std::unique_ptr<unsigned char[]> mStorage;
+    EuclidEventRing* mRing = nullptr;
+    bool mOverflowPending = false;        // producer side only
+    MemoryCharge mMem{EUCLID_MEM_CPU_QUEUES};
+};
+}
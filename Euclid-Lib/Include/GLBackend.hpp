@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Euclid
+{
+// Dispatch over glad's entry point table. Every GL function the engine calls is listed
+// in GLBackend.cpp and gets two typed hooks: a forwarding one (count / record, then call
+// the driver) and a null one (count, fake a plausible result, no work). Swapping the
+// pointers costs nothing when neither is in use.
+//
+// glad's table is process-wide, so both the null backend and capture apply to every
+// instance in the process: switch while no other thread is inside Euclid.
+class GLBackend {
+public:
+    enum class Capture { Off, Count, Record };
+
+    enum Category : uint8_t {
+        kOther = 0, kDraw, kBind, kState, kUniform, kUpload, kQuery, kCategoryCount
+    };
+
+    struct Command {
+        uint32_t call;       // index into the call table, see CallName
+        uint32_t argCount;   // args beyond 4 are not kept
+        uint64_t args[4];    // integers/enums as is, floats as their IEEE bits, pointers as addresses
+    };
+
+    // Loader handing out the null hooks (and nullptr for anything not in the table)
+    static void* NullProcAddress(const char* name);
+    static bool  NullLoaded();   // glad currently points at the null hooks
+
+    // Wraps the live driver entry points (no-op for the null backend, which always counts)
+    static void    SetCapture(Capture mode);
+    static Capture GetCapture();
+
+    static uint64_t CallCount(uint32_t call);
+    static uint64_t CategoryCount(Category c);
+    static uint64_t TotalCount();
+    static void     ResetCounts();
+
+    // Oldest first; taken commands are gone from the stream
+    static size_t   TakeCommands(Command* out, size_t max);
+    static size_t   PendingCommands();
+    static uint64_t DroppedCommands();   // lost to a full stream since it was last emptied
+
+    static uint32_t    CallTableSize();
+    static const char* CallName(uint32_t call);   // nullptr if out of range
+    static int         FindCall(const char* name);   // -1 if unknown
+};
+}
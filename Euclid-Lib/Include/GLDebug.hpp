@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Euclid_Debug.h"
+#include "Euclid_Types.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace Euclid
+{
+// KHR_debug output, process-wide like glad's entry points. Contexts that turned it on
+// report synchronously into one deduplicated log (Euclid_Debug.h); shader and link
+// failures are reported into it too. Scopes are the profiler zones open on the
+// reporting thread, so a driver message names the Euclid code that triggered it.
+class GLDebug {
+public:
+    static bool Enabled() { return sContexts.load(std::memory_order_relaxed) > 0; }
+
+    // Debug entry points for GL < 4.3 contexts with GL_KHR_debug (glad only loads them for 4.3)
+    static void LoadEntryPoints(Euclid_GetProcAddr loader);
+    // Current context; false if the driver has no debug output
+    static bool Attach(bool on);
+
+    static void Report(EuclidGLMessageSource source, EuclidGLMessageType type,
+                       EuclidGLMessageSeverity severity, uint32_t id, const char* text);
+    static void EndFrame();
+
+    static void SetCallback(EuclidGLMessageCallback cb, void* user, EuclidGLMessageSeverity minSeverity);
+    static int  Messages(EuclidGLMessage* out, int max);
+    static void GetStats(EuclidGLDebugStats& out);
+    static void Clear();
+
+    // Zone names (string literals) while output is on; GL debug groups around GPU passes
+    static void PushScope(const char* name);
+    static void PopScope();
+    static void PushGroup(const char* name);
+    static void PopGroup();
+
+    // glObjectLabel when the driver has it: "label" or "label suffix". Objects must
+    // have been bound once.
+    static void Label(unsigned type, unsigned name, const char* label, const char* suffix = nullptr);
+
+private:
+    static std::atomic<int> sContexts;   // contexts with output on
+};
+}
@@ -7,6 +7,8 @@
 #include <iostream>
 #include <span>
 #include <array>
+#include <string>
+#include <vector>
 
 namespace Euclid
 {
@@ -50,6 +52,8 @@ public:
 
     void SetYaw(float yaw);
     void SetPitch(float pitch);
+    float GetYaw() const;
+    float GetPitch() const;
 
     void SetMouseSensitivity(float s);
     void SetScrollSpeed(float s);
@@ -102,12 +106,19 @@ private:
     void CheckCompileErrors();
     
 private:
-    unsigned int mShaderID;
+    unsigned int mShaderID = 0;
 };
 
 class ShaderProgram {
 public:
     void Init(std::span<unsigned int> shaderIDs);
+    void Init(const char* vertexCode, const char* fragmentCode);   // compiles + links, shaders are dropped after
+    void BeginCompile(const char* vertexCode, const char* fragmentCode); // non-blocking half of Init
+    void BeginCompile(const char* computeCode);                        // same, compute-only program
+    void FinishCompile();                                              // waits, logs errors, drops shaders
+    bool InitFromBinary(GLenum format, const void* data, int length); // false if the driver rejects it
+    bool GetBinary(GLenum& format, std::vector<uint8_t>& out) const;
+    bool IsLinked() const;
     unsigned int GetID();
     void Use();
     
@@ -117,7 +128,43 @@ private:
     void CheckCompileErrors();
     
 private:
-    unsigned int mProgramID;
+    unsigned int mProgramID = 0;
+    unsigned int mPending[2] = {0, 0};   // shaders between BeginCompile and FinishCompile
+};
+
+// Linked program binaries on disk, so a warm start skips GLSL compilation entirely.
+// Entries are keyed by driver (vendor/renderer/version) + source hash; anything that
+// doesn't match or fails to load is rebuilt from source and written back.
+class ProgramCache {
+public:
+    static void SetDirectory(const char* dir);   // process-wide, "" disables, nullptr = default location
+
+    void Init();                                  // needs a current context
+    bool Enabled() const { return mEnabled; }
+
+    // Loads `name` from the cache or builds it from source (and caches it)
+    void Build(ShaderProgram& prog, const char* name, const char* vertexCode, const char* fragmentCode);
+    // Split Build: Begin returns true if the binary loaded; otherwise the compile is only
+    // queued and Finish has to run before the program is used.
+    bool Begin(ShaderProgram& prog, const char* name, const char* vertexCode, const char* fragmentCode);
+    void Finish(ShaderProgram& prog, const char* name, const char* vertexCode, const char* fragmentCode);
+    // Compute-only program, blocking (GL 4.3)
+    void BuildCompute(ShaderProgram& prog, const char* name, const char* computeCode);
+
+    int Hits() const   { return mHits; }
+    int Misses() const { return mMisses; }
+
+private:
+    std::string PathFor(const char* name, uint64_t key) const;
+    uint64_t    KeyFor(const char* vertexCode, const char* fragmentCode) const;
+    bool        Load(ShaderProgram& prog, const char* name, uint64_t key);    // counts the hit/miss
+    void        Store(ShaderProgram& prog, const char* name, uint64_t key);
+
+private:
+    bool        mEnabled = false;
+    std::string mDir;
+    uint64_t    mDriverHash = 0;
+    int         mHits = 0, mMisses = 0;
 };
 }
 
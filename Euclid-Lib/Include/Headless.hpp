@@ -0,0 +1,33 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace Euclid
+{
+// Library-owned GL context with no window or surface (EGL surfaceless on Linux).
+// Works on GPU-less machines through Mesa's llvmpipe. Every instance has its own
+// context, so several can render in parallel as long as each sticks to one thread
+// at a time.
+class HeadlessContext {
+public:
+    static std::unique_ptr<HeadlessContext> Create(int glMajor, int glMinor, std::string& error);
+
+    bool MakeCurrent();      // binds to the calling thread
+    void DoneCurrent();      // releases from the calling thread
+
+    // GL entry points for glad
+    static void* GetProcAddress(const char* name);
+
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+private:
+    HeadlessContext() = default;
+
+    void* mDisplay = nullptr;
+    void* mContext = nullptr;
+};
+}
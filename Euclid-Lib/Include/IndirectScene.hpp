@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Graphics.hpp"
+#include "Objects.hpp"
+#include "MemoryStats.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Euclid
+{
+// GPU-driven scene pass (GL 4.3). World matrices and bounds live in SSBOs, a compute
+// pass frustum-culls every object and appends it to its mesh's indirect command, and
+// one glMultiDrawElementsIndirect draws the lot out of a single vertex/index arena.
+//
+// CPU work per frame doesn't depend on the scene size: only matrices UpdateWorld
+// recomputed are uploaded. Adding/removing objects rebuilds the object tables, adding
+// or releasing meshes rebuilds the arena (GPU-side copies).
+//
+// Occlusion (two-phase, against a depth pyramid): what was visible last frame is drawn
+// first, its depth is reduced into a max-Z pyramid, and everything else is tested against
+// that and drawn in a second indirect call if it shows. Objects that become visible are
+// drawn the frame they do, so nothing pops in; hidden ones cost one compute thread.
+//
+// Imported meshes are drawn by meshlet (Objects.hpp): objects that pass hand their
+// clusters to a second compute pass (frustum, backface cone, the same two-phase
+// occlusion per cluster), which sets one indirect command per cluster to 0 or 1 instances.
+//
+// Within one mesh, draw order is whatever order the culling threads finished in.
+class IndirectScene {
+public:
+    static bool Supported();   // current context: compute shaders + multi-draw indirect
+
+    bool Init(ProgramCache& cache);   // false: stay on the per-object path
+    void Release();
+    bool Ready() const { return mReady; }
+
+    // Syncs with objs and draws it into the bound framebuffer (current viewport).
+    // occlusion: also cull against the depth buffer (single-sampled targets only)
+    // backfaces: imports single-sided, clusters facing away skipped
+    void Draw(ObjectStore& objs, const glm::mat4& view, const glm::mat4& proj, bool occlusion, bool backfaces);
+
+    // Last Draw: indirect draws issued and triangles submitted before culling
+    int Draws() const     { return mDrawn; }
+    int Triangles() const { return mTriangles; }
+
+    ~IndirectScene() { Release(); }
+
+private:
+    struct Bucket {                         // one per mesh: primitives, then imports
+        uint32_t indexCount = 0;
+        uint32_t firstIndex = 0;
+        int32_t  baseVertex = 0;
+        uint32_t objects = 0;               // drawable objects using it
+        uint32_t firstMeshlet = 0;          // into mMeshlets
+        uint32_t meshlets = 0;              // 0: drawn whole by the object pass
+    };
+    struct ObjectInfo {                     // std430, by slot: local bounds + mesh
+        glm::vec3 center;
+        uint32_t  bucket;                   // ~0u: not drawn (group, mesh missing)
+        glm::vec3 extent;
+        uint32_t  clustered;                // 1: the cluster pass draws it
+    };
+
+    void SyncArena(ObjectStore& objs);
+    void SyncObjects(ObjectStore& objs);
+    void SyncWorlds(ObjectStore& objs);
+    bool PrepareDepth();   // false: target is multisampled or has no size
+    void BuildPyramid();
+    void Cull(uint32_t mode, const glm::mat4& viewProj, const glm::vec4 planes[6]);
+    void CullClusters(uint32_t mode, const glm::mat4& viewProj, const glm::vec4 planes[6], const glm::vec4& eye, bool cones);
+    void DrawSet(uint32_t set, bool backfaces);
+
+    bool          mReady = false;
+    ShaderProgram mCull;
+    ShaderProgram mReduce;            // depth pyramid, one dispatch per level
+    ShaderProgram mClusterCull;
+    ShaderProgram mDraw;
+    int           mPlanesLoc = -1, mCountLoc = -1, mViewLoc = -1, mProjLoc = -1;
+    int           mSingleSidedLoc = -1;
+    int           mModeLoc = -1, mBucketsLoc = -1, mViewProjLoc = -1, mViewportLoc = -1, mLevelsLoc = -1;
+    int           mSourceLevelLoc = -1;
+    int           mClusterPlanesLoc = -1, mClusterCountLoc = -1, mClusterModeLoc = -1, mClusterViewProjLoc = -1;
+    int           mClusterViewportLoc = -1, mClusterLevelsLoc = -1, mEyeLoc = -1, mConesLoc = -1;
+
+    // geometry arena
+    unsigned int mVAO = 0, mVBO = 0, mEBO = 0;
+    unsigned int mMeshlets = 0;     // every import's meshlets, indices made absolute
+    uint64_t     mMeshVersion = 0;
+    std::vector<Bucket> mBuckets;
+
+    // object tables
+    unsigned int mWorlds = 0;       // mat4 per slot
+    unsigned int mInfo = 0;         // ObjectInfo per slot
+    unsigned int mVisible = 0;      // slots that passed, grouped by bucket (instance attribute)
+    unsigned int mCommands = 0;     // DrawElementsIndirectCommand per bucket and set, rewritten per frame
+    unsigned int mTemplate = 0;     // ... with zero instances, copied over mCommands
+    unsigned int mFlags = 0;        // per slot: passed the occlusion test last frame
+    unsigned int mPassed = 0;       // per slot: clustered object passed this frame's culls
+    // clusters: one (slot, meshlet) per meshlet of every clustered object
+    unsigned int mClusterVAO = 0;   // arena + slot from mClusterRefs
+    unsigned int mClusterRefs = 0;
+    unsigned int mClusterCommands = 0;   // one per cluster and set, rewritten by the cluster pass
+    unsigned int mClusterFlags = 0;      // per cluster: visible last frame
+    uint32_t     mClusters = 0;
+    uint64_t     mVersion = 0;
+    uint32_t     mCount = 0;        // slots
+    uint32_t     mWorldsCap = 0;
+    int          mSceneTriangles = 0;
+    std::vector<ObjectInfo> mInfoScratch;
+    std::vector<uint32_t>   mRuns;  // sorted changed slots
+    bool         mFlagsValid = false;   // false: everything counts as visible last frame
+
+    // occlusion: copy of the depth buffer and its max-Z pyramid (level 0 = half size)
+    unsigned int mDepthTex = 0, mPyramid = 0;
+    int          mDepthW = 0, mDepthH = 0, mLevels = 0;
+    int          mViewport[4] = {};
+
+    int mDrawn = 0, mTriangles = 0;
+    MemoryCharge mGeomMem{EUCLID_MEM_GPU_MESHES};
+    MemoryCharge mTableMem{EUCLID_MEM_GPU_STREAMING};
+    MemoryCharge mDepthMem{EUCLID_MEM_GPU_RENDER_TARGETS};
+};
+}
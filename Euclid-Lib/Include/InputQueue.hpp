@@ -0,0 +1,45 @@
+#pragma once
+
+#include "MemoryStats.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Euclid
+{
+struct InputEvent {
+    enum Kind : uint8_t { Move, Button, Scroll, Mods };
+    Kind     kind = Move;
+    bool     down = false;        // Button
+    int      button = 0;          // Button
+    unsigned mods = 0;            // Button, Mods
+    double   x = 0.0, y = 0.0;    // Move: position, Scroll: wheel delta
+    uint64_t timeNs = 0;          // when the host handed it over (steady clock)
+};
+
+// Host input waiting for the next frame. Push from any thread; Take once per frame
+// from the thread that renders. Coalesced on the way in, without changing what the
+// frame ends up seeing:
+//   - a run of moves keeps its first and its latest sample: orbit deltas telescope, and
+//     the first one still anchors a fresh orbit; drags only solve the latest
+//   - a scroll right after a scroll adds up
+//   - mods that don't change anything are dropped (hosts often resend them with every move)
+// Coalesced events keep the oldest timestamp, so latency counts from the first sample.
+class InputQueue {
+public:
+    void Push(const InputEvent& e);
+    void Take(std::vector<InputEvent>& out);   // swaps the pending list into out
+
+    uint64_t Received() const { return mReceived.load(std::memory_order_relaxed); }   // before coalescing
+    static uint64_t NowNs();
+
+private:
+    std::mutex              mMutex;
+    std::vector<InputEvent> mPending;
+    unsigned                mQueuedMods = 0;   // mods as of the last queued event
+    std::atomic<uint64_t>   mReceived{0};
+    MemoryCharge            mMem{EUCLID_MEM_CPU_QUEUES};   // both lists (they trade places every Take)
+};
+}
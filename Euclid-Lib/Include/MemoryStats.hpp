@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Euclid_Memory.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Euclid
+{
+// Process-wide byte counters per category (Euclid_Memory.h). Lock-free; owners report
+// through a MemoryCharge rather than calling Add directly, so nothing is counted twice
+// or left behind when they go away.
+class MemoryStats {
+public:
+    static void Add(EuclidMemoryCategory c, int64_t bytes, int allocations);
+    static void Get(EuclidMemoryStats& out);
+    static void ResetPeaks();
+};
+
+// What one owner (a buffer, a container) currently holds in a category. Set it after
+// every allocation or resize; it is uncharged on destruction.
+class MemoryCharge {
+public:
+    explicit MemoryCharge(EuclidMemoryCategory c) : mCategory(c) {}
+    ~MemoryCharge() { Set(0); }
+
+    MemoryCharge(MemoryCharge&& o) noexcept : mCategory(o.mCategory), mBytes(o.mBytes) { o.mBytes = 0; }
+    MemoryCharge& operator=(MemoryCharge&& o) noexcept {
+        if (this != &o) { Set(0); mCategory = o.mCategory; mBytes = o.mBytes; o.mBytes = 0; }
+        return *this;
+    }
+    MemoryCharge(const MemoryCharge&) = delete;
+    MemoryCharge& operator=(const MemoryCharge&) = delete;
+
+    void Set(size_t bytes) {
+        if (bytes == mBytes) return;
+        MemoryStats::Add(mCategory, (int64_t)bytes - (int64_t)mBytes, (bytes != 0) - (mBytes != 0));
+        mBytes = bytes;
+    }
+    void   Add(size_t bytes) { Set(mBytes + bytes); }
+    size_t Bytes() const { return mBytes; }
+
+private:
+    EuclidMemoryCategory mCategory;
+    size_t               mBytes = 0;
+};
+
+// Bytes a vector holds (its capacity, not its size)
+template <typename Vec>
+size_t CapacityBytes(const Vec& v) { return v.capacity() * sizeof(typename Vec::value_type); }
+}
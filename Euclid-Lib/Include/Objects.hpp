@@ -1,4 +1,6 @@
 #pragma once
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <glm/glm.hpp>
@@ -9,44 +11,98 @@
 
 #include "Euclid_Types.h"  // EuclidObjectID, EuclidShapeType, EuclidTransform (ensure it has CONE, CYLINDER, PRISM, CIRCLE)
 #include "Utils.h"          // TRS(tf)
+#include "MemoryStats.hpp"
 
 namespace Euclid {
 
+class PagedMesh;   // PagedMesh.hpp
+
 struct Object {
     EuclidObjectID id = 0;
     EuclidShapeType type = EUCLID_SHAPE_CUBE;
-    EuclidTransform tf{};
-    glm::mat4 Model() const { return TRS(tf); }
+    uint32_t slot = 0;                     // index into ObjectStore's scene arrays (transform, ...)
+    Object*  parent = nullptr;             // transform is relative to this one's world matrix
+    uint32_t childCount = 0;
 
     int  customIndex = -1;                 // <— index into ObjectStore::mCustom
     glm::vec3 localMin{-0.5f}, localMax{0.5f}; // <— local AABB for picking
 };
 
+// A run of an imported mesh's index buffer: a compact patch of up to ~128 triangles
+// (imports are sorted so they come out that way). In local space, it faces away from
+// an eye at e when dot(center - e, coneAxis) >= coneCutoff * |center - e| + radius.
+struct Meshlet {
+    glm::vec3 center;   float radius;       // bounding sphere
+    glm::vec3 coneAxis; float coneCutoff;   // sin of the normals' spread; axis 0, cutoff 1: never
+    uint32_t  firstIndex = 0, indexCount = 0;
+};
+
 struct SharedMesh {
     unsigned vao = 0, vbo = 0, ebo = 0;
     int      indexCount = 0;   // for glDrawArrays or glDrawElements
+    int      vertexCount = 0;
     bool     indexed = false;
+    std::vector<Meshlet> meshlets;   // imports: covers the index buffer in order
+    MemoryCharge mem{EUCLID_MEM_GPU_MESHES};
 
     void Release();
 };
 
+// -------- Import plumbing (Objects.cpp), shared with the paged importer --------
+struct MeshVertex { float p[3]; float c[3]; };   // every mesh: position, color
+
+struct ObjCorner { int v = -1, vn = -1; };       // 0-based position / normal, -1: none
+// Corners of one OBJ "f" line, s pointing past the "f "
+void ParseOBJFace(char* s, std::vector<ObjCorner>& face);
+// Imports color by the normal, grey without one
+MeshVertex ObjVertex(const glm::vec3& p, const glm::vec3& n);
+
+void UploadMesh(SharedMesh& dst, const MeshVertex* verts, size_t vertCount,
+                const unsigned* idx, size_t idxCount, const char* label);
+// Sorts an indexed mesh into meshlets (Meshlet), vertices into first-use order
+void BuildMeshlets(std::vector<MeshVertex>& verts, std::vector<unsigned>& idx, std::vector<Meshlet>& out);
+
 class ObjectStore {
 public:
-    // GPU primitives
-    void InitPrimitives();
+    // GPU primitives (uploaded lazily by MeshFor)
     void ReleasePrimitives();
+    int  PrimitivesBuilt() const { return mPrimitivesBuilt; }
 
     // CRUD
     Object* Create(EuclidShapeType t, const void* params, const EuclidTransform& xform, EuclidObjectID id);
     void    DestroyGPU(EuclidObjectID id);  // currently no per-object GPU, kept for future
     void    Clear();
     
-    bool Remove(EuclidObjectID id);
+    // Removes the object and its whole subtree; removed ids are appended to *removed
+    bool Remove(EuclidObjectID id, std::vector<EuclidObjectID>* removed = nullptr);
+
+    // Hierarchy. parent == nullptr makes it a root again; the local transform is kept.
+    // Fails if parent is child itself or somewhere below it.
+    bool SetParent(Object& child, Object* parent);
+
+    // Bulk paths for the batched C API. Transforms are read/written at base + i*stride.
+    // Return how many ids were found.
+    void   Reserve(size_t extra);
+    // Any thread: count fresh ids for objects created later with an explicit id
+    EuclidObjectID ReserveIDs(size_t count) { mIDsReserved = true; return mNextID.fetch_add(count); }
+    size_t SetTransforms(const EuclidObjectID* ids, size_t count, const void* src, size_t stride);
+    size_t GetTransforms(const EuclidObjectID* ids, size_t count, void* dst, size_t stride) const;
     
     const SharedMesh* GetCustomMesh(int customIndex) const {
         if (customIndex < 0 || customIndex >= (int)mCustom.size()) return nullptr;
         return &mCustom[customIndex].mesh;
     }
+    size_t CustomMeshCount() const { return mCustom.size(); }
+    // Out-of-core imports: the custom entry has no mesh of its own, chunks stream in instead
+    PagedMesh* GetPagedMesh(int customIndex) const {
+        if (customIndex < 0 || customIndex >= (int)mCustom.size()) return nullptr;
+        return mCustom[customIndex].paged.get();
+    }
+    const std::vector<EuclidObjectID>& PagedObjects() const { return mPagedObjects; }
+    // Bumped whenever a mesh is uploaded or released (primitives and imports)
+    uint64_t MeshVersion() const { return mMeshVersion; }
+    // GPU readback of a custom mesh (positions xyz, indices); false if it has none
+    bool ReadCustomMesh(int customIndex, std::vector<float>& positions, std::vector<unsigned>& indices) const;
     // (optional) bounds if you ever need them at render-time
     bool GetCustomBounds(int customIndex, glm::vec3& mn, glm::vec3& mx) const {
         if (customIndex < 0 || customIndex >= (int)mCustom.size()) return false;
@@ -58,6 +114,8 @@ public:
     const Object* Get(EuclidObjectID id) const;
 
     const std::unordered_map<EuclidObjectID, std::unique_ptr<Object>>& All() const { return mObjects; }
+    // Flat list for drawing, rebuilt on first use after objects were added/removed
+    const std::vector<const Object*>& DrawList();
 
     // Selection
     void            SetSelection(EuclidObjectID id) { mSelected = id; }
@@ -66,33 +124,110 @@ public:
     // Transforms
     EuclidResult GetTransform(EuclidObjectID id, EuclidTransform& out) const;
     EuclidResult SetTransform(EuclidObjectID id, const EuclidTransform& in);
+    const EuclidTransform& Transform(const Object& o) const { return mTransforms[o.slot]; }
+    EuclidTransform&       EditTransform(const Object& o) { mSeqs[o.slot] = ++mChangeSeq; MarkWorldDirty(o.slot); return mTransforms[o.slot]; }
+    // World matrix (parent chain applied), brought up to date on demand
+    const glm::mat4&       Model(const Object& o) const { UpdateWorld(); return mWorld[o.slot]; }
+    glm::mat4              ParentModel(const Object& o) const { return o.parent ? Model(*o.parent) : glm::mat4(1.0f); }
+    // Recomputes world matrices of dirty subtrees only, in one pass over the hierarchy order
+    void                   UpdateWorld() const;
+    // Slots whose world matrix UpdateWorld recomputed since the last ClearWorldChanges, for
+    // a consumer that mirrors the matrices (IndirectScene). Off by default. AllWorldsChanged:
+    // too many to list, treat every slot as changed. Version() changes aren't listed.
+    void                         TrackWorldChanges(bool on) { mTrackWorld = on; ClearWorldChanges(); }
+    const std::vector<uint32_t>& WorldChanges() const { return mWorldChanges; }
+    bool                         AllWorldsChanged() const { return mAllWorldsChanged; }
+    void                         ClearWorldChanges() { mWorldChanges.clear(); mAllWorldsChanged = false; }
+
+    // Scene arrays, one entry per object, same order in each. Read-only view for the
+    // host: pointers stay valid until Version() changes (objects added/removed).
+    // Seqs()[i] is the ChangeSeq() value of that object's last create/transform edit.
+    size_t                 Count()      const { return mIds.size(); }
+    const EuclidObjectID*  Ids()        const { return mIds.data(); }
+    const EuclidShapeType* Types()      const { return mTypes.data(); }
+    const EuclidTransform* Transforms() const { return mTransforms.data(); }
+    const uint64_t*        Seqs()       const { return mSeqs.data(); }
+    uint64_t               Version()    const { return mVersion; }
+    uint64_t               ChangeSeq()  const { return mChangeSeq; }
+    const glm::mat4*       Worlds()     const { UpdateWorld(); return mWorld.data(); }
 
     // Picking (ray in world from screen)
     EuclidObjectID RayPick(float screenX, float screenY,
                            const glm::mat4& invViewProj,
                            int viewportW, int viewportH) const;
     
-    EuclidResult LoadOBJ(const char* path, EuclidObjectID* outID, bool normalize);
+    // progress (optional) gets the share of the file parsed so far, 0..1
+    EuclidResult LoadOBJ(const char* path, EuclidObjectID* outID, bool normalize,
+                         const std::function<void(float)>& progress = nullptr);
+    // Opens a file from BuildPagedMesh; BAD_PARAM if it isn't one
+    EuclidResult LoadPagedMesh(const char* path, EuclidObjectID* outID);
     EuclidResult CreateFromRawMesh(const float* positions, size_t vertexCount,
                                        const unsigned* indices, size_t indexCount,
                                        EuclidObjectID* outID, bool normalize);
     
     // Mesh routing for drawing
-    const SharedMesh& MeshFor(EuclidShapeType t) const;
+    const SharedMesh& MeshFor(EuclidShapeType t);
+    // Primitive mesh if MeshFor uploaded it already, else nullptr
+    const SharedMesh* BuiltPrimitive(EuclidShapeType t) const;
 
     // Bounds (local space, unit primitives)
     void ShapeLocalBounds(EuclidShapeType t, glm::vec3& bmin, glm::vec3& bmax) const;
+    // World AABB of an object (local bounds pushed through its model matrix)
+    void WorldBounds(const Object& o, glm::vec3& bmin, glm::vec3& bmax) const;
+    // Same, merged over the object and everything below it (groups have no extent of their own)
+    bool SubtreeBounds(const Object& o, glm::vec3& bmin, glm::vec3& bmax) const;
 
 private:
     std::unordered_map<EuclidObjectID, std::unique_ptr<Object>> mObjects;
     EuclidObjectID mSelected = 0;
+
+    std::vector<const Object*> mDrawList;
+    bool mDrawListDirty = true;
+
+    // scene arrays (SoA, indexed by Object::slot); removal swaps the last entry in
+    std::vector<EuclidObjectID>  mIds;
+    std::vector<EuclidShapeType> mTypes;
+    std::vector<EuclidTransform> mTransforms;
+    std::vector<uint64_t>        mSeqs;
+    std::vector<Object*>         mSlotObjects;
+    uint64_t mVersion = 1;
+    uint64_t mChangeSeq = 0;
+
+    // Hierarchy, kept in pre-order so every subtree is one contiguous range of mOrder
+    // and parents always come before their children. World matrices are a cache:
+    // edits only queue the edited slot, UpdateWorld walks the queued subtrees.
+    static constexpr uint32_t kNoSlot = 0xFFFFFFFFu;
+    mutable std::vector<glm::mat4> mWorld;        // by slot
+    mutable std::vector<uint32_t>  mParentSlot;   // by slot
+    mutable std::vector<uint32_t>  mOrderPos;     // by slot: position in mOrder
+    mutable std::vector<uint32_t>  mSubtreeEnd;   // by slot: one past its last descendant in mOrder
+    mutable std::vector<uint8_t>   mWorldDirty;   // by slot
+    mutable std::vector<uint32_t>  mOrder;        // slots, pre-order
+    mutable std::vector<uint32_t>  mDirtySlots;
+    mutable bool mOrderDirty = false;             // reparent/remove: rebuild mOrder before use
+    mutable std::vector<uint32_t>  mWorldChanges; // see TrackWorldChanges
+    mutable bool mAllWorldsChanged = false;
+    bool         mTrackWorld = false;
+
+    mutable MemoryCharge mSceneMem{EUCLID_MEM_CPU_SCENE};
+    void ChargeMemory() const;   // after the containers above grew or shrank
+
+    void MarkWorldDirty(uint32_t slot) {
+        if (!mWorldDirty[slot]) { mWorldDirty[slot] = 1; mDirtySlots.push_back(slot); }
+    }
+    void RebuildOrder() const;
+    void RemoveOne(Object* o, std::vector<EuclidObjectID>* removed);
     
-    EuclidObjectID mNextID = 1;          // 0 is “no selection” sentinel
-    EuclidObjectID NewID() { return mNextID++; }
+    // atomic: other threads reserve ids for queued creates (ReserveIDs)
+    std::atomic<EuclidObjectID> mNextID{1};   // 0 is “no selection” sentinel
+    std::atomic<bool> mIDsReserved{false};
+    EuclidObjectID NewID() { return mNextID.fetch_add(1); }
     
     // Primitives
     SharedMesh mCube, mPlane, mSphere, mTorus,
                mCone, mCylinder, mPrism, mCircle;
+    int mPrimitivesBuilt = 0;
+    uint64_t mMeshVersion = 1;
 
     struct Ray { glm::vec3 o; glm::vec3 d; };
     static Ray  ScreenRay(float x, float y, int w, int h, const glm::mat4& invViewProj);
@@ -101,8 +236,12 @@ private:
     struct CustomEntry {
         SharedMesh mesh;
         glm::vec3  localMin{-0.5f}, localMax{0.5f};
+        std::shared_ptr<PagedMesh> paged;   // out-of-core import, mesh unused
     };
     std::vector<CustomEntry> mCustom;
+    std::vector<int>         mFreeCustom;   // entries whose object is gone (mesh released)
+    std::vector<EuclidObjectID> mPagedObjects;
+    int AddCustom(CustomEntry&& ce);
 };
 
 } // namespace Euclid
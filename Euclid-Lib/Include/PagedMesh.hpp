@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Objects.hpp"
+#include "ThreadPool.hpp"
+#include "MemoryStats.hpp"
+#include "Euclid_Core.h"
+#include "Euclid_Renderer.h"   // EUCLID_MAX_VIEWPORTS
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Euclid
+{
+// Out-of-core imports (Euclid_BuildPagedMesh / Euclid_LoadPagedMesh).
+//
+// BuildPagedMesh converts an OBJ in three streaming passes: positions and normals go to
+// temp files (read back through a small page cache), triangles are binned by centroid into
+// a uniform grid and spilled to disk in blocks, then each cell is welded, sorted into
+// meshlets and written as one chunk with a vertex-clustered proxy. Memory is bounded by
+// the largest chunk plus fixed-size buffers, not by the mesh.
+//
+// A PagedMesh keeps its chunk table and every proxy resident. PageStreamer decides each
+// frame which chunks belong on the GPU (in view before out of view, nearest first, within
+// a byte budget), reads them on a worker thread and uploads a few per frame. Chunks that
+// aren't resident are drawn as their proxy.
+EuclidResult BuildPagedMesh(const char* objPath, const char* pagePath, bool normalize,
+                            const std::function<void(float)>& progress = nullptr);
+
+class PagedMesh {
+public:
+    enum ChunkState : uint8_t { kOnDisk, kLoading, kResident, kBroken };
+    struct Chunk {
+        glm::vec3  bmin{0.0f}, bmax{0.0f};          // local space
+        uint64_t   offset = 0;                      // vertices, indices, meshlets
+        uint32_t   vertexCount = 0, indexCount = 0, meshletCount = 0;
+        uint32_t   proxyFirst = 0, proxyCount = 0;  // index range of the proxy mesh
+        ChunkState state = kOnDisk;
+        SharedMesh mesh;                            // while resident
+
+        uint64_t Bytes() const { return (uint64_t)vertexCount * sizeof(MeshVertex) + (uint64_t)indexCount * sizeof(uint32_t); }
+    };
+
+    bool Open(const char* path);   // chunk table + proxies (uploaded); false if it isn't a paged file
+    void Release();                // GPU side; reads still in flight are dropped when they land
+
+    const std::string&        Path() const { return mPath; }
+    uint64_t                  Serial() const { return mSerial; }   // unique per Open, tags worker results
+    const glm::vec3&          BoundsMin() const { return mMin; }
+    const glm::vec3&          BoundsMax() const { return mMax; }
+    const SharedMesh&         Proxy() const { return mProxy; }
+    std::vector<Chunk>&       Chunks() { return mChunks; }
+    const std::vector<Chunk>& Chunks() const { return mChunks; }
+    void                      ChargeMemory();   // after chunks came or went
+
+private:
+    std::string        mPath;
+    uint64_t           mSerial = 0;
+    glm::vec3          mMin{0.0f}, mMax{0.0f};
+    std::vector<Chunk> mChunks;
+    SharedMesh         mProxy;
+    MemoryCharge       mTableMem{EUCLID_MEM_CPU_SCENE};
+};
+
+// Residency for every paged mesh of a scene (one per SharedContext)
+class PageStreamer {
+public:
+    static constexpr uint64_t kDefaultBudget = 256ull << 20;
+
+    void     SetBudget(uint64_t bytes) { mBudget = bytes; }
+    uint64_t Budget() const { return mBudget; }
+    // Each view posts its cameras (world-space eyes, one viewProj each) once per frame.
+    // The first post of a frame uploads what arrived, picks what should be resident for
+    // the cameras of every view and queues the reads; a view posting again starts the
+    // next frame. So views on one context share the budget instead of evicting each
+    // other's chunks. GL thread.
+    void Update(ObjectStore& objs, const void* view, const glm::vec3* eyes, const glm::mat4* viewProjs, int count);
+    void RemoveView(const void* view);
+    // Exports: loads what these cameras want and blocks until it is resident
+    void Settle(ObjectStore& objs, const glm::vec3* eyes, const glm::mat4* viewProjs, int count);
+    void GetStats(const ObjectStore& objs, EuclidStreamingStats& out) const;
+
+private:
+    struct Loaded {   // read by the worker, waiting for upload
+        uint64_t                serial = 0;
+        uint32_t                chunk = 0;
+        bool                    ok = false;
+        std::vector<MeshVertex> verts;
+        std::vector<unsigned>   idx;
+        std::vector<Meshlet>    meshlets;
+        size_t Bytes() const { return CapacityBytes(verts) + CapacityBytes(idx) + CapacityBytes(meshlets); }
+    };
+    struct Candidate {
+        bool       outside;   // of every view
+        float      distance;  // world units, nearest eye
+        PagedMesh* mesh;
+        uint32_t   chunk;
+        bool       wanted = false;   // fits the budget in priority order
+    };
+
+    struct View {
+        const void* owner = nullptr;
+        bool        posted = false;   // this frame
+        int         count = 0;
+        glm::vec3   eyes[EUCLID_MAX_VIEWPORTS];
+        glm::mat4   viewProjs[EUCLID_MAX_VIEWPORTS];
+    };
+
+    void Select(ObjectStore& objs, const glm::vec3* eyes, const glm::mat4* viewProjs, int count);
+    void Upload(ObjectStore& objs);
+    void Read(const PagedMesh& mesh, uint32_t chunk);
+
+    uint64_t mBudget = kDefaultBudget;
+    uint64_t mLoads = 0, mEvictions = 0;
+    std::vector<View> mViews;
+    bool     mSelected = false;           // this frame's selection ran
+    int      mInFlight = 0;               // chunks loading after the last selection
+    std::vector<Candidate> mCandidates;   // scratch, by priority
+    std::vector<Loaded>    mArrived;      // taken from the inbox, over this frame's upload cap
+    MemoryCharge           mScratchMem{EUCLID_MEM_CPU_FRAME};
+    MemoryCharge           mArrivedMem{EUCLID_MEM_CPU_IMPORT};
+
+    std::mutex          mMutex;           // inbox, filled by the worker
+    std::vector<Loaded> mInbox;
+    MemoryCharge        mInboxMem{EUCLID_MEM_CPU_IMPORT};
+    ThreadPool          mPool{1};         // last: joined before the inbox goes
+};
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "Euclid_Profiler.h"
+#include "GLDebug.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace Euclid
+{
+// Process-wide zone profiler. Every thread records into its own fixed buffer (one
+// writer, no locks on the hot path); Export walks all of them and writes Chrome trace
+// event JSON (chrome://tracing, Perfetto). Disabled it costs one relaxed load per zone.
+// Zone names must be string literals (only the pointer is kept).
+class Profiler {
+public:
+    enum Track : uint8_t { kCpu = 0, kGpu = 1 };
+
+    static void SetEnabled(bool on);
+    static bool Enabled() { return sEnabled.load(std::memory_order_relaxed); }
+
+    static uint64_t NowNs();
+    // start/end in NowNs() time; gpu zones are recorded by the GL thread once resolved
+    static void Record(const char* name, uint64_t startNs, uint64_t endNs, Track track = kCpu);
+    static void SetThreadName(const char* name);   // copied
+
+    // Writes everything recorded since the last export and starts over
+    static bool ExportChromeTrace(const char* path);
+    static uint64_t Dropped();   // zones lost to full buffers since the last export
+
+private:
+    static std::atomic<bool> sEnabled;
+};
+
+// Also the scope GL debug messages are attributed to while debug output is on
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name)
+        : mName(Profiler::Enabled() ? name : nullptr), mScoped(GLDebug::Enabled()) {
+        if (mName) mStart = Profiler::NowNs();
+        if (mScoped) GLDebug::PushScope(name);
+    }
+    ~ProfileZone() {
+        if (mName) Profiler::Record(mName, mStart, Profiler::NowNs());
+        if (mScoped) GLDebug::PopScope();
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* mName;
+    bool        mScoped;
+    uint64_t    mStart = 0;
+};
+
+// GL timestamp queries around GPU passes. Results are read back a few frames later
+// (Collect, no stalls) and land on the GPU track of the thread that collects them.
+// In live mode it also keeps per-pass totals of the last frame (Euclid_GetPassTimings),
+// whether or not a trace is being captured.
+// One per GL context user (Core); GL thread only.
+class GpuProfiler {
+public:
+    int  Begin(const char* name);   // -1 if profiling is off or too many are in flight
+    void End(int zone);
+    void Collect();                 // call once per frame
+
+    void SetLive(bool on) { mLive = on; }
+    int  PassTimings(EuclidPassTiming* out, int max) const;
+
+    ~GpuProfiler();
+
+private:
+    static constexpr int kMaxZones  = 256;
+    static constexpr int kMaxPasses = 16;
+    struct Zone {
+        const char* name = nullptr;
+        unsigned    query[2] = {0, 0};
+        uint8_t     state = 0;      // 0 free, 1 open, 2 waiting for results
+        int8_t      pass = -1;
+        uint32_t    frame = 0;
+        uint64_t    cpuStart = 0;
+    };
+    // same name = same pass (a pass can run several times a frame)
+    struct Pass {
+        const char* name = nullptr;
+        uint64_t    cpuNs = 0, gpuNs = 0;     // frame being built / being resolved
+        double      cpuMs = 0.0, gpuMs = 0.0; // last complete frame
+    };
+    int PassIndex(const char* name);
+
+    Zone     mZones[kMaxZones];
+    int      mHead = 0, mTail = 0;  // next to open / oldest unresolved
+    bool     mCreated = false;
+    int64_t  mGpuToCpuNs = 0;       // GL_TIMESTAMP -> NowNs()
+    uint64_t mCalibratedAt = 0;
+
+    bool     mLive = false;
+    Pass     mPasses[kMaxPasses];
+    int      mPassCount = 0;
+    uint32_t mFrame = 0;            // Collect calls so far
+    uint32_t mGpuFrame = 0;         // frame the GPU totals are being summed for
+};
+
+// ... and a GL debug group (named in RenderDoc & co.) while debug output is on
+class GpuZone {
+public:
+    GpuZone(GpuProfiler& p, const char* name) : mProfiler(p), mZone(p.Begin(name)), mGroup(GLDebug::Enabled()) {
+        if (mGroup) GLDebug::PushGroup(name);
+    }
+    ~GpuZone() {
+        if (mZone >= 0) mProfiler.End(mZone);
+        if (mGroup) GLDebug::PopGroup();
+    }
+
+    GpuZone(const GpuZone&) = delete;
+    GpuZone& operator=(const GpuZone&) = delete;
+
+private:
+    GpuProfiler& mProfiler;
+    int          mZone;
+    bool         mGroup;
+};
+}
+
+#define EUCLID_PROFILE_CONCAT2(a, b) a##b
+#define EUCLID_PROFILE_CONCAT(a, b) EUCLID_PROFILE_CONCAT2(a, b)
+
+#if defined(EUCLID_NO_PROFILER)
+    #define EUCLID_ZONE(name)            ((void)0)
+    #define EUCLID_GPU_ZONE(prof, name)  ((void)0)
+#else
+    // CPU zone for the rest of the scope
+    #define EUCLID_ZONE(name)            ::Euclid::ProfileZone EUCLID_PROFILE_CONCAT(euclidZone_, __LINE__)(name)
+    // CPU zone + GL timestamp pair for the rest of the scope
+    #define EUCLID_GPU_ZONE(prof, name)  EUCLID_ZONE(name); ::Euclid::GpuZone EUCLID_PROFILE_CONCAT(euclidGpuZone_, __LINE__)(prof, name)
+#endif
@@ -1 +1,112 @@
-//Renderer
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "MemoryStats.hpp"
+
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+namespace Euclid
+{
+// true if the current context lists the extension (core-profile way, glGetStringi)
+bool HasGLExtension(const char* name);
+
+// Gribb/Hartmann: the 6 clip planes (xyz = inward normal, w = offset, unnormalized)
+// straight from the rows of view-projection, any projection
+void FrustumPlanes(const glm::mat4& viewProj, glm::vec4 out[6]);
+
+// Offscreen color + depth target. Used for exports where we can't touch the host backbuffer.
+class RenderTarget {
+public:
+    bool Create(int width, int height);
+    void Release();
+
+    unsigned int GetFBO() const { return mFBO; }
+    int GetWidth() const  { return mWidth; }
+    int GetHeight() const { return mHeight; }
+
+    ~RenderTarget();
+
+private:
+    unsigned int mFBO = 0;
+    unsigned int mColor = 0;
+    unsigned int mDepth = 0;
+    int mWidth = 0;
+    int mHeight = 0;
+    MemoryCharge mMem{EUCLID_MEM_GPU_RENDER_TARGETS};
+};
+
+// Ring of pixel-pack buffers + fences. glReadPixels lands in a PBO without
+// stalling, so the GPU can start the next tile/frame while the copy is in flight.
+class ReadbackRing {
+public:
+    struct Slot {
+        unsigned int pbo = 0;
+        GLsync fence = nullptr;
+        int x = 0, y = 0, w = 0, h = 0;
+        int tag = 0;              // caller data (tile index, frame index, ...)
+    };
+
+    bool Init(int slots, size_t slotBytes);
+    void Release();
+
+    bool Empty() const { return mCount == 0; }
+    bool Full()  const { return mCount == (int)mSlots.size(); }
+
+    // Reads [x,y,w,h] of the bound READ framebuffer as RGBA8 into the next free slot.
+    void Enqueue(int x, int y, int w, int h, int tag);
+
+    // Waits for the oldest read and maps it. Rows are bottom-up (GL order).
+    const uint8_t* MapOldest(Slot& info);
+    void UnmapOldest();
+
+    ~ReadbackRing();
+
+private:
+    std::vector<Slot> mSlots;
+    size_t mSlotBytes = 0;
+    MemoryCharge mMem{EUCLID_MEM_GPU_READBACK};
+    int mHead = 0;     // oldest in-flight slot
+    int mCount = 0;
+};
+
+// Streaming PNG encoder (8-bit RGB/RGBA). Rows are filtered and deflated as they
+// arrive and written straight to disk, so memory stays flat for any image height.
+class PngWriter {
+public:
+    bool Open(const char* path, int width, int height, int channels);
+    bool WriteRow(const uint8_t* row);
+    bool Close();
+
+    ~PngWriter();
+
+private:
+    void WriteChunk(const char type[4], const uint8_t* data, size_t len);
+    void FlushIDAT(bool force);
+    void Deflate(const uint8_t* data, size_t len);
+    void PutBits(uint32_t bits, int count);
+    void PutHuff(uint32_t code, int len);
+    void PutLiteral(int v);
+    void PutMatch(int len, int dist);
+
+private:
+    FILE* mFile = nullptr;
+    int mWidth = 0, mHeight = 0, mChannels = 0, mRows = 0;
+    std::vector<uint8_t> mPrev, mLine;     // previous raw row / filtered row
+    std::vector<uint8_t> mOut;             // pending IDAT bytes
+    uint32_t mBitBuf = 0; int mBitCount = 0;
+    uint32_t mAdlerA = 1, mAdlerB = 0;
+    // LZ77 window: [mWinBase, mWinBase + mWin.size()) in absolute stream positions
+    std::vector<uint8_t> mWin;
+    size_t mWinBase = 0;
+    std::vector<int64_t> mHead;            // hash -> last absolute position
+    bool mOk = false;
+};
+
+// One-shot encoders for tightly packed top-down 8-bit pixels (3 or 4 channels).
+bool WritePNG(const char* path, int width, int height, int channels, const uint8_t* pixels);
+bool WriteQOI(const char* path, int width, int height, int channels, const uint8_t* pixels);
+}
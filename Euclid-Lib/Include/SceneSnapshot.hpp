@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Euclid_Core.h"
+#include "MemoryStats.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Euclid
+{
+class ObjectStore;
+
+// Two copies of the scene arrays for readers on other threads. The GL thread writes
+// the copy that is not current and flips; a copy with readers on it is never written
+// (Publish just skips that frame). Readers never wait.
+class SceneSnapshot {
+public:
+    void Publish(const ObjectStore& objs);                  // GL thread
+
+    uint32_t Acquire(EuclidSceneView& out);                 // any thread; returns the token
+    void     Release(uint32_t token);
+
+private:
+    struct Buffer {
+        uint64_t version = 0, changeSeq = 0;
+        std::vector<EuclidObjectID>  ids;
+        std::vector<EuclidShapeType> types;
+        std::vector<EuclidTransform> transforms;
+        std::vector<uint64_t>        seqs;
+        std::vector<glm::mat4>       world;
+        MemoryCharge mem{EUCLID_MEM_CPU_SNAPSHOTS};
+    };
+    Buffer mBuffers[2];
+    std::atomic<uint32_t> mFront{0};
+    std::atomic<uint32_t> mReaders[2]{};
+};
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Euclid_Record.h"
+#include "MemoryStats.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Euclid
+{
+// Binary log of API calls (Euclid_Record.h). Little-endian, no padding:
+//
+//   header : "EREC" u32 version, i32 width, i32 height
+//   record : u8 op, varint ns since the previous record, payload (per op, see Euclid_Record.cpp)
+//
+// Varints are LEB128, floats/doubles raw IEEE-754. A record is written under one lock, so
+// input from other threads interleaves with GL-thread calls in call order.
+class SessionWriter {
+public:
+    static constexpr uint32_t kMagic   = 0x43455245;   // "EREC"
+    static constexpr uint32_t kVersion = 1;
+
+    // Payload builder; the lock is held until it goes out of scope
+    class Record {
+    public:
+        explicit operator bool() const { return mW != nullptr; }
+        Record& U8(uint8_t v)            { mW->Put(&v, 1); return *this; }
+        Record& Var(uint64_t v);
+        Record& F32(float v)             { mW->Put(&v, sizeof(v)); return *this; }
+        Record& F64(double v)            { mW->Put(&v, sizeof(v)); return *this; }
+        Record& Bytes(const void* p, size_t n) { mW->Put(p, n); return *this; }
+        Record& Str(const char* s);
+
+    private:
+        friend class SessionWriter;
+        Record(SessionWriter* w, std::unique_lock<std::mutex>&& lock) : mW(w), mLock(std::move(lock)) {}
+        SessionWriter*               mW;
+        std::unique_lock<std::mutex> mLock;
+    };
+
+    bool Open(const char* path, int width, int height);
+    void Close();
+    bool Active() const { return mActive.load(std::memory_order_relaxed); }
+
+    // Empty record (false) when not recording; costs one relaxed load then
+    Record Begin(EuclidRecordOp op);
+
+    ~SessionWriter() { Close(); }
+
+private:
+    void Put(const void* p, size_t n);
+    void Flush();
+
+    std::atomic<bool>    mActive{false};
+    std::mutex           mMutex;
+    FILE*                mFile = nullptr;
+    std::vector<uint8_t> mBuf;
+    MemoryCharge         mMem{EUCLID_MEM_CPU_QUEUES};
+    uint64_t             mLastNs = 0;
+};
+
+// Reads a whole log into memory and walks it record by record
+class SessionReader {
+public:
+    bool Open(const char* path);
+    int  Width() const  { return mWidth; }
+    int  Height() const { return mHeight; }
+
+    // Next record header; false at the end or on a damaged log (see Bad)
+    bool Next(EuclidRecordOp& op, uint64_t& dtNs);
+    bool Bad() const { return mBad; }
+
+    uint8_t     U8();
+    uint64_t    Var();
+    float       F32();
+    double      F64();
+    const void* Bytes(size_t n);   // nullptr if the log is shorter
+    std::string Str();
+
+private:
+    std::vector<uint8_t> mData;
+    size_t mPos = 0;
+    int    mWidth = 0, mHeight = 0;
+    bool   mBad = false;
+};
+}
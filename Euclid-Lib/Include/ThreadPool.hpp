@@ -0,0 +1,37 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Euclid
+{
+// Plain fixed-size worker pool for CPU jobs (encoding, parsing). No GL in here.
+class ThreadPool {
+public:
+    explicit ThreadPool(int threads = 0);   // 0 = hardware concurrency
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Submit(std::function<void()> job);
+    void Wait();                            // blocks until every submitted job finished
+    int  Size() const { return (int)mWorkers.size(); }
+
+private:
+    void WorkerLoop();
+
+private:
+    std::vector<std::thread> mWorkers;
+    std::deque<std::function<void()>> mJobs;
+    std::mutex mMutex;
+    std::condition_variable mJobCv;
+    std::condition_variable mIdleCv;
+    int  mActive = 0;
+    bool mStop = false;
+};
+}
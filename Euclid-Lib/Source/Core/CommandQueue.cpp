@@ -0,0 +1,47 @@
+#include "CommandQueue.hpp"
+
+namespace Euclid
+{
+void CommandQueue::Enable(uint32_t capacity) {
+    mCells.reset();
+    mMask = 0;
+    mEnqueue.store(0, std::memory_order_relaxed);
+    mDequeue = 0;
+    mMem.Set(0);
+    if (capacity == 0) return;
+
+    uint64_t cap = 1;
+    while (cap < capacity && cap < (1u << 20)) cap <<= 1;
+    mCells.reset(new Cell[cap]);
+    for (uint64_t i = 0; i < cap; ++i) mCells[i].seq.store(i, std::memory_order_relaxed);
+    mMask = cap - 1;
+    mMem.Set(cap * sizeof(Cell));
+}
+
+bool CommandQueue::Submit(const EuclidCommand* cmds, size_t count) {
+    if (!mCells || count == 0) return mCells != nullptr;
+    if (count > mMask + 1) return false;
+
+    // claim [pos, pos + count). The consumer frees cells in order, so if the last one
+    // is free the whole range is.
+    uint64_t pos = mEnqueue.load(std::memory_order_relaxed);
+    for (;;) {
+        const uint64_t last = pos + count - 1;
+        const uint64_t seq = mCells[last & mMask].seq.load(std::memory_order_acquire);
+        const int64_t dif = (int64_t)(seq - last);
+        if (dif == 0) {
+            if (mEnqueue.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) break;
+        } else if (dif < 0) {
+            return false;   // full
+        } else {
+            pos = mEnqueue.load(std::memory_order_relaxed);
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) mCells[(pos + i) & mMask].cmd = cmds[i];
+    // first cell last: once the consumer can read it, the rest of the batch is there too
+    for (size_t i = count; i-- > 0; )
+        mCells[(pos + i) & mMask].seq.store(pos + i + 1, std::memory_order_release);
+    return true;
+}
+}
@@ -1,5 +1,7 @@
 #include "Core.hpp"
 #include <cmath>
+#include <cstring>
+#include <functional>
 #include <algorithm>
 #include <glm/gtx/norm.hpp> 
 #include <glm/gtx/euler_angles.hpp>
@@ -26,13 +28,6 @@ struct TipVert {
     glm::vec2 corner;
 };
 
-// ------ orbit gating state (DLL-internal) ------
-static bool     sCtrlDown = false;
-static bool     sMMBDown  = false;
-static bool     sFirstMoveWhileOrbit = true;
-static double   sLastX = 0.0, sLastY = 0.0;
-static unsigned sMods   = 0; // last known modifiers
-// ------------------------------------------------
 static inline float WrapNearestDeg(float prevDeg, float currDeg) {
     // shift curr by +/-360 so it's closest to prev
     float d = currDeg - prevDeg;
@@ -57,75 +52,68 @@ static inline glm::vec3 EulerXYZFromMatDeg(const glm::mat3& R) {
 void Init() {
     
 }
-bool Core::Init(int width, int height, int gl_major, int gl_minor) {
-    mWidth = width;
-    mHeight = height;
+static double MsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+SharedContext::~SharedContext() {
+    objs.Clear();
+    objs.ReleasePrimitives();
+    if (glDebug) GLDebug::Attach(false);
+    indirect.Release();
+    if (translationVAO)    glDeleteVertexArrays(1, &translationVAO);
+    if (transformationVAO) glDeleteVertexArrays(1, &transformationVAO);
+    if (dummyVAO)          glDeleteVertexArrays(1, &dummyVAO);
+    if (translationVBO)    glDeleteBuffers(1, &translationVBO);
+    if (transformationVBO) glDeleteBuffers(1, &transformationVBO);
+    if (multiViewVBO)      glDeleteBuffers(1, &multiViewVBO);
+}
 
-    InitShader();
+Core::Core(std::shared_ptr<SharedContext> shared)
+    : mShared(shared ? std::move(shared) : std::make_shared<SharedContext>()) {}
 
-    // Interleaved positions (xyz) + colors (rgb) for a cube (36 verts)
-    const float tri[] = {
-        // positions          // colors
-        -0.5f, -0.5f, -0.5f,  1.0f, 0.0f, 0.0f, // back
-         0.5f, -0.5f, -0.5f,  0.0f, 1.0f, 0.0f,
-         0.5f,  0.5f, -0.5f,  0.0f, 0.0f, 1.0f,
-         0.5f,  0.5f, -0.5f,  0.0f, 0.0f, 1.0f,
-        -0.5f,  0.5f, -0.5f,  1.0f, 1.0f, 0.0f,
-        -0.5f, -0.5f, -0.5f,  1.0f, 0.0f, 0.0f,
-
-        -0.5f, -0.5f,  0.5f,  1.0f, 0.0f, 1.0f, // front
-         0.5f, -0.5f,  0.5f,  0.0f, 1.0f, 1.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 1.0f, 1.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 1.0f, 1.0f,
-        -0.5f,  0.5f,  0.5f,  0.5f, 0.5f, 0.5f,
-        -0.5f, -0.5f,  0.5f,  1.0f, 0.0f, 1.0f,
-
-        -0.5f,  0.5f,  0.5f,  0.0f, 1.0f, 0.5f, // left
-        -0.5f,  0.5f, -0.5f,  0.0f, 0.5f, 1.0f,
-        -0.5f, -0.5f, -0.5f,  1.0f, 0.5f, 0.0f,
-        -0.5f, -0.5f, -0.5f,  1.0f, 0.5f, 0.0f,
-        -0.5f, -0.5f,  0.5f,  0.5f, 1.0f, 0.0f,
-        -0.5f,  0.5f,  0.5f,  0.0f, 1.0f, 0.5f,
-
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f, 0.5f, // right
-         0.5f,  0.5f, -0.5f,  0.5f, 0.0f, 1.0f,
-         0.5f, -0.5f, -0.5f,  0.0f, 0.5f, 0.5f,
-         0.5f, -0.5f, -0.5f,  0.0f, 0.5f, 0.5f,
-         0.5f, -0.5f,  0.5f,  0.5f, 1.0f, 0.5f,
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f, 0.5f,
-
-        -0.5f, -0.5f, -0.5f,  0.3f, 0.7f, 0.5f, // bottom
-         0.5f, -0.5f, -0.5f,  0.7f, 0.3f, 0.5f,
-         0.5f, -0.5f,  0.5f,  0.5f, 0.7f, 0.3f,
-         0.5f, -0.5f,  0.5f,  0.5f, 0.7f, 0.3f,
-        -0.5f, -0.5f,  0.5f,  0.3f, 0.5f, 0.7f,
-        -0.5f, -0.5f, -0.5f,  0.3f, 0.7f, 0.5f,
-
-        -0.5f,  0.5f, -0.5f,  0.7f, 0.5f, 0.3f, // top
-         0.5f,  0.5f, -0.5f,  0.5f, 0.3f, 0.7f,
-         0.5f,  0.5f,  0.5f,  0.7f, 0.7f, 0.7f,
-         0.5f,  0.5f,  0.5f,  0.7f, 0.7f, 0.7f,
-        -0.5f,  0.5f,  0.5f,  0.2f, 0.8f, 0.4f,
-        -0.5f,  0.5f, -0.5f,  0.7f, 0.5f, 0.3f
-    };
-    // VAO/VBO
-    glGenVertexArrays(1, &mVAO);
-    glGenBuffers(1, &mVBO);
+Core::~Core() {
+    mShared->streaming.RemoveView(this);   // its cameras no longer hold chunks
+}
 
-    glBindVertexArray(mVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(tri), tri, GL_STATIC_DRAW);
+void Core::InitShared(Euclid_GetProcAddr loader) {
+    // Let the driver compile on its own threads. glad here predates the extension,
+    // so the entry point comes straight from the host's loader.
+    mParallelCompile = false;
+    if (loader) {
+        typedef void (APIENTRYP MaxCompilerThreadsProc)(GLuint count);
+        MaxCompilerThreadsProc maxThreads = nullptr;
+        if (HasGLExtension("GL_KHR_parallel_shader_compile"))
+            maxThreads = (MaxCompilerThreadsProc)loader("glMaxShaderCompilerThreadsKHR");
+        else if (HasGLExtension("GL_ARB_parallel_shader_compile"))
+            maxThreads = (MaxCompilerThreadsProc)loader("glMaxShaderCompilerThreadsARB");
+        if (maxThreads) {
+            maxThreads(0xFFFFFFFFu);   // implementation decides
+            mParallelCompile = true;
+        }
+    }
 
-    // layout(location=0) vec3 aPos
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    GLDebug::LoadEntryPoints(loader);
 
-    // layout(location=1) vec3 aColor
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    auto t0 = std::chrono::steady_clock::now();
+    InitShader();
+    mInitStats.shaders_ms = MsSince(t0);
+    mGizmoReady = false;   // gizmo builds on first selection (EnsureGizmo)
+    mShared->initialized = true;
+}
 
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+bool Core::Init(int width, int height, int gl_major, int gl_minor, Euclid_GetProcAddr loader) {
+    mInitStart = std::chrono::steady_clock::now();
+    mInitStats = {};
+    mFirstFrameDone = false;
+    mWidth = width;
+    mHeight = height;
+
+    // another view on an existing context: programs and geometry are already there
+    if (!mShared->initialized)
+        InitShared(loader);
+
+    // hosts asking for 4.3+ get the GPU-driven scene pass; it builds on the first frame
+    mIndirect = gl_major * 10 + gl_minor >= 43 && IndirectScene::Supported();
 
     // Basic state
     glViewport(0, 0, width, height);
@@ -142,17 +130,55 @@ bool Core::Init(int width, int height, int gl_major, int gl_minor) {
     // Model matrix (identity; let the camera do the orbiting)
     mModel = glm::mat4(1.0f);
 
-    mObjs.InitPrimitives();
-    
+    // primitives upload on first draw, gizmo on first selection (EnsureGizmo)
     mGizmoLength = 2.0f;
+
+    mInitStats.init_total_ms = MsSince(mInitStart);
+    return true;
+}
+void Core::EnsureGizmo() {
+    if (mGizmoReady) return;
+    auto t0 = std::chrono::steady_clock::now();
+    FinishGizmoPrograms();
     BuildTranslationGizmo(glm::vec3(0), mGizmoLength);
     BuildScaleTips(glm::vec3(0), mGizmoLength);
-    
+    mGizmoReady = true;
+    mInitStats.gizmo_ms = MsSince(t0);
+}
+void Core::BeginFrameStats() {
+    mDraws = 0;
+    mTriangles = 0;
+}
+bool Core::EnableGLDebug(bool on) {
+    if (mShared->glDebug == on) return true;
+    if (!GLDebug::Attach(on)) return false;
+    mShared->glDebug = on;
     return true;
 }
+bool Core::SetGpuDriven(bool on) {
+    if (on && !mShared->indirect.Init(mProgramCache)) return false;
+    mIndirect = on;
+    return true;
+}
+void Core::EndFrameStats() {
+    GLDebug::EndFrame();
+    mStats.draw_calls = mDraws;   // scene + grid; the gizmo is not counted
+    mStats.triangles = mTriangles;
+    const uint64_t now = Profiler::NowNs();
+    if (mLastFrameNs && now > mLastFrameNs) {
+        const float fps = 1e9f / float(now - mLastFrameNs);
+        mStats.fps = mStats.fps > 0.0f ? 0.9f * mStats.fps + 0.1f * fps : fps;
+    }
+    mLastFrameNs = now;
+}
+void Core::GetInitStats(EuclidInitStats& out) const {
+    out = mInitStats;
+    out.program_cache_hits   = mProgramCache.Hits();
+    out.program_cache_misses = mProgramCache.Misses();
+    out.parallel_compile     = mParallelCompile ? 1 : 0;
+    out.primitives_built     = mObjs.PrimitivesBuilt();
+}
 void Core::CleanUp() {
-    if (mVBO) { glDeleteBuffers(1, &mVBO); mVBO = 0; }
-    if (mVAO) { glDeleteVertexArrays(1, &mVAO); mVAO = 0; }
     mObjs.ReleasePrimitives();
 }
 void Core::Resize(int width, int height) {
@@ -166,24 +192,50 @@ void Core::Update(float dtSeconds) {
     mModel = glm::mat4(1.0f);
 }
 void Core::Render() {
+    EUCLID_ZONE("Render");
+    mGpuProfiler.Collect();
+    BeginFrameStats();
+
+    // whatever other threads queued lands as a whole, before anything is drawn
+    {
+        EUCLID_ZONE("Apply commands");
+        mCommands.Drain([this](const EuclidCommand& c) { ApplyCommand(c); });
+    }
+    ProcessInput();   // latest pointer state, one drag solve per frame
+
+    const glm::mat4 view = mainCamera.GetViewMatrix(), proj = ProjectionMatrix();
+    {
+        const glm::vec3 eye(glm::inverse(view)[3]);
+        const glm::mat4 viewProj = proj * view;
+        UpdateStreaming(&eye, &viewProj, 1);
+    }
+    RenderView(view, proj, mShowGrid, /*drawGizmo*/true);
+    if (mDragDirty) FlushDragEvent(/*final*/false);
+    if (mCommands.Enabled()) {
+        EUCLID_ZONE("Publish snapshot");
+        mSnapshot.Publish(mObjs);
+    }
+    EndFrameInput();
+    EndFrameStats();
+
+    if (!mFirstFrameDone) {
+        glFinish();   // once, so the number includes the GPU side of the first frame
+        mInitStats.first_frame_ms = MsSince(mInitStart);
+        mFirstFrameDone = true;
+    }
+}
+void Core::RenderView(const glm::mat4& view, const glm::mat4& projection, bool drawGrid, bool drawGizmo) {
     glClearColor(0.05f, 0.05f, 0.05f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // --- camera matrices ---
-    float aspect = (mHeight > 0) ? (float)mWidth / (float)mHeight : 1.0f;
-    glm::mat4 projection = glm::perspective(glm::radians(mainCamera.GetZoom()), aspect, 0.1f, 100.0f);
-    glm::mat4 view = mainCamera.GetViewMatrix();
-    glm::mat4 invVP = glm::inverse(projection * view);
-
-    // If your Camera exposes position, use that:
-    // glm::vec3 camPos = mainCamera.GetPosition();
-    // Otherwise extract from view matrix:
-    glm::mat4 invView = glm::inverse(view);
-    glm::vec3 camPos = glm::vec3(invView[3]); // translation of inverse(view)
     glm::mat4 viewProj = projection * view;
 
     // --- MAIN SCENE ---
-    DrawScene(view, projection);
+    {
+        EUCLID_GPU_ZONE(mGpuProfiler, "Scene");
+        DrawScene(view, projection);
+    }
 
     // --- GRID BACKGROUND PASS ---
     glBindVertexArray(mDummyVAO);   // or mVAO if you don't want a dummy
@@ -191,29 +243,39 @@ void Core::Render() {
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LEQUAL);
 
-    gridShader.Use();
-    GLint locInvVP = glGetUniformLocation(gridShader.GetID(), "uInvViewProj");
-    GLint locCam   = glGetUniformLocation(gridShader.GetID(), "uCamPos");
-    glUniformMatrix4fv(locInvVP, 1, GL_FALSE, &invVP[0][0]);
-    glUniform3fv(locCam, 1, &camPos[0]);
-    
-    //glUseProgram(gridShader.GetID());
-    glUniformMatrix4fv(glGetUniformLocation(gridShader.GetID(),"uInvViewProj"), 1, GL_FALSE, &invVP[0][0]);
-    glUniformMatrix4fv(glGetUniformLocation(gridShader.GetID(),"uViewProj"),    1, GL_FALSE, &viewProj[0][0]);
-    glUniform3fv(glGetUniformLocation(gridShader.GetID(),"uCamPos"), 1, &camPos[0]);
-
-    glDrawArrays(GL_TRIANGLES, 0, 3);
+    if (drawGrid) {
+        EUCLID_GPU_ZONE(mGpuProfiler, "Grid");
+        DrawGrid(view, projection);
+    }
     
     // --- SELECTED GIZMO RENDERING ---
     
     glDisable(GL_DEPTH_TEST);
-    DrawGizmoForSelection(viewProj);
+    if (drawGizmo && mObjs.GetSelection()) {
+        EUCLID_GPU_ZONE(mGpuProfiler, "Gizmo");
+        DrawGizmoForSelection(viewProj);
+    }
 
     glUseProgram(0);
     glDepthMask(GL_TRUE);
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LEQUAL);
 }
+void Core::DrawGrid(const glm::mat4& view, const glm::mat4& projection) {
+    glm::mat4 viewProj = projection * view;
+    glm::mat4 invVP = glm::inverse(viewProj);
+    glm::vec3 camPos = glm::vec3(glm::inverse(view)[3]); // translation of inverse(view)
+
+    glBindVertexArray(mDummyVAO);
+    gridShader.Use();
+    glUniformMatrix4fv(glGetUniformLocation(gridShader.GetID(),"uInvViewProj"), 1, GL_FALSE, &invVP[0][0]);
+    glUniformMatrix4fv(glGetUniformLocation(gridShader.GetID(),"uViewProj"),    1, GL_FALSE, &viewProj[0][0]);
+    glUniform3fv(glGetUniformLocation(gridShader.GetID(),"uCamPos"), 1, &camPos[0]);
+
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    ++mDraws;
+    ++mTriangles;
+}
 void Core::BuildTranslationGizmo(const glm::vec3 &origin, float L) {
     glm::vec3 X = origin + glm::vec3(L,0,0);
         glm::vec3 Y = origin + glm::vec3(0,L,0);
@@ -246,6 +308,9 @@ void Core::BuildTranslationGizmo(const glm::vec3 &origin, float L) {
         glBindVertexArray(mTranslationVAO);
         glBindBuffer(GL_ARRAY_BUFFER, mTranslationVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(v), v, GL_DYNAMIC_DRAW);
+        mShared->gizmoMem.Add(sizeof(v));
+        GLDebug::Label(GL_VERTEX_ARRAY, mTranslationVAO, "Translation gizmo");
+        GLDebug::Label(GL_BUFFER, mTranslationVBO, "Translation gizmo", "vertices");
 
         GLsizei stride = sizeof(MoveVert);
         std::size_t off0 = offsetof(MoveVert, startWS);
@@ -284,6 +349,9 @@ void Core::BuildScaleTips(const glm::vec3& origin, float L) {
     glBindVertexArray(mTransformationVAO);
     glBindBuffer(GL_ARRAY_BUFFER, mTransformationVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(v), v, GL_DYNAMIC_DRAW);
+    mShared->gizmoMem.Add(sizeof(v));
+    GLDebug::Label(GL_VERTEX_ARRAY, mTransformationVAO, "Scale gizmo tips");
+    GLDebug::Label(GL_BUFFER, mTransformationVBO, "Scale gizmo tips", "vertices");
 
     GLsizei stride = sizeof(TipVert);
     std::size_t o0 = offsetof(TipVert, centerWS);
@@ -369,58 +437,117 @@ void Core::DrawTransformationGizmo(const glm::mat4& viewProj,
     glDrawArrays(GL_TRIANGLE_STRIP, 8,  4); // Z tip
     glBindVertexArray(0);
 }
+// -------- Input --------
 void Core::OnMouseMove(double x, double y) {
+    InputEvent e; e.kind = InputEvent::Move; e.x = x; e.y = y; e.timeNs = InputQueue::NowNs();
+    mInput.Push(e);
+}
+void Core::OnMouseButton(int button, bool down, unsigned mods) {
+    InputEvent e; e.kind = InputEvent::Button; e.button = button; e.down = down; e.mods = mods; e.timeNs = InputQueue::NowNs();
+    mInput.Push(e);
+}
+void Core::OnScroll(double dx, double dy) {
+    InputEvent e; e.kind = InputEvent::Scroll; e.x = dx; e.y = dy; e.timeNs = InputQueue::NowNs();
+    mInput.Push(e);
+}
+void Core::OnMods(unsigned mods) {
+    InputEvent e; e.kind = InputEvent::Mods; e.mods = mods; e.timeNs = InputQueue::NowNs();
+    mInput.Push(e);
+}
+void Core::ProcessInput() {
+    mInput.Take(mInputBatch);
+    mInputStats.events_received = mInput.Received();
+    if (mInputBatch.empty()) return;
+    EUCLID_ZONE("Process input");
+    for (size_t i = 0; i < mInputBatch.size(); ++i) {
+        const InputEvent& e = mInputBatch[i];
+        const bool moreMoves = i + 1 < mInputBatch.size() && mInputBatch[i + 1].kind == InputEvent::Move;
+        switch (e.kind) {
+            case InputEvent::Move:
+                // a drag only needs the latest position
+                if (mDraggingGizmo && moreMoves) { mLastX = e.x; mLastY = e.y; }
+                else ApplyMouseMove(e.x, e.y);
+                break;
+            case InputEvent::Button: ApplyMouseButton(e.button, e.down, e.mods); break;
+            case InputEvent::Scroll: ApplyScroll(e.x, e.y); break;
+            case InputEvent::Mods:   ApplyMods(e.mods); break;
+        }
+        if (!mFrameInputNs || e.timeNs < mFrameInputNs) mFrameInputNs = e.timeNs;
+    }
+    mInputStats.events_applied += mInputBatch.size();
+}
+void Core::EndFrameInput() {
+    if (!mFrameInputNs) return;
+    // without present reports the frame counts as shown once it is submitted
+    if (mPresentReported) mUnpresentedInputNs = mFrameInputNs;
+    else                  RecordInputLatency(mFrameInputNs);
+    mFrameInputNs = 0;
+}
+void Core::FramePresented() {
+    mPresentReported = true;
+    if (mUnpresentedInputNs) { RecordInputLatency(mUnpresentedInputNs); mUnpresentedInputNs = 0; }
+}
+void Core::RecordInputLatency(uint64_t sinceNs) {
+    const double ms = double(InputQueue::NowNs() - sinceNs) * 1e-6;
+    EuclidInputStats& st = mInputStats;
+    st.last_latency_ms = ms;
+    st.avg_latency_ms  = st.frames_with_input ? st.avg_latency_ms + (ms - st.avg_latency_ms) / 16.0 : ms;   // EMA
+    if (ms > st.max_latency_ms) st.max_latency_ms = ms;
+    ++st.frames_with_input;
+}
+void Core::ApplyMouseMove(double x, double y) {
     // 1) Gizmo drag takes priority (no Ctrl/MMB required)
     if (mDraggingGizmo) {
         UpdateGizmoDrag((float)x, (float)y);
-        sLastX = x; sLastY = y;   // keep cache in sync
+        ++mInputStats.gizmo_solves;
+        mLastX = x; mLastY = y;   // keep cache in sync
         return;
     }
 
     // 2) Orbit camera (same logic you had)
-    const bool orbiting = sCtrlDown || sMMBDown;
+    const bool orbiting = mCtrlDown || mMMBDown;
     if (!orbiting) {                      // not orbiting -> just refresh last pos
-        sFirstMoveWhileOrbit = true;
-        sLastX = x; sLastY = y;
+        mFirstMoveWhileOrbit = true;
+        mLastX = x; mLastY = y;
         return;
     }
 
-    if (sFirstMoveWhileOrbit) {
-        sLastX = x; sLastY = y;
-        sFirstMoveWhileOrbit = false;
+    if (mFirstMoveWhileOrbit) {
+        mLastX = x; mLastY = y;
+        mFirstMoveWhileOrbit = false;
         return;
     }
 
-    float dx = (float)(x - sLastX);
-    float dy = (float)(y - sLastY);
-    sLastX = x; sLastY = y;
+    float dx = (float)(x - mLastX);
+    float dy = (float)(y - mLastY);
+    mLastX = x; mLastY = y;
 
     mainCamera.ProcessMouseMovement(dx, dy, /*constrainPitch*/ true);
 }
-void Core::OnMouseButton(int button, bool down, unsigned mods) {
-    OnMods(mods);
+void Core::ApplyMouseButton(int button, bool down, unsigned mods) {
+    ApplyMods(mods);
 
     // MMB orbit (unchanged)
     if (button == kMouseMiddle) {
-        sMMBDown = down;
-        if (down) sFirstMoveWhileOrbit = true; // avoid jump
+        mMMBDown = down;
+        if (down) mFirstMoveWhileOrbit = true; // avoid jump
     }
 
     // LMB begins/ends gizmo drag
     const int kMouseLeft = 0; // matches EUCLID_MOUSE_LEFT
     if (button == kMouseLeft) {
-        if (down) BeginGizmoDrag((float)sLastX, (float)sLastY);
+        if (down) BeginGizmoDrag((float)mLastX, (float)mLastY);
         else      EndGizmoDrag();
     }
 }
-void Core::OnScroll(double dx, double dy) {
+void Core::ApplyScroll(double dx, double dy) {
     (void)dx;
     // Scroll wheel changes ORBIT RADIUS
     mainCamera.ProcessMouseScroll(static_cast<float>(dy));
 }
-void Core::OnMods(unsigned mods) {
-    sMods = mods;
-    sCtrlDown = (sMods & kModCtrl) != 0 || (sMods & kModSuper) != 0;
+void Core::ApplyMods(unsigned mods) {
+    mMods = mods;
+    mCtrlDown = (mMods & kModCtrl) != 0 || (mMods & kModSuper) != 0;
 }
 }
 
@@ -430,7 +557,9 @@ namespace Euclid
 
 Euclid::Object* Core::CreateObject(EuclidShapeType t, const void* params,
                                    const EuclidTransform& xform, EuclidObjectID id) {
-    return mObjs.Create(t, params, xform, id);
+    Object* o = mObjs.Create(t, params, xform, id);
+    if (o) PostEvent(EUCLID_EVENT_OBJECT_CREATED, o->id);
+    return o;
 }
 
 void Core::DestroyObjectGPU(EuclidObjectID id) {
@@ -438,6 +567,7 @@ void Core::DestroyObjectGPU(EuclidObjectID id) {
 }
 
 void Core::SetSelection(EuclidObjectID id) {
+    if (id != mObjs.GetSelection()) PostEvent(EUCLID_EVENT_SELECTION_CHANGED, id);
     mObjs.SetSelection(id);
     if (id != 0) {
         if (const Object* o = mObjs.Get(id)) {
@@ -447,8 +577,8 @@ void Core::SetSelection(EuclidObjectID id) {
 }
 
 EuclidObjectID Core::RayPick(float x, float y) {
-    float aspect = (mHeight>0)? float(mWidth)/float(mHeight) : 1.0f;
-    glm::mat4 proj = glm::perspective(glm::radians(mainCamera.GetZoom()), aspect, 0.1f, 100.0f);
+    ProcessInput();   // picking happens where the pointer is now
+    glm::mat4 proj = ProjectionMatrix();
     glm::mat4 view = mainCamera.GetViewMatrix();
     glm::mat4 invVP = glm::inverse(proj * view);
     return mObjs.RayPick(x, y, invVP, mWidth, mHeight);
@@ -459,7 +589,74 @@ EuclidResult Core::GetObjectTransform(EuclidObjectID id, EuclidTransform& out) {
 }
 
 EuclidResult Core::SetObjectTransform(EuclidObjectID id, const EuclidTransform& in) {
-    return mObjs.SetTransform(id, in);
+    const EuclidResult r = mObjs.SetTransform(id, in);
+    if (r == EUCLID_OK) PostEvent(EUCLID_EVENT_TRANSFORM_CHANGED, id, &in);
+    return r;
+}
+
+EuclidResult Core::CreateObjects(const EuclidCreateShapeDesc* descs, size_t count, EuclidObjectID* outIDs) {
+    // all or nothing: check the whole batch before making any of it. Custom meshes
+    // come from the Load* calls, not from a shape desc.
+    for (size_t i = 0; i < count; ++i) {
+        const int t = (int)descs[i].type;
+        if (t < EUCLID_SHAPE_CUBE || t > EUCLID_SHAPE_GROUP || t == EUCLID_SHAPE_CUSTOM)
+            return EUCLID_ERR_BAD_PARAM;
+    }
+    mObjs.Reserve(count);   // one rehash for the whole batch
+    for (size_t i = 0; i < count; ++i)
+        outIDs[i] = mObjs.Create(descs[i].type, descs[i].params, descs[i].xform, 0)->id;
+    for (size_t i = 0; i < count; ++i) PostEvent(EUCLID_EVENT_OBJECT_CREATED, outIDs[i]);
+    return EUCLID_OK;
+}
+
+EuclidResult Core::SetObjectTransforms(const EuclidObjectID* ids, size_t count, const void* src, size_t stride) {
+    const size_t found = mObjs.SetTransforms(ids, count, src, stride);
+    if (mEvents.Enabled()) {
+        for (size_t i = 0; i < count; ++i)
+            if (const Object* o = mObjs.Get(ids[i])) PostEvent(EUCLID_EVENT_TRANSFORM_CHANGED, o->id, &mObjs.Transform(*o));
+    }
+    return found == count ? EUCLID_OK : EUCLID_ERR_BAD_PARAM;
+}
+
+EuclidResult Core::GetObjectTransforms(const EuclidObjectID* ids, size_t count, void* dst, size_t stride) {
+    return mObjs.GetTransforms(ids, count, dst, stride) == count ? EUCLID_OK : EUCLID_ERR_BAD_PARAM;
+}
+
+void Core::GetSceneView(EuclidSceneView& out) const {
+    out.version    = mObjs.Version();
+    out.change_seq = mObjs.ChangeSeq();
+    out.count      = mObjs.Count();
+    out.ids        = mObjs.Ids();
+    out.types      = mObjs.Types();
+    out.transforms = mObjs.Transforms();
+    out.seqs       = mObjs.Seqs();
+    out.world_matrices = mObjs.Count() ? &mObjs.Worlds()[0][0][0] : nullptr;
+}
+
+// ---- Hierarchy ----
+EuclidResult Core::SetParents(const EuclidObjectID* ids, size_t count, EuclidObjectID parent) {
+    Object* p = nullptr;
+    if (parent && !(p = mObjs.Get(parent))) return EUCLID_ERR_BAD_PARAM;
+    bool ok = true;
+    for (size_t i = 0; i < count; ++i) {
+        Object* c = mObjs.Get(ids[i]);
+        if (!c || !mObjs.SetParent(*c, p)) ok = false;
+    }
+    return ok ? EUCLID_OK : EUCLID_ERR_BAD_PARAM;
+}
+
+EuclidResult Core::GetParent(EuclidObjectID id, EuclidObjectID& out) const {
+    const Object* o = mObjs.Get(id);
+    if (!o) return EUCLID_ERR_BAD_PARAM;
+    out = o->parent ? o->parent->id : 0;
+    return EUCLID_OK;
+}
+
+EuclidResult Core::GetWorldMatrix(EuclidObjectID id, float out[16]) const {
+    const Object* o = mObjs.Get(id);
+    if (!o) return EUCLID_ERR_BAD_PARAM;
+    std::memcpy(out, &mObjs.Model(*o)[0][0], sizeof(float) * 16);
+    return EUCLID_OK;
 }
 
 void Core::RequestRebuildScene() {
@@ -467,47 +664,214 @@ void Core::RequestRebuildScene() {
 }
 
 void Core::EndGizmoDrag() {
+    if (mDraggingGizmo) FlushDragEvent(/*final*/true);
     mDraggingGizmo = false;
     mActiveGizmo   = GizmoPart::None;
 }
 
+// ---- Scene events ----
+EuclidResult Core::EnableEvents(uint32_t capacity) {
+    mEvents.Enable(capacity);
+    return EUCLID_OK;
+}
+// ---- Command queue ----
+EuclidResult Core::EnableCommandQueue(uint32_t capacity) {
+    mCommands.Enable(capacity);
+    if (capacity) mSnapshot.Publish(mObjs);   // readable before the first frame
+    return EUCLID_OK;
+}
+void Core::ApplyCommand(const EuclidCommand& c) {
+    // same paths as the direct calls, so events and selection behave identically
+    switch (c.type) {
+        case EUCLID_CMD_SET_TRANSFORM: SetObjectTransform(c.id, c.transform); break;
+        case EUCLID_CMD_CREATE_SHAPE:
+            if (c.id && CreateObject(c.shape, c.has_params ? c.params : nullptr, c.transform, c.id) && c.parent)
+                SetParents(&c.id, 1, c.parent);
+            break;
+        case EUCLID_CMD_DELETE_OBJECT: DeleteObject(c.id); break;
+        case EUCLID_CMD_SET_PARENT:    SetParents(&c.id, 1, c.parent); break;
+        case EUCLID_CMD_SELECT:        SetSelection(c.id); break;
+        case EUCLID_CMD_CLEAR_SCENE:   ClearScene(); break;
+        default: break;
+    }
+}
+void Core::PostEvent(EuclidEventType type, EuclidObjectID id, const EuclidTransform* tf, float progress, bool dragging) {
+    if (!mEvents.Enabled()) return;
+    EuclidEvent e{};
+    e.type = type;
+    e.dragging = dragging ? 1 : 0;
+    e.id = id;
+    if (tf) e.transform = *tf;
+    e.progress = progress;
+    mEvents.Push(e);
+}
+void Core::FlushDragEvent(bool final) {
+    // mouse moves can outpace frames: one event per frame, plus the resting value on release
+    const bool dirty = mDragDirty;
+    mDragDirty = false;
+    if (!dirty && !final) return;
+    if (const Object* o = mObjs.Get(mDragObj))
+        PostEvent(EUCLID_EVENT_TRANSFORM_CHANGED, o->id, &mObjs.Transform(*o), 0.0f, /*dragging*/!final);
+}
+
 // ---- PRIVATE FUNCTION CALLS ON OBJECTS ----
 void Core::DrawObject(const Object& o, const glm::mat4& view, const glm::mat4& proj) {
-    glm::mat4 model = o.Model();
+    glm::mat4 model = mObjs.Model(o);
     mainShader.Use();
     glUniformMatrix4fv(glGetUniformLocation(mainShader.GetID(),"uModel"),1,GL_FALSE,&model[0][0]);
         glUniformMatrix4fv(glGetUniformLocation(mainShader.GetID(),"uView"),1,GL_FALSE,&view[0][0]);       glUniformMatrix4fv(glGetUniformLocation(mainShader.GetID(),"uProjection"),1,GL_FALSE,&proj[0][0]);
 
     if (o.type == EUCLID_SHAPE_CUSTOM) {
+        // a mirrored model turns its screen winding around
+        const GLenum front = glm::determinant(glm::mat3(model)) < 0.0f ? GL_CW : GL_CCW;
+        if (const PagedMesh* pm = mObjs.GetPagedMesh(o.customIndex)) {
+            if (mBackfaceCulling) { glEnable(GL_CULL_FACE); glFrontFace(front); }
+            DrawPaged(*pm, model, proj * view);   // counts its own draws
+            if (mBackfaceCulling) { glDisable(GL_CULL_FACE); glFrontFace(GL_CCW); }
+            glBindVertexArray(0);
+            return;
+        }
         const SharedMesh* cm = mObjs.GetCustomMesh(o.customIndex);
         if (!cm) return;
         glBindVertexArray(cm->vao);
-        if (cm->indexed) glDrawElements(GL_TRIANGLES, cm->indexCount, GL_UNSIGNED_INT, 0);
-        else              glDrawArrays  (GL_TRIANGLES, 0,            cm->indexCount);
+        if (mBackfaceCulling) { glEnable(GL_CULL_FACE); glFrontFace(front); }
+        if (!cm->meshlets.empty()) DrawMeshlets(*cm, model, proj * view);
+        else if (cm->indexed) glDrawElements(GL_TRIANGLES, cm->indexCount, GL_UNSIGNED_INT, 0);
+        else                  glDrawArrays  (GL_TRIANGLES, 0,            cm->indexCount);
+        if (mBackfaceCulling) { glDisable(GL_CULL_FACE); glFrontFace(GL_CCW); }
+        mTriangles += cm->indexCount / 3;
     } else {
         const SharedMesh& mesh = mObjs.MeshFor(o.type);
         glBindVertexArray(mesh.vao);
         if (mesh.indexed) glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0);
         else              glDrawArrays  (GL_TRIANGLES, 0,            mesh.indexCount);
+        mTriangles += mesh.indexCount / 3;
     }
+    ++mDraws;
     glBindVertexArray(0);
     
 }
 
+// Clusters outside the frustum, or facing away with backface culling on, are skipped; the
+// rest go out as one glMultiDrawElements, neighbours merged into one range.
+void Core::DrawMeshlets(const SharedMesh& mesh, const glm::mat4& model, const glm::mat4& viewProj) {
+    // frustum and eye in the mesh's own space: nothing gets transformed per cluster
+    const glm::mat4 mvp = viewProj * model;
+    glm::vec4 planes[6];
+    FrustumPlanes(mvp, planes);
+    float planeLen[6];
+    for (int p = 0; p < 6; ++p) planeLen[p] = glm::length(glm::vec3(planes[p]));
+
+    // a point's side of a plane survives any affine map, mirrors too: no flip needed
+    const bool cones = mBackfaceCulling && std::abs(glm::determinant(glm::mat3(model))) > 1e-12f;
+    // eye as a homogeneous point, w = 0 for orthographic projections
+    glm::vec4 eye(0.0f);
+    if (cones) eye = glm::inverse(mvp) * glm::vec4(0.0f, 0.0f, -1.0f, 0.0f);
+    if (eye.w < 0.0f) eye = -eye;
+
+    mClusterCounts.clear();
+    mClusterOffsets.clear();
+    uint32_t runEnd = 0xFFFFFFFFu;
+    for (const Meshlet& m : mesh.meshlets) {
+        bool outside = false;
+        for (int p = 0; p < 6 && !outside; ++p)
+            outside = glm::dot(glm::vec3(planes[p]), m.center) + planes[p].w < -m.radius * planeLen[p];
+        if (outside) continue;
+        if (cones && m.coneCutoff < 1.0f) {
+            const glm::vec3 v = m.center * eye.w - glm::vec3(eye);
+            if (glm::dot(v, m.coneAxis) >= m.coneCutoff * glm::length(v) + m.radius * eye.w) continue;
+        }
+        if (m.firstIndex == runEnd) mClusterCounts.back() += (int)m.indexCount;
+        else {
+            mClusterCounts.push_back((int)m.indexCount);
+            mClusterOffsets.push_back((const void*)(uintptr_t(m.firstIndex) * sizeof(uint32_t)));
+        }
+        runEnd = m.firstIndex + m.indexCount;
+    }
+    mClusterMem.Set(CapacityBytes(mClusterCounts) + CapacityBytes(mClusterOffsets));
+    if (!mClusterCounts.empty())
+        glMultiDrawElements(GL_TRIANGLES, mClusterCounts.data(), GL_UNSIGNED_INT, mClusterOffsets.data(),
+                            (GLsizei)mClusterCounts.size());
+}
+
+// Chunks in view that aren't resident are drawn as their proxies, all in one
+// glMultiDrawElements on the proxy mesh; resident ones as their own meshlets.
+void Core::DrawPaged(const PagedMesh& pm, const glm::mat4& model, const glm::mat4& viewProj) {
+    glm::vec4 planes[6];
+    FrustumPlanes(viewProj * model, planes);
+    auto outside = [&](const PagedMesh::Chunk& c) {
+        const glm::vec3 center = 0.5f * (c.bmin + c.bmax), extent = 0.5f * (c.bmax - c.bmin);
+        for (const glm::vec4& p : planes)
+            if (glm::dot(glm::vec3(p), center) + p.w < -glm::dot(glm::abs(glm::vec3(p)), extent)) return true;
+        return false;
+    };
+
+    mClusterCounts.clear();
+    mClusterOffsets.clear();
+    uint32_t runEnd = 0xFFFFFFFFu;
+    for (const PagedMesh::Chunk& c : pm.Chunks()) {
+        if (c.state == PagedMesh::kResident || !c.proxyCount || outside(c)) continue;
+        if (c.proxyFirst == runEnd) mClusterCounts.back() += (int)c.proxyCount;
+        else {
+            mClusterCounts.push_back((int)c.proxyCount);
+            mClusterOffsets.push_back((const void*)(uintptr_t(c.proxyFirst) * sizeof(uint32_t)));
+        }
+        runEnd = c.proxyFirst + c.proxyCount;
+        mTriangles += (int)c.proxyCount / 3;
+    }
+    if (!mClusterCounts.empty() && pm.Proxy().vao) {
+        glBindVertexArray(pm.Proxy().vao);
+        glMultiDrawElements(GL_TRIANGLES, mClusterCounts.data(), GL_UNSIGNED_INT, mClusterOffsets.data(),
+                            (GLsizei)mClusterCounts.size());
+        ++mDraws;
+    }
+
+    for (const PagedMesh::Chunk& c : pm.Chunks()) {
+        if (c.state != PagedMesh::kResident || outside(c)) continue;
+        glBindVertexArray(c.mesh.vao);
+        if (!c.mesh.meshlets.empty()) DrawMeshlets(c.mesh, model, viewProj);
+        else glDrawElements(GL_TRIANGLES, c.mesh.indexCount, GL_UNSIGNED_INT, 0);
+        mTriangles += c.mesh.indexCount / 3;
+        ++mDraws;
+    }
+}
+
+// Once per frame, not per RenderView: tiles and sequence frames settle their own cameras
+void Core::UpdateStreaming(const glm::vec3* eyes, const glm::mat4* viewProjs, int count) {
+    // also drains reads that landed after the last paged object went away
+    mShared->streaming.Update(mObjs, this, eyes, viewProjs, count);
+}
+
+void Core::SettleStreaming(const glm::mat4& view, const glm::mat4& proj) {
+    const glm::vec3 eye(glm::inverse(view)[3]);
+    const glm::mat4 viewProj = proj * view;
+    mShared->streaming.Settle(mObjs, &eye, &viewProj, 1);
+}
+
 void Core::DrawScene(const glm::mat4& view, const glm::mat4& proj) {
-    // copy ids to avoid iterator invalidation if something deletes during draw
-    std::vector<EuclidObjectID> ids; ids.reserve(mObjs.All().size());
-    for (auto& kv : mObjs.All()) ids.push_back(kv.first);
-    for (auto id : ids) {
-        if (const Object* o = mObjs.Get(id)) DrawObject(*o, view, proj);
+    if (mIndirect) {
+        IndirectScene& gpu = mShared->indirect;
+        if (gpu.Init(mProgramCache)) {
+            gpu.Draw(mObjs, view, proj, mOcclusion, mBackfaceCulling);
+            mDraws += gpu.Draws();
+            mTriangles += gpu.Triangles();   // before culling, like the per-object path
+            // paged meshes have no mesh of their own in the arena: they come after
+            for (EuclidObjectID id : mObjs.PagedObjects())
+                if (const Object* o = mObjs.Get(id)) DrawObject(*o, view, proj);
+            return;
+        }
+        mIndirect = false;   // programs didn't build: stay on the per-object path
     }
+    // cached list: no per-frame id copy + hash lookups
+    for (const Object* o : mObjs.DrawList()) DrawObject(*o, view, proj);
 }
 
 void Core::DrawGizmoForSelection(const glm::mat4& viewProj) {
     EuclidObjectID sel = mObjs.GetSelection(); if (!sel) return;
     const Object* o = mObjs.Get(sel); if (!o) return;
+    EnsureGizmo();
 
-    glm::vec3 pos(o->tf.position[0], o->tf.position[1], o->tf.position[2]);
+    const glm::vec3 pos(mObjs.Model(*o)[3]);   // world position: parents count
     UpdateGizmoBasisFromObject(*o);
     UpdateGizmoGeometry(pos, mGizmoBasis, mGizmoLength);
 
@@ -541,14 +905,19 @@ void Core::DrawGizmoForSelection(const glm::mat4& viewProj) {
     }
 }
 
+glm::mat4 Core::ProjectionMatrix() const {
+    float aspect = (mHeight>0)? float(mWidth)/float(mHeight) : 1.0f;
+    return glm::perspective(glm::radians(mainCamera.GetZoom()), aspect, kNearPlane, kFarPlane);
+}
+
 void Core::FocusOnObject(const Object& o, bool adjustRadius) {
     // Set target to object's position, keep current yaw/pitch and (usually) the same radius
-    glm::vec3 pos(o.tf.position[0], o.tf.position[1], o.tf.position[2]);
-    mainCamera.SetTarget(pos);
+    const EuclidTransform& tf = mObjs.Transform(o);
+    mainCamera.SetTarget(glm::vec3(mObjs.Model(o)[3]));
 
     if (adjustRadius) {
         // Very conservative "fit" radius from object scale (unit primitives). Tweak as you like.
-        glm::vec3 s(o.tf.scale[0], o.tf.scale[1], o.tf.scale[2]);
+        glm::vec3 s(tf.scale[0], tf.scale[1], tf.scale[2]);
         float approxBound = 0.5f * glm::length(s);  // ~ half-diagonal of unit box scaled
         float minRadius   = glm::max(0.5f, approxBound * 2.2f);
         if (mainCamera.GetRadius() < minRadius)     // only zoom out if too close
@@ -556,6 +925,46 @@ void Core::FocusOnObject(const Object& o, bool adjustRadius) {
     }
 }
 
+EuclidResult Core::FrameObject(EuclidObjectID id) {
+    const Object* o = mObjs.Get(id);
+    if (!o) return EUCLID_ERR_BAD_PARAM;
+
+    glm::vec3 mn, mx;
+    mObjs.SubtreeBounds(*o, mn, mx);   // a group frames its contents
+    const glm::vec3 center = 0.5f * (mn + mx);
+    const float radius = glm::max(0.5f * glm::length(mx - mn), 1e-3f);
+
+    // bounding sphere has to fit the narrower of the two half-FOVs
+    const float halfY  = 0.5f * glm::radians(mainCamera.GetZoom());
+    const float aspect = float(std::max(1, mWidth)) / float(std::max(1, mHeight));
+    const float halfX  = std::atan(std::tan(halfY) * aspect);
+    const float dist   = kFrameMargin * radius / std::sin(std::min(halfX, halfY));
+
+    mainCamera.SetTarget(center);
+    mainCamera.SetRadius(dist);
+    return EUCLID_OK;
+}
+
+Core::CameraState Core::GetCameraState() {
+    ProcessInput();
+    const glm::vec3 t = mainCamera.GetTarget();
+    return { { t.x, t.y, t.z }, mainCamera.GetRadius(), mainCamera.GetYaw(), mainCamera.GetPitch(), mainCamera.GetZoom() };
+}
+
+void Core::SetCameraState(const CameraState& c) {
+    mainCamera.SetTarget(glm::vec3(c.target[0], c.target[1], c.target[2]));
+    mainCamera.SetRadius(c.radius);
+    mainCamera.SetYaw(c.yaw);
+    mainCamera.SetPitch(c.pitch);
+    mainCamera.SetZoom(c.zoom);
+}
+
+EuclidResult Core::ReadCustomMesh(EuclidObjectID id, std::vector<float>& positions, std::vector<unsigned>& indices) const {
+    const Object* o = mObjs.Get(id);
+    if (!o || o->type != EUCLID_SHAPE_CUSTOM) return EUCLID_ERR_BAD_PARAM;
+    return mObjs.ReadCustomMesh(o->customIndex, positions, indices) ? EUCLID_OK : EUCLID_ERR_INIT;
+}
+
 Core::Ray Core::ScreenRay(float px, float py, const glm::mat4& invVP) const {
     float sx =  (2.0f * float(px) / float(mWidth)) - 1.0f;
     float sy = -(2.0f * float(py) / float(mHeight)) + 1.0f;
@@ -683,12 +1092,11 @@ void Core::BeginGizmoDrag(float px, float py) {
     const Object* o = mObjs.Get(mDragObj); if (!o) return;
 
     // freeze basis & origin for the entire drag
-    mDragOriginWS = { o->tf.position[0], o->tf.position[1], o->tf.position[2] };
+    mDragOriginWS = glm::vec3(mObjs.Model(*o)[3]);
     UpdateGizmoBasisFromObject(*o);
     mDragBasis = mGizmoBasis;
 
-    float aspect = (mHeight>0)? float(mWidth)/float(mHeight) : 1.0f;
-    glm::mat4 proj = glm::perspective(glm::radians(mainCamera.GetZoom()), aspect, 0.1f, 100.0f);
+    glm::mat4 proj = ProjectionMatrix();
     glm::mat4 view = mainCamera.GetViewMatrix();
     glm::mat4 invVP= glm::inverse(proj * view);
 
@@ -745,9 +1153,10 @@ void Core::BeginGizmoDrag(float px, float py) {
 void Core::UpdateGizmoDrag(float px, float py) {
     if (!mDraggingGizmo || !mDragObj) return;
     Object* o = mObjs.Get(mDragObj); if (!o) return;
+    EuclidTransform& tf = mObjs.EditTransform(*o);
+    mDragDirty = true;   // published once per frame from Render
 
-    float aspect = (mHeight>0)? float(mWidth)/float(mHeight) : 1.0f;
-    glm::mat4 proj = glm::perspective(glm::radians(mainCamera.GetZoom()), aspect, 0.1f, 100.0f);
+    glm::mat4 proj = ProjectionMatrix();
     glm::mat4 view = mainCamera.GetViewMatrix();
     glm::mat4 invVP= glm::inverse(proj * view);
 
@@ -773,7 +1182,7 @@ void Core::UpdateGizmoDrag(float px, float py) {
         mAngle0  = a;
 
         // Build current orientation from degrees (XYZ intrinsic)
-        glm::mat3 Rcur = MatFromEulerXYZ_Deg(o->tf.rotation[0], o->tf.rotation[1], o->tf.rotation[2]);
+        glm::mat3 Rcur = MatFromEulerXYZ_Deg(tf.rotation[0], tf.rotation[1], tf.rotation[2]);
 
         // Local axis for the chosen ring (X/Y/Z in local space)
         glm::vec3 axisLocal(0.0f); axisLocal[idx] = 1.0f;
@@ -786,13 +1195,13 @@ void Core::UpdateGizmoDrag(float px, float py) {
         float rx, ry, rz;
         glm::extractEulerAngleXYZ(glm::mat4(Rnew), rx, ry, rz);
         glm::vec3 eDeg = EulerXYZFromMatDeg(Rnew);
-        eDeg.x = WrapNearestDeg(o->tf.rotation[0], eDeg.x);
-        eDeg.y = WrapNearestDeg(o->tf.rotation[1], eDeg.y);
-        eDeg.z = WrapNearestDeg(o->tf.rotation[2], eDeg.z);
+        eDeg.x = WrapNearestDeg(tf.rotation[0], eDeg.x);
+        eDeg.y = WrapNearestDeg(tf.rotation[1], eDeg.y);
+        eDeg.z = WrapNearestDeg(tf.rotation[2], eDeg.z);
 
-        o->tf.rotation[0] = eDeg.x;
-        o->tf.rotation[1] = eDeg.y;
-        o->tf.rotation[2] = eDeg.z;
+        tf.rotation[0] = eDeg.x;
+        tf.rotation[1] = eDeg.y;
+        tf.rotation[2] = eDeg.z;
         return;
     }
 
@@ -805,9 +1214,10 @@ void Core::UpdateGizmoDrag(float px, float py) {
     float dt = t - mAxisT0;
 
     if (mGizmoMode == EUCLID_GIZMO_TRANSLATE) {
-        glm::vec3 p(o->tf.position[0], o->tf.position[1], o->tf.position[2]);
-        p += mDragAxis * dt;                              // move along the visible axis
-        o->tf.position[0] = p.x; o->tf.position[1] = p.y; o->tf.position[2] = p.z;
+        // move along the visible (world) axis; position lives in the parent's space
+        glm::vec3 p(tf.position[0], tf.position[1], tf.position[2]);
+        p += glm::vec3(glm::inverse(mObjs.ParentModel(*o)) * glm::vec4(mDragAxis * dt, 0.0f));
+        tf.position[0] = p.x; tf.position[1] = p.y; tf.position[2] = p.z;
         mAxisT0 = t;
         return;
     }
@@ -820,7 +1230,7 @@ void Core::UpdateGizmoDrag(float px, float py) {
         if (idx<0) return;
 
         float s = 1.0f + dt;
-        o->tf.scale[idx] = glm::max(0.001f, o->tf.scale[idx] * s);
+        tf.scale[idx] = glm::max(0.001f, tf.scale[idx] * s);
         mAxisT0 = t;
         return;
     }
@@ -828,7 +1238,7 @@ void Core::UpdateGizmoDrag(float px, float py) {
 
 
 void Core::UpdateGizmoBasisFromObject(const Object& o) {
-    glm::mat4 M = o.Model();
+    glm::mat4 M = mObjs.Model(o);
     glm::vec3 X = glm::normalize(glm::vec3(M[0]));
     glm::vec3 Y = glm::normalize(glm::vec3(M[1]));
     glm::vec3 Z = glm::normalize(glm::vec3(M[2]));
@@ -866,32 +1276,62 @@ void Core::UpdateGizmoGeometry(const glm::vec3& origin, const glm::mat3& B, floa
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 EuclidResult Core::LoadOBJ(const char* path, EuclidObjectID* outID, bool normalize) {
-    return mObjs.LoadOBJ(path, outID, normalize);
+    std::function<void(float)> progress;
+    if (mEvents.Enabled())
+        progress = [this](float f) { PostEvent(EUCLID_EVENT_IMPORT_PROGRESS, 0, nullptr, f); };
+
+    const EuclidResult r = mObjs.LoadOBJ(path, outID, normalize, progress);
+    if (r == EUCLID_OK) {
+        PostEvent(EUCLID_EVENT_OBJECT_CREATED, *outID);
+        PostEvent(EUCLID_EVENT_IMPORT_PROGRESS, *outID, nullptr, 1.0f);
+    }
+    return r;
 }
 EuclidResult Core::CreateFromRawMesh(const float* pos, size_t vcount,
                                      const unsigned* idx, size_t icount,
                                      EuclidObjectID* outID, bool normalize) {
-    return mObjs.CreateFromRawMesh(pos, vcount, idx, icount, outID, normalize);
+    const EuclidResult r = mObjs.CreateFromRawMesh(pos, vcount, idx, icount, outID, normalize);
+    if (r == EUCLID_OK) PostEvent(EUCLID_EVENT_OBJECT_CREATED, *outID);
+    return r;
+}
+EuclidResult Core::BuildPagedMesh(const char* objPath, const char* pagePath, bool normalize) {
+    std::function<void(float)> progress;
+    if (mEvents.Enabled())
+        progress = [this](float f) { PostEvent(EUCLID_EVENT_IMPORT_PROGRESS, 0, nullptr, f); };
+    return Euclid::BuildPagedMesh(objPath, pagePath, normalize, progress);
+}
+EuclidResult Core::LoadPagedMesh(const char* path, EuclidObjectID* outID) {
+    const EuclidResult r = mObjs.LoadPagedMesh(path, outID);
+    if (r == EUCLID_OK) PostEvent(EUCLID_EVENT_OBJECT_CREATED, *outID);
+    return r;
+}
+EuclidResult Core::PagedMeshPath(EuclidObjectID id, std::string& out) const {
+    const Object* o = mObjs.Get(id);
+    const PagedMesh* pm = o && o->type == EUCLID_SHAPE_CUSTOM ? mObjs.GetPagedMesh(o->customIndex) : nullptr;
+    if (!pm) return EUCLID_ERR_BAD_PARAM;
+    out = pm->Path();
+    return EUCLID_OK;
 }
 
 EuclidResult Core::DeleteObject(EuclidObjectID id) {
     if (!id) return EUCLID_ERR_BAD_PARAM;
 
-    // stop drag if the deleted object is being dragged
-    if (mDraggingGizmo && mDragObj == id) {
-        EndGizmoDrag();
-    }
-
-    // Remove from store
+    // Remove from store (children go with it)
     if (!mObjs.Get(id)) return EUCLID_ERR_BAD_PARAM;
-    mObjs.SetSelection(0);
-    // add this in ObjectStore (below): mObjs.Remove(id);
-    const bool ok = mObjs.Remove(id);
+    SetSelection(0);
+    std::vector<EuclidObjectID> removed;
+    const bool ok = mObjs.Remove(id, &removed);
+
+    // stop drag if the dragged object was in there
+    if (mDraggingGizmo && !mObjs.Get(mDragObj)) EndGizmoDrag();
+    for (EuclidObjectID r : removed) PostEvent(EUCLID_EVENT_OBJECT_DELETED, r);
     return ok ? EUCLID_OK : EUCLID_ERR_BAD_PARAM;
 }
 EuclidResult Core::ClearScene() {
     EndGizmoDrag();
+    SetSelection(0);
     mObjs.Clear();
+    PostEvent(EUCLID_EVENT_SCENE_CLEARED, 0);
     return EUCLID_OK;
 }
 }
@@ -0,0 +1,73 @@
+#include "EventQueue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace Euclid
+{
+namespace {
+    // the indices live in the plain C struct, so go through atomic_ref
+    uint32_t Load(uint32_t& v, std::memory_order o)          { return std::atomic_ref<uint32_t>(v).load(o); }
+    void     Store(uint32_t& v, uint32_t x, std::memory_order o) { std::atomic_ref<uint32_t>(v).store(x, o); }
+}
+
+void EventQueue::Enable(uint32_t capacity) {
+    mRing = nullptr;
+    mStorage.reset();
+    mOverflowPending = false;
+    mMem.Set(0);
+    if (capacity == 0) return;
+
+    uint32_t cap = 1;
+    while (cap < capacity && cap < (1u << 24)) cap <<= 1;
+
+    // header, then the slots, 64-byte aligned
+    const size_t header = (sizeof(EuclidEventRing) + 63) & ~size_t(63);
+    mStorage.reset(new unsigned char[header + size_t(cap) * sizeof(EuclidEvent) + 64]);
+    mMem.Set(header + size_t(cap) * sizeof(EuclidEvent) + 64);
+    unsigned char* base = mStorage.get() + (64 - reinterpret_cast<uintptr_t>(mStorage.get()) % 64) % 64;
+
+    mRing = new (base) EuclidEventRing{};
+    mRing->capacity = cap;
+    mRing->events = reinterpret_cast<EuclidEvent*>(base + header);
+    std::uninitialized_value_construct_n(mRing->events, cap);
+}
+
+void EventQueue::Push(const EuclidEvent& e) {
+    if (!mRing) return;
+    const uint32_t cap = mRing->capacity;
+    uint32_t w = Load(mRing->write_index, std::memory_order_relaxed);
+    const uint32_t r = Load(mRing->read_index, std::memory_order_acquire);
+
+    // after a drop the consumer must hear about it before anything newer
+    const uint32_t need = mOverflowPending ? 2u : 1u;
+    if (w - r + need > cap) {
+        Store(mRing->dropped, mRing->dropped + 1, std::memory_order_relaxed);
+        mOverflowPending = true;
+        return;
+    }
+    if (mOverflowPending) {
+        EuclidEvent& o = mRing->events[w & (cap - 1)];
+        o = {};
+        o.type = EUCLID_EVENT_OVERFLOW;
+        ++w;
+        mOverflowPending = false;
+    }
+    mRing->events[w & (cap - 1)] = e;
+    Store(mRing->write_index, w + 1, std::memory_order_release);
+}
+
+size_t EventQueue::Drain(EuclidEvent* out, size_t max) {
+    if (!mRing || !out) return 0;
+    const uint32_t cap = mRing->capacity;
+    const uint32_t r = Load(mRing->read_index, std::memory_order_relaxed);
+    const uint32_t w = Load(mRing->write_index, std::memory_order_acquire);
+    const size_t n = std::min<size_t>(w - r, max);
+    for (size_t i = 0; i < n; ++i) out[i] = mRing->events[(r + (uint32_t)i) & (cap - 1)];
+    Store(mRing->read_index, r + (uint32_t)n, std::memory_order_release);
+    return n;
+}
+}
@@ -0,0 +1,41 @@
+#include "InputQueue.hpp"
+
+#include <chrono>
+
+namespace Euclid
+{
+uint64_t InputQueue::NowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void InputQueue::Push(const InputEvent& e) {
+    mReceived.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (e.kind == InputEvent::Mods || e.kind == InputEvent::Button) {
+        if (e.kind == InputEvent::Mods && e.mods == mQueuedMods) return;
+        mQueuedMods = e.mods;
+    }
+    if (!mPending.empty()) {
+        InputEvent& last = mPending.back();
+        const bool runOfMoves = mPending.size() >= 2 && mPending[mPending.size() - 2].kind == InputEvent::Move;
+        if (e.kind == InputEvent::Move && last.kind == InputEvent::Move && runOfMoves) {
+            last.x = e.x; last.y = e.y;
+            return;
+        }
+        if (e.kind == InputEvent::Scroll && last.kind == InputEvent::Scroll) {
+            last.x += e.x; last.y += e.y;
+            return;
+        }
+    }
+    mPending.push_back(e);
+}
+
+void InputQueue::Take(std::vector<InputEvent>& out) {
+    out.clear();
+    std::lock_guard<std::mutex> lock(mMutex);
+    out.swap(mPending);
+    mMem.Set(CapacityBytes(out) + CapacityBytes(mPending));
+}
+}
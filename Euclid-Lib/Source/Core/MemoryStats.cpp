@@ -0,0 +1,53 @@
+#include "MemoryStats.hpp"
+
+namespace Euclid
+{
+namespace {
+    struct Counter {
+        std::atomic<int64_t> bytes{0};
+        std::atomic<int64_t> peak{0};
+        std::atomic<int64_t> allocations{0};
+    };
+    Counter sCategories[EUCLID_MEM_CATEGORY_COUNT];
+    Counter sTotals[2];   // gpu, cpu
+
+    void RaisePeak(std::atomic<int64_t>& peak, int64_t now) {
+        for (int64_t p = peak.load(std::memory_order_relaxed);
+             now > p && !peak.compare_exchange_weak(p, now, std::memory_order_relaxed); ) {}
+    }
+
+    void Charge(Counter& c, int64_t bytes, int allocations) {
+        const int64_t now = c.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        if (allocations) c.allocations.fetch_add(allocations, std::memory_order_relaxed);
+        if (bytes > 0) RaisePeak(c.peak, now);
+    }
+
+    uint64_t Load(const std::atomic<int64_t>& v) {
+        const int64_t x = v.load(std::memory_order_relaxed);
+        return x > 0 ? (uint64_t)x : 0;
+    }
+}
+
+void MemoryStats::Add(EuclidMemoryCategory c, int64_t bytes, int allocations) {
+    if (c < 0 || c >= EUCLID_MEM_CATEGORY_COUNT) return;
+    Charge(sCategories[c], bytes, allocations);
+    Charge(sTotals[(int)c >= EUCLID_MEM_FIRST_CPU], bytes, 0);
+}
+
+void MemoryStats::Get(EuclidMemoryStats& out) {
+    for (int i = 0; i < EUCLID_MEM_CATEGORY_COUNT; ++i) {
+        out.categories[i].bytes       = Load(sCategories[i].bytes);
+        out.categories[i].peak_bytes  = Load(sCategories[i].peak);
+        out.categories[i].allocations = Load(sCategories[i].allocations);
+    }
+    out.gpu_bytes      = Load(sTotals[0].bytes);
+    out.gpu_peak_bytes = Load(sTotals[0].peak);
+    out.cpu_bytes      = Load(sTotals[1].bytes);
+    out.cpu_peak_bytes = Load(sTotals[1].peak);
+}
+
+void MemoryStats::ResetPeaks() {
+    for (Counter& c : sCategories) c.peak.store(c.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    for (Counter& c : sTotals)     c.peak.store(c.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+}
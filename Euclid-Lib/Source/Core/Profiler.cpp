@@ -0,0 +1,267 @@
+#include "Profiler.hpp"
+#include "MemoryStats.hpp"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Euclid
+{
+namespace {
+    constexpr uint32_t kRecordsPerThread = 1u << 16;   // 2 MB per recording thread
+    constexpr uint32_t kGpuTidOffset     = 100000;     // GPU tracks sort after the threads
+    constexpr size_t   kMaxThreadBuffers = 256;        // past that, new threads' zones are dropped
+
+    struct Rec {
+        const char* name;
+        uint64_t    start, end;
+        Profiler::Track track;
+    };
+
+    // One writer (its thread). state = epoch << 32 | count, so the exporter never
+    // mistakes records left over from an earlier export for new ones.
+    struct ThreadBuffer {
+        std::unique_ptr<Rec[]> recs{ new Rec[kRecordsPerThread] };
+        std::atomic<uint64_t>  state{0};
+        uint32_t    tid = 0;
+        std::string name;    // sRegistryMutex
+        MemoryCharge mem{EUCLID_MEM_CPU_DIAGNOSTICS};
+    };
+
+    std::mutex                                 sRegistryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> sBuffers;    // never shrinks; exited threads' go to sFree
+    std::vector<ThreadBuffer*>                 sFree;       // sRegistryMutex
+    std::mutex                                 sExportMutex;
+    std::atomic<uint32_t>                      sEpoch{1};
+    std::atomic<uint64_t>                      sDropped{0};
+    std::atomic<uint64_t>                      sOriginNs{0};
+
+    // Hands the buffer back when its thread exits, so pools that come and go
+    // (one per sequence export) reuse buffers instead of piling up new ones
+    struct BufferOwner {
+        ThreadBuffer* buffer = nullptr;
+        ~BufferOwner() {
+            if (!buffer) return;
+            std::lock_guard<std::mutex> lock(sRegistryMutex);
+            sFree.push_back(buffer);
+        }
+    };
+    thread_local BufferOwner tOwner;
+
+    // nullptr once kMaxThreadBuffers are all taken
+    ThreadBuffer* Mine() {
+        if (tOwner.buffer) return tOwner.buffer;
+        std::lock_guard<std::mutex> lock(sRegistryMutex);
+        // a buffer still holding zones of the running capture waits for the export
+        const uint64_t epoch = sEpoch.load(std::memory_order_acquire);
+        auto it = std::find_if(sFree.begin(), sFree.end(), [&](ThreadBuffer* b) {
+            return (b->state.load(std::memory_order_acquire) >> 32) != epoch;
+        });
+        ThreadBuffer* b = nullptr;
+        if (it != sFree.end()) {
+            b = *it;
+            sFree.erase(it);
+        } else {
+            if (sBuffers.size() >= kMaxThreadBuffers) return nullptr;
+            sBuffers.push_back(std::make_unique<ThreadBuffer>());
+            b = sBuffers.back().get();
+            b->mem.Set(kRecordsPerThread * sizeof(Rec));
+            b->tid = (uint32_t)sBuffers.size();
+        }
+        b->name = "Thread " + std::to_string(b->tid);
+        return tOwner.buffer = b;
+    }
+
+    void WriteEscaped(FILE* f, const char* s) {
+        for (; *s; ++s) {
+            if (*s == '"' || *s == '\\') std::fputc('\\', f);
+            if ((unsigned char)*s >= 0x20) std::fputc(*s, f);
+        }
+    }
+}
+
+std::atomic<bool> Profiler::sEnabled{false};
+
+uint64_t Profiler::NowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Profiler::SetEnabled(bool on) {
+    if (on && !sEnabled.load()) {
+        // a fresh capture: drop whatever an earlier one left behind
+        std::lock_guard<std::mutex> lock(sExportMutex);
+        sEpoch.fetch_add(1, std::memory_order_acq_rel);
+        sDropped = 0;
+        sOriginNs = NowNs();
+    }
+    sEnabled.store(on, std::memory_order_relaxed);
+}
+
+void Profiler::Record(const char* name, uint64_t startNs, uint64_t endNs, Track track) {
+    ThreadBuffer* b = Mine();
+    if (!b) { sDropped.fetch_add(1, std::memory_order_relaxed); return; }
+    const uint64_t epoch = sEpoch.load(std::memory_order_acquire);
+    const uint64_t s = b->state.load(std::memory_order_relaxed);
+    const uint32_t n = (s >> 32) == epoch ? (uint32_t)s : 0;
+    if (n >= kRecordsPerThread) { sDropped.fetch_add(1, std::memory_order_relaxed); return; }
+    b->recs[n] = { name, startNs, endNs, track };
+    b->state.store((epoch << 32) | (n + 1), std::memory_order_release);
+}
+
+void Profiler::SetThreadName(const char* name) {
+    ThreadBuffer* b = Mine();
+    if (!b) return;
+    std::lock_guard<std::mutex> lock(sRegistryMutex);
+    b->name = name ? name : "";
+}
+
+uint64_t Profiler::Dropped() { return sDropped.load(std::memory_order_relaxed); }
+
+bool Profiler::ExportChromeTrace(const char* path) {
+    std::lock_guard<std::mutex> exportLock(sExportMutex);
+    FILE* f = std::fopen(path, "wb");
+    if (!f) return false;
+
+    const uint64_t epoch  = sEpoch.load(std::memory_order_acquire);
+    const uint64_t origin = sOriginNs.load();
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+    bool first = true;
+    auto sep = [&] { if (!first) std::fputs(",\n", f); first = false; };
+
+    std::lock_guard<std::mutex> lock(sRegistryMutex);
+    for (const auto& b : sBuffers) {
+        const uint64_t s = b->state.load(std::memory_order_acquire);
+        const uint32_t n = (s >> 32) == epoch ? (uint32_t)s : 0;
+        if (!n) continue;
+
+        bool gpu = false;
+        for (uint32_t i = 0; i < n; ++i) {
+            const Rec& r = b->recs[i];
+            // zones that started before the capture (or GPU clock skew) clamp to its start
+            const uint64_t start = r.start > origin ? r.start - origin : 0;
+            const uint64_t end   = r.end   > origin ? r.end   - origin : 0;
+            gpu |= r.track == kGpu;
+            sep();
+            std::fputs("{\"name\":\"", f); WriteEscaped(f, r.name);
+            std::fprintf(f, "\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                         r.track == kGpu ? "gpu" : "cpu", b->tid + (r.track == kGpu ? kGpuTidOffset : 0),
+                         double(start) * 1e-3, double(end > start ? end - start : 0) * 1e-3);
+        }
+        sep();
+        std::fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", b->tid);
+        WriteEscaped(f, b->name.c_str());
+        std::fputs("\"}}", f);
+        if (gpu) {
+            sep();
+            std::fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"GPU (", b->tid + kGpuTidOffset);
+            WriteEscaped(f, b->name.c_str());
+            std::fputs(")\"}}", f);
+        }
+    }
+    std::fprintf(f, "\n],\"otherData\":{\"dropped_zones\":%llu}}\n", (unsigned long long)sDropped.load());
+    const bool ok = std::fclose(f) == 0;
+
+    // start over: writers notice the new epoch on their next zone
+    sEpoch.fetch_add(1, std::memory_order_acq_rel);
+    sDropped = 0;
+    sOriginNs = NowNs();
+    return ok;
+}
+
+// -------- GpuProfiler --------
+GpuProfiler::~GpuProfiler() {
+    if (!mCreated) return;
+    for (Zone& z : mZones) glDeleteQueries(2, z.query);
+}
+
+int GpuProfiler::PassIndex(const char* name) {
+    for (int i = 0; i < mPassCount; ++i)
+        if (mPasses[i].name == name || std::strcmp(mPasses[i].name, name) == 0) return i;
+    if (mPassCount == kMaxPasses) return -1;
+    mPasses[mPassCount].name = name;
+    return mPassCount++;
+}
+
+int GpuProfiler::Begin(const char* name) {
+    if (!Profiler::Enabled() && !mLive) return -1;
+    if (!mCreated) {
+        for (Zone& z : mZones) glGenQueries(2, z.query);
+        mCreated = true;
+    }
+    Zone& z = mZones[mHead];
+    if (z.state != 0) return -1;   // results are not coming back fast enough
+    z.name = name;
+    z.state = 1;
+    z.pass = (int8_t)(mLive ? PassIndex(name) : -1);
+    z.frame = mFrame;
+    z.cpuStart = Profiler::NowNs();
+    glQueryCounter(z.query[0], GL_TIMESTAMP);
+    const int id = mHead;
+    mHead = (mHead + 1) % kMaxZones;
+    return id;
+}
+
+void GpuProfiler::End(int zone) {
+    Zone& z = mZones[zone];
+    glQueryCounter(z.query[1], GL_TIMESTAMP);
+    z.state = 2;
+    if (z.pass >= 0) mPasses[z.pass].cpuNs += Profiler::NowNs() - z.cpuStart;
+}
+
+void GpuProfiler::Collect() {
+    // CPU totals are complete as soon as the frame is
+    for (int i = 0; i < mPassCount; ++i) {
+        mPasses[i].cpuMs = double(mPasses[i].cpuNs) * 1e-6;
+        mPasses[i].cpuNs = 0;
+    }
+    ++mFrame;
+    if (!mCreated) return;
+
+    // GPU clock -> CPU clock, refreshed now and then against drift
+    const uint64_t now = Profiler::NowNs();
+    if (now - mCalibratedAt > 1000000000ull) {
+        GLint64 gpuNow = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+        mGpuToCpuNs = (int64_t)Profiler::NowNs() - (int64_t)gpuNow;
+        mCalibratedAt = now;
+    }
+
+    // in order, and only what is already done: never waits on the GPU
+    while (mZones[mTail].state == 2) {
+        Zone& z = mZones[mTail];
+        GLint ready = 0;
+        glGetQueryObjectiv(z.query[1], GL_QUERY_RESULT_AVAILABLE, &ready);
+        if (!ready) break;
+        GLuint64 t0 = 0, t1 = 0;
+        glGetQueryObjectui64v(z.query[0], GL_QUERY_RESULT, &t0);
+        glGetQueryObjectui64v(z.query[1], GL_QUERY_RESULT, &t1);
+        if (z.frame != mGpuFrame) {
+            // first result of a newer frame: the previous one is all in
+            for (int i = 0; i < mPassCount; ++i) {
+                mPasses[i].gpuMs = double(mPasses[i].gpuNs) * 1e-6;
+                mPasses[i].gpuNs = 0;
+            }
+            mGpuFrame = z.frame;
+        }
+        if (z.pass >= 0 && t1 > t0) mPasses[z.pass].gpuNs += t1 - t0;
+        if (Profiler::Enabled())
+            Profiler::Record(z.name, (uint64_t)((int64_t)t0 + mGpuToCpuNs), (uint64_t)((int64_t)t1 + mGpuToCpuNs), Profiler::kGpu);
+        z.state = 0;
+        mTail = (mTail + 1) % kMaxZones;
+    }
+}
+
+int GpuProfiler::PassTimings(EuclidPassTiming* out, int max) const {
+    if (!out) return mPassCount;
+    const int n = std::min(max, mPassCount);
+    for (int i = 0; i < n; ++i) out[i] = { mPasses[i].name, mPasses[i].cpuMs, mPasses[i].gpuMs };
+    return n;
+}
+}
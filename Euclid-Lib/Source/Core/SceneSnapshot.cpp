@@ -0,0 +1,54 @@
+#include "SceneSnapshot.hpp"
+#include "Objects.hpp"
+
+namespace Euclid
+{
+void SceneSnapshot::Publish(const ObjectStore& objs) {
+    const uint32_t back = 1u - mFront.load();
+    if (mReaders[back].load() != 0) return;   // someone is still on last frame's copy
+
+    Buffer& b = mBuffers[back];
+    const Buffer& front = mBuffers[1u - back];
+    if (b.version == objs.Version() && b.changeSeq == objs.ChangeSeq()) {
+        // idle scene: both copies are already current
+        if (front.version == b.version && front.changeSeq == b.changeSeq) return;
+    } else {
+        const size_t n = objs.Count();
+        b.ids.assign(objs.Ids(), objs.Ids() + n);
+        b.types.assign(objs.Types(), objs.Types() + n);
+        b.transforms.assign(objs.Transforms(), objs.Transforms() + n);
+        b.seqs.assign(objs.Seqs(), objs.Seqs() + n);
+        b.world.assign(objs.Worlds(), objs.Worlds() + n);
+        b.version = objs.Version();
+        b.changeSeq = objs.ChangeSeq();
+        b.mem.Set(CapacityBytes(b.ids) + CapacityBytes(b.types) + CapacityBytes(b.transforms) +
+                  CapacityBytes(b.seqs) + CapacityBytes(b.world));
+    }
+    mFront.store(back);
+}
+
+uint32_t SceneSnapshot::Acquire(EuclidSceneView& out) {
+    // pin, then check it is still current; otherwise Publish may be writing it
+    uint32_t f;
+    for (;;) {
+        f = mFront.load();
+        mReaders[f].fetch_add(1);
+        if (mFront.load() == f) break;
+        mReaders[f].fetch_sub(1);
+    }
+    const Buffer& b = mBuffers[f];
+    out.version = b.version;
+    out.change_seq = b.changeSeq;
+    out.count = b.ids.size();
+    out.ids = b.ids.data();
+    out.types = b.types.data();
+    out.transforms = b.transforms.data();
+    out.seqs = b.seqs.data();
+    out.world_matrices = b.world.empty() ? nullptr : &b.world[0][0][0];
+    return f;
+}
+
+void SceneSnapshot::Release(uint32_t token) {
+    if (token < 2) mReaders[token].fetch_sub(1);
+}
+}
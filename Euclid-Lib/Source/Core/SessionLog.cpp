@@ -0,0 +1,156 @@
+#include "SessionLog.hpp"
+#include "InputQueue.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Euclid
+{
+namespace {
+    constexpr size_t   kFlushBytes = 1u << 20;
+    constexpr uint64_t kMaxString  = 1u << 16;
+}
+
+// -------- SessionWriter --------
+SessionWriter::Record& SessionWriter::Record::Var(uint64_t v) {
+    uint8_t b[10];
+    int n = 0;
+    do { b[n] = uint8_t(v & 0x7f); v >>= 7; if (v) b[n] |= 0x80; ++n; } while (v);
+    mW->Put(b, (size_t)n);
+    return *this;
+}
+
+SessionWriter::Record& SessionWriter::Record::Str(const char* s) {
+    const size_t n = s ? std::strlen(s) : 0;
+    Var(n);
+    return Bytes(s, n);
+}
+
+bool SessionWriter::Open(const char* path, int width, int height) {
+    Close();
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFile = path ? std::fopen(path, "wb") : nullptr;
+    if (!mFile) return false;
+
+    const uint32_t magic = kMagic, version = kVersion;
+    const int32_t  size[2] = { width, height };
+    mBuf.clear();
+    Put(&magic, sizeof(magic));
+    Put(&version, sizeof(version));
+    Put(size, sizeof(size));
+    mLastNs = InputQueue::NowNs();
+    mActive.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void SessionWriter::Close() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mActive.store(false, std::memory_order_relaxed);
+    if (!mFile) return;
+    Flush();
+    std::fclose(mFile);
+    mFile = nullptr;
+    mBuf = {};
+    mMem.Set(0);
+}
+
+SessionWriter::Record SessionWriter::Begin(EuclidRecordOp op) {
+    if (!Active()) return Record(nullptr, {});
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (!mFile) return Record(nullptr, {});
+
+    const uint64_t now = InputQueue::NowNs();
+    const uint64_t dt = now > mLastNs ? now - mLastNs : 0;
+    mLastNs = std::max(now, mLastNs);
+
+    Record r(this, std::move(lock));
+    r.U8((uint8_t)op).Var(dt);
+    return r;
+}
+
+void SessionWriter::Put(const void* p, size_t n) {
+    const auto* b = static_cast<const uint8_t*>(p);
+    mBuf.insert(mBuf.end(), b, b + n);
+    if (mBuf.size() >= kFlushBytes) Flush();
+}
+
+void SessionWriter::Flush() {
+    if (mFile && !mBuf.empty()) std::fwrite(mBuf.data(), 1, mBuf.size(), mFile);
+    mBuf.clear();
+    mMem.Set(CapacityBytes(mBuf));
+}
+
+// -------- SessionReader --------
+bool SessionReader::Open(const char* path) {
+    mData.clear();
+    mPos = 0;
+    mBad = false;
+    FILE* f = path ? std::fopen(path, "rb") : nullptr;
+    if (!f) return false;
+    uint8_t chunk[1 << 16];
+    for (size_t n; (n = std::fread(chunk, 1, sizeof(chunk), f)) > 0; ) mData.insert(mData.end(), chunk, chunk + n);
+    std::fclose(f);
+
+    uint32_t magic = 0, version = 0;
+    int32_t  size[2] = { 0, 0 };
+    const void* p;
+    if ((p = Bytes(sizeof(magic))))   std::memcpy(&magic, p, sizeof(magic));
+    if ((p = Bytes(sizeof(version)))) std::memcpy(&version, p, sizeof(version));
+    if ((p = Bytes(sizeof(size))))    std::memcpy(size, p, sizeof(size));
+    if (mBad || magic != SessionWriter::kMagic || version != SessionWriter::kVersion) return false;
+    mWidth = size[0];
+    mHeight = size[1];
+    return true;
+}
+
+bool SessionReader::Next(EuclidRecordOp& op, uint64_t& dtNs) {
+    if (mBad || mPos >= mData.size()) return false;
+    op = (EuclidRecordOp)U8();
+    dtNs = Var();
+    if (op <= 0 || op >= EUCLID_REC_OP_COUNT) mBad = true;
+    return !mBad;
+}
+
+uint8_t SessionReader::U8() {
+    const void* p = Bytes(1);
+    return p ? *static_cast<const uint8_t*>(p) : 0;
+}
+
+uint64_t SessionReader::Var() {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (mPos >= mData.size()) { mBad = true; return 0; }
+        const uint8_t b = mData[mPos++];
+        v |= uint64_t(b & 0x7f) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    mBad = true;
+    return 0;
+}
+
+float SessionReader::F32() {
+    float v = 0.0f;
+    if (const void* p = Bytes(sizeof(v))) std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+double SessionReader::F64() {
+    double v = 0.0;
+    if (const void* p = Bytes(sizeof(v))) std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+const void* SessionReader::Bytes(size_t n) {
+    if (mBad || n > mData.size() - mPos) { mBad = true; return nullptr; }
+    const void* p = mData.data() + mPos;
+    mPos += n;
+    return p;
+}
+
+std::string SessionReader::Str() {
+    const uint64_t n = Var();
+    if (n > kMaxString) { mBad = true; return {}; }
+    const void* p = Bytes((size_t)n);
+    return p ? std::string(static_cast<const char*>(p), (size_t)n) : std::string();
+}
+}
@@ -4,8 +4,8 @@
 
 namespace Euclid
 {
-void Core::InitShader() {
-    mainVertex.Init(GL_VERTEX_SHADER,
+namespace {
+    constexpr const char* kMainVS =
     R"(
     #version 330 core
     layout (location = 0) in vec3 aPos;
@@ -22,9 +22,9 @@ void Core::InitShader() {
         gl_Position = uProjection * uView * uModel * vec4(aPos, 1.0);
         vColor = aColor;
     }
-    )");
+    )";
 
-    mainFragment.Init(GL_FRAGMENT_SHADER,
+    constexpr const char* kMainFS =
     R"(
     #version 330 core
     in vec3 vColor;
@@ -34,9 +34,9 @@ void Core::InitShader() {
     {
         FragColor = vec4(vColor, 1.0);
     }
-    )");
+    )";
     
-    gridVertex.Init(GL_VERTEX_SHADER,
+    constexpr const char* kGridVS =
     R"(
     #version 330 core
     // Fullscreen triangle — no VAO data needed
@@ -53,9 +53,9 @@ void Core::InitShader() {
         v_ndc = verts[gl_VertexID];
     }
 
-    )");
+    )";
 
-    gridFragment.Init(GL_FRAGMENT_SHADER,
+    constexpr const char* kGridFS =
     R"(
     #version 330 core
     in vec2 v_ndc;
@@ -179,9 +179,9 @@ void Core::InitShader() {
 
         FragColor = vec4(col, alpha);
     }
-    )");
+    )";
     
-    translationVertex.Init(GL_VERTEX_SHADER,
+    constexpr const char* kTranslationVS =
     R"(
     #version 330 core
     layout (location=0) in vec3 aStartWS;   // baked at origin (0,0,0)
@@ -229,9 +229,9 @@ void Core::InitShader() {
         gl_Position = vec4(ndc * P.w, P.z, P.w);
         vColor = aColor;
     }
-    )");
+    )";
 
-    translationFragment.Init(GL_FRAGMENT_SHADER,
+    constexpr const char* kTranslationFS =
     R"(
     #version 330 core
     in vec3 vColor;
@@ -240,9 +240,9 @@ void Core::InitShader() {
     void main(){
         FragColor = vec4(vColor, 1.0); // opaque lines
     }
-    )");
+    )";
     
-    rotationVertex.Init(GL_VERTEX_SHADER,
+    constexpr const char* kRotationVS =
     R"(
     #version 330 core
     uniform mat4  uViewProj;
@@ -288,17 +288,17 @@ void Core::InitShader() {
         gl_Position = vec4((ndc + offset) * P.w, P.z, P.w);
         vColor = uColor;
     }
-    )");
+    )";
 
-    rotationFragment.Init(GL_FRAGMENT_SHADER,
+    constexpr const char* kRotationFS =
     R"(
     #version 330 core
     in vec3 vColor;
     out vec4 FragColor;
     void main(){ FragColor = vec4(vColor, 1.0); }
-    )");
+    )";
     
-    transformationVertex.Init(GL_VERTEX_SHADER,
+    constexpr const char* kTransformationVS =
     R"(
     #version 330 core
     layout (location=0) in vec3 aCenterWS;  // baked axis-end at origin (e.g., (L,0,0))
@@ -330,31 +330,30 @@ void Core::InitShader() {
         gl_Position = vec4(ndc * P.w, P.z, P.w);
         vColor = aColor;
     }
-    )");
+    )";
 
-    transformationFragment.Init(GL_FRAGMENT_SHADER,
+    constexpr const char* kTransformationFS =
     R"(
     #version 330 core
     in vec3 vColor;
     out vec4 FragColor;
     void main(){ FragColor = vec4(vColor, 1.0); }
-    )");
-    
-    // link programs
-    std::vector<unsigned int> mainShaderIDs = { mainVertex.GetID(), mainFragment.GetID() };
-    mainShader.Init(mainShaderIDs);
+    )";
+}
 
-    std::vector<unsigned int> gridShaderIDs = { gridVertex.GetID(), gridFragment.GetID() };
-    gridShader.Init(gridShaderIDs);
-    
-    std::vector<unsigned int> translationShaderIDs = { translationVertex.GetID(), translationFragment.GetID() };
-    translationShader.Init(translationShaderIDs);
-    
-    std::vector<unsigned int> rotationShaderIDs = { rotationVertex.GetID(), rotationFragment.GetID() };
-    rotationShader.Init(rotationShaderIDs);
-    
-    std::vector<unsigned int> transformationShaderIDs = { transformationVertex.GetID(), transformationFragment.GetID() };
-    transformationShader.Init(transformationShaderIDs);
+void Core::InitShader() {
+    mProgramCache.Init();
+
+    // the first frame only needs main + grid; queue both before waiting on either
+    const bool mainLoaded = mProgramCache.Begin(mainShader, "main", kMainVS, kMainFS);
+    const bool gridLoaded = mProgramCache.Begin(gridShader, "grid", kGridVS, kGridFS);
+
+    // Gizmos only show up once something is selected. With parallel compile the driver
+    // works on them in the background from here; otherwise they wait for first use.
+    if (mParallelCompile) BeginGizmoPrograms();
+
+    if (!mainLoaded) mProgramCache.Finish(mainShader, "main", kMainVS, kMainFS);
+    if (!gridLoaded) mProgramCache.Finish(gridShader, "grid", kGridVS, kGridFS);
 
     // create dummy VAO (core profile needs some VAO bound)
     glGenVertexArrays(1, &mDummyVAO);
@@ -372,18 +371,29 @@ void Core::InitShader() {
     glUniform3f(glGetUniformLocation(gridShader.GetID(),"uAxisZColor"), 0.35f,0.65f,0.95f);
     glUniform3f(glGetUniformLocation(gridShader.GetID(),"uBgColor"),    0.06f,0.07f,0.08f);
     glUseProgram(0);
-    
-    BuildTranslationGizmo(glm::vec3(0), mGizmoLength);
-    BuildScaleTips(glm::vec3(0), mGizmoLength);
-    
-
-    glUniform1f (glGetUniformLocation(translationShader.GetID(),"uLength"), mGizmoLength);
-    glUniform1f (glGetUniformLocation(translationShader.GetID(),"uBakedLength"), 2.0f); // your baked L
-    
-
-    //glUniform3fv(glGetUniformLocation(transformationShader.GetID(),"uOrigin"), 1, &originWS[0]);
+}
+void Core::BeginGizmoPrograms() {
+    if (mGizmoProgramsStarted) return;
+    mGizmoPending[0] = !mProgramCache.Begin(translationShader,    "translation",    kTranslationVS,    kTranslationFS);
+    mGizmoPending[1] = !mProgramCache.Begin(rotationShader,       "rotation",       kRotationVS,       kRotationFS);
+    mGizmoPending[2] = !mProgramCache.Begin(transformationShader, "transformation", kTransformationVS, kTransformationFS);
+    mGizmoProgramsStarted = true;
+}
+void Core::FinishGizmoPrograms() {
+    BeginGizmoPrograms();
+    if (mGizmoPending[0]) mProgramCache.Finish(translationShader,    "translation",    kTranslationVS,    kTranslationFS);
+    if (mGizmoPending[1]) mProgramCache.Finish(rotationShader,       "rotation",       kRotationVS,       kRotationFS);
+    if (mGizmoPending[2]) mProgramCache.Finish(transformationShader, "transformation", kTransformationVS, kTransformationFS);
+    mGizmoPending[0] = mGizmoPending[1] = mGizmoPending[2] = false;
+
+    glUseProgram(translationShader.GetID());
+    glUniform1f(glGetUniformLocation(translationShader.GetID(),"uLength"), mGizmoLength);
+    glUniform1f(glGetUniformLocation(translationShader.GetID(),"uBakedLength"), 2.0f); // your baked L
+
+    glUseProgram(transformationShader.GetID());
     glUniform1f(glGetUniformLocation(transformationShader.GetID(),"uLength"), mGizmoLength);
     glUniform1f(glGetUniformLocation(transformationShader.GetID(),"uBakedLength"), 2.0f);
+    glUseProgram(0);
 }
 void Core::UseShader() {
     mainShader.Use();
@@ -0,0 +1,53 @@
+#include "ThreadPool.hpp"
+
+namespace Euclid
+{
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+    mWorkers.reserve(threads);
+    for (int i = 0; i < threads; ++i) mWorkers.emplace_back([this]{ WorkerLoop(); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mJobCv.notify_all();
+    for (auto& t : mWorkers) t.join();
+}
+
+void ThreadPool::Submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJobs.push_back(std::move(job));
+    }
+    mJobCv.notify_one();
+}
+
+void ThreadPool::Wait() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mIdleCv.wait(lock, [this]{ return mJobs.empty() && mActive == 0; });
+}
+
+void ThreadPool::WorkerLoop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mJobCv.wait(lock, [this]{ return mStop || !mJobs.empty(); });
+            if (mStop && mJobs.empty()) return;
+            job = std::move(mJobs.front());
+            mJobs.pop_front();
+            ++mActive;
+        }
+        job();
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            --mActive;
+            if (mJobs.empty() && mActive == 0) mIdleCv.notify_all();
+        }
+    }
+}
+}
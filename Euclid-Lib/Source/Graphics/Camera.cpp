@@ -62,6 +62,9 @@ void Camera::SetPitch(float pitch) {
     UpdateCameraVectors();
 }
 
+float Camera::GetYaw() const   { return mYaw; }
+float Camera::GetPitch() const { return mPitch; }
+
 void Camera::SetMouseSensitivity(float s) { mMouseSensitivity = s; }
 void Camera::SetScrollSpeed(float s)      { mScrollSpeed = s; }
 void Camera::SetMovementSpeed(float s)    { mMovementSpeed = s; }
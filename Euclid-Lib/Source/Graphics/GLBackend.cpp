@@ -0,0 +1,326 @@
+#include "GLBackend.hpp"
+#include "MemoryStats.hpp"
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+// Every GL entry point the engine calls. Add new ones here, or they bypass counting
+// and the null backend hands glad a nullptr for them (Scripts/Check-GLCalls.sh finds strays).
+#define EUCLID_GL_CALLS(X) \
+    X(glAttachShader) X(glBindBuffer) X(glBindBufferBase) X(glBindFramebuffer) X(glBindImageTexture) \
+    X(glBindRenderbuffer) X(glBindTexture) X(glBindVertexArray) X(glBufferData) X(glBufferSubData) \
+    X(glCheckFramebufferStatus) X(glClear) X(glClearBufferData) X(glClearColor) X(glClientWaitSync) \
+    X(glCompileShader) X(glCopyBufferSubData) X(glCopyTexSubImage2D) X(glCreateProgram) \
+    X(glCreateShader) X(glDebugMessageCallback) X(glDebugMessageControl) X(glDeleteBuffers) \
+    X(glDeleteFramebuffers) X(glDeleteProgram) X(glDeleteQueries) X(glDeleteRenderbuffers) \
+    X(glDeleteShader) X(glDeleteSync) X(glDeleteTextures) X(glDeleteVertexArrays) X(glDepthFunc) \
+    X(glDepthMask) X(glDetachShader) X(glDisable) X(glDisableVertexAttribArray) X(glDispatchCompute) \
+    X(glDrawArrays) X(glDrawArraysInstanced) X(glDrawElements) X(glDrawElementsInstanced) \
+    X(glEnable) X(glEnableVertexAttribArray) X(glFenceSync) X(glFinish) X(glFramebufferRenderbuffer) \
+    X(glFramebufferTexture2D) X(glFrontFace) X(glGenBuffers) X(glGenFramebuffers) X(glGenQueries) \
+    X(glGenRenderbuffers) X(glGenTextures) X(glGenVertexArrays) X(glGetBufferParameteriv) \
+    X(glGetBufferSubData) X(glGetError) X(glGetInteger64v) X(glGetIntegerv) X(glGetProgramBinary) \
+    X(glGetProgramInfoLog) X(glGetProgramiv) X(glGetQueryObjectiv) X(glGetQueryObjectui64v) \
+    X(glGetShaderInfoLog) X(glGetShaderiv) X(glGetString) X(glGetStringi) X(glGetUniformLocation) \
+    X(glLinkProgram) X(glMapBufferRange) X(glMemoryBarrier) X(glMultiDrawElements) \
+    X(glMultiDrawElementsIndirect) X(glObjectLabel) X(glPixelStorei) X(glPopDebugGroup) \
+    X(glProgramBinary) X(glProgramParameteri) X(glPushDebugGroup) X(glQueryCounter) X(glReadPixels) \
+    X(glRenderbufferStorage) X(glScissor) X(glShaderSource) X(glTexImage2D) X(glTexParameteri) \
+    X(glTexStorage2D) X(glUniform1f) X(glUniform1i) X(glUniform1ui) X(glUniform2f) X(glUniform2fv) \
+    X(glUniform2i) X(glUniform3f) X(glUniform3fv) X(glUniform4fv) X(glUniformMatrix4fv) \
+    X(glUnmapBuffer) X(glUseProgram) X(glVertexAttribDivisor) X(glVertexAttribIPointer) \
+    X(glVertexAttribPointer) X(glViewport) X(glViewportArrayv)
+
+namespace Euclid
+{
+namespace {
+    enum Call : uint32_t {
+#define EUCLID_GL_ENUM(fn) k_##fn,
+        EUCLID_GL_CALLS(EUCLID_GL_ENUM)
+#undef EUCLID_GL_ENUM
+        kCallCount
+    };
+
+    const char* const kNames[kCallCount] = {
+#define EUCLID_GL_NAME(fn) #fn,
+        EUCLID_GL_CALLS(EUCLID_GL_NAME)
+#undef EUCLID_GL_NAME
+    };
+
+    void** const kSlots[kCallCount] = {
+#define EUCLID_GL_SLOT(fn) reinterpret_cast<void**>(&glad_##fn),
+        EUCLID_GL_CALLS(EUCLID_GL_SLOT)
+#undef EUCLID_GL_SLOT
+    };
+
+    constexpr size_t kMaxCommands = 1u << 20;
+
+    std::atomic<uint64_t> sCounts[kCallCount];
+    void*                 sReal[kCallCount];          // driver entry points while capturing
+    std::atomic<bool>     sRecord{false};
+    GLBackend::Capture    sCapture = GLBackend::Capture::Off;
+    std::mutex            sCaptureMutex;
+
+    std::mutex                      sLogMutex;
+    std::vector<GLBackend::Command> sLog;
+    size_t                          sLogRead = 0;      // taken so far
+    uint64_t                        sLogDropped = 0;
+    MemoryCharge                    sLogMem{EUCLID_MEM_CPU_DIAGNOSTICS};
+
+    GLBackend::Category CategoryOf(const char* n) {
+        auto starts = [n](const char* p) { return std::strncmp(n, p, std::strlen(p)) == 0; };
+        if (starts("glDraw") || starts("glMultiDraw") || starts("glDispatch")) return GLBackend::kDraw;
+        if (starts("glBind") || starts("glUseProgram"))                        return GLBackend::kBind;
+        if (starts("glUniform"))                                               return GLBackend::kUniform;
+        if (starts("glBufferData") || starts("glBufferSubData") || starts("glTexImage") ||
+            starts("glMapBuffer") || starts("glReadPixels"))                   return GLBackend::kUpload;
+        if (starts("glGet") || starts("glCheck") || starts("glClientWaitSync") || starts("glFinish"))
+                                                                               return GLBackend::kQuery;
+        if (starts("glEnable") || starts("glDisable") || starts("glDepth") || starts("glViewport") ||
+            starts("glScissor") || starts("glClearColor") || starts("glPixelStore") || starts("glFrontFace") ||
+            starts("glVertexAttrib"))                                          return GLBackend::kState;
+        return GLBackend::kOther;
+    }
+
+    const std::array<GLBackend::Category, kCallCount> kCategories = [] {
+        std::array<GLBackend::Category, kCallCount> c{};
+        for (uint32_t i = 0; i < kCallCount; ++i) c[i] = CategoryOf(kNames[i]);
+        return c;
+    }();
+
+    template <typename T>
+    uint64_t Pack(T v) {
+        if constexpr (std::is_pointer_v<T>) return (uint64_t)(uintptr_t)v;
+        else if constexpr (std::is_floating_point_v<T>) {
+            const float f = (float)v;
+            uint32_t bits;
+            std::memcpy(&bits, &f, sizeof(bits));
+            return bits;
+        }
+        else return (uint64_t)v;
+    }
+
+    template <typename... A>
+    void Log(uint32_t call, A... a) {
+        GLBackend::Command c{ call, (uint32_t)sizeof...(A), {0, 0, 0, 0} };
+        uint32_t i = 0;
+        ((i < 4 ? (void)(c.args[i++] = Pack(a)) : (void)0), ...);
+        std::lock_guard<std::mutex> lock(sLogMutex);
+        if (sLog.size() - sLogRead < kMaxCommands) {
+            const size_t cap = sLog.capacity();
+            sLog.push_back(c);
+            if (sLog.capacity() != cap) sLogMem.Set(CapacityBytes(sLog));
+        }
+        else ++sLogDropped;
+    }
+
+    // -------- Null results --------
+    // Just enough for Core to initialize and run its frame loop: names are handed out,
+    // shaders always compile, framebuffers are complete, fences already signaled.
+    std::atomic<GLuint> sNextName{1};
+    thread_local GLint  tViewport[4] = {0, 0, 0, 0};
+
+    void GenNames(GLsizei n, GLuint* out) {
+        for (GLsizei i = 0; out && i < n; ++i) out[i] = sNextName.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    struct Custom { static constexpr bool kCustom = true; };
+    template <uint32_t Id> struct NullFn { static constexpr bool kCustom = false; };
+
+    template <> struct NullFn<k_glGenBuffers>       : Custom { static void Call(GLsizei n, GLuint* o) { GenNames(n, o); } };
+    template <> struct NullFn<k_glGenFramebuffers>  : Custom { static void Call(GLsizei n, GLuint* o) { GenNames(n, o); } };
+    template <> struct NullFn<k_glGenQueries>       : Custom { static void Call(GLsizei n, GLuint* o) { GenNames(n, o); } };
+    template <> struct NullFn<k_glGenRenderbuffers> : Custom { static void Call(GLsizei n, GLuint* o) { GenNames(n, o); } };
+    template <> struct NullFn<k_glGenTextures>      : Custom { static void Call(GLsizei n, GLuint* o) { GenNames(n, o); } };
+    template <> struct NullFn<k_glGenVertexArrays>  : Custom { static void Call(GLsizei n, GLuint* o) { GenNames(n, o); } };
+    template <> struct NullFn<k_glCreateProgram>    : Custom { static GLuint Call() { GLuint n; GenNames(1, &n); return n; } };
+    template <> struct NullFn<k_glCreateShader>     : Custom { static GLuint Call(GLenum) { GLuint n; GenNames(1, &n); return n; } };
+
+    template <> struct NullFn<k_glGetShaderiv> : Custom {
+        static void Call(GLuint, GLenum pname, GLint* v) { if (v) *v = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0; }
+    };
+    template <> struct NullFn<k_glGetProgramiv> : Custom {
+        static void Call(GLuint, GLenum pname, GLint* v) { if (v) *v = (pname == GL_LINK_STATUS) ? GL_TRUE : 0; }
+    };
+    template <> struct NullFn<k_glGetIntegerv> : Custom {
+        static void Call(GLenum pname, GLint* v) {
+            if (!v) return;
+            switch (pname) {
+                case GL_MAX_VIEWPORT_DIMS:      v[0] = v[1] = 16384; break;
+                case GL_MAX_TEXTURE_SIZE:
+                case GL_MAX_RENDERBUFFER_SIZE:  v[0] = 16384; break;
+                case GL_MAJOR_VERSION:          v[0] = 4; break;
+                case GL_MINOR_VERSION:          v[0] = 5; break;
+                case GL_NUM_EXTENSIONS:         v[0] = 1; break;   // glad refuses a context with none
+                case GL_VIEWPORT:               std::memcpy(v, tViewport, sizeof(tViewport)); break;
+                default:                        v[0] = 0; break;
+            }
+        }
+    };
+    template <> struct NullFn<k_glViewport> : Custom {
+        static void Call(GLint x, GLint y, GLsizei w, GLsizei h) { tViewport[0] = x; tViewport[1] = y; tViewport[2] = w; tViewport[3] = h; }
+    };
+    template <> struct NullFn<k_glGetString> : Custom {
+        static const GLubyte* Call(GLenum name) {
+            switch (name) {
+                case GL_VENDOR:                   return (const GLubyte*)"Euclid";
+                case GL_RENDERER:                 return (const GLubyte*)"Euclid null backend";
+                case GL_VERSION:                  return (const GLubyte*)"4.5 Euclid null";
+                case GL_SHADING_LANGUAGE_VERSION: return (const GLubyte*)"4.50";
+                default:                          return (const GLubyte*)"";
+            }
+        }
+    };
+    template <> struct NullFn<k_glGetStringi> : Custom {
+        static const GLubyte* Call(GLenum, GLuint) { return (const GLubyte*)"GL_EUCLID_null_backend"; }
+    };
+    template <> struct NullFn<k_glGetShaderInfoLog> : Custom {
+        static void Call(GLuint, GLsizei size, GLsizei* len, GLchar* log) { if (len) *len = 0; if (log && size > 0) log[0] = 0; }
+    };
+    template <> struct NullFn<k_glGetProgramInfoLog> : Custom {
+        static void Call(GLuint, GLsizei size, GLsizei* len, GLchar* log) { if (len) *len = 0; if (log && size > 0) log[0] = 0; }
+    };
+    template <> struct NullFn<k_glCheckFramebufferStatus> : Custom {
+        static GLenum Call(GLenum) { return GL_FRAMEBUFFER_COMPLETE; }
+    };
+    template <> struct NullFn<k_glFenceSync> : Custom {
+        static GLsync Call(GLenum, GLbitfield) { return reinterpret_cast<GLsync>(uintptr_t(1)); }
+    };
+    template <> struct NullFn<k_glClientWaitSync> : Custom {
+        static GLenum Call(GLsync, GLbitfield, GLuint64) { return GL_ALREADY_SIGNALED; }
+    };
+    template <> struct NullFn<k_glMapBufferRange> : Custom {
+        static void* Call(GLenum, GLintptr, GLsizeiptr length, GLbitfield) {
+            thread_local std::vector<uint8_t> scratch;
+            scratch.resize((size_t)length);
+            return scratch.data();
+        }
+    };
+    template <> struct NullFn<k_glUnmapBuffer> : Custom { static GLboolean Call(GLenum) { return GL_TRUE; } };
+    template <> struct NullFn<k_glGetQueryObjectiv> : Custom {
+        static void Call(GLuint, GLenum pname, GLint* v) { if (v) *v = (pname == GL_QUERY_RESULT_AVAILABLE) ? 1 : 0; }
+    };
+
+    // -------- Hooks --------
+    template <uint32_t Id, typename Fn> struct Hook;
+    template <uint32_t Id, typename R, typename... A>
+    struct Hook<Id, R (APIENTRYP)(A...)> {
+        using Fn = R (APIENTRYP)(A...);
+
+        static R APIENTRY Forward(A... a) {
+            sCounts[Id].fetch_add(1, std::memory_order_relaxed);
+            if (sRecord.load(std::memory_order_relaxed)) Log(Id, a...);
+            return reinterpret_cast<Fn>(sReal[Id])(a...);
+        }
+        static R APIENTRY Null(A... a) {
+            sCounts[Id].fetch_add(1, std::memory_order_relaxed);
+            if (sRecord.load(std::memory_order_relaxed)) Log(Id, a...);
+            if constexpr (NullFn<Id>::kCustom) return NullFn<Id>::Call(a...);
+            else if constexpr (!std::is_void_v<R>) return R{};
+        }
+    };
+
+    void* const kForwardHooks[kCallCount] = {
+#define EUCLID_GL_FORWARD(fn) reinterpret_cast<void*>(&Hook<k_##fn, decltype(glad_##fn)>::Forward),
+        EUCLID_GL_CALLS(EUCLID_GL_FORWARD)
+#undef EUCLID_GL_FORWARD
+    };
+    void* const kNullHooks[kCallCount] = {
+#define EUCLID_GL_NULL(fn) reinterpret_cast<void*>(&Hook<k_##fn, decltype(glad_##fn)>::Null),
+        EUCLID_GL_CALLS(EUCLID_GL_NULL)
+#undef EUCLID_GL_NULL
+    };
+}
+
+void* GLBackend::NullProcAddress(const char* name) {
+    const int i = FindCall(name);
+    return i >= 0 ? kNullHooks[i] : nullptr;
+}
+
+bool GLBackend::NullLoaded() {
+    return *kSlots[k_glGetString] == kNullHooks[k_glGetString];
+}
+
+void GLBackend::SetCapture(Capture mode) {
+    std::lock_guard<std::mutex> lock(sCaptureMutex);
+    sRecord.store(mode == Capture::Record, std::memory_order_relaxed);
+    // the null hooks count already; wrapping them would count twice
+    const bool wrap = mode != Capture::Off && !NullLoaded();
+    const bool wrapped = sCapture != Capture::Off && *kSlots[k_glGetString] == kForwardHooks[k_glGetString];
+    if (wrap && !wrapped) {
+        for (uint32_t i = 0; i < kCallCount; ++i) {
+            sReal[i] = *kSlots[i];
+            if (sReal[i]) *kSlots[i] = kForwardHooks[i];   // functions the driver lacks stay null
+        }
+    } else if (!wrap && wrapped) {
+        for (uint32_t i = 0; i < kCallCount; ++i)
+            if (*kSlots[i] == kForwardHooks[i]) *kSlots[i] = sReal[i];
+    }
+    sCapture = mode;
+}
+
+GLBackend::Capture GLBackend::GetCapture() {
+    std::lock_guard<std::mutex> lock(sCaptureMutex);
+    return sCapture;
+}
+
+uint64_t GLBackend::CallCount(uint32_t call) {
+    return call < kCallCount ? sCounts[call].load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t GLBackend::CategoryCount(Category c) {
+    uint64_t n = 0;
+    for (uint32_t i = 0; i < kCallCount; ++i)
+        if (kCategories[i] == c) n += sCounts[i].load(std::memory_order_relaxed);
+    return n;
+}
+
+uint64_t GLBackend::TotalCount() {
+    uint64_t n = 0;
+    for (uint32_t i = 0; i < kCallCount; ++i) n += sCounts[i].load(std::memory_order_relaxed);
+    return n;
+}
+
+void GLBackend::ResetCounts() {
+    for (auto& c : sCounts) c.store(0, std::memory_order_relaxed);
+}
+
+size_t GLBackend::TakeCommands(Command* out, size_t max) {
+    std::lock_guard<std::mutex> lock(sLogMutex);
+    const size_t n = std::min(max, sLog.size() - sLogRead);
+    if (out && n) std::memcpy(out, sLog.data() + sLogRead, n * sizeof(Command));
+    sLogRead += n;
+    if (sLogRead == sLog.size()) { sLog.clear(); sLogRead = 0; sLogDropped = 0; }
+    else if (sLogRead > sLog.size() / 2) { sLog.erase(sLog.begin(), sLog.begin() + sLogRead); sLogRead = 0; }
+    return n;
+}
+
+size_t GLBackend::PendingCommands() {
+    std::lock_guard<std::mutex> lock(sLogMutex);
+    return sLog.size() - sLogRead;
+}
+
+uint64_t GLBackend::DroppedCommands() {
+    std::lock_guard<std::mutex> lock(sLogMutex);
+    return sLogDropped;
+}
+
+uint32_t GLBackend::CallTableSize() { return kCallCount; }
+
+const char* GLBackend::CallName(uint32_t call) {
+    return call < kCallCount ? kNames[call] : nullptr;
+}
+
+int GLBackend::FindCall(const char* name) {
+    if (!name) return -1;
+    for (uint32_t i = 0; i < kCallCount; ++i)
+        if (std::strcmp(kNames[i], name) == 0) return (int)i;
+    return -1;
+}
+}
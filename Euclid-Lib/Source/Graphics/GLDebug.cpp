@@ -0,0 +1,221 @@
+#include "GLDebug.hpp"
+#include "MemoryStats.hpp"
+#include "Renderer.hpp"
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Euclid
+{
+namespace {
+    constexpr size_t kMaxMessages = 512;   // distinct; repeats only bump a count
+    constexpr int    kMaxScopes   = 32;
+
+    struct Entry {
+        EuclidGLMessage msg;
+        std::string     text;
+    };
+
+    std::mutex                          sMutex;
+    std::vector<Entry>                  sLog;       // reserved up front: text pointers stay put
+    std::unordered_map<uint64_t, size_t> sIndex;    // dedup key -> sLog
+    EuclidGLDebugStats                  sStats{};
+    size_t                              sTextBytes = 0;
+    MemoryCharge                        sMem{EUCLID_MEM_CPU_DIAGNOSTICS};
+    std::atomic<uint64_t>               sFrame{0};
+    std::atomic<uint64_t>               sThisFrame{0};
+    EuclidGLMessageCallback             sCallback = nullptr;
+    void*                               sUser = nullptr;
+    EuclidGLMessageSeverity             sMinSeverity = EUCLID_GL_SEVERITY_LOW;
+
+    thread_local const char* tScopes[kMaxScopes];
+    thread_local int         tDepth = 0;
+
+    uint64_t Hash(const char* s, uint64_t h) {
+        for (; *s; ++s) { h ^= (uint8_t)*s; h *= 1099511628211ull; }
+        return h;
+    }
+
+    EuclidGLMessageSource SourceOf(GLenum s) {
+        switch (s) {
+            case GL_DEBUG_SOURCE_API:             return EUCLID_GL_MSG_SOURCE_API;
+            case GL_DEBUG_SOURCE_WINDOW_SYSTEM:   return EUCLID_GL_MSG_SOURCE_WINDOW_SYSTEM;
+            case GL_DEBUG_SOURCE_SHADER_COMPILER: return EUCLID_GL_MSG_SOURCE_SHADER_COMPILER;
+            case GL_DEBUG_SOURCE_THIRD_PARTY:     return EUCLID_GL_MSG_SOURCE_THIRD_PARTY;
+            case GL_DEBUG_SOURCE_APPLICATION:     return EUCLID_GL_MSG_SOURCE_APPLICATION;
+            default:                              return EUCLID_GL_MSG_SOURCE_OTHER;
+        }
+    }
+    EuclidGLMessageType TypeOf(GLenum t) {
+        switch (t) {
+            case GL_DEBUG_TYPE_ERROR:               return EUCLID_GL_MSG_ERROR;
+            case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return EUCLID_GL_MSG_DEPRECATED;
+            case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:  return EUCLID_GL_MSG_UNDEFINED;
+            case GL_DEBUG_TYPE_PORTABILITY:         return EUCLID_GL_MSG_PORTABILITY;
+            case GL_DEBUG_TYPE_PERFORMANCE:         return EUCLID_GL_MSG_PERFORMANCE;
+            case GL_DEBUG_TYPE_MARKER:              return EUCLID_GL_MSG_MARKER;
+            default:                                return EUCLID_GL_MSG_OTHER;
+        }
+    }
+    EuclidGLMessageSeverity SeverityOf(GLenum s) {
+        switch (s) {
+            case GL_DEBUG_SEVERITY_HIGH:   return EUCLID_GL_SEVERITY_HIGH;
+            case GL_DEBUG_SEVERITY_MEDIUM: return EUCLID_GL_SEVERITY_MEDIUM;
+            case GL_DEBUG_SEVERITY_LOW:    return EUCLID_GL_SEVERITY_LOW;
+            default:                       return EUCLID_GL_SEVERITY_NOTIFICATION;
+        }
+    }
+
+    void APIENTRY OnDriverMessage(GLenum source, GLenum type, GLuint id, GLenum severity,
+                                  GLsizei, const GLchar* message, const void*) {
+        // our own debug groups echo back as messages
+        if (type == GL_DEBUG_TYPE_PUSH_GROUP || type == GL_DEBUG_TYPE_POP_GROUP) return;
+        GLDebug::Report(SourceOf(source), TypeOf(type), SeverityOf(severity), id, message ? message : "");
+    }
+}
+
+std::atomic<int> GLDebug::sContexts{0};
+
+void GLDebug::LoadEntryPoints(Euclid_GetProcAddr loader) {
+    if (!loader || glad_glDebugMessageCallback || !HasGLExtension("GL_KHR_debug")) return;
+    // desktop KHR_debug uses the core names
+    glad_glDebugMessageCallback = (PFNGLDEBUGMESSAGECALLBACKPROC)loader("glDebugMessageCallback");
+    glad_glDebugMessageControl  = (PFNGLDEBUGMESSAGECONTROLPROC)loader("glDebugMessageControl");
+    glad_glObjectLabel          = (PFNGLOBJECTLABELPROC)loader("glObjectLabel");
+    glad_glPushDebugGroup       = (PFNGLPUSHDEBUGGROUPPROC)loader("glPushDebugGroup");
+    glad_glPopDebugGroup        = (PFNGLPOPDEBUGGROUPPROC)loader("glPopDebugGroup");
+}
+
+bool GLDebug::Attach(bool on) {
+    if (!glad_glDebugMessageCallback || !glad_glDebugMessageControl) return false;
+    if (on) {
+        glEnable(GL_DEBUG_OUTPUT);
+        glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);   // raised inside the offending call, on its thread
+        glDebugMessageCallback(OnDriverMessage, nullptr);
+        glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+        glDebugMessageControl(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_PUSH_GROUP, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+        glDebugMessageControl(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_POP_GROUP, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+        sContexts.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+        glDisable(GL_DEBUG_OUTPUT);
+        glDebugMessageCallback(nullptr, nullptr);
+        sContexts.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void GLDebug::Report(EuclidGLMessageSource source, EuclidGLMessageType type,
+                     EuclidGLMessageSeverity severity, uint32_t id, const char* text) {
+    const char* scope = tDepth > 0 ? tScopes[std::min(tDepth, kMaxScopes) - 1] : "";
+    const uint64_t frame = sFrame.load(std::memory_order_relaxed);
+    sThisFrame.fetch_add(1, std::memory_order_relaxed);
+
+    EuclidGLMessage first{};
+    EuclidGLMessageCallback cb = nullptr;
+    void* user = nullptr;
+    bool toStderr = false;
+    {
+        std::lock_guard<std::mutex> lock(sMutex);
+        ++sStats.total;
+        ++sStats.by_severity[severity];
+        if (type == EUCLID_GL_MSG_PERFORMANCE) ++sStats.performance;
+
+        // same message from the same place: one entry
+        uint64_t key = Hash(text, 1469598103934665603ull);
+        key = Hash(scope, key ^ ((uint64_t)source << 56 | (uint64_t)type << 48 | id));
+        auto it = sIndex.find(key);
+        if (it != sIndex.end()) {
+            EuclidGLMessage& m = sLog[it->second].msg;
+            ++m.count;
+            m.last_frame = frame;
+            return;
+        }
+        if (sLog.size() == kMaxMessages) { ++sStats.dropped; return; }
+        if (sLog.capacity() < kMaxMessages) sLog.reserve(kMaxMessages);
+
+        sLog.push_back({ EuclidGLMessage{ source, type, severity, id, 1, frame, frame, scope, nullptr }, text });
+        Entry& e = sLog.back();
+        e.msg.text = e.text.c_str();
+        sIndex.emplace(key, sLog.size() - 1);
+        sStats.unique = sLog.size();
+        sTextBytes += e.text.capacity();
+        sMem.Set(CapacityBytes(sLog) + sTextBytes);
+
+        first = e.msg;
+        if (sCallback && severity >= sMinSeverity) { cb = sCallback; user = sUser; }
+        toStderr = !sCallback && severity == EUCLID_GL_SEVERITY_HIGH;
+    }
+    if (cb) cb(&first, user);
+    else if (toStderr) std::fprintf(stderr, "Euclid GL%s%s: %s\n", *scope ? " in " : "", scope, text);
+}
+
+void GLDebug::EndFrame() {
+    const uint64_t n = sThisFrame.exchange(0, std::memory_order_relaxed);
+    sFrame.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(sMutex);
+    sStats.last_frame = n;
+}
+
+void GLDebug::SetCallback(EuclidGLMessageCallback cb, void* user, EuclidGLMessageSeverity minSeverity) {
+    std::lock_guard<std::mutex> lock(sMutex);
+    sCallback = cb;
+    sUser = user;
+    sMinSeverity = minSeverity;
+}
+
+int GLDebug::Messages(EuclidGLMessage* out, int max) {
+    std::lock_guard<std::mutex> lock(sMutex);
+    if (!out) return (int)sLog.size();
+    const int n = std::min(max, (int)sLog.size());
+    for (int i = 0; i < n; ++i) out[i] = sLog[i].msg;
+    return n;
+}
+
+void GLDebug::GetStats(EuclidGLDebugStats& out) {
+    std::lock_guard<std::mutex> lock(sMutex);
+    out = sStats;
+    out.frame = sFrame.load(std::memory_order_relaxed);
+}
+
+void GLDebug::Clear() {
+    std::lock_guard<std::mutex> lock(sMutex);
+    sLog.clear();
+    sIndex.clear();
+    sStats = {};
+    sTextBytes = 0;
+    sMem.Set(CapacityBytes(sLog));
+}
+
+// -------- Scopes and labels --------
+void GLDebug::PushScope(const char* name) {
+    if (tDepth < kMaxScopes) tScopes[tDepth] = name;
+    ++tDepth;
+}
+
+void GLDebug::PopScope() {
+    if (tDepth > 0) --tDepth;
+}
+
+void GLDebug::PushGroup(const char* name) {
+    if (glad_glPushDebugGroup) glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name);
+}
+
+void GLDebug::PopGroup() {
+    if (glad_glPopDebugGroup) glPopDebugGroup();
+}
+
+void GLDebug::Label(unsigned type, unsigned name, const char* label, const char* suffix) {
+    if (!glad_glObjectLabel || !name || !label) return;
+    if (!suffix) { glObjectLabel(type, name, -1, label); return; }
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "%s %s", label, suffix);
+    glObjectLabel(type, name, -1, buf);
+}
+}
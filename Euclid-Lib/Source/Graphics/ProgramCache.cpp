@@ -0,0 +1,181 @@
+#include "Graphics.hpp"
+#include "GLDebug.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Euclid
+{
+namespace {
+    constexpr uint32_t kMagic     = 0x31425045;       // "EPB1"
+    constexpr uint32_t kMaxBinary = 64u << 20;        // anything bigger is a corrupt file
+
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t format;
+        uint64_t key;
+        uint32_t length;
+        uint32_t reserved;
+    };
+
+    std::mutex  sDirMutex;
+    bool        sDirSet = false;   // SetDirectory was called
+    std::string sDir;
+
+    unsigned long ProcessId() {
+#if defined(_WIN32)
+        return (unsigned long)_getpid();
+#else
+        return (unsigned long)getpid();
+#endif
+    }
+
+    uint64_t Fnv1a(const void* data, size_t len, uint64_t h) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < len; ++i) { h ^= p[i]; h *= 0x100000001b3ull; }
+        return h;
+    }
+    // hashes the terminator too, so "ab"+"c" != "a"+"bc"
+    uint64_t HashStr(const char* s, uint64_t h) {
+        return s ? Fnv1a(s, std::strlen(s) + 1, h) : Fnv1a("", 1, h);
+    }
+
+    std::string DefaultDir() {
+        if (const char* env = std::getenv("EUCLID_SHADER_CACHE")) return env;   // "" disables
+#if defined(_WIN32)
+        if (const char* base = std::getenv("LOCALAPPDATA")) return std::string(base) + "\\Euclid\\ShaderCache";
+#elif defined(__APPLE__)
+        if (const char* home = std::getenv("HOME")) return std::string(home) + "/Library/Caches/Euclid/Shaders";
+#else
+        if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) return std::string(xdg) + "/euclid/shaders";
+        if (const char* home = std::getenv("HOME")) return std::string(home) + "/.cache/euclid/shaders";
+#endif
+        return {};
+    }
+}
+
+void ProgramCache::SetDirectory(const char* dir) {
+    std::lock_guard<std::mutex> lock(sDirMutex);
+    sDirSet = dir != nullptr;
+    sDir = dir ? dir : "";
+}
+
+void ProgramCache::Init() {
+    mEnabled = false;
+    mHits = mMisses = 0;
+    {
+        std::lock_guard<std::mutex> lock(sDirMutex);
+        mDir = sDirSet ? sDir : DefaultDir();
+    }
+    if (mDir.empty()) return;
+    if (!glGetProgramBinary || !glProgramBinary || !glProgramParameteri) return;
+
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0) return;
+
+    std::error_code ec;
+    std::filesystem::create_directories(mDir, ec);
+    if (ec) return;
+
+    // binaries are only valid for the exact driver build that produced them
+    uint64_t h = 0xcbf29ce484222325ull;
+    h = HashStr((const char*)glGetString(GL_VENDOR), h);
+    h = HashStr((const char*)glGetString(GL_RENDERER), h);
+    h = HashStr((const char*)glGetString(GL_VERSION), h);
+    h = HashStr((const char*)glGetString(GL_SHADING_LANGUAGE_VERSION), h);
+    mDriverHash = h;
+    mEnabled = true;
+}
+
+uint64_t ProgramCache::KeyFor(const char* vertexCode, const char* fragmentCode) const {
+    return HashStr(fragmentCode, HashStr(vertexCode, mDriverHash));
+}
+
+std::string ProgramCache::PathFor(const char* name, uint64_t key) const {
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)key);
+    return (std::filesystem::path(mDir) / (std::string(name) + "-" + hex + ".bin")).string();
+}
+
+void ProgramCache::Build(ShaderProgram& prog, const char* name, const char* vertexCode, const char* fragmentCode) {
+    if (!Begin(prog, name, vertexCode, fragmentCode)) Finish(prog, name, vertexCode, fragmentCode);
+}
+
+bool ProgramCache::Begin(ShaderProgram& prog, const char* name, const char* vertexCode, const char* fragmentCode) {
+    if (mEnabled && Load(prog, name, KeyFor(vertexCode, fragmentCode))) return true;
+    prog.BeginCompile(vertexCode, fragmentCode);
+    return false;
+}
+
+void ProgramCache::BuildCompute(ShaderProgram& prog, const char* name, const char* computeCode) {
+    // same entries as the graphics programs, keyed as if the fragment stage were empty
+    const uint64_t key = KeyFor(computeCode, "");
+    if (mEnabled && Load(prog, name, key)) return;
+    prog.BeginCompile(computeCode);
+    prog.FinishCompile();
+    GLDebug::Label(GL_PROGRAM, prog.GetID(), name, "program");
+    if (mEnabled) Store(prog, name, key);
+}
+
+bool ProgramCache::Load(ShaderProgram& prog, const char* name, uint64_t key) {
+    if (FILE* f = std::fopen(PathFor(name, key).c_str(), "rb")) {
+        FileHeader hd{};
+        std::vector<uint8_t> blob;
+        bool ok = std::fread(&hd, sizeof(hd), 1, f) == 1 &&
+                  hd.magic == kMagic && hd.key == key && hd.length > 0 && hd.length <= kMaxBinary;
+        if (ok) {
+            blob.resize(hd.length);
+            ok = std::fread(blob.data(), 1, blob.size(), f) == blob.size();
+        }
+        std::fclose(f);
+        // the driver can still refuse it (e.g. updated without changing its version string)
+        if (ok && prog.InitFromBinary((GLenum)hd.format, blob.data(), (int)blob.size())) {
+            GLDebug::Label(GL_PROGRAM, prog.GetID(), name, "program");
+            ++mHits;
+            return true;
+        }
+    }
+    ++mMisses;
+    return false;
+}
+
+void ProgramCache::Finish(ShaderProgram& prog, const char* name, const char* vertexCode, const char* fragmentCode) {
+    prog.FinishCompile();
+    GLDebug::Label(GL_PROGRAM, prog.GetID(), name, "program");
+    if (mEnabled) Store(prog, name, KeyFor(vertexCode, fragmentCode));
+}
+
+void ProgramCache::Store(ShaderProgram& prog, const char* name, uint64_t key) {
+    GLenum format = 0;
+    std::vector<uint8_t> blob;
+    if (!prog.GetBinary(format, blob) || blob.size() > kMaxBinary) return;
+
+    // write aside + rename: other instances/processes may be loading the same entry
+    const std::string path = PathFor(name, key);
+    // thread ids repeat across processes: the pid keeps two writers apart
+    const std::string tmp = path + ".tmp" + std::to_string(ProcessId()) + "-" +
+                            std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) return;
+    const FileHeader hd{ kMagic, (uint32_t)format, key, (uint32_t)blob.size(), 0 };
+    const bool ok = std::fwrite(&hd, sizeof(hd), 1, f) == 1 &&
+                    std::fwrite(blob.data(), 1, blob.size(), f) == blob.size();
+    const bool closed = std::fclose(f) == 0;
+
+    std::error_code ec;
+    if (ok && closed) std::filesystem::rename(tmp, path, ec);
+    if (!ok || !closed || ec) std::filesystem::remove(tmp, ec);
+}
+}
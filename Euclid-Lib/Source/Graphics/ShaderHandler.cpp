@@ -1,7 +1,19 @@
 #include "Graphics.hpp"
+#include "GLDebug.hpp"
+
+#include <cstdio>
 
 namespace Euclid
 {
+namespace {
+    // Into the GL debug log (Euclid_Debug.h) with the zone that was compiling
+    void ReportBuildError(const char* what, const char* infoLog) {
+        char text[1100];
+        std::snprintf(text, sizeof(text), "%s failed: %s", what, infoLog);
+        GLDebug::Report(EUCLID_GL_MSG_SOURCE_EUCLID, EUCLID_GL_MSG_ERROR, EUCLID_GL_SEVERITY_HIGH, 0, text);
+    }
+}
+
 void Shader::Init(GLenum shaderType, const char* shaderCode) {
     mShaderID = glCreateShader(shaderType);
     
@@ -23,7 +35,7 @@ void Shader::CheckCompileErrors() {
     if (!success)
     {
         glGetShaderInfoLog(mShaderID, 1024, NULL, infoLog);
-        std::cout << "ERROR::SHADER_COMPILATION_ERROR" << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
+        ReportBuildError("Shader compile", infoLog);
     }
 }
 }
@@ -36,6 +48,82 @@ void ShaderProgram::Init(std::span<unsigned int> shaderIDs) {
     glLinkProgram(mProgramID);
     CheckCompileErrors();
 }
+void ShaderProgram::Init(const char* vertexCode, const char* fragmentCode) {
+    BeginCompile(vertexCode, fragmentCode);
+    FinishCompile();
+}
+// Queues compile + link without reading anything back, so a driver with
+// KHR_parallel_shader_compile keeps working on it while we do other things.
+void ShaderProgram::BeginCompile(const char* vertexCode, const char* fragmentCode) {
+    const GLenum types[2] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER };
+    const char*  code[2]  = { vertexCode, fragmentCode };
+
+    mProgramID = glCreateProgram();
+    if (glProgramParameteri) glProgramParameteri(mProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    for (int i = 0; i < 2; ++i) {
+        mPending[i] = glCreateShader(types[i]);
+        glShaderSource(mPending[i], 1, &code[i], NULL);
+        glCompileShader(mPending[i]);
+        glAttachShader(mProgramID, mPending[i]);
+    }
+    glLinkProgram(mProgramID);
+}
+void ShaderProgram::BeginCompile(const char* computeCode) {
+    mProgramID = glCreateProgram();
+    if (glProgramParameteri) glProgramParameteri(mProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    mPending[0] = glCreateShader(GL_COMPUTE_SHADER);
+    glShaderSource(mPending[0], 1, &computeCode, NULL);
+    glCompileShader(mPending[0]);
+    glAttachShader(mProgramID, mPending[0]);
+    glLinkProgram(mProgramID);
+}
+void ShaderProgram::FinishCompile() {
+    for (auto& id : mPending) {
+        if (!id) continue;
+        int success;
+        glGetShaderiv(id, GL_COMPILE_STATUS, &success);
+        if (!success)
+        {
+            char infoLog[1024];
+            glGetShaderInfoLog(id, 1024, NULL, infoLog);
+            ReportBuildError("Shader compile", infoLog);
+        }
+    }
+    CheckCompileErrors();
+    // the program keeps its binary, shader objects can go
+    for (auto& id : mPending) {
+        if (!id) continue;
+        glDetachShader(mProgramID, id);
+        glDeleteShader(id);
+        id = 0;
+    }
+}
+bool ShaderProgram::InitFromBinary(GLenum format, const void* data, int length) {
+    if (!glProgramBinary) return false;
+    mProgramID = glCreateProgram();
+    glProgramBinary(mProgramID, format, data, length);
+    if (IsLinked()) return true;
+    glDeleteProgram(mProgramID);
+    mProgramID = 0;
+    return false;
+}
+bool ShaderProgram::GetBinary(GLenum& format, std::vector<uint8_t>& out) const {
+    if (!glGetProgramBinary || !IsLinked()) return false;
+    GLint length = 0;
+    glGetProgramiv(mProgramID, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return false;
+    out.resize((size_t)length);
+    GLsizei written = 0;
+    glGetProgramBinary(mProgramID, length, &written, &format, out.data());
+    out.resize((size_t)written);
+    return written > 0;
+}
+bool ShaderProgram::IsLinked() const {
+    if (!mProgramID) return false;
+    GLint ok = 0;
+    glGetProgramiv(mProgramID, GL_LINK_STATUS, &ok);
+    return ok == GL_TRUE;
+}
 unsigned int ShaderProgram::GetID() {
     return mProgramID;
 }
@@ -52,7 +140,7 @@ void ShaderProgram::CheckCompileErrors() {
     if (!success)
     {
         glGetProgramInfoLog(mProgramID, 1024, NULL, infoLog);
-        std::cout << "ERROR::PROGRAM_LINKING_ERROR" << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
+        ReportBuildError("Program link", infoLog);
     }
 }
 }
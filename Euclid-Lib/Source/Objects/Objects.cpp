@@ -1,9 +1,15 @@
 #include "Objects.hpp"
+#include "PagedMesh.hpp"
+#include "Profiler.hpp"
+#include "GLDebug.hpp"
 #include <glad/glad.h>
 
+#include <array>
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <functional>
 
 namespace Euclid {
 
@@ -12,6 +18,8 @@ void SharedMesh::Release() {
     if (ebo) { glDeleteBuffers(1, &ebo); ebo = 0; }
     if (vbo) { glDeleteBuffers(1, &vbo); vbo = 0; }
     if (vao) { glDeleteVertexArrays(1, &vao); vao = 0; }
+    std::vector<Meshlet>().swap(meshlets);
+    mem.Set(0);
 }
 
 static inline void MulScale(EuclidTransform& tf, float sx, float sy, float sz) {
@@ -75,105 +83,132 @@ static void ApplyParamsToScale(EuclidShapeType t, const void* params, EuclidTran
     }
 }
 
+// -------- Upload --------
+void UploadMesh(SharedMesh& dst,
+                const MeshVertex* verts, size_t vertCount,
+                const unsigned* idx, size_t idxCount,
+                const char* label)
+{
+    glGenVertexArrays(1, &dst.vao);
+    glGenBuffers(1, &dst.vbo);
+
+    glBindVertexArray(dst.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, dst.vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertCount*sizeof(MeshVertex), verts, GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void*)(3*sizeof(float)));
+
+    if (idxCount) {
+        glGenBuffers(1, &dst.ebo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, dst.ebo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, idxCount*sizeof(unsigned), idx, GL_STATIC_DRAW);
+        dst.indexCount = (GLsizei)idxCount;
+        dst.indexed = true;
+    } else {
+        dst.indexCount = (GLsizei)vertCount;
+        dst.indexed = false;
+    }
+    dst.vertexCount = (int)vertCount;
+    dst.mem.Set(vertCount * sizeof(MeshVertex) + idxCount * sizeof(unsigned));
+    GLDebug::Label(GL_VERTEX_ARRAY, dst.vao, label);
+    GLDebug::Label(GL_BUFFER, dst.vbo, label, "vertices");
+    GLDebug::Label(GL_BUFFER, dst.ebo, label, "indices");
 
+    glBindVertexArray(0);
+}
 
 namespace {
-    struct V { float p[3]; float c[3]; };
+    using V = MeshVertex;
     constexpr float PI = 3.14159265358979323846f;
 
-    inline V VC(float x, float y, float z, float r, float g, float b) {
+    constexpr V VC(float x, float y, float z, float r, float g, float b) {
         return {{x,y,z},{r,g,b}};
     }
 
+    // constexpr sin/cos (std:: ones aren't until C++26), good to well below float precision
+    constexpr double CSin(double x) {
+        constexpr double kPi = 3.14159265358979323846, kTwoPi = 2.0 * kPi;
+        x -= kTwoPi * (double)(long long)(x / kTwoPi);
+        if (x > kPi) x -= kTwoPi; else if (x < -kPi) x += kTwoPi;
+        double term = x, sum = x;
+        for (int n = 1; n < 12; ++n) { term *= -x * x / double((2*n) * (2*n + 1)); sum += term; }
+        return sum;
+    }
+    constexpr float Sin(float a) { return (float)CSin(a); }
+    constexpr float Cos(float a) { return (float)CSin((double)a + 1.57079632679489661923); }
+
     inline void UploadMesh(SharedMesh& dst,
                            const std::vector<V>& verts,
-                           const std::vector<unsigned>& idx)
+                           const std::vector<unsigned>& idx,
+                           const char* label)
     {
-        glGenVertexArrays(1, &dst.vao);
-        glGenBuffers(1, &dst.vbo);
-
-        glBindVertexArray(dst.vao);
-        glBindBuffer(GL_ARRAY_BUFFER, dst.vbo);
-        glBufferData(GL_ARRAY_BUFFER, verts.size()*sizeof(V), verts.data(), GL_STATIC_DRAW);
-
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(V), (void*)0);
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(V), (void*)(3*sizeof(float)));
-
-        if (!idx.empty()) {
-            glGenBuffers(1, &dst.ebo);
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, dst.ebo);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx.size()*sizeof(unsigned), idx.data(), GL_STATIC_DRAW);
-            dst.indexCount = (GLsizei)idx.size();
-            dst.indexed = true;
-        } else {
-            dst.indexCount = (GLsizei)verts.size();
-            dst.indexed = false;
-        }
-
-        glBindVertexArray(0);
+        UploadMesh(dst, verts.data(), verts.size(), idx.data(), idx.size(), label);
     }
 
-    // ---------- Primitive builders ----------
+    // ---------- Primitive tables ----------
+    // Built at compile time; creating a scene only uploads them, and only the shapes it uses.
 
-    // Non-indexed cube (same layout/colors you used)
-    void BuildCube(SharedMesh& out) {
-        const V cubeVerts[] = {
-            // back
-            {{-0.5f,-0.5f,-0.5f},{1,0,0}}, {{0.5f,-0.5f,-0.5f},{0,1,0}}, {{0.5f,0.5f,-0.5f},{0,0,1}},
-            {{0.5f,0.5f,-0.5f},{0,0,1}}, {{-0.5f,0.5f,-0.5f},{1,1,0}}, {{-0.5f,-0.5f,-0.5f},{1,0,0}},
-            // front
-            {{-0.5f,-0.5f, 0.5f},{1,0,1}}, {{0.5f,-0.5f, 0.5f},{0,1,1}}, {{0.5f,0.5f, 0.5f},{1,1,1}},
-            {{0.5f,0.5f, 0.5f},{1,1,1}}, {{-0.5f,0.5f, 0.5f},{.5,.5,.5}}, {{-0.5f,-0.5f, 0.5f},{1,0,1}},
-            // left
-            {{-0.5f, 0.5f, 0.5f},{0,1,.5}}, {{-0.5f, 0.5f,-0.5f},{0,.5,1}}, {{-0.5f,-0.5f,-0.5f},{1,.5,0}},
-            {{-0.5f,-0.5f,-0.5f},{1,.5,0}}, {{-0.5f,-0.5f, 0.5f},{.5,1,0}}, {{-0.5f, 0.5f, 0.5f},{0,1,.5}},
-            // right
-            {{0.5f, 0.5f, 0.5f},{1,0,.5}}, {{0.5f, 0.5f,-0.5f},{.5,0,1}}, {{0.5f,-0.5f,-0.5f},{0,.5,.5}},
-            {{0.5f,-0.5f,-0.5f},{0,.5,.5}}, {{0.5f,-0.5f, 0.5f},{.5,1,.5}}, {{0.5f, 0.5f, 0.5f},{1,0,.5}},
-            // bottom
-            {{-0.5f,-0.5f,-0.5f},{.3,.7,.5}}, {{0.5f,-0.5f,-0.5f},{.7,.3,.5}}, {{0.5f,-0.5f,0.5f},{.5,.7,.3}},
-            {{0.5f,-0.5f,0.5f},{.5,.7,.3}}, {{-0.5f,-0.5f,0.5f},{.3,.5,.7}}, {{-0.5f,-0.5f,-0.5f},{.3,.7,.5}},
-            // top
-            {{-0.5f,0.5f,-0.5f},{.7,.5,.3}}, {{0.5f,0.5f,-0.5f},{.5,.3,.7}}, {{0.5f,0.5f,0.5f},{.7,.7,.7}},
-            {{0.5f,0.5f,0.5f},{.7,.7,.7}}, {{-0.5f,0.5f,0.5f},{.2,.8,.4}}, {{-0.5f,0.5f,-0.5f},{.7,.5,.3}},
-        };
-        std::vector<V> verts(std::begin(cubeVerts), std::end(cubeVerts));
-        std::vector<unsigned> idx; // none
-        UploadMesh(out, verts, idx);
+    template <size_t NV, size_t NI>
+    struct MeshTable {
+        std::array<V, NV>        v{};
+        std::array<unsigned, NI> idx{};
+    };
+
+    template <size_t NV, size_t NI>
+    void UploadMesh(SharedMesh& dst, const MeshTable<NV, NI>& m, const char* label) {
+        UploadMesh(dst, m.v.data(), NV, NI ? m.idx.data() : nullptr, NI, label);
     }
 
+    // Non-indexed cube (same layout/colors you used)
+    constexpr MeshTable<36, 0> kCube = {{{
+        // back
+        {{-0.5f,-0.5f,-0.5f},{1,0,0}}, {{0.5f,-0.5f,-0.5f},{0,1,0}}, {{0.5f,0.5f,-0.5f},{0,0,1}},
+        {{0.5f,0.5f,-0.5f},{0,0,1}}, {{-0.5f,0.5f,-0.5f},{1,1,0}}, {{-0.5f,-0.5f,-0.5f},{1,0,0}},
+        // front
+        {{-0.5f,-0.5f, 0.5f},{1,0,1}}, {{0.5f,-0.5f, 0.5f},{0,1,1}}, {{0.5f,0.5f, 0.5f},{1,1,1}},
+        {{0.5f,0.5f, 0.5f},{1,1,1}}, {{-0.5f,0.5f, 0.5f},{.5f,.5f,.5f}}, {{-0.5f,-0.5f, 0.5f},{1,0,1}},
+        // left
+        {{-0.5f, 0.5f, 0.5f},{0,1,.5f}}, {{-0.5f, 0.5f,-0.5f},{0,.5f,1}}, {{-0.5f,-0.5f,-0.5f},{1,.5f,0}},
+        {{-0.5f,-0.5f,-0.5f},{1,.5f,0}}, {{-0.5f,-0.5f, 0.5f},{.5f,1,0}}, {{-0.5f, 0.5f, 0.5f},{0,1,.5f}},
+        // right
+        {{0.5f, 0.5f, 0.5f},{1,0,.5f}}, {{0.5f, 0.5f,-0.5f},{.5f,0,1}}, {{0.5f,-0.5f,-0.5f},{0,.5f,.5f}},
+        {{0.5f,-0.5f,-0.5f},{0,.5f,.5f}}, {{0.5f,-0.5f, 0.5f},{.5f,1,.5f}}, {{0.5f, 0.5f, 0.5f},{1,0,.5f}},
+        // bottom
+        {{-0.5f,-0.5f,-0.5f},{.3f,.7f,.5f}}, {{0.5f,-0.5f,-0.5f},{.7f,.3f,.5f}}, {{0.5f,-0.5f,0.5f},{.5f,.7f,.3f}},
+        {{0.5f,-0.5f,0.5f},{.5f,.7f,.3f}}, {{-0.5f,-0.5f,0.5f},{.3f,.5f,.7f}}, {{-0.5f,-0.5f,-0.5f},{.3f,.7f,.5f}},
+        // top
+        {{-0.5f,0.5f,-0.5f},{.7f,.5f,.3f}}, {{0.5f,0.5f,-0.5f},{.5f,.3f,.7f}}, {{0.5f,0.5f,0.5f},{.7f,.7f,.7f}},
+        {{0.5f,0.5f,0.5f},{.7f,.7f,.7f}}, {{-0.5f,0.5f,0.5f},{.2f,.8f,.4f}}, {{-0.5f,0.5f,-0.5f},{.7f,.5f,.3f}},
+    }}, {}};
+
     // Non-indexed plane (1x1 in XZ at y=0)
-    void BuildPlane(SharedMesh& out) {
-        const V planeVerts[] = {
-            {{-0.5f,0,-0.5f},{1,1,1}}, {{0.5f,0,-0.5f},{1,1,1}}, {{0.5f,0,0.5f},{1,1,1}},
-            {{0.5f,0,0.5f},{1,1,1}}, {{-0.5f,0,0.5f},{1,1,1}}, {{-0.5f,0,-0.5f},{1,1,1}},
-        };
-        std::vector<V> verts(std::begin(planeVerts), std::end(planeVerts));
-        std::vector<unsigned> idx; // none
-        UploadMesh(out, verts, idx);
-    }
+    constexpr MeshTable<6, 0> kPlane = {{{
+        {{-0.5f,0,-0.5f},{1,1,1}}, {{0.5f,0,-0.5f},{1,1,1}}, {{0.5f,0,0.5f},{1,1,1}},
+        {{0.5f,0,0.5f},{1,1,1}}, {{-0.5f,0,0.5f},{1,1,1}}, {{-0.5f,0,-0.5f},{1,1,1}},
+    }}, {}};
 
     // Sphere (lat/long)
-    void BuildSphere(SharedMesh& out, int stacks=24, int slices=36, float R=0.5f) {
-        std::vector<V> v; v.reserve((stacks+1)*(slices+1));
-        std::vector<unsigned> idx; idx.reserve(stacks*slices*6);
-
+    template <int stacks, int slices>
+    constexpr auto MakeSphere(float R) {
+        MeshTable<(stacks+1)*(slices+1), stacks*slices*6> m;
+        size_t nv = 0, ni = 0;
         for (int i=0;i<=stacks;i++){
             float t  = float(i)/stacks;
             float th = t*PI;               // [0..PI]
-            float y  = R*std::cos(th);
-            float r  = R*std::sin(th);
+            float y  = R*Cos(th);
+            float r  = R*Sin(th);
             for (int j=0;j<=slices;j++){
                 float s  = float(j)/slices;
                 float ph = s*2*PI;         // [0..2PI]
-                float x  = r*std::cos(ph);
-                float z  = r*std::sin(ph);
+                float x  = r*Cos(ph);
+                float z  = r*Sin(ph);
                 float cr = 0.5f + 0.5f*(x/R);
                 float cg = 0.5f + 0.5f*(y/R);
                 float cb = 0.5f + 0.5f*(z/R);
-                v.push_back(VC(x,y,z, cr,cg,cb));
+                m.v[nv++] = VC(x,y,z, cr,cg,cb);
             }
         }
         int stride = slices+1;
@@ -181,31 +216,31 @@ namespace {
             for (int j=0;j<slices;j++){
                 unsigned a = i*stride + j;
                 unsigned b = a + stride;
-                idx.push_back(a); idx.push_back(b); idx.push_back(a+1);
-                idx.push_back(b); idx.push_back(b+1); idx.push_back(a+1);
+                m.idx[ni++] = a; m.idx[ni++] = b;   m.idx[ni++] = a+1;
+                m.idx[ni++] = b; m.idx[ni++] = b+1; m.idx[ni++] = a+1;
             }
         }
-        UploadMesh(out, v, idx);
+        return m;
     }
 
     // Torus
-    void BuildTorus(SharedMesh& out, int segU=48, int segV=24, float R=0.5f, float r=0.2f) {
-        std::vector<V> v; v.reserve((segU+1)*(segV+1));
-        std::vector<unsigned> idx; idx.reserve(segU*segV*6);
-
+    template <int segU, int segV>
+    constexpr auto MakeTorus(float R, float r) {
+        MeshTable<(segU+1)*(segV+1), segU*segV*6> m;
+        size_t nv = 0, ni = 0;
         for (int i=0;i<=segU;i++){
             float u = (float)i/segU * 2*PI;
-            float cu = std::cos(u), su = std::sin(u);
+            float cu = Cos(u), su = Sin(u);
             for (int j=0;j<=segV;j++){
                 float vv = (float)j/segV * 2*PI;
-                float cv = std::cos(vv), sv = std::sin(vv);
+                float cv = Cos(vv), sv = Sin(vv);
                 float x = (R + r*cv)*cu;
                 float y = r*sv;
                 float z = (R + r*cv)*su;
                 float cr = 0.5f+0.5f*cv;
                 float cg = 0.5f+0.5f*sv;
                 float cb = 0.5f+0.5f*cu;
-                v.push_back(VC(x,y,z, cr,cg,cb));
+                m.v[nv++] = VC(x,y,z, cr,cg,cb);
             }
         }
         int stride = segV+1;
@@ -213,83 +248,85 @@ namespace {
             for (int j=0;j<segV;j++){
                 unsigned a = i*stride + j;
                 unsigned b = a + stride;
-                idx.push_back(a); idx.push_back(b); idx.push_back(a+1);
-                idx.push_back(b); idx.push_back(b+1); idx.push_back(a+1);
+                m.idx[ni++] = a; m.idx[ni++] = b;   m.idx[ni++] = a+1;
+                m.idx[ni++] = b; m.idx[ni++] = b+1; m.idx[ni++] = a+1;
             }
         }
-        UploadMesh(out, v, idx);
+        return m;
     }
 
     // Cone (base at y=-h/2, apex at y=+h/2)
-    void BuildCone(SharedMesh& out, int seg=32, float radius=0.5f, float h=1.0f) {
+    template <int seg>
+    constexpr auto MakeCone(float radius, float h) {
+        MeshTable<seg + 2, seg*6> m;
         float y0 = -0.5f*h, y1 = 0.5f*h;
-        std::vector<V> v; v.reserve(seg + 1 + 1);
-        std::vector<unsigned> idx;
+        size_t nv = 0, ni = 0;
 
         for (int i=0;i<seg;i++){
             float a = (float)i/seg * 2*PI;
-            float x = radius*std::cos(a);
-            float z = radius*std::sin(a);
-            v.push_back(VC(x,y0,z, 0.9f,0.6f,0.2f));
+            float x = radius*Cos(a);
+            float z = radius*Sin(a);
+            m.v[nv++] = VC(x,y0,z, 0.9f,0.6f,0.2f);
         }
-        unsigned baseCenter = (unsigned)v.size();
-        v.push_back(VC(0,y0,0, 0.8f,0.5f,0.2f));
+        unsigned baseCenter = (unsigned)nv;
+        m.v[nv++] = VC(0,y0,0, 0.8f,0.5f,0.2f);
 
-        unsigned apex = (unsigned)v.size();
-        v.push_back(VC(0,y1,0, 0.95f,0.35f,0.35f));
+        unsigned apex = (unsigned)nv;
+        m.v[nv++] = VC(0,y1,0, 0.95f,0.35f,0.35f);
 
         // base fan
         for (int i=0;i<seg;i++){
             unsigned a = (unsigned)i;
             unsigned b = (unsigned)((i+1)%seg);
-            idx.push_back(baseCenter); idx.push_back(b); idx.push_back(a);
+            m.idx[ni++] = baseCenter; m.idx[ni++] = b; m.idx[ni++] = a;
         }
         // sides
         for (int i=0;i<seg;i++){
             unsigned a = (unsigned)i;
             unsigned b = (unsigned)((i+1)%seg);
-            idx.push_back(a); idx.push_back(b); idx.push_back(apex);
+            m.idx[ni++] = a; m.idx[ni++] = b; m.idx[ni++] = apex;
         }
-        UploadMesh(out, v, idx);
+        return m;
     }
 
     // Cylinder (axis Y, height h, radius r)
-    void BuildCylinder(SharedMesh& out, int seg=32, float radius=0.5f, float h=1.0f) {
+    template <int seg>
+    constexpr auto MakeCylinder(float radius, float h) {
+        MeshTable<2*seg + 2, seg*12> m;
         float y0 = -0.5f*h, y1 = 0.5f*h;
-        std::vector<V> v; v.reserve(2*seg + 2);
-        std::vector<unsigned> idx;
+        size_t nv = 0, ni = 0;
 
         // bottom ring
         for (int i=0;i<seg;i++){
             float a = (float)i/seg * 2*PI;
-            float x = radius*std::cos(a);
-            float z = radius*std::sin(a);
-            v.push_back(VC(x,y0,z, 0.7f,0.7f,0.9f));
+            float x = radius*Cos(a);
+            float z = radius*Sin(a);
+            m.v[nv++] = VC(x,y0,z, 0.7f,0.7f,0.9f);
         }
-        unsigned bottomCenter = (unsigned)v.size();
-        v.push_back(VC(0,y0,0, 0.6f,0.6f,0.9f));
+        unsigned bottomCenter = (unsigned)nv;
+        m.v[nv++] = VC(0,y0,0, 0.6f,0.6f,0.9f);
 
         // top ring
-        unsigned topStart = (unsigned)v.size();
+        unsigned topStart = (unsigned)nv;
         for (int i=0;i<seg;i++){
             float a = (float)i/seg * 2*PI;
-            float x = radius*std::cos(a);
-            float z = radius*std::sin(a);
-            v.push_back(VC(x,y1,z, 0.7f,0.9f,0.7f));
+            float x = radius*Cos(a);
+            float z = radius*Sin(a);
+            m.v[nv++] = VC(x,y1,z, 0.7f,0.9f,0.7f);
         }
-        unsigned topCenter = (unsigned)v.size();
-        v.push_back(VC(0,y1,0, 0.6f,0.9f,0.6f));
+        unsigned topCenter = (unsigned)nv;
+        m.v[nv++] = VC(0,y1,0, 0.6f,0.9f,0.6f);
 
         // caps
         for (int i=0;i<seg;i++){
             unsigned a = (unsigned)i;
             unsigned b = (unsigned)((i+1)%seg);
             // bottom fan
-            idx.push_back(bottomCenter); idx.push_back(b); idx.push_back(a);
+            m.idx[ni++] = bottomCenter; m.idx[ni++] = b; m.idx[ni++] = a;
             // top fan
             unsigned ta = topStart + a;
             unsigned tb = topStart + b;
-            idx.push_back(topCenter); idx.push_back(ta); idx.push_back(tb);
+            m.idx[ni++] = topCenter; m.idx[ni++] = ta; m.idx[ni++] = tb;
         }
 
         // sides
@@ -298,67 +335,62 @@ namespace {
             unsigned b0 = (unsigned)((i+1)%seg);
             unsigned a1 = topStart + i;
             unsigned b1 = topStart + ((i+1)%seg);
-            idx.push_back(a0); idx.push_back(b0); idx.push_back(a1);
-            idx.push_back(b0); idx.push_back(b1); idx.push_back(a1);
+            m.idx[ni++] = a0; m.idx[ni++] = b0; m.idx[ni++] = a1;
+            m.idx[ni++] = b0; m.idx[ni++] = b1; m.idx[ni++] = a1;
         }
-        UploadMesh(out, v, idx);
+        return m;
     }
 
     // Triangular prism (equilateral XZ, height along Y)
-    void BuildTriPrism(SharedMesh& out, float height=1.0f, float radius=0.5f) {
+    constexpr auto MakeTriPrism(float height, float radius) {
+        MeshTable<6, 24> m;
         float y0 = -0.5f*height, y1 = 0.5f*height;
-        std::vector<V> v; v.reserve(6);
-        std::vector<unsigned> idx;
 
         for (int k=0;k<3;k++){
             float a = (PI/2.0f) + k*(2*PI/3.0f);
-            float x = radius*std::cos(a);
-            float z = radius*std::sin(a);
-            v.push_back(VC(x,y0,z, 0.9f,0.9f,0.3f)); // bottom
-        }
-        for (int k=0;k<3;k++){
-            float a = (PI/2.0f) + k*(2*PI/3.0f);
-            float x = radius*std::cos(a);
-            float z = radius*std::sin(a);
-            v.push_back(VC(x,y1,z, 0.9f,0.6f,0.3f)); // top
+            float x = radius*Cos(a);
+            float z = radius*Sin(a);
+            m.v[k]   = VC(x,y0,z, 0.9f,0.9f,0.3f); // bottom
+            m.v[k+3] = VC(x,y1,z, 0.9f,0.6f,0.3f); // top
         }
 
-        // caps
-        idx.push_back(0); idx.push_back(2); idx.push_back(1);     // bottom
-        idx.push_back(3); idx.push_back(4); idx.push_back(5);     // top
-
-        // sides (three quads -> two tris each)
-        auto quad = [&](unsigned a, unsigned b, unsigned c, unsigned d){
-            idx.push_back(a); idx.push_back(b); idx.push_back(c);
-            idx.push_back(a); idx.push_back(c); idx.push_back(d);
+        m.idx = {
+            0,2,1,  3,4,5,          // caps (bottom, top)
+            0,1,4,  0,4,3,          // sides (three quads -> two tris each)
+            1,2,5,  1,5,4,
+            2,0,3,  2,3,5,
         };
-        quad(0,1,4,3);
-        quad(1,2,5,4);
-        quad(2,0,3,5);
-
-        UploadMesh(out, v, idx);
+        return m;
     }
 
     // Circle (filled disc) in XZ at y=0
-    void BuildCircle(SharedMesh& out, int seg=64, float radius=0.5f) {
-        std::vector<V> v; v.reserve(seg+1);
-        std::vector<unsigned> idx; idx.reserve(seg*3);
-        v.push_back(VC(0,0,0, 0.95f,0.95f,0.95f)); // center
+    template <int seg>
+    constexpr auto MakeCircle(float radius) {
+        MeshTable<seg + 1, seg*3> m;
+        size_t ni = 0;
+        m.v[0] = VC(0,0,0, 0.95f,0.95f,0.95f); // center
         for (int i=0;i<seg;i++){
             float a = (float)i/seg * 2*PI;
-            float x = radius*std::cos(a);
-            float z = radius*std::sin(a);
-            float cr = 0.5f+0.5f*std::cos(a);
-            float cg = 0.5f+0.5f*std::sin(a);
-            v.push_back(VC(x,0,z, cr,cg,0.9f));
+            float x = radius*Cos(a);
+            float z = radius*Sin(a);
+            float cr = 0.5f+0.5f*Cos(a);
+            float cg = 0.5f+0.5f*Sin(a);
+            m.v[1 + i] = VC(x,0,z, cr,cg,0.9f);
         }
         for (int i=0;i<seg;i++){
             unsigned a = 1 + (unsigned)i;
             unsigned b = 1 + (unsigned)((i+1)%seg);
-            idx.push_back(0); idx.push_back(a); idx.push_back(b);
+            m.idx[ni++] = 0; m.idx[ni++] = a; m.idx[ni++] = b;
         }
-        UploadMesh(out, v, idx);
+        return m;
     }
+
+    constexpr auto kSphere   = MakeSphere<24, 36>(/*R*/0.5f);
+    constexpr auto kTorus    = MakeTorus<48, 24>(/*R*/0.5f, /*r*/0.2f);
+    constexpr auto kCone     = MakeCone<32>(/*radius*/0.5f, /*h*/1.0f);
+    constexpr auto kCylinder = MakeCylinder<32>(/*radius*/0.5f, /*h*/1.0f);
+    constexpr auto kPrism    = MakeTriPrism(/*height*/1.0f, /*radius*/0.5f);
+    constexpr auto kCircle   = MakeCircle<64>(/*radius*/0.5f);
 } // anon
 
 // === Helpers (put next to UploadMesh in the same anonymous namespace) ===
@@ -385,67 +417,183 @@ static void NormalizeToUnit(std::vector<V>& verts) {
     }
 }
 
+// -------- Meshlets --------
+// Triangles in Morton order of their centroids are spatially compact runs; cut them every
+// kMeshletTriangles, or earlier (past kMeshletMinTriangles) where the surface turns away,
+// so the normal cones stay narrow enough to be worth testing.
+constexpr size_t kMeshletTriangles    = 128;
+constexpr size_t kMeshletMinTriangles = 64;
+constexpr float  kMeshletMaxTurn      = 0.5f;   // cos 60 degrees off the run's mean normal
+
+static uint32_t SpreadBits10(uint32_t x) {   // 10 bits -> every third bit
+    x &= 0x3FFu;
+    x = (x | (x << 16)) & 0x030000FFu;
+    x = (x | (x << 8))  & 0x0300F00Fu;
+    x = (x | (x << 4))  & 0x030C30C3u;
+    x = (x | (x << 2))  & 0x09249249u;
+    return x;
+}
+
+// Reorders idx so every meshlet is one contiguous range, and verts into first-use order so
+// its vertices are one compact range too; out stays empty if idx points past verts (drawn
+// whole then)
+void BuildMeshlets(std::vector<V>& verts, std::vector<unsigned>& idx, std::vector<Meshlet>& out) {
+    EUCLID_ZONE("Build meshlets");
+    out.clear();
+    const size_t tris = idx.size() / 3;
+    if (!tris || tris > 0xFFFFFFFFu) return;
+    for (unsigned i : idx) if (i >= verts.size()) return;
+
+    auto P = [&](unsigned i) { return glm::vec3(verts[i].p[0], verts[i].p[1], verts[i].p[2]); };
+    glm::vec3 mn, mx;
+    ComputeAABB(verts, mn, mx);
+    const glm::vec3 toGrid = 1023.0f / glm::max(mx - mn, glm::vec3(1e-20f));
+
+    std::vector<uint64_t> order(tris);   // Morton code << 32 | triangle
+    for (size_t t = 0; t < tris; ++t) {
+        const glm::vec3 c = (P(idx[3*t]) + P(idx[3*t+1]) + P(idx[3*t+2])) * (1.0f / 3.0f);
+        const glm::uvec3 q(glm::clamp((c - mn) * toGrid, glm::vec3(0.0f), glm::vec3(1023.0f)));
+        const uint32_t code = SpreadBits10(q.x) | (SpreadBits10(q.y) << 1) | (SpreadBits10(q.z) << 2);
+        order[t] = (uint64_t)code << 32 | t;
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<unsigned> sorted(tris * 3);
+    std::vector<glm::vec3> normals(tris);   // unit, zero for degenerate triangles
+    MemoryCharge staging(EUCLID_MEM_CPU_IMPORT);
+    staging.Set(CapacityBytes(order) + CapacityBytes(sorted) + CapacityBytes(normals));
+    for (size_t k = 0; k < tris; ++k) {
+        const size_t t = (size_t)(order[k] & 0xFFFFFFFFu);
+        std::memcpy(&sorted[3*k], &idx[3*t], 3 * sizeof(unsigned));
+        const glm::vec3 a = P(sorted[3*k]), n = glm::cross(P(sorted[3*k+1]) - a, P(sorted[3*k+2]) - a);
+        const float len = glm::length(n);
+        normals[k] = len > 0.0f ? n / len : glm::vec3(0.0f);
+    }
+
+    auto finish = [&](size_t first, size_t end, const glm::vec3& sum) {
+        Meshlet m;
+        glm::vec3 lo(1e30f), hi(-1e30f);
+        for (size_t i = 3 * first; i < 3 * end; ++i) { lo = glm::min(lo, P(sorted[i])); hi = glm::max(hi, P(sorted[i])); }
+        m.center = 0.5f * (lo + hi);
+        float r2 = 0.0f;
+        for (size_t i = 3 * first; i < 3 * end; ++i) { const glm::vec3 d = P(sorted[i]) - m.center; r2 = std::max(r2, glm::dot(d, d)); }
+        m.radius = std::sqrt(r2);
+
+        // cone: widest normal off the mean; past ~84 degrees there's nothing left to cull
+        m.coneAxis = glm::vec3(0.0f);
+        m.coneCutoff = 1.0f;
+        const float sumLen = glm::length(sum);
+        if (sumLen > 0.0f) {
+            const glm::vec3 axis = sum / sumLen;
+            float minDot = 1.0f;
+            for (size_t k = first; k < end; ++k)
+                if (normals[k] != glm::vec3(0.0f)) minDot = std::min(minDot, glm::dot(normals[k], axis));
+            if (minDot > 0.1f) { m.coneAxis = axis; m.coneCutoff = std::sqrt(1.0f - minDot * minDot); }
+        }
+        m.firstIndex = (uint32_t)(3 * first);
+        m.indexCount = (uint32_t)(3 * (end - first));
+        out.push_back(m);
+    };
+
+    out.reserve(tris / kMeshletMinTriangles + 1);
+    size_t first = 0;
+    glm::vec3 sum(0.0f);
+    for (size_t k = 0; k < tris; ++k) {
+        const size_t len = k - first;
+        const float sumLen = glm::length(sum);
+        const bool turns = len >= kMeshletMinTriangles && sumLen > 0.0f && normals[k] != glm::vec3(0.0f) &&
+                           glm::dot(normals[k], sum / sumLen) < kMeshletMaxTurn;
+        if (len == kMeshletTriangles || turns) { finish(first, k, sum); first = k; sum = glm::vec3(0.0f); }
+        sum += normals[k];
+    }
+    finish(first, tris, sum);
+    out.shrink_to_fit();
+
+    // vertices by first use; unreferenced ones keep their place at the end
+    std::vector<unsigned> remap(verts.size(), 0xFFFFFFFFu);
+    std::vector<V> reordered;
+    reordered.reserve(verts.size());
+    for (unsigned& i : sorted) {
+        if (remap[i] == 0xFFFFFFFFu) { remap[i] = (unsigned)reordered.size(); reordered.push_back(verts[i]); }
+        i = remap[i];
+    }
+    for (size_t i = 0; i < verts.size(); ++i)
+        if (remap[i] == 0xFFFFFFFFu) reordered.push_back(verts[i]);
+    staging.Set(CapacityBytes(order) + CapacityBytes(sorted) + CapacityBytes(normals) +
+                CapacityBytes(remap) + CapacityBytes(reordered));
+    idx.swap(sorted);
+    verts.swap(reordered);
+}
+
+// -------- OBJ --------
+void ParseOBJFace(char* s, std::vector<ObjCorner>& face) {
+    face.clear();
+    while (*s) {
+        while (*s==' ') ++s; if (*s=='\n'||*s=='\0') break;
+        int vi=-1, ni=-1; char* st=s;
+        vi=(int)strtol(s,&s,10);
+        if (*s=='/') { ++s; if (*s=='/') { ++s; ni=(int)strtol(s,&s,10);} else { (void)strtol(s,&s,10); if (*s=='/') { ++s; ni=(int)strtol(s,&s,10);} } }
+        if (s==st) break;
+        ObjCorner id; if (vi>0) id.v=vi-1; if (ni>0) id.vn=ni-1; face.push_back(id);
+        while (*s==' ') ++s;
+    }
+}
+
+MeshVertex ObjVertex(const glm::vec3& P, const glm::vec3& N) {
+    glm::vec3 C = (glm::length(N)>0) ? 0.5f*(glm::normalize(N)+glm::vec3(1)) : glm::vec3(0.9f);
+    V v; v.p[0]=P.x; v.p[1]=P.y; v.p[2]=P.z; v.c[0]=C.x; v.c[1]=C.y; v.c[2]=C.z;
+    return v;
+}
+
 // tiny OBJ reader: v, vn, f (triangulates fan)
-struct Idx { int v=-1, vn=-1; };
-static bool ParseOBJ(const char* path, std::vector<V>& outVerts, std::vector<unsigned>& outIdx) {
+static bool ParseOBJ(const char* path, std::vector<V>& outVerts, std::vector<unsigned>& outIdx,
+                     const std::function<void(float)>& progress) {
     FILE* fp = fopen(path, "rb");
     if (!fp) return false;
 
+    // progress = share of the file consumed, reported in ~1% steps
+    long fileSize = 0;
+    if (progress && fseek(fp, 0, SEEK_END) == 0) { fileSize = ftell(fp); fseek(fp, 0, SEEK_SET); }
+    long nextReport = 0;
+    size_t lineNo = 0;
+
     std::vector<glm::vec3> pos, nrm;
-    std::vector<Idx> face;
+    std::vector<ObjCorner> face;
     char line[1024];
 
-    auto emitTri = [&](const Idx& a, const Idx& b, const Idx& c){
-        auto push = [&](const Idx& id)->unsigned{
+    auto emitTri = [&](const ObjCorner& a, const ObjCorner& b, const ObjCorner& c){
+        auto push = [&](const ObjCorner& id)->unsigned{
             glm::vec3 P(0), N(0);
             if (id.v  >=0 && id.v  < (int)pos.size()) P = pos[id.v];
             if (id.vn >=0 && id.vn < (int)nrm.size()) N = nrm[id.vn];
-            glm::vec3 C = (glm::length(N)>0) ? 0.5f*(glm::normalize(N)+glm::vec3(1)) : glm::vec3(0.9f);
-            V v; v.p[0]=P.x; v.p[1]=P.y; v.p[2]=P.z; v.c[0]=C.x; v.c[1]=C.y; v.c[2]=C.z;
-            outVerts.push_back(v); return (unsigned)outVerts.size()-1;
+            outVerts.push_back(ObjVertex(P, N)); return (unsigned)outVerts.size()-1;
         };
         unsigned ia=push(a), ib=push(b), ic=push(c);
         outIdx.push_back(ia); outIdx.push_back(ib); outIdx.push_back(ic);
     };
 
     while (fgets(line, sizeof(line), fp)) {
+        if (fileSize > 0 && (++lineNo & 1023) == 0) {
+            const long at = ftell(fp);
+            if (at >= nextReport) { progress(float(at) / float(fileSize)); nextReport = at + fileSize / 100; }
+        }
         if (line[0]=='v' && line[1]==' ') {
             glm::vec3 p; if (sscanf(line,"v %f %f %f",&p.x,&p.y,&p.z)==3) pos.push_back(p);
         } else if (line[0]=='v' && line[1]=='n') {
             glm::vec3 n; if (sscanf(line,"vn %f %f %f",&n.x,&n.y,&n.z)==3) nrm.push_back(n);
         } else if (line[0]=='f' && line[1]==' ') {
-            face.clear(); char* s=line+2;
-            while (*s) {
-                while (*s==' ') ++s; if (*s=='\n'||*s=='\0') break;
-                int vi=-1, ti=-1, ni=-1; char* st=s;
-                vi=(int)strtol(s,&s,10);
-                if (*s=='/') { ++s; if (*s=='/') { ++s; ni=(int)strtol(s,&s,10);} else { (void)strtol(s,&s,10); if (*s=='/') { ++s; ni=(int)strtol(s,&s,10);} } }
-                if (s==st) break;
-                Idx id; if (vi>0) id.v=vi-1; if (ni>0) id.vn=ni-1; face.push_back(id);
-                while (*s==' ') ++s;
-            }
+            ParseOBJFace(line+2, face);
             if (face.size()>=3) for (size_t i=1;i+1<face.size();++i) emitTri(face[0], face[i], face[i+1]);
         }
     }
     fclose(fp);
+    // the import's high-water mark: attribute lists and the expanded mesh side by side
+    MemoryCharge staging(EUCLID_MEM_CPU_IMPORT);
+    staging.Set(CapacityBytes(pos) + CapacityBytes(nrm) + CapacityBytes(outVerts) + CapacityBytes(outIdx));
     return !outVerts.empty();
 }
 
 // -------- ObjectStore: primitives --------
-void ObjectStore::InitPrimitives() {
-    // Cube & Plane (non-indexed to match your current shader path)
-    BuildCube(mCube);
-    BuildPlane(mPlane);
-
-    // Parametric shapes
-    BuildSphere   (mSphere,   /*stacks*/24, /*slices*/36, /*R*/0.5f);
-    BuildTorus    (mTorus,    /*segU*/48,   /*segV*/24,   /*R*/0.5f, /*r*/0.2f);
-    BuildCone     (mCone,     /*seg*/32,    /*radius*/0.5f, /*h*/1.0f);
-    BuildCylinder (mCylinder, /*seg*/32,    /*radius*/0.5f, /*h*/1.0f);
-    BuildTriPrism (mPrism,    /*height*/1.0f, /*radius*/0.5f);
-    BuildCircle   (mCircle,   /*seg*/64,    /*radius*/0.5f);
-}
-
 void ObjectStore::ReleasePrimitives() {
     mCube.Release();
     mSphere.Release();
@@ -455,24 +603,48 @@ void ObjectStore::ReleasePrimitives() {
     mPrism.Release();
     mCircle.Release();
     mPlane.Release();
+    mPrimitivesBuilt = 0;
+    ++mMeshVersion;
 }
 
 // -------- CRUD --------
 Object* ObjectStore::Create(EuclidShapeType t, const void* params,
                             const EuclidTransform& xform, EuclidObjectID id) {
-    auto obj = std::make_unique<Object>();
     // auto-generate a usable id when caller passes 0
     if (id == 0) id = NewID();
+    else if (mObjects.count(id)) return nullptr;   // taken
+    // keep generated ids clear of explicit ones
+    for (EuclidObjectID n = mNextID.load(); id >= n && !mNextID.compare_exchange_weak(n, id + 1); ) {}
+    auto obj = std::make_unique<Object>();
 
     obj->id   = id;
     obj->type = t;
-    obj->tf   = xform;
+    obj->slot = (uint32_t)mIds.size();
 
-    for (int i=0;i<3;++i) if (obj->tf.scale[i] == 0.0f) obj->tf.scale[i] = 1.0f;
-    ApplyParamsToScale(t, params, obj->tf);
+    EuclidTransform tf = xform;
+    for (int i=0;i<3;++i) if (tf.scale[i] == 0.0f) tf.scale[i] = 1.0f;
+    ApplyParamsToScale(t, params, tf);
 
     auto* raw = obj.get();
+    mIds.push_back(id);
+    mTypes.push_back(t);
+    mTransforms.push_back(tf);
+    mSeqs.push_back(++mChangeSeq);
+    mSlotObjects.push_back(raw);
+    ++mVersion;
+
+    // new objects are roots: appending keeps the pre-order valid
+    mWorld.emplace_back(1.0f);
+    mParentSlot.push_back(kNoSlot);
+    mOrderPos.push_back((uint32_t)mOrder.size());
+    mSubtreeEnd.push_back((uint32_t)mOrder.size() + 1);
+    mWorldDirty.push_back(0);
+    mOrder.push_back(raw->slot);
+    MarkWorldDirty(raw->slot);   // matrix is computed on first use
+
     mObjects.emplace(id, std::move(obj));
+    mDrawListDirty = true;
+    ChargeMemory();
     return raw;
 }
 
@@ -482,8 +654,54 @@ void ObjectStore::DestroyGPU(EuclidObjectID /*id*/) {
 
 void ObjectStore::Clear() {
     mObjects.clear();
+    mIds.clear(); mTypes.clear(); mTransforms.clear(); mSeqs.clear(); mSlotObjects.clear();
+    mWorld.clear(); mParentSlot.clear(); mOrderPos.clear(); mSubtreeEnd.clear(); mWorldDirty.clear();
+    mOrder.clear(); mDirtySlots.clear();
+    mOrderDirty = false;
+    ++mVersion;
+    mDrawListDirty = true;
+    // imported meshes belong to their objects, so they go too
+    for (auto& ce : mCustom) {
+        ce.mesh.Release();
+        if (ce.paged) ce.paged->Release();
+    }
+    mCustom.clear();
+    mFreeCustom.clear();
+    mPagedObjects.clear();
+    ++mMeshVersion;
     mSelected = 0;
-    mNextID   = 1; // (optional) start fresh so ids stay small between scenes
+    // start fresh so ids stay small, unless some are handed out. ReserveIDs sets the flag
+    // before it moves the counter: one racing with this either shows in the flag or makes
+    // the CAS fail, so its ids are never handed out again
+    EuclidObjectID next = mNextID.load();
+    if (!mIDsReserved.load()) mNextID.compare_exchange_strong(next, 1);
+    ChargeMemory();
+}
+
+int ObjectStore::AddCustom(CustomEntry&& ce) {
+    ++mMeshVersion;
+    if (!mFreeCustom.empty()) {
+        const int i = mFreeCustom.back();
+        mFreeCustom.pop_back();
+        mCustom[i] = std::move(ce);
+        return i;
+    }
+    mCustom.push_back(std::move(ce));
+    return (int)mCustom.size() - 1;
+}
+
+void ObjectStore::ChargeMemory() const {
+    // hash nodes counted as object + key + next link + cached hash + owning pointer
+    size_t bytes = mObjects.bucket_count() * sizeof(void*)
+                 + mObjects.size() * (sizeof(Object) + sizeof(EuclidObjectID) + 3 * sizeof(void*));
+    bytes += CapacityBytes(mIds) + CapacityBytes(mTypes) + CapacityBytes(mTransforms) + CapacityBytes(mSeqs)
+           + CapacityBytes(mSlotObjects) + CapacityBytes(mWorld) + CapacityBytes(mParentSlot)
+           + CapacityBytes(mOrderPos) + CapacityBytes(mSubtreeEnd) + CapacityBytes(mWorldDirty)
+           + CapacityBytes(mOrder) + CapacityBytes(mDirtySlots) + CapacityBytes(mDrawList)
+           + CapacityBytes(mCustom) + CapacityBytes(mFreeCustom) + CapacityBytes(mWorldChanges)
+           + CapacityBytes(mPagedObjects);
+    for (const CustomEntry& ce : mCustom) bytes += CapacityBytes(ce.mesh.meshlets);
+    mSceneMem.Set(bytes);
 }
 
 // -------- Access --------
@@ -497,11 +715,54 @@ const Object* ObjectStore::Get(EuclidObjectID id) const {
 // -------- Transforms --------
 EuclidResult ObjectStore::GetTransform(EuclidObjectID id, EuclidTransform& out) const {
     auto it = mObjects.find(id); if (it == mObjects.end()) return EUCLID_ERR_BAD_PARAM;
-    out = it->second->tf; return EUCLID_OK;
+    out = mTransforms[it->second->slot]; return EUCLID_OK;
 }
 EuclidResult ObjectStore::SetTransform(EuclidObjectID id, const EuclidTransform& in) {
     auto it = mObjects.find(id); if (it == mObjects.end()) return EUCLID_ERR_BAD_PARAM;
-    it->second->tf = in; return EUCLID_OK;
+    EditTransform(*it->second) = in; return EUCLID_OK;
+}
+void ObjectStore::Reserve(size_t extra) {
+    const size_t n = mIds.size() + extra;
+    mObjects.reserve(n);
+    mIds.reserve(n); mTypes.reserve(n); mTransforms.reserve(n); mSeqs.reserve(n); mSlotObjects.reserve(n);
+    mWorld.reserve(n); mParentSlot.reserve(n); mOrderPos.reserve(n); mSubtreeEnd.reserve(n); mWorldDirty.reserve(n);
+    mOrder.reserve(n);
+    ChargeMemory();
+}
+size_t ObjectStore::SetTransforms(const EuclidObjectID* ids, size_t count, const void* src, size_t stride) {
+    const auto* p = static_cast<const uint8_t*>(src);
+    size_t found = 0;
+    for (size_t i = 0; i < count; ++i, p += stride) {
+        auto it = mObjects.find(ids[i]); if (it == mObjects.end()) continue;
+        std::memcpy(&EditTransform(*it->second), p, sizeof(EuclidTransform));   // caller's array may be unaligned
+        ++found;
+    }
+    return found;
+}
+size_t ObjectStore::GetTransforms(const EuclidObjectID* ids, size_t count, void* dst, size_t stride) const {
+    auto* p = static_cast<uint8_t*>(dst);
+    size_t found = 0;
+    for (size_t i = 0; i < count; ++i, p += stride) {
+        auto it = mObjects.find(ids[i]); if (it == mObjects.end()) continue;
+        std::memcpy(p, &mTransforms[it->second->slot], sizeof(EuclidTransform));
+        ++found;
+    }
+    return found;
+}
+
+const std::vector<const Object*>& ObjectStore::DrawList() {
+    if (mDrawListDirty) {
+        mDrawList.clear();
+        mDrawList.reserve(mObjects.size());
+        for (auto& kv : mObjects)
+            if (kv.second->type != EUCLID_SHAPE_GROUP) mDrawList.push_back(kv.second.get());
+        // creation order, so coplanar overlaps don't depend on hash-table layout
+        std::sort(mDrawList.begin(), mDrawList.end(),
+                  [](const Object* a, const Object* b) { return a->id < b->id; });
+        mDrawListDirty = false;
+        ChargeMemory();
+    }
+    return mDrawList;
 }
 
 // -------- Bounds --------
@@ -515,27 +776,176 @@ void ObjectStore::ShapeLocalBounds(EuclidShapeType t, glm::vec3& bmin, glm::vec3
         case EUCLID_SHAPE_CYLINDER: bmin={-0.5f,-0.5f,-0.5f}; bmax={0.5f,0.5f,0.5f}; break;
         case EUCLID_SHAPE_PRISM:    bmin={-0.5f,-0.5f,-0.5f}; bmax={0.5f,0.5f,0.5f}; break;
         case EUCLID_SHAPE_CIRCLE:   bmin={-0.5f, 0.0f,-0.5f}; bmax={0.5f,0.0f,0.5f}; break;
+        case EUCLID_SHAPE_GROUP:    bmin={ 0.0f, 0.0f, 0.0f}; bmax={0.0f,0.0f,0.0f}; break; // just its origin
         default:                    bmin={-0.5f,-0.5f,-0.5f}; bmax={0.5f,0.5f,0.5f}; break;
     }
 }
 
+void ObjectStore::WorldBounds(const Object& o, glm::vec3& bmin, glm::vec3& bmax) const {
+    // use custom bounds if this is an imported mesh
+    glm::vec3 bminL, bmaxL;
+    if (o.type == EUCLID_SHAPE_CUSTOM) {
+        bminL = o.localMin;
+        bmaxL = o.localMax;
+    } else {
+        ShapeLocalBounds(o.type, bminL, bmaxL);
+    }
+
+    const glm::mat4& M = Model(o);
+
+    // local AABB -> world AABB via 8 corners
+    glm::vec3 corners[8] = {
+        {bminL.x,bminL.y,bminL.z},{bmaxL.x,bminL.y,bminL.z},{bminL.x,bmaxL.y,bminL.z},{bmaxL.x,bmaxL.y,bminL.z},
+        {bminL.x,bminL.y,bmaxL.z},{bmaxL.x,bminL.y,bmaxL.z},{bminL.x,bmaxL.y,bmaxL.z},{bmaxL.x,bmaxL.y,bmaxL.z}
+    };
+    bmin = glm::vec3( 1e9f); bmax = glm::vec3(-1e9f);
+    for (auto& c : corners) {
+        glm::vec3 w = glm::vec3(M * glm::vec4(c, 1));
+        bmin = glm::min(bmin, w);
+        bmax = glm::max(bmax, w);
+    }
+}
+
+bool ObjectStore::SubtreeBounds(const Object& o, glm::vec3& bmin, glm::vec3& bmax) const {
+    UpdateWorld();
+    bool any = false;
+    bmin = glm::vec3( 1e9f); bmax = glm::vec3(-1e9f);
+    for (uint32_t i = mOrderPos[o.slot]; i < mSubtreeEnd[o.slot]; ++i) {
+        const Object& c = *mSlotObjects[mOrder[i]];
+        if (c.type == EUCLID_SHAPE_GROUP) continue;
+        glm::vec3 mn, mx;
+        WorldBounds(c, mn, mx);
+        bmin = glm::min(bmin, mn); bmax = glm::max(bmax, mx);
+        any = true;
+    }
+    if (!any) WorldBounds(o, bmin, bmax);
+    return any;
+}
+
+// -------- Hierarchy --------
+bool ObjectStore::SetParent(Object& child, Object* parent) {
+    if (parent == child.parent) return true;
+    for (const Object* p = parent; p; p = p->parent)
+        if (p == &child) return false;   // would make a cycle
+
+    if (child.parent) --child.parent->childCount;
+    child.parent = parent;
+    if (parent) ++parent->childCount;
+    mSeqs[child.slot] = ++mChangeSeq;   // its world matrix changed
+
+    mOrderDirty = true;
+    MarkWorldDirty(child.slot);
+    return true;
+}
+
+void ObjectStore::RebuildOrder() const {
+    const uint32_t n = (uint32_t)mSlotObjects.size();
+    for (uint32_t s = 0; s < n; ++s) {
+        const Object* p = mSlotObjects[s]->parent;
+        mParentSlot[s] = p ? p->slot : kNoSlot;
+    }
+
+    // children grouped by parent (counting sort), then an iterative pre-order walk
+    std::vector<uint32_t> first(n + 1, 0), kids(n);
+    for (uint32_t s = 0; s < n; ++s) if (mParentSlot[s] != kNoSlot) ++first[mParentSlot[s] + 1];
+    for (uint32_t s = 0; s < n; ++s) first[s + 1] += first[s];
+    std::vector<uint32_t> fill(first.begin(), first.end() - 1);
+    for (uint32_t s = 0; s < n; ++s) if (mParentSlot[s] != kNoSlot) kids[fill[mParentSlot[s]]++] = s;
+
+    mOrder.clear();
+    std::vector<uint32_t> stack;
+    for (uint32_t r = 0; r < n; ++r) {
+        if (mParentSlot[r] != kNoSlot) continue;
+        stack.push_back(r);
+        while (!stack.empty()) {
+            const uint32_t s = stack.back(); stack.pop_back();
+            mOrderPos[s] = (uint32_t)mOrder.size();
+            mOrder.push_back(s);
+            for (uint32_t k = first[s + 1]; k > first[s]; --k) stack.push_back(kids[k - 1]);
+        }
+    }
+
+    // children sit after their parent, so walking backwards finishes them first
+    for (uint32_t i = n; i-- > 0; ) mSubtreeEnd[mOrder[i]] = i + 1;
+    for (uint32_t i = n; i-- > 0; ) {
+        const uint32_t s = mOrder[i], p = mParentSlot[s];
+        if (p != kNoSlot) mSubtreeEnd[p] = std::max(mSubtreeEnd[p], mSubtreeEnd[s]);
+    }
+    mOrderDirty = false;
+}
+
+void ObjectStore::UpdateWorld() const {
+    if (!mOrderDirty && mDirtySlots.empty()) return;
+    EUCLID_ZONE("Update world matrices");
+    if (mOrderDirty) {
+        RebuildOrder();
+        // removals moved slots around; the flags moved with them, the queue didn't
+        mDirtySlots.clear();
+        for (uint32_t s = 0; s < (uint32_t)mWorldDirty.size(); ++s)
+            if (mWorldDirty[s]) mDirtySlots.push_back(s);
+    }
+    if (mDirtySlots.empty()) return;
+
+    std::sort(mDirtySlots.begin(), mDirtySlots.end(),
+              [this](uint32_t a, uint32_t b) { return mOrderPos[a] < mOrderPos[b]; });
+
+    // each dirty slot redoes its subtree range; ranges nested in one already done are skipped
+    uint32_t done = 0;
+    for (uint32_t s : mDirtySlots) {
+        const uint32_t pos = mOrderPos[s];
+        if (pos < done) continue;
+        const uint32_t end = mSubtreeEnd[s];
+        for (uint32_t i = pos; i < end; ++i) {
+            const uint32_t t = mOrder[i], p = mParentSlot[t];
+            mWorld[t] = (p == kNoSlot) ? TRS(mTransforms[t]) : mWorld[p] * TRS(mTransforms[t]);
+        }
+        if (mTrackWorld && !mAllWorldsChanged) {
+            if (mWorldChanges.size() + (end - pos) > mWorld.size() / 2) { mAllWorldsChanged = true; mWorldChanges.clear(); }
+            else mWorldChanges.insert(mWorldChanges.end(), mOrder.begin() + pos, mOrder.begin() + end);
+        }
+        done = end;
+    }
+    for (uint32_t s : mDirtySlots) mWorldDirty[s] = 0;
+    mDirtySlots.clear();
+}
+
 // -------- Mesh routing --------
-const SharedMesh& ObjectStore::MeshFor(EuclidShapeType t) const {
+const SharedMesh& ObjectStore::MeshFor(EuclidShapeType t) {
+    // uploaded on first use: most scenes only ever touch a couple of shapes
+    auto lazy = [this](SharedMesh& m, const auto& table, const char* label) -> const SharedMesh& {
+        if (!m.vao) { UploadMesh(m, table, label); ++mPrimitivesBuilt; ++mMeshVersion; }
+        return m;
+    };
     switch (t) {
-        case EUCLID_SHAPE_CUBE:     return mCube;
-        case EUCLID_SHAPE_PLANE:    return mPlane;
-        case EUCLID_SHAPE_SPHERE:   return mSphere;
-        case EUCLID_SHAPE_TORUS:    return mTorus;
-        case EUCLID_SHAPE_CONE:     return mCone;
-        case EUCLID_SHAPE_CYLINDER: return mCylinder;
-        case EUCLID_SHAPE_PRISM:    return mPrism;
-        case EUCLID_SHAPE_CIRCLE:   return mCircle;
+        case EUCLID_SHAPE_CUBE:     return lazy(mCube,     kCube,      "Cube");
+        case EUCLID_SHAPE_PLANE:    return lazy(mPlane,    kPlane,     "Plane");
+        case EUCLID_SHAPE_SPHERE:   return lazy(mSphere,   kSphere,    "Sphere");
+        case EUCLID_SHAPE_TORUS:    return lazy(mTorus,    kTorus,     "Torus");
+        case EUCLID_SHAPE_CONE:     return lazy(mCone,     kCone,      "Cone");
+        case EUCLID_SHAPE_CYLINDER: return lazy(mCylinder, kCylinder,  "Cylinder");
+        case EUCLID_SHAPE_PRISM:    return lazy(mPrism,    kPrism,     "Prism");
+        case EUCLID_SHAPE_CIRCLE:   return lazy(mCircle,   kCircle,    "Circle");
         case EUCLID_SHAPE_CUSTOM:
-        default:                    return mCube;
+        default:                    return lazy(mCube,     kCube,      "Cube");
     }
 }
 
-// -------- Picking helpers --------
+const SharedMesh* ObjectStore::BuiltPrimitive(EuclidShapeType t) const {
+    const SharedMesh* m = nullptr;
+    switch (t) {
+        case EUCLID_SHAPE_CUBE:     m = &mCube;     break;
+        case EUCLID_SHAPE_PLANE:    m = &mPlane;    break;
+        case EUCLID_SHAPE_SPHERE:   m = &mSphere;   break;
+        case EUCLID_SHAPE_TORUS:    m = &mTorus;    break;
+        case EUCLID_SHAPE_CONE:     m = &mCone;     break;
+        case EUCLID_SHAPE_CYLINDER: m = &mCylinder; break;
+        case EUCLID_SHAPE_PRISM:    m = &mPrism;    break;
+        case EUCLID_SHAPE_CIRCLE:   m = &mCircle;   break;
+        default:                    return nullptr;
+    }
+    return m->vao ? m : nullptr;
+}
+
 ObjectStore::Ray ObjectStore::ScreenRay(float x, float y, int w, int h, const glm::mat4& invViewProj) {
     float sx =  (2.0f * float(x) / float(w)) - 1.0f;
     float sy = -(2.0f * float(y) / float(h)) + 1.0f;
@@ -564,6 +974,7 @@ EuclidObjectID ObjectStore::RayPick(float screenX, float screenY,
                                     const glm::mat4& invViewProj,
                                     int viewportW, int viewportH) const
 {
+    EUCLID_ZONE("Ray pick");
     if (viewportW <= 0 || viewportH <= 0) return 0;
     Ray ray = ScreenRay(screenX, screenY, viewportW, viewportH, invViewProj);
 
@@ -572,29 +983,10 @@ EuclidObjectID ObjectStore::RayPick(float screenX, float screenY,
 
     for (auto& kv : mObjects) {
         const Object& o = *kv.second;
+        if (o.type == EUCLID_SHAPE_GROUP) continue;
 
-        // 👇 use custom bounds if this is an imported mesh
-        glm::vec3 bminL, bmaxL;
-        if (o.type == EUCLID_SHAPE_CUSTOM) {
-            bminL = o.localMin;
-            bmaxL = o.localMax;
-        } else {
-            ShapeLocalBounds(o.type, bminL, bmaxL);
-        }
-
-        glm::mat4 M = o.Model();
-
-        // local AABB -> world AABB via 8 corners (as you already do)
-        glm::vec3 corners[8] = {
-            {bminL.x,bminL.y,bminL.z},{bmaxL.x,bminL.y,bminL.z},{bminL.x,bmaxL.y,bminL.z},{bmaxL.x,bmaxL.y,bminL.z},
-            {bminL.x,bminL.y,bmaxL.z},{bmaxL.x,bminL.y,bmaxL.z},{bminL.x,bmaxL.y,bmaxL.z},{bmaxL.x,bmaxL.y,bmaxL.z}
-        };
-        glm::vec3 bminW( 1e9f), bmaxW(-1e9f);
-        for (auto& c : corners) {
-            glm::vec3 w = glm::vec3(M * glm::vec4(c, 1));
-            bminW = glm::min(bminW, w);
-            bmaxW = glm::max(bmaxW, w);
-        }
+        glm::vec3 bminW, bmaxW;
+        WorldBounds(o, bminW, bmaxW);
 
         float t;
         if (IntersectAABB(ray, bminW, bmaxW, t) && t < bestT) { bestT = t; best = o.id; }
@@ -602,29 +994,61 @@ EuclidObjectID ObjectStore::RayPick(float screenX, float screenY,
     return best;
 }
 
+bool ObjectStore::ReadCustomMesh(int customIndex, std::vector<float>& positions, std::vector<unsigned>& indices) const
+{
+    const SharedMesh* m = GetCustomMesh(customIndex);
+    if (!m || !m->vbo || !m->indexed) return false;
+
+    GLint vbytes = 0, ibytes = 0;
+    glBindBuffer(GL_COPY_READ_BUFFER, m->vbo);
+    glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &vbytes);
+    std::vector<V> verts((size_t)std::max(vbytes, 0) / sizeof(V));
+    if (!verts.empty()) glGetBufferSubData(GL_COPY_READ_BUFFER, 0, verts.size() * sizeof(V), verts.data());
+
+    glBindBuffer(GL_COPY_READ_BUFFER, m->ebo);
+    glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &ibytes);
+    indices.assign((size_t)std::max(ibytes, 0) / sizeof(unsigned), 0u);
+    if (!indices.empty()) glGetBufferSubData(GL_COPY_READ_BUFFER, 0, indices.size() * sizeof(unsigned), indices.data());
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    positions.resize(verts.size() * 3);
+    for (size_t i = 0; i < verts.size(); ++i) std::memcpy(&positions[3*i], verts[i].p, sizeof(verts[i].p));
+    return !verts.empty() && indices.size() >= 3;
+}
+
 // === ObjectStore methods ===
-EuclidResult ObjectStore::LoadOBJ(const char* path, EuclidObjectID* outID, bool normalize)
+EuclidResult ObjectStore::LoadOBJ(const char* path, EuclidObjectID* outID, bool normalize,
+                                  const std::function<void(float)>& progress)
 {
+    EUCLID_ZONE("Import OBJ");
     if (!path || !outID) return EUCLID_ERR_BAD_PARAM;
 
     std::vector<V> verts;
     std::vector<unsigned> idx;
-    if (!ParseOBJ(path, verts, idx))
-        return EUCLID_ERR_BAD_PARAM;
+    {
+        EUCLID_ZONE("Parse OBJ");
+        if (!ParseOBJ(path, verts, idx, progress))
+            return EUCLID_ERR_BAD_PARAM;
+    }
+    MemoryCharge staging(EUCLID_MEM_CPU_IMPORT);
+    staging.Set(CapacityBytes(verts) + CapacityBytes(idx));
 
     if (normalize) NormalizeToUnit(verts);
 
     glm::vec3 mn, mx;
     ComputeAABB(verts, mn, mx);
 
-    // Upload GPU mesh
+    // Upload GPU mesh, triangles in meshlet order
     CustomEntry ce;
-    UploadMesh(ce.mesh, verts, idx);
+    BuildMeshlets(verts, idx, ce.mesh.meshlets);
+    {
+        EUCLID_ZONE("Upload mesh");
+        UploadMesh(ce.mesh, verts, idx, "Imported mesh");
+    }
     ce.localMin = mn;
     ce.localMax = mx;
 
-    const int customIndex = (int)mCustom.size();
-    mCustom.push_back(std::move(ce));
+    const int customIndex = AddCustom(std::move(ce));
 
     // Create scene object and hook it up to the custom mesh
     EuclidTransform xform{};
@@ -645,6 +1069,7 @@ EuclidResult ObjectStore::CreateFromRawMesh(const float* positions, size_t verte
                                             const unsigned* indices, size_t indexCount,
                                             EuclidObjectID* outID, bool normalize)
 {
+    EUCLID_ZONE("Import raw mesh");
     if (!positions || vertexCount == 0 || !indices || indexCount < 3 || !outID)
         return EUCLID_ERR_BAD_PARAM;
 
@@ -661,20 +1086,25 @@ EuclidResult ObjectStore::CreateFromRawMesh(const float* positions, size_t verte
     }
 
     std::vector<unsigned> idx(indices, indices + indexCount);
+    MemoryCharge staging(EUCLID_MEM_CPU_IMPORT);
+    staging.Set(CapacityBytes(verts) + CapacityBytes(idx));
 
     if (normalize) NormalizeToUnit(verts);
 
     glm::vec3 mn, mx;
     ComputeAABB(verts, mn, mx);
 
-    // Upload GPU mesh
+    // Upload GPU mesh, triangles in meshlet order
     CustomEntry ce;
-    UploadMesh(ce.mesh, verts, idx);
+    BuildMeshlets(verts, idx, ce.mesh.meshlets);
+    {
+        EUCLID_ZONE("Upload mesh");
+        UploadMesh(ce.mesh, verts, idx, "Imported mesh");
+    }
     ce.localMin = mn;
     ce.localMax = mx;
 
-    const int customIndex = (int)mCustom.size();
-    mCustom.push_back(std::move(ce));
+    const int customIndex = AddCustom(std::move(ce));
 
     // Create scene object
     EuclidTransform xform{};
@@ -691,10 +1121,92 @@ EuclidResult ObjectStore::CreateFromRawMesh(const float* positions, size_t verte
     return EUCLID_OK;
 }
 
-bool ObjectStore::Remove(EuclidObjectID id) {
-    // (Optional) if you want to auto-clear selection when it points at this id:
-    if (mSelected == id) mSelected = 0;
-    return mObjects.erase(id) > 0;
+EuclidResult ObjectStore::LoadPagedMesh(const char* path, EuclidObjectID* outID) {
+    EUCLID_ZONE("Load paged mesh");
+    if (!path || !outID) return EUCLID_ERR_BAD_PARAM;
+
+    // only the chunk table and proxies come in here; PageStreamer does the rest
+    auto paged = std::make_shared<PagedMesh>();
+    if (!paged->Open(path)) return EUCLID_ERR_BAD_PARAM;
+
+    CustomEntry ce;
+    ce.localMin = paged->BoundsMin();
+    ce.localMax = paged->BoundsMax();
+    ce.paged = std::move(paged);
+    const int customIndex = AddCustom(std::move(ce));
+
+    EuclidTransform xform{};
+    xform.scale[0] = xform.scale[1] = xform.scale[2] = 1.f;
+
+    Object* o = Create(EUCLID_SHAPE_CUSTOM, nullptr, xform, 0);
+    if (!o) return EUCLID_ERR_INIT;
+
+    o->customIndex = customIndex;
+    o->localMin    = mCustom[customIndex].localMin;
+    o->localMax    = mCustom[customIndex].localMax;
+    mPagedObjects.push_back(o->id);
+    ChargeMemory();
+
+    *outID = o->id;
+    return EUCLID_OK;
+}
+
+bool ObjectStore::Remove(EuclidObjectID id, std::vector<EuclidObjectID>* removed) {
+    auto it = mObjects.find(id);
+    if (it == mObjects.end()) return false;
+    Object* root = it->second.get();
+
+    if (root->childCount == 0) {
+        RemoveOne(root, removed);
+    } else {
+        // deepest first, so no object outlives its parent
+        if (mOrderDirty) RebuildOrder();
+        std::vector<Object*> doomed;
+        for (uint32_t i = mOrderPos[root->slot]; i < mSubtreeEnd[root->slot]; ++i) doomed.push_back(mSlotObjects[mOrder[i]]);
+        for (auto d = doomed.rbegin(); d != doomed.rend(); ++d) RemoveOne(*d, removed);
+    }
+    ChargeMemory();
+    return true;
+}
+
+void ObjectStore::RemoveOne(Object* o, std::vector<EuclidObjectID>* removed) {
+    if (mSelected == o->id) mSelected = 0;
+    if (o->parent) --o->parent->childCount;
+
+    // swap-remove from the scene arrays
+    const uint32_t slot = o->slot;
+    const uint32_t last = (uint32_t)mIds.size() - 1;
+    if (slot != last) {
+        mIds[slot]         = mIds[last];
+        mTypes[slot]       = mTypes[last];
+        mTransforms[slot]  = mTransforms[last];
+        mSeqs[slot]        = mSeqs[last];
+        mWorld[slot]       = mWorld[last];
+        mWorldDirty[slot]  = mWorldDirty[last];
+        mSlotObjects[slot] = mSlotObjects[last];
+        mSlotObjects[slot]->slot = slot;
+    }
+    mIds.pop_back(); mTypes.pop_back(); mTransforms.pop_back(); mSeqs.pop_back(); mSlotObjects.pop_back();
+    mWorld.pop_back(); mWorldDirty.pop_back(); mParentSlot.pop_back(); mOrderPos.pop_back(); mSubtreeEnd.pop_back();
+    mOrderDirty = true;
+    ++mVersion;
+
+    // an imported mesh belongs to its one object
+    if (o->customIndex >= 0 && o->customIndex < (int)mCustom.size()) {
+        CustomEntry& ce = mCustom[o->customIndex];
+        ce.mesh.Release();
+        if (ce.paged) {
+            ce.paged->Release();
+            ce.paged.reset();
+            mPagedObjects.erase(std::remove(mPagedObjects.begin(), mPagedObjects.end(), o->id), mPagedObjects.end());
+        }
+        mFreeCustom.push_back(o->customIndex);
+        ++mMeshVersion;
+    }
+
+    if (removed) removed->push_back(o->id);
+    mObjects.erase(o->id);
+    mDrawListDirty = true;
 }
 
 } // namespace Euclid
@@ -0,0 +1,776 @@
+#include "PagedMesh.hpp"
+#include "Renderer.hpp"
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Euclid
+{
+namespace {
+    constexpr char     kMagic[8] = { 'E', 'U', 'C', 'L', 'I', 'D', 'P', 'G' };
+    constexpr uint32_t kVersion  = 1;
+
+    constexpr uint64_t kChunkTriangles      = 1u << 16;    // the grid aims for about this many per chunk
+    constexpr uint64_t kMaxChunkTriangles   = 2 * kChunkTriangles;   // denser cells are split until they fit
+    constexpr size_t   kSplitSliceTriangles = 1u << 15;    // read / buffered per side while splitting a cell
+    constexpr int      kMaxGridCells        = 64;          // per axis
+    constexpr int      kProxyCells          = 16;          // proxy clustering grid along a chunk's longest side
+    constexpr size_t   kSpillBytes          = 32u << 20;   // triangles buffered over all bins before they go to disk
+    constexpr size_t   kCachePageVerts      = 1u << 16;    // attribute cache: vec3s per page ...
+    constexpr size_t   kCachePages          = 32;          // ... and pages per attribute (24 MB)
+    constexpr int      kMaxReads            = 4;           // chunk reads in flight
+    constexpr uint64_t kUploadBytesPerFrame = 16u << 20;
+
+    // On disk: header, chunk payloads (vertices, indices, meshlets), proxy mesh (vertices,
+    // indices), chunk table. The magic goes in last, so an interrupted build won't open.
+    struct FileHeader {
+        char     magic[8];
+        uint32_t version;
+        uint32_t chunkCount;
+        float    bmin[3], bmax[3];
+        uint64_t proxyOffset;
+        uint32_t proxyVertexCount, proxyIndexCount;
+        uint64_t tableOffset;
+        uint64_t triangles;
+    };
+    struct FileChunk {
+        float    bmin[3], bmax[3];
+        uint64_t offset;
+        uint32_t vertexCount, indexCount, meshletCount;
+        uint32_t proxyFirst, proxyCount;
+        uint32_t pad;
+    };
+
+    std::atomic<uint64_t> sNextSerial{1};
+
+    struct FileCloser { void operator()(FILE* f) const { std::fclose(f); } };
+    using File = std::unique_ptr<FILE, FileCloser>;
+
+    // 64-bit offsets: scans and paged files go past 2 GB
+    bool Seek(FILE* f, uint64_t at) {
+#if defined(_WIN32)
+        return _fseeki64(f, (long long)at, SEEK_SET) == 0;
+#else
+        return fseeko(f, (off_t)at, SEEK_SET) == 0;
+#endif
+    }
+    uint64_t Tell(FILE* f) {
+#if defined(_WIN32)
+        return (uint64_t)_ftelli64(f);
+#else
+        return (uint64_t)ftello(f);
+#endif
+    }
+    uint64_t FileSize(FILE* f) {
+        if (std::fseek(f, 0, SEEK_END) != 0) return 0;
+        const uint64_t size = Tell(f);
+        Seek(f, 0);
+        return size;
+    }
+    template <typename T>
+    bool WriteItems(FILE* f, const T* data, size_t count) { return !count || std::fwrite(data, sizeof(T), count, f) == count; }
+    template <typename T>
+    bool ReadItems(FILE* f, T* data, size_t count) { return !count || std::fread(data, sizeof(T), count, f) == count; }
+
+    // Scratch file next to the output, deleted with this
+    struct TempFile {
+        std::string path;
+        FILE*       f = nullptr;
+        bool Open(std::string p) { path = std::move(p); f = std::fopen(path.c_str(), "w+b"); return f != nullptr; }
+        ~TempFile() { if (f) std::fclose(f); if (!path.empty()) std::remove(path.c_str()); }
+    };
+
+    // vec3 array in a temp file, random access through a few LRU pages. OBJ faces mostly
+    // point at recent vertices, so nearly every lookup hits.
+    class Vec3Cache {
+    public:
+        Vec3Cache(FILE* f, uint64_t count)
+            : mFile(f), mCount(count), mSlot((size_t)((count + kCachePageVerts - 1) / kCachePageVerts), -1) {}
+
+        bool Get(uint64_t i, glm::vec3& out) {
+            if (i >= mCount) return false;
+            const uint64_t page = i / kCachePageVerts;
+            int32_t s = mSlot[page];
+            if (s < 0) {
+                if (mPages.size() < kCachePages) { mPages.emplace_back(); s = (int32_t)mPages.size() - 1; }
+                else {
+                    s = 0;
+                    for (size_t k = 1; k < mPages.size(); ++k) if (mPages[k].used < mPages[s].used) s = (int32_t)k;
+                    mSlot[mPages[s].page] = -1;
+                }
+                Page& p = mPages[s];
+                p.data.resize((size_t)std::min<uint64_t>(kCachePageVerts, mCount - page * kCachePageVerts));
+                if (!Seek(mFile, page * kCachePageVerts * sizeof(glm::vec3)) || !ReadItems(mFile, p.data.data(), p.data.size()))
+                    return false;
+                p.page = page;
+                mSlot[page] = s;
+                mMem.Set(CapacityBytes(mSlot) + mPages.size() * kCachePageVerts * sizeof(glm::vec3));
+            }
+            mPages[s].used = ++mTick;
+            out = mPages[s].data[i % kCachePageVerts];
+            return true;
+        }
+
+    private:
+        struct Page { uint64_t page = 0, used = 0; std::vector<glm::vec3> data; };
+        FILE*                mFile;
+        uint64_t             mCount;
+        uint64_t             mTick = 0;
+        std::vector<int32_t> mSlot;    // per page of the file, -1: not cached
+        std::vector<Page>    mPages;
+        MemoryCharge         mMem{EUCLID_MEM_CPU_IMPORT};
+    };
+
+    struct VertexHash {
+        size_t operator()(const MeshVertex& v) const {
+            uint64_t h = 1469598103934665603ull;
+            const auto* b = reinterpret_cast<const uint8_t*>(&v);
+            for (size_t i = 0; i < sizeof(MeshVertex); ++i) { h ^= b[i]; h *= 1099511628211ull; }
+            return (size_t)h;
+        }
+    };
+    struct VertexEq {
+        bool operator()(const MeshVertex& a, const MeshVertex& b) const { return std::memcmp(&a, &b, sizeof(MeshVertex)) == 0; }
+    };
+
+    // Vertex clustering: one vertex per occupied cell (mean position and color); triangles
+    // still spanning three cells survive, winding kept.
+    void BuildProxy(const std::vector<MeshVertex>& verts, const std::vector<unsigned>& idx,
+                    const glm::vec3& bmin, const glm::vec3& bmax,
+                    std::vector<MeshVertex>& outVerts, std::vector<unsigned>& outIdx) {
+        const glm::vec3 ext = bmax - bmin;
+        const float cell = std::max({ ext.x, ext.y, ext.z }) / float(kProxyCells);
+        const float inv = cell > 0.0f ? 1.0f / cell : 0.0f;
+
+        struct Sum { glm::vec3 p{0.0f}, c{0.0f}; uint32_t n = 0; };
+        std::unordered_map<uint32_t, uint32_t> cells;   // grid cell -> sums
+        std::vector<Sum> sums;
+        std::vector<uint32_t> vertexCell(verts.size());
+        for (size_t i = 0; i < verts.size(); ++i) {
+            const glm::vec3 p(verts[i].p[0], verts[i].p[1], verts[i].p[2]);
+            const glm::ivec3 q = glm::clamp(glm::ivec3((p - bmin) * inv), glm::ivec3(0), glm::ivec3(kProxyCells - 1));
+            const auto it = cells.try_emplace((uint32_t)(q.x + kProxyCells * (q.y + kProxyCells * q.z)), (uint32_t)sums.size()).first;
+            if (it->second == sums.size()) sums.emplace_back();
+            Sum& s = sums[it->second];
+            s.p += p;
+            s.c += glm::vec3(verts[i].c[0], verts[i].c[1], verts[i].c[2]);
+            ++s.n;
+            vertexCell[i] = it->second;
+        }
+
+        const uint32_t base = (uint32_t)outVerts.size();
+        for (const Sum& s : sums) {
+            const glm::vec3 p = s.p / float(s.n), c = s.c / float(s.n);
+            outVerts.push_back({ { p.x, p.y, p.z }, { c.x, c.y, c.z } });
+        }
+        std::unordered_set<uint64_t> seen;
+        for (size_t t = 0; t + 2 < idx.size(); t += 3) {
+            uint32_t a = vertexCell[idx[t]], b = vertexCell[idx[t+1]], c = vertexCell[idx[t+2]];
+            if (a == b || b == c || a == c) continue;
+            while (a > b || a > c) { const uint32_t x = a; a = b; b = c; c = x; }   // same key for every rotation
+            if (!seen.insert((uint64_t)a << 42 | (uint64_t)b << 21 | c).second) continue;
+            outIdx.push_back(base + a);
+            outIdx.push_back(base + b);
+            outIdx.push_back(base + c);
+        }
+    }
+}
+
+// -------- Build --------
+EuclidResult BuildPagedMesh(const char* objPath, const char* pagePath, bool normalize,
+                            const std::function<void(float)>& progress) {
+    EUCLID_ZONE("Build paged mesh");
+    if (!objPath || !pagePath) return EUCLID_ERR_BAD_PARAM;
+    File obj(std::fopen(objPath, "rb"));
+    if (!obj) return EUCLID_ERR_BAD_PARAM;
+    const uint64_t objSize = progress ? FileSize(obj.get()) : 0;
+
+    // one pass over the OBJ; progress runs from..to across it in ~1% steps
+    std::vector<ObjCorner> face;
+    char line[1024];
+    auto scan = [&](float from, float to, const auto& onLine) {
+        Seek(obj.get(), 0);
+        uint64_t nextReport = 0;
+        size_t lineNo = 0;
+        while (std::fgets(line, sizeof(line), obj.get())) {
+            if (objSize > 0 && (++lineNo & 1023) == 0) {
+                const uint64_t at = Tell(obj.get());
+                if (at >= nextReport) { progress(from + (to - from) * float(double(at) / double(objSize))); nextReport = at + objSize / 100; }
+            }
+            onLine();
+        }
+    };
+
+    TempFile posFile, nrmFile, binFile;
+    const std::string base(pagePath);
+    if (!posFile.Open(base + ".pos.tmp") || !nrmFile.Open(base + ".nrm.tmp") || !binFile.Open(base + ".bins.tmp"))
+        return EUCLID_ERR_BAD_PARAM;
+
+    // --- pass 1: attributes out to disk, bounds, triangle count ---
+    uint64_t positions = 0, normals = 0, triangles = 0;
+    glm::vec3 mn(1e30f), mx(-1e30f);
+    bool ioOk = true;
+    {
+        EUCLID_ZONE("Scan attributes");
+        scan(0.0f, 0.4f, [&] {
+            if (line[0]=='v' && line[1]==' ') {
+                glm::vec3 p;
+                if (std::sscanf(line, "v %f %f %f", &p.x, &p.y, &p.z) != 3) return;
+                ioOk &= WriteItems(posFile.f, &p, 1);
+                ++positions;
+                mn = glm::min(mn, p); mx = glm::max(mx, p);
+            } else if (line[0]=='v' && line[1]=='n') {
+                glm::vec3 n;
+                if (std::sscanf(line, "vn %f %f %f", &n.x, &n.y, &n.z) != 3) return;
+                ioOk &= WriteItems(nrmFile.f, &n, 1);
+                ++normals;
+            } else if (line[0]=='f' && line[1]==' ') {
+                ParseOBJFace(line + 2, face);
+                if (face.size() >= 3) triangles += face.size() - 2;
+            }
+        });
+    }
+    if (!ioOk) return EUCLID_ERR_INIT;
+    if (!positions || !triangles) return EUCLID_ERR_BAD_PARAM;
+
+    // same unit box as NormalizeToUnit
+    glm::vec3 center(0.0f);
+    float scale = 1.0f;
+    if (normalize) {
+        const glm::vec3 size = mx - mn;
+        const float maxDim = std::max(size.x, std::max(size.y, size.z));
+        if (maxDim > 0.0f) { center = 0.5f * (mn + mx); scale = 1.0f / maxDim; }
+    }
+    auto place = [&](const glm::vec3& p) { return normalize ? (p - center) * scale : p; };
+
+    // scans are surfaces: about n^2 of the n^3 cells end up occupied
+    const glm::vec3 gmin = place(mn), ext = place(mx) - gmin;
+    const int n = std::clamp((int)std::ceil(std::sqrt(double(triangles) / double(kChunkTriangles))), 1, kMaxGridCells);
+    const float longest = std::max(ext.x, std::max(ext.y, ext.z));
+    const float cell = longest > 0.0f ? longest / float(n) : 1.0f;
+    glm::ivec3 dims;
+    for (int a = 0; a < 3; ++a) dims[a] = std::clamp((int)std::ceil(ext[a] / cell), 1, n);
+    auto cellOf = [&](const glm::vec3& c) {
+        const glm::ivec3 q = glm::clamp(glm::ivec3(glm::floor((c - gmin) / cell)), glm::ivec3(0), dims - 1);
+        return (uint32_t)(q.x + dims.x * (q.y + dims.y * q.z));
+    };
+
+    // --- pass 2: triangles into bins by centroid, spilled to disk in blocks ---
+    struct Part {
+        std::vector<std::pair<uint64_t, uint64_t>> blocks;    // on disk: offset, triangles
+        uint64_t  triangles = 0;
+        glm::vec3 lo{1e30f}, hi{-1e30f};                      // of the centroids
+    };
+    struct Bin : Part {
+        std::vector<MeshVertex> pending;                      // 3 per triangle, not on disk yet
+    };
+    std::unordered_map<uint32_t, Bin> bins;
+    size_t buffered = 0;
+    uint64_t spillEnd = 0;
+    MemoryCharge staging(EUCLID_MEM_CPU_IMPORT);
+    auto spill = [&] {
+        ioOk &= Seek(binFile.f, spillEnd);
+        for (auto& kv : bins) {
+            Bin& b = kv.second;
+            if (b.pending.empty()) continue;
+            ioOk &= WriteItems(binFile.f, b.pending.data(), b.pending.size());
+            b.blocks.emplace_back(spillEnd, b.pending.size() / 3);
+            spillEnd += b.pending.size() * sizeof(MeshVertex);
+            std::vector<MeshVertex>().swap(b.pending);
+        }
+        buffered = 0;
+        staging.Set(bins.size() * sizeof(Bin));
+    };
+    {
+        EUCLID_ZONE("Bin triangles");
+        Vec3Cache posCache(posFile.f, positions), nrmCache(nrmFile.f, normals);
+        scan(0.4f, 0.8f, [&] {
+            if (line[0] != 'f' || line[1] != ' ') return;
+            ParseOBJFace(line + 2, face);
+            for (size_t i = 1; i + 1 < face.size(); ++i) {
+                const ObjCorner* corners[3] = { &face[0], &face[i], &face[i+1] };
+                MeshVertex tri[3];
+                glm::vec3 c(0.0f);
+                for (int k = 0; k < 3; ++k) {
+                    glm::vec3 P(0.0f), N(0.0f);
+                    if (corners[k]->v  >= 0) posCache.Get((uint64_t)corners[k]->v, P);
+                    if (corners[k]->vn >= 0) nrmCache.Get((uint64_t)corners[k]->vn, N);
+                    P = place(P);
+                    tri[k] = ObjVertex(P, N);
+                    c += P;
+                }
+                c *= 1.0f / 3.0f;
+                Bin& b = bins[cellOf(c)];
+                b.pending.insert(b.pending.end(), tri, tri + 3);
+                ++b.triangles;
+                b.lo = glm::min(b.lo, c);
+                b.hi = glm::max(b.hi, c);
+                buffered += sizeof(tri);
+                if (buffered >= kSpillBytes) spill();
+                else if ((b.triangles & 1023) == 0) staging.Set(bins.size() * sizeof(Bin) + buffered);
+            }
+        });
+        spill();
+    }
+    if (!ioOk || std::ferror(posFile.f) || std::ferror(nrmFile.f)) return EUCLID_ERR_INIT;
+
+    // A cell over kMaxChunkTriangles (a dense spot of the scan) is halved across the longest
+    // side of its centroids' box, by order when they all coincide, until each part fits.
+    // Halves stream through the spill file, so no cell has to fit in memory whole.
+    std::vector<MeshVertex> slice, sides[2];
+    auto split = [&](const Part& p, Part (&halves)[2]) {
+        const glm::vec3 size = p.hi - p.lo;
+        const int axis = size.x >= size.y && size.x >= size.z ? 0 : (size.y >= size.z ? 1 : 2);
+        const float mid = 0.5f * (p.lo[axis] + p.hi[axis]);
+        for (bool byOrder : { !(size[axis] > 0.0f), true }) {
+            halves[0] = Part{};
+            halves[1] = Part{};
+            auto flush = [&](int h) {
+                if (sides[h].empty()) return;
+                ioOk &= Seek(binFile.f, spillEnd) && WriteItems(binFile.f, sides[h].data(), sides[h].size());
+                halves[h].blocks.emplace_back(spillEnd, sides[h].size() / 3);
+                spillEnd += sides[h].size() * sizeof(MeshVertex);
+                sides[h].clear();
+            };
+            uint64_t seen = 0;
+            for (const auto& block : p.blocks) {
+                for (uint64_t done = 0; done < block.second && ioOk; ) {
+                    const uint64_t n = std::min<uint64_t>(block.second - done, kSplitSliceTriangles);
+                    slice.resize((size_t)n * 3);
+                    ioOk &= Seek(binFile.f, block.first + done * 3 * sizeof(MeshVertex)) &&
+                            ReadItems(binFile.f, slice.data(), slice.size());
+                    for (size_t t = 0; t < slice.size(); t += 3, ++seen) {
+                        glm::vec3 c(0.0f);
+                        for (int k = 0; k < 3; ++k) c += glm::vec3(slice[t+k].p[0], slice[t+k].p[1], slice[t+k].p[2]);
+                        c *= 1.0f / 3.0f;
+                        const int h = byOrder ? (seen >= p.triangles / 2) : (c[axis] >= mid);
+                        sides[h].insert(sides[h].end(), slice.begin() + t, slice.begin() + t + 3);
+                        ++halves[h].triangles;
+                        halves[h].lo = glm::min(halves[h].lo, c);
+                        halves[h].hi = glm::max(halves[h].hi, c);
+                        if (sides[h].size() >= kSplitSliceTriangles * 3) flush(h);
+                    }
+                    done += n;
+                }
+            }
+            flush(0);
+            flush(1);
+            if (halves[0].triangles && halves[1].triangles) return;   // else rounding sent all one way
+        }
+    };
+
+    // --- pass 3: one chunk per bin (or per part of one), welded and in meshlet order, plus its proxy ---
+    File out(std::fopen(pagePath, "wb"));
+    if (!out) return EUCLID_ERR_BAD_PARAM;
+    auto fail = [&] { out.reset(); std::remove(pagePath); return EUCLID_ERR_INIT; };
+
+    FileHeader header{};
+    ioOk &= WriteItems(out.get(), &header, 1);
+    uint64_t at = sizeof(FileHeader);
+
+    std::vector<uint32_t> keys;
+    keys.reserve(bins.size());
+    for (const auto& kv : bins) keys.push_back(kv.first);
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<FileChunk>  table;
+    std::vector<MeshVertex> soup, verts, proxyVerts;
+    std::vector<unsigned>   idx, proxyIdx;
+    std::vector<Meshlet>    meshlets;
+    std::unordered_map<MeshVertex, unsigned, VertexHash, VertexEq> weld;
+    glm::vec3 fileMin(1e30f), fileMax(-1e30f);
+    uint64_t written = 0;
+    {
+        EUCLID_ZONE("Write chunks");
+        std::vector<Part> parts;
+        for (size_t k = 0; k < keys.size() && ioOk; ++k) {
+            Bin& b = bins[keys[k]];
+            parts.assign(1, std::move(static_cast<Part&>(b)));
+            b = Bin{};
+            while (!parts.empty() && ioOk) {
+                Part part = std::move(parts.back());
+                parts.pop_back();
+                if (part.triangles > kMaxChunkTriangles) {
+                    Part halves[2];
+                    split(part, halves);
+                    parts.push_back(std::move(halves[1]));   // lower half first: chunks stay in space order
+                    parts.push_back(std::move(halves[0]));
+                    continue;
+                }
+                soup.clear();
+                soup.reserve((size_t)part.triangles * 3);
+                for (const auto& block : part.blocks) {
+                    const size_t old = soup.size();
+                    soup.resize(old + (size_t)block.second * 3);
+                    ioOk &= Seek(binFile.f, block.first) && ReadItems(binFile.f, soup.data() + old, (size_t)block.second * 3);
+                }
+
+                verts.clear();
+                idx.clear();
+                weld.clear();
+                idx.reserve(soup.size());
+                for (const MeshVertex& v : soup) {
+                    const auto it = weld.try_emplace(v, (unsigned)verts.size()).first;
+                    if (it->second == verts.size()) verts.push_back(v);
+                    idx.push_back(it->second);
+                }
+                BuildMeshlets(verts, idx, meshlets);
+
+                FileChunk fc{};
+                glm::vec3 lo(1e30f), hi(-1e30f);
+                for (const MeshVertex& v : verts) {
+                    lo = glm::min(lo, glm::vec3(v.p[0], v.p[1], v.p[2]));
+                    hi = glm::max(hi, glm::vec3(v.p[0], v.p[1], v.p[2]));
+                }
+                std::memcpy(fc.bmin, &lo, sizeof(fc.bmin));
+                std::memcpy(fc.bmax, &hi, sizeof(fc.bmax));
+                fileMin = glm::min(fileMin, lo);
+                fileMax = glm::max(fileMax, hi);
+                fc.offset       = at;
+                fc.vertexCount  = (uint32_t)verts.size();
+                fc.indexCount   = (uint32_t)idx.size();
+                fc.meshletCount = (uint32_t)meshlets.size();
+                ioOk &= WriteItems(out.get(), verts.data(), verts.size()) && WriteItems(out.get(), idx.data(), idx.size()) &&
+                        WriteItems(out.get(), meshlets.data(), meshlets.size());
+                at += verts.size() * sizeof(MeshVertex) + idx.size() * sizeof(unsigned) + meshlets.size() * sizeof(Meshlet);
+
+                fc.proxyFirst = (uint32_t)proxyIdx.size();
+                BuildProxy(verts, idx, lo, hi, proxyVerts, proxyIdx);
+                fc.proxyCount = (uint32_t)proxyIdx.size() - fc.proxyFirst;
+                table.push_back(fc);
+                written += idx.size() / 3;
+
+                staging.Set(bins.size() * sizeof(Bin) + CapacityBytes(soup) + CapacityBytes(verts) + CapacityBytes(idx) +
+                            CapacityBytes(meshlets) + weld.size() * (sizeof(MeshVertex) + 2 * sizeof(void*) + sizeof(unsigned)) +
+                            CapacityBytes(proxyVerts) + CapacityBytes(proxyIdx) + CapacityBytes(table) +
+                            CapacityBytes(slice) + CapacityBytes(sides[0]) + CapacityBytes(sides[1]));
+            }
+            if (progress) progress(0.8f + 0.2f * float(k + 1) / float(keys.size()));
+        }
+    }
+
+    header.proxyOffset = at;
+    header.proxyVertexCount = (uint32_t)proxyVerts.size();
+    header.proxyIndexCount = (uint32_t)proxyIdx.size();
+    ioOk &= WriteItems(out.get(), proxyVerts.data(), proxyVerts.size()) && WriteItems(out.get(), proxyIdx.data(), proxyIdx.size());
+    at += proxyVerts.size() * sizeof(MeshVertex) + proxyIdx.size() * sizeof(unsigned);
+
+    header.tableOffset = at;
+    ioOk &= WriteItems(out.get(), table.data(), table.size());
+
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.chunkCount = (uint32_t)table.size();
+    std::memcpy(header.bmin, &fileMin, sizeof(header.bmin));
+    std::memcpy(header.bmax, &fileMax, sizeof(header.bmax));
+    header.triangles = written;
+    ioOk &= Seek(out.get(), 0) && WriteItems(out.get(), &header, 1);
+    if (!ioOk || std::fclose(out.release()) != 0) return fail();
+    return EUCLID_OK;
+}
+
+// -------- PagedMesh --------
+bool PagedMesh::Open(const char* path) {
+    EUCLID_ZONE("Open paged mesh");
+    Release();
+    File f(path ? std::fopen(path, "rb") : nullptr);
+    if (!f) return false;
+    const uint64_t size = FileSize(f.get());
+
+    FileHeader h{};
+    if (!ReadItems(f.get(), &h, 1) || std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion) return false;
+    // counts are checked against the file before anything is allocated for them
+    auto fits = [&](uint64_t offset, uint64_t bytes) { return offset <= size && bytes <= size - offset; };
+    const uint64_t proxyBytes = (uint64_t)h.proxyVertexCount * sizeof(MeshVertex) + (uint64_t)h.proxyIndexCount * sizeof(unsigned);
+    if (!fits(h.tableOffset, (uint64_t)h.chunkCount * sizeof(FileChunk)) || !fits(h.proxyOffset, proxyBytes)) return false;
+
+    std::vector<FileChunk>  table(h.chunkCount);
+    std::vector<MeshVertex> proxyVerts(h.proxyVertexCount);
+    std::vector<unsigned>   proxyIdx(h.proxyIndexCount);
+    if (!Seek(f.get(), h.tableOffset) || !ReadItems(f.get(), table.data(), table.size()) ||
+        !Seek(f.get(), h.proxyOffset) || !ReadItems(f.get(), proxyVerts.data(), proxyVerts.size()) ||
+        !ReadItems(f.get(), proxyIdx.data(), proxyIdx.size()))
+        return false;
+    for (unsigned i : proxyIdx) if (i >= proxyVerts.size()) return false;
+
+    std::vector<Chunk> chunks(table.size());
+    for (size_t i = 0; i < table.size(); ++i) {
+        const FileChunk& fc = table[i];
+        Chunk& c = chunks[i];
+        std::memcpy(&c.bmin, fc.bmin, sizeof(fc.bmin));
+        std::memcpy(&c.bmax, fc.bmax, sizeof(fc.bmax));
+        c.offset       = fc.offset;
+        c.vertexCount  = fc.vertexCount;
+        c.indexCount   = fc.indexCount;
+        c.meshletCount = fc.meshletCount;
+        c.proxyFirst   = fc.proxyFirst;
+        c.proxyCount   = fc.proxyCount;
+        if (!fits(c.offset, c.Bytes() + (uint64_t)c.meshletCount * sizeof(Meshlet)) ||
+            c.proxyFirst > proxyIdx.size() || c.proxyCount > proxyIdx.size() - c.proxyFirst)
+            return false;
+    }
+
+    if (!proxyIdx.empty()) UploadMesh(mProxy, proxyVerts.data(), proxyVerts.size(), proxyIdx.data(), proxyIdx.size(), "Paged mesh proxies");
+    mChunks.swap(chunks);
+    mPath = path;
+    mSerial = sNextSerial.fetch_add(1);
+    std::memcpy(&mMin, h.bmin, sizeof(h.bmin));
+    std::memcpy(&mMax, h.bmax, sizeof(h.bmax));
+    ChargeMemory();
+    return true;
+}
+
+void PagedMesh::Release() {
+    for (Chunk& c : mChunks) c.mesh.Release();
+    std::vector<Chunk>().swap(mChunks);
+    mProxy.Release();
+    mSerial = 0;
+    ChargeMemory();
+}
+
+void PagedMesh::ChargeMemory() {
+    size_t bytes = CapacityBytes(mChunks) + mPath.capacity();
+    for (const Chunk& c : mChunks) bytes += CapacityBytes(c.mesh.meshlets);
+    mTableMem.Set(bytes);
+}
+
+// -------- PageStreamer --------
+void PageStreamer::Read(const PagedMesh& mesh, uint32_t chunk) {
+    const PagedMesh::Chunk& c = mesh.Chunks()[chunk];
+    mPool.Submit([this, path = mesh.Path(), serial = mesh.Serial(), chunk, offset = c.offset,
+                  nv = c.vertexCount, ni = c.indexCount, nm = c.meshletCount] {
+        EUCLID_ZONE("Read chunk");
+        Loaded l;
+        l.serial = serial;
+        l.chunk = chunk;
+        l.verts.resize(nv);
+        l.idx.resize(ni);
+        l.meshlets.resize(nm);
+        File f(std::fopen(path.c_str(), "rb"));
+        l.ok = f && Seek(f.get(), offset) && ReadItems(f.get(), l.verts.data(), nv) &&
+               ReadItems(f.get(), l.idx.data(), ni) && ReadItems(f.get(), l.meshlets.data(), nm);
+        // a damaged file must not send the GPU past the buffers
+        for (size_t i = 0; i < l.idx.size() && l.ok; ++i) l.ok = l.idx[i] < nv;
+        for (size_t i = 0; i < l.meshlets.size() && l.ok; ++i)
+            l.ok = l.meshlets[i].firstIndex <= ni && l.meshlets[i].indexCount <= ni - l.meshlets[i].firstIndex;
+        if (!l.ok) {   // nothing to upload: drop the partial read
+            std::vector<MeshVertex>().swap(l.verts);
+            std::vector<unsigned>().swap(l.idx);
+            std::vector<Meshlet>().swap(l.meshlets);
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mInbox.push_back(std::move(l));
+        size_t bytes = CapacityBytes(mInbox);
+        for (const Loaded& x : mInbox) bytes += x.Bytes();
+        mInboxMem.Set(bytes);
+    });
+}
+
+void PageStreamer::Upload(ObjectStore& objs) {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (Loaded& l : mInbox) mArrived.push_back(std::move(l));
+        mInbox.clear();
+        mInboxMem.Set(CapacityBytes(mInbox));
+    }
+    if (mArrived.empty()) return;
+
+    EUCLID_ZONE("Upload chunks");
+    auto meshOf = [&](uint64_t serial) -> PagedMesh* {
+        for (EuclidObjectID id : objs.PagedObjects()) {
+            const Object* o = objs.Get(id);
+            PagedMesh* m = o ? objs.GetPagedMesh(o->customIndex) : nullptr;
+            if (m && m->Serial() == serial) return m;
+        }
+        return nullptr;
+    };
+    uint64_t uploaded = 0;
+    size_t keep = 0, bytes = 0;
+    for (Loaded& l : mArrived) {
+        PagedMesh* mesh = meshOf(l.serial);
+        PagedMesh::Chunk* c = mesh && l.chunk < mesh->Chunks().size() ? &mesh->Chunks()[l.chunk] : nullptr;
+        if (!c || c->state != PagedMesh::kLoading) continue;   // its mesh went away meanwhile
+        if (!l.ok) { c->state = PagedMesh::kBroken; continue; }
+        if (uploaded >= kUploadBytesPerFrame) {                 // the rest waits for the next frame
+            bytes += l.Bytes();
+            mArrived[keep++] = std::move(l);
+            continue;
+        }
+        UploadMesh(c->mesh, l.verts.data(), l.verts.size(), l.idx.data(), l.idx.size(), "Paged mesh chunk");
+        c->mesh.meshlets = std::move(l.meshlets);
+        c->state = PagedMesh::kResident;
+        uploaded += c->Bytes();
+        ++mLoads;
+        mesh->ChargeMemory();
+    }
+    mArrived.resize(keep);
+    mArrivedMem.Set(CapacityBytes(mArrived) + bytes);
+}
+
+void PageStreamer::Update(ObjectStore& objs, const void* view, const glm::vec3* eyes, const glm::mat4* viewProjs, int count) {
+    count = std::clamp(count, 0, (int)EUCLID_MAX_VIEWPORTS);
+    auto it = std::find_if(mViews.begin(), mViews.end(), [&](const View& v) { return v.owner == view; });
+    if (it == mViews.end()) {
+        it = mViews.emplace(mViews.end());
+        it->owner = view;
+    }
+    if (it->posted) {   // this view is back: a new frame
+        for (View& v : mViews) v.posted = false;
+        mSelected = false;
+    }
+    it->posted = true;
+    it->count = count;
+    std::copy(eyes, eyes + count, it->eyes);
+    std::copy(viewProjs, viewProjs + count, it->viewProjs);
+    if (mSelected) return;
+    mSelected = true;
+
+    // this view's cameras, then the latest of the others, as many as fit
+    glm::vec3 allEyes[EUCLID_MAX_VIEWPORTS];
+    glm::mat4 allViewProjs[EUCLID_MAX_VIEWPORTS];
+    int n = 0;
+    auto add = [&](const View& v) {
+        for (int i = 0; i < v.count && n < (int)EUCLID_MAX_VIEWPORTS; ++i, ++n) {
+            allEyes[n] = v.eyes[i];
+            allViewProjs[n] = v.viewProjs[i];
+        }
+    };
+    add(*it);
+    for (const View& v : mViews)
+        if (&v != &*it) add(v);
+    Select(objs, allEyes, allViewProjs, n);
+}
+
+void PageStreamer::RemoveView(const void* view) {
+    mViews.erase(std::remove_if(mViews.begin(), mViews.end(), [&](const View& v) { return v.owner == view; }),
+                 mViews.end());
+}
+
+void PageStreamer::Settle(ObjectStore& objs, const glm::vec3* eyes, const glm::mat4* viewProjs, int count) {
+    EUCLID_ZONE("Settle streaming");
+    for (;;) {
+        Select(objs, eyes, viewProjs, std::min(count, (int)EUCLID_MAX_VIEWPORTS));
+        if (!mInFlight && mArrived.empty()) break;
+        mPool.Wait();
+    }
+    mSelected = false;   // the views' own cameras pick again on their next frame
+}
+
+void PageStreamer::Select(ObjectStore& objs, const glm::vec3* eyes, const glm::mat4* viewProjs, int count) {
+    Upload(objs);
+    mInFlight = 0;
+    if (objs.PagedObjects().empty() || count <= 0) return;
+    EUCLID_ZONE("Streaming");
+
+    // every chunk of every paged mesh, by priority: in some view first, then nearest
+    mCandidates.clear();
+    for (EuclidObjectID id : objs.PagedObjects()) {
+        const Object* o = objs.Get(id);
+        PagedMesh* mesh = o ? objs.GetPagedMesh(o->customIndex) : nullptr;
+        if (!mesh) continue;
+        const glm::mat4& M = objs.Model(*o);
+        const glm::mat4 inv = glm::inverse(M);
+        const float scale = std::max({ glm::length(glm::vec3(M[0])), glm::length(glm::vec3(M[1])), glm::length(glm::vec3(M[2])) });
+        glm::vec3 eye[EUCLID_MAX_VIEWPORTS];
+        glm::vec4 planes[EUCLID_MAX_VIEWPORTS][6];
+        for (int v = 0; v < count; ++v) {
+            eye[v] = glm::vec3(inv * glm::vec4(eyes[v], 1.0f));
+            FrustumPlanes(viewProjs[v] * M, planes[v]);
+        }
+        for (uint32_t i = 0; i < mesh->Chunks().size(); ++i) {
+            const PagedMesh::Chunk& c = mesh->Chunks()[i];
+            if (c.state == PagedMesh::kBroken) continue;
+            const glm::vec3 center = 0.5f * (c.bmin + c.bmax), extent = 0.5f * (c.bmax - c.bmin);
+            Candidate k{ true, 1e30f, mesh, i };
+            for (int v = 0; v < count; ++v) {
+                k.distance = std::min(k.distance, glm::length(eye[v] - glm::clamp(eye[v], c.bmin, c.bmax)) * scale);
+                bool outside = false;
+                for (int p = 0; p < 6 && !outside; ++p) {
+                    const glm::vec3 n(planes[v][p]);
+                    outside = glm::dot(n, center) + planes[v][p].w < -glm::dot(glm::abs(n), extent);
+                }
+                k.outside = k.outside && outside;
+            }
+            mCandidates.push_back(k);
+        }
+    }
+    std::sort(mCandidates.begin(), mCandidates.end(), [](const Candidate& a, const Candidate& b) {
+        if (a.outside != b.outside) return !a.outside;
+        if (a.distance != b.distance) return a.distance < b.distance;
+        return a.mesh != b.mesh ? a.mesh->Serial() < b.mesh->Serial() : a.chunk < b.chunk;
+    });
+    mScratchMem.Set(CapacityBytes(mCandidates));
+    auto chunkOf = [](const Candidate& k) -> PagedMesh::Chunk& { return k.mesh->Chunks()[k.chunk]; };
+
+    // wanted: in priority order, whatever still fits the budget; a chunk too big for what
+    // is left doesn't keep the smaller ones after it out
+    uint64_t total = 0, resident = 0, loading = 0;
+    for (Candidate& k : mCandidates) {
+        const uint64_t b = chunkOf(k).Bytes();
+        k.wanted = total + b <= mBudget;
+        if (k.wanted) total += b;
+    }
+    int reads = 0;
+    for (const Candidate& k : mCandidates) {
+        const PagedMesh::Chunk& c = chunkOf(k);
+        if (c.state == PagedMesh::kResident) resident += c.Bytes();
+        else if (c.state == PagedMesh::kLoading) { loading += c.Bytes(); ++reads; }
+    }
+
+    // room comes from resident chunks outside the wanted set, farthest first; they stay
+    // until something needs it, so a camera hovering at the edge doesn't thrash
+    size_t victim = mCandidates.size();
+    auto evict = [&] {
+        while (victim > 0) {
+            const Candidate& k = mCandidates[--victim];
+            PagedMesh::Chunk& c = chunkOf(k);
+            if (k.wanted || c.state != PagedMesh::kResident) continue;
+            resident -= c.Bytes();
+            c.mesh.Release();
+            c.state = PagedMesh::kOnDisk;
+            k.mesh->ChargeMemory();
+            ++mEvictions;
+            return true;
+        }
+        return false;
+    };
+    while (resident > mBudget && evict()) {}
+    for (size_t i = 0; i < mCandidates.size() && reads < kMaxReads; ++i) {
+        PagedMesh::Chunk& c = chunkOf(mCandidates[i]);
+        if (!mCandidates[i].wanted || c.state != PagedMesh::kOnDisk) continue;
+        while (resident + loading + c.Bytes() > mBudget && evict()) {}
+        if (resident + loading + c.Bytes() > mBudget) continue;   // a smaller one further down may fit
+        c.state = PagedMesh::kLoading;
+        loading += c.Bytes();
+        ++reads;
+        Read(*mCandidates[i].mesh, mCandidates[i].chunk);
+    }
+    mInFlight = reads;
+}
+
+void PageStreamer::GetStats(const ObjectStore& objs, EuclidStreamingStats& out) const {
+    out = EuclidStreamingStats{};
+    out.budget_bytes = mBudget;
+    out.loads = mLoads;
+    out.evictions = mEvictions;
+    for (EuclidObjectID id : objs.PagedObjects()) {
+        const Object* o = objs.Get(id);
+        const PagedMesh* mesh = o ? objs.GetPagedMesh(o->customIndex) : nullptr;
+        if (!mesh) continue;
+        out.proxy_bytes += mesh->Proxy().mem.Bytes();
+        for (const PagedMesh::Chunk& c : mesh->Chunks()) {
+            ++out.chunks;
+            if (c.state == PagedMesh::kResident) { ++out.resident_chunks; out.resident_bytes += c.Bytes(); }
+            else if (c.state == PagedMesh::kLoading) ++out.loading_chunks;
+        }
+    }
+}
+}
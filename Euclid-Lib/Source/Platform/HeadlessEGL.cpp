@@ -0,0 +1,255 @@
+#include "Headless.hpp"
+
+#if defined(__linux__)
+
+#include <dlfcn.h>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace Euclid
+{
+// libEGL is opened at runtime so the library still loads (and Euclid_Create still works)
+// on machines without it. Only the handful of EGL bits we need are declared here.
+namespace {
+    using EGLDisplay = void*;
+    using EGLContext = void*;
+    using EGLConfig  = void*;
+    using EGLSurface = void*;
+    using EGLint     = int32_t;
+    using EGLBoolean = unsigned int;
+    using EGLenum    = unsigned int;
+
+    constexpr EGLint  kEGL_NONE                           = 0x3038;
+    constexpr EGLint  kEGL_EXTENSIONS                     = 0x3055;
+    constexpr EGLint  kEGL_SURFACE_TYPE                   = 0x3033;
+    constexpr EGLint  kEGL_PBUFFER_BIT                    = 0x0001;
+    constexpr EGLint  kEGL_RENDERABLE_TYPE                = 0x3040;
+    constexpr EGLint  kEGL_OPENGL_BIT                     = 0x0008;
+    constexpr EGLint  kEGL_WIDTH                          = 0x3057;
+    constexpr EGLint  kEGL_HEIGHT                         = 0x3056;
+    constexpr EGLenum kEGL_OPENGL_API                     = 0x30A2;
+    constexpr EGLint  kEGL_CONTEXT_MAJOR_VERSION          = 0x3098;
+    constexpr EGLint  kEGL_CONTEXT_MINOR_VERSION          = 0x30FB;
+    constexpr EGLint  kEGL_CONTEXT_OPENGL_PROFILE_MASK    = 0x30FD;
+    constexpr EGLint  kEGL_CONTEXT_OPENGL_CORE_PROFILE_BIT = 0x0001;
+    constexpr EGLenum kEGL_PLATFORM_SURFACELESS_MESA      = 0x31DD;
+
+    struct EGL {
+        void* lib = nullptr;
+        void*       (*GetProcAddress)(const char*) = nullptr;
+        EGLDisplay  (*GetDisplay)(void*) = nullptr;
+        EGLDisplay  (*GetPlatformDisplayEXT)(EGLenum, void*, const EGLint*) = nullptr;
+        EGLBoolean  (*Initialize)(EGLDisplay, EGLint*, EGLint*) = nullptr;
+        EGLBoolean  (*Terminate)(EGLDisplay) = nullptr;
+        const char* (*QueryString)(EGLDisplay, EGLint) = nullptr;
+        EGLBoolean  (*BindAPI)(EGLenum) = nullptr;
+        EGLBoolean  (*ChooseConfig)(EGLDisplay, const EGLint*, EGLConfig*, EGLint, EGLint*) = nullptr;
+        EGLContext  (*CreateContext)(EGLDisplay, EGLConfig, EGLContext, const EGLint*) = nullptr;
+        EGLBoolean  (*DestroyContext)(EGLDisplay, EGLContext) = nullptr;
+        EGLSurface  (*CreatePbufferSurface)(EGLDisplay, EGLConfig, const EGLint*) = nullptr;
+        EGLBoolean  (*DestroySurface)(EGLDisplay, EGLSurface) = nullptr;
+        EGLBoolean  (*MakeCurrent)(EGLDisplay, EGLSurface, EGLSurface, EGLContext) = nullptr;
+        EGLContext  (*GetCurrentContext)() = nullptr;
+    };
+
+    // one display for the whole process, ref-counted by live contexts
+    std::mutex sEglMutex;
+    EGL        sEgl;
+    EGLDisplay sDisplay = nullptr;
+    int        sDisplayRefs = 0;
+    bool       sSurfaceless = false;   // EGL_KHR_surfaceless_context
+    bool       sNoConfig = false;      // EGL_KHR_no_config_context
+
+    bool HasExt(const char* list, const char* name) {
+        if (!list) return false;
+        const size_t n = std::strlen(name);
+        for (const char* p = list; (p = std::strstr(p, name)); p += n)
+            if ((p == list || p[-1] == ' ') && (p[n] == ' ' || p[n] == '\0')) return true;
+        return false;
+    }
+
+    template <typename T> void Sym(T& fn, const char* name) {
+        fn = reinterpret_cast<T>(dlsym(sEgl.lib, name));
+    }
+
+    bool LoadEGL(std::string& err) {
+        if (sEgl.lib) return true;
+        void* lib = dlopen("libEGL.so.1", RTLD_NOW | RTLD_LOCAL);
+        if (!lib) lib = dlopen("libEGL.so", RTLD_NOW | RTLD_LOCAL);
+        if (!lib) { err = "libEGL not found"; return false; }
+
+        sEgl.lib = lib;
+        Sym(sEgl.GetProcAddress, "eglGetProcAddress");
+        Sym(sEgl.GetDisplay, "eglGetDisplay");
+        Sym(sEgl.Initialize, "eglInitialize");
+        Sym(sEgl.Terminate, "eglTerminate");
+        Sym(sEgl.QueryString, "eglQueryString");
+        Sym(sEgl.BindAPI, "eglBindAPI");
+        Sym(sEgl.ChooseConfig, "eglChooseConfig");
+        Sym(sEgl.CreateContext, "eglCreateContext");
+        Sym(sEgl.DestroyContext, "eglDestroyContext");
+        Sym(sEgl.CreatePbufferSurface, "eglCreatePbufferSurface");
+        Sym(sEgl.DestroySurface, "eglDestroySurface");
+        Sym(sEgl.MakeCurrent, "eglMakeCurrent");
+        Sym(sEgl.GetCurrentContext, "eglGetCurrentContext");
+        if (sEgl.GetProcAddress)
+            sEgl.GetPlatformDisplayEXT = reinterpret_cast<decltype(sEgl.GetPlatformDisplayEXT)>(
+                sEgl.GetProcAddress("eglGetPlatformDisplayEXT"));
+
+        if (!sEgl.GetProcAddress || !sEgl.GetDisplay || !sEgl.Initialize || !sEgl.Terminate ||
+            !sEgl.QueryString || !sEgl.BindAPI || !sEgl.ChooseConfig || !sEgl.CreateContext ||
+            !sEgl.DestroyContext || !sEgl.MakeCurrent || !sEgl.GetCurrentContext) {
+            dlclose(lib); sEgl = EGL{};
+            err = "libEGL is missing core entry points";
+            return false;
+        }
+        return true;
+    }
+
+    bool AcquireDisplay(std::string& err) {
+        if (sDisplayRefs > 0) { ++sDisplayRefs; return true; }
+        if (!LoadEGL(err)) return false;
+
+        // Mesa's surfaceless platform needs no X/Wayland/GBM device; otherwise take
+        // whatever the default display is (NVIDIA's EGL picks a device by itself).
+        const char* clientExt = sEgl.QueryString(nullptr, kEGL_EXTENSIONS);
+        EGLDisplay dpy = nullptr;
+        if (sEgl.GetPlatformDisplayEXT && HasExt(clientExt, "EGL_MESA_platform_surfaceless"))
+            dpy = sEgl.GetPlatformDisplayEXT(kEGL_PLATFORM_SURFACELESS_MESA, nullptr, nullptr);
+        if (!dpy) dpy = sEgl.GetDisplay(nullptr);
+
+        EGLint major = 0, minor = 0;
+        if (!dpy || !sEgl.Initialize(dpy, &major, &minor)) {
+            err = "eglInitialize failed";
+            return false;
+        }
+
+        const char* ext = sEgl.QueryString(dpy, kEGL_EXTENSIONS);
+        sSurfaceless = HasExt(ext, "EGL_KHR_surfaceless_context");
+        sNoConfig    = HasExt(ext, "EGL_KHR_no_config_context");
+        sDisplay = dpy;
+        sDisplayRefs = 1;
+        return true;
+    }
+
+    void ReleaseDisplay() {
+        if (sDisplayRefs > 0 && --sDisplayRefs == 0) {
+            sEgl.Terminate(sDisplay);
+            sDisplay = nullptr;
+        }
+    }
+
+    // pbuffers for drivers without surfaceless support, keyed by context
+    struct Pbuffer { EGLContext ctx; EGLSurface surf; };
+    std::vector<Pbuffer> sPbuffers;
+
+    EGLSurface PbufferFor(EGLContext ctx) {
+        for (auto& p : sPbuffers) if (p.ctx == ctx) return p.surf;
+        return nullptr;
+    }
+}
+
+std::unique_ptr<HeadlessContext> HeadlessContext::Create(int glMajor, int glMinor, std::string& error) {
+    std::lock_guard<std::mutex> lock(sEglMutex);
+    if (!AcquireDisplay(error)) return nullptr;
+
+    if (!sEgl.BindAPI(kEGL_OPENGL_API)) {
+        ReleaseDisplay();
+        error = "EGL has no desktop OpenGL";
+        return nullptr;
+    }
+
+    EGLConfig config = nullptr;
+    const bool needSurface = !sSurfaceless;
+    if (!sNoConfig || needSurface) {
+        const EGLint attribs[] = { kEGL_RENDERABLE_TYPE, kEGL_OPENGL_BIT,
+                                   kEGL_SURFACE_TYPE,    kEGL_PBUFFER_BIT,
+                                   kEGL_NONE };
+        EGLint count = 0;
+        if (!sEgl.ChooseConfig(sDisplay, attribs, &config, 1, &count) || count < 1) {
+            ReleaseDisplay();
+            error = "no EGL config with desktop OpenGL";
+            return nullptr;
+        }
+    }
+
+    if (glMajor <= 0) { glMajor = 3; glMinor = 3; }
+    const EGLint ctxAttribs[] = { kEGL_CONTEXT_MAJOR_VERSION, glMajor,
+                                  kEGL_CONTEXT_MINOR_VERSION, glMinor,
+                                  kEGL_CONTEXT_OPENGL_PROFILE_MASK, kEGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                  kEGL_NONE };
+    EGLContext ctx = sEgl.CreateContext(sDisplay, config, nullptr, ctxAttribs);
+    if (!ctx) {
+        ReleaseDisplay();
+        error = "eglCreateContext failed (GL " + std::to_string(glMajor) + "." + std::to_string(glMinor) + " core)";
+        return nullptr;
+    }
+
+    if (needSurface) {
+        const EGLint pbAttribs[] = { kEGL_WIDTH, 1, kEGL_HEIGHT, 1, kEGL_NONE };
+        EGLSurface surf = sEgl.CreatePbufferSurface ? sEgl.CreatePbufferSurface(sDisplay, config, pbAttribs) : nullptr;
+        if (!surf) {
+            sEgl.DestroyContext(sDisplay, ctx);
+            ReleaseDisplay();
+            error = "eglCreatePbufferSurface failed";
+            return nullptr;
+        }
+        sPbuffers.push_back({ ctx, surf });
+    }
+
+    std::unique_ptr<HeadlessContext> out(new HeadlessContext());
+    out->mDisplay = sDisplay;
+    out->mContext = ctx;
+    return out;
+}
+
+bool HeadlessContext::MakeCurrent() {
+    EGLSurface surf;
+    {
+        std::lock_guard<std::mutex> lock(sEglMutex);
+        surf = PbufferFor(mContext);
+    }
+    sEgl.BindAPI(kEGL_OPENGL_API);   // the bound API is per-thread
+    return sEgl.MakeCurrent(mDisplay, surf, surf, mContext) != 0;
+}
+
+void HeadlessContext::DoneCurrent() {
+    // only let go if it's ours; the thread may have another instance bound
+    if (sEgl.GetCurrentContext() == mContext) sEgl.MakeCurrent(mDisplay, nullptr, nullptr, nullptr);
+}
+
+void* HeadlessContext::GetProcAddress(const char* name) {
+    return sEgl.GetProcAddress ? sEgl.GetProcAddress(name) : nullptr;
+}
+
+HeadlessContext::~HeadlessContext() {
+    DoneCurrent();
+    std::lock_guard<std::mutex> lock(sEglMutex);
+    for (size_t i = 0; i < sPbuffers.size(); ++i) {
+        if (sPbuffers[i].ctx != mContext) continue;
+        sEgl.DestroySurface(mDisplay, sPbuffers[i].surf);
+        sPbuffers.erase(sPbuffers.begin() + i);
+        break;
+    }
+    sEgl.DestroyContext(mDisplay, mContext);
+    ReleaseDisplay();
+}
+}
+
+#else
+
+namespace Euclid
+{
+std::unique_ptr<HeadlessContext> HeadlessContext::Create(int, int, std::string& error) {
+    error = "headless contexts are only available on Linux (EGL)";
+    return nullptr;
+}
+bool  HeadlessContext::MakeCurrent() { return false; }
+void  HeadlessContext::DoneCurrent() {}
+void* HeadlessContext::GetProcAddress(const char*) { return nullptr; }
+HeadlessContext::~HeadlessContext() = default;
+}
+
+#endif
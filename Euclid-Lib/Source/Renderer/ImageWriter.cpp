@@ -0,0 +1,302 @@
+#include "Renderer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Euclid
+{
+namespace {
+    // ---- CRC32 (PNG chunks) ----
+    struct CrcTable {
+        uint32_t t[256];
+        CrcTable() {
+            for (uint32_t n = 0; n < 256; ++n) {
+                uint32_t c = n;
+                for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : (c >> 1);
+                t[n] = c;
+            }
+        }
+    };
+    const CrcTable kCrc;
+
+    uint32_t Crc32(uint32_t crc, const uint8_t* p, size_t n) {
+        crc = ~crc;
+        while (n--) crc = kCrc.t[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    void PutBE32(uint8_t* p, uint32_t v) {
+        p[0] = uint8_t(v >> 24); p[1] = uint8_t(v >> 16); p[2] = uint8_t(v >> 8); p[3] = uint8_t(v);
+    }
+
+    // ---- deflate tables (RFC 1951, fixed Huffman) ----
+    constexpr int kLenBase[29]  = {3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258};
+    constexpr int kLenExtra[29] = {0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0};
+    constexpr int kDistBase[30] = {1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,
+                                   1025,1537,2049,3073,4097,6145,8193,12289,16385,24577};
+    constexpr int kDistExtra[30]= {0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13};
+
+    constexpr int    kHashBits  = 15;
+    constexpr size_t kWindow    = 32768;
+    constexpr size_t kMaxMatch  = 258;
+    constexpr size_t kIDATBytes = 1u << 16;
+
+    inline uint32_t Hash3(const uint8_t* p) {
+        return ((uint32_t(p[0]) << 16 | uint32_t(p[1]) << 8 | p[2]) * 2654435761u) >> (32 - kHashBits);
+    }
+}
+
+// -------- PngWriter --------
+bool PngWriter::Open(const char* path, int width, int height, int channels) {
+    Close();
+    if (!path || width <= 0 || height <= 0 || (channels != 3 && channels != 4)) return false;
+
+    mFile = fopen(path, "wb");
+    if (!mFile) return false;
+
+    mWidth = width; mHeight = height; mChannels = channels; mRows = 0;
+    mPrev.assign((size_t)width * channels, 0);
+    mLine.resize(1 + (size_t)width * channels);
+    mOut.clear(); mOut.reserve(kIDATBytes + 1024);
+    mBitBuf = 0; mBitCount = 0;
+    mAdlerA = 1; mAdlerB = 0;
+    mWin.clear(); mWinBase = 0;
+    mHead.assign(size_t(1) << kHashBits, -1);
+    mOk = true;
+
+    static const uint8_t sig[8] = {0x89,'P','N','G','\r','\n',0x1A,'\n'};
+    fwrite(sig, 1, 8, mFile);
+
+    uint8_t ihdr[13];
+    PutBE32(ihdr + 0, (uint32_t)width);
+    PutBE32(ihdr + 4, (uint32_t)height);
+    ihdr[8]  = 8;                          // bit depth
+    ihdr[9]  = channels == 4 ? 6 : 2;      // RGBA / RGB
+    ihdr[10] = 0; ihdr[11] = 0; ihdr[12] = 0;
+    WriteChunk("IHDR", ihdr, sizeof(ihdr));
+
+    // zlib header (deflate, 32K window) + one final fixed-Huffman block for the whole stream
+    mOut.push_back(0x78); mOut.push_back(0x01);
+    PutBits(1, 1);  // BFINAL
+    PutBits(1, 2);  // BTYPE = fixed
+    return true;
+}
+
+bool PngWriter::WriteRow(const uint8_t* row) {
+    if (!mFile || !mOk || !row || mRows >= mHeight) return false;
+
+    // "Up" filter: renders are mostly flat background, this makes long zero runs
+    const size_t n = (size_t)mWidth * mChannels;
+    mLine[0] = 2;
+    for (size_t i = 0; i < n; ++i) mLine[1 + i] = uint8_t(row[i] - mPrev[i]);
+    std::memcpy(mPrev.data(), row, n);
+
+    // adler32 over the uncompressed stream
+    const uint8_t* p = mLine.data(); size_t left = mLine.size();
+    while (left) {
+        size_t k = std::min<size_t>(left, 5552);
+        left -= k;
+        while (k--) { mAdlerA += *p++; mAdlerB += mAdlerA; }
+        mAdlerA %= 65521; mAdlerB %= 65521;
+    }
+
+    Deflate(mLine.data(), mLine.size());
+    FlushIDAT(false);
+    ++mRows;
+    return mOk;
+}
+
+bool PngWriter::Close() {
+    if (!mFile) return false;
+
+    bool ok = mOk && mRows == mHeight;
+    if (mOk) {
+        PutLiteral(256);                                  // end of block
+        if (mBitCount > 0) PutBits(0, 8 - mBitCount);     // pad to byte
+        uint8_t adler[4]; PutBE32(adler, (mAdlerB << 16) | mAdlerA);
+        mOut.insert(mOut.end(), adler, adler + 4);
+        FlushIDAT(true);
+        WriteChunk("IEND", nullptr, 0);
+    }
+    ok = (fclose(mFile) == 0) && ok;
+    mFile = nullptr;
+    mOk = false;
+
+    std::vector<uint8_t>().swap(mWin);
+    std::vector<int64_t>().swap(mHead);
+    return ok;
+}
+
+PngWriter::~PngWriter() {
+    Close();
+}
+
+void PngWriter::WriteChunk(const char type[4], const uint8_t* data, size_t len) {
+    uint8_t hdr[8];
+    PutBE32(hdr, (uint32_t)len);
+    std::memcpy(hdr + 4, type, 4);
+    uint32_t crc = Crc32(0, hdr + 4, 4);
+    if (len) crc = Crc32(crc, data, len);
+    uint8_t tail[4]; PutBE32(tail, crc);
+
+    if (fwrite(hdr, 1, 8, mFile) != 8) mOk = false;
+    if (len && fwrite(data, 1, len, mFile) != len) mOk = false;
+    if (fwrite(tail, 1, 4, mFile) != 4) mOk = false;
+}
+
+void PngWriter::FlushIDAT(bool force) {
+    if (mOut.empty() || (!force && mOut.size() < kIDATBytes)) return;
+    WriteChunk("IDAT", mOut.data(), mOut.size());
+    mOut.clear();
+}
+
+// Greedy LZ77 over a sliding 32K window, one hash probe per position.
+void PngWriter::Deflate(const uint8_t* data, size_t len) {
+    const size_t start = mWin.size();
+    mWin.insert(mWin.end(), data, data + len);
+    const size_t n = mWin.size();
+
+    size_t i = start;
+    while (i < n) {
+        size_t bestLen = 0, bestDist = 0;
+        if (i + 3 <= n) {
+            const uint32_t h = Hash3(&mWin[i]);
+            const int64_t cand = mHead[h];
+            const size_t  abs  = mWinBase + i;
+            mHead[h] = (int64_t)abs;
+            if (cand >= (int64_t)mWinBase && abs - (size_t)cand <= kWindow) {
+                const size_t c = (size_t)cand - mWinBase;
+                const size_t maxLen = std::min(kMaxMatch, n - i);
+                size_t l = 0;
+                while (l < maxLen && mWin[c + l] == mWin[i + l]) ++l;
+                if (l >= 3) { bestLen = l; bestDist = abs - (size_t)cand; }
+            }
+        }
+
+        if (bestLen) {
+            PutMatch((int)bestLen, (int)bestDist);
+            for (size_t k = 1; k < bestLen && i + k + 3 <= n; ++k)
+                mHead[Hash3(&mWin[i + k])] = (int64_t)(mWinBase + i + k);
+            i += bestLen;
+        } else {
+            PutLiteral(mWin[i]);
+            ++i;
+        }
+    }
+
+    // keep only the last 32K as history
+    if (mWin.size() > 2 * kWindow) {
+        const size_t drop = mWin.size() - kWindow;
+        mWin.erase(mWin.begin(), mWin.begin() + drop);
+        mWinBase += drop;
+    }
+}
+
+void PngWriter::PutBits(uint32_t bits, int count) {
+    mBitBuf |= bits << mBitCount;
+    mBitCount += count;
+    while (mBitCount >= 8) {
+        mOut.push_back(uint8_t(mBitBuf & 0xFF));
+        mBitBuf >>= 8;
+        mBitCount -= 8;
+    }
+}
+
+// Huffman codes are stored MSB-first, the bit stream is LSB-first.
+void PngWriter::PutHuff(uint32_t code, int len) {
+    uint32_t rev = 0;
+    for (int i = 0; i < len; ++i) { rev = (rev << 1) | (code & 1); code >>= 1; }
+    PutBits(rev, len);
+}
+
+void PngWriter::PutLiteral(int v) {
+    if      (v < 144) PutHuff(0x30  + v,         8);
+    else if (v < 256) PutHuff(0x190 + (v - 144), 9);
+    else if (v < 280) PutHuff(v - 256,           7);
+    else              PutHuff(0xC0  + (v - 280), 8);
+}
+
+void PngWriter::PutMatch(int len, int dist) {
+    int lc = 28;
+    while (kLenBase[lc] > len) --lc;
+    PutLiteral(257 + lc);
+    if (kLenExtra[lc]) PutBits(uint32_t(len - kLenBase[lc]), kLenExtra[lc]);
+
+    int dc = 29;
+    while (kDistBase[dc] > dist) --dc;
+    PutHuff((uint32_t)dc, 5);
+    if (kDistExtra[dc]) PutBits(uint32_t(dist - kDistBase[dc]), kDistExtra[dc]);
+}
+
+// -------- one-shot helpers --------
+bool WritePNG(const char* path, int width, int height, int channels, const uint8_t* pixels) {
+    if (!pixels) return false;
+    PngWriter png;
+    if (!png.Open(path, width, height, channels)) return false;
+    const size_t stride = (size_t)width * channels;
+    for (int y = 0; y < height; ++y) png.WriteRow(pixels + (size_t)y * stride);
+    return png.Close();
+}
+
+// QOI ("Quite OK Image"): single pass, no entropy coder -> much cheaper than PNG
+bool WriteQOI(const char* path, int width, int height, int channels, const uint8_t* pixels) {
+    if (!path || !pixels || width <= 0 || height <= 0 || (channels != 3 && channels != 4)) return false;
+
+    std::vector<uint8_t> out;
+    out.reserve(14 + (size_t)width * height * (channels + 1) / 2 + 8);
+
+    uint8_t hdr[14] = {'q','o','i','f'};
+    PutBE32(hdr + 4, (uint32_t)width);
+    PutBE32(hdr + 8, (uint32_t)height);
+    hdr[12] = (uint8_t)channels;
+    hdr[13] = 0;  // sRGB with linear alpha
+    out.insert(out.end(), hdr, hdr + 14);
+
+    struct Px { uint8_t r, g, b, a; };
+    Px index[64] = {};
+    Px prev{0, 0, 0, 255};
+    int run = 0;
+
+    const size_t count = (size_t)width * height;
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* p = pixels + i * channels;
+        Px px{p[0], p[1], p[2], channels == 4 ? p[3] : uint8_t(255)};
+
+        if (px.r == prev.r && px.g == prev.g && px.b == prev.b && px.a == prev.a) {
+            if (++run == 62 || i + 1 == count) { out.push_back(uint8_t(0xC0 | (run - 1))); run = 0; }
+            continue;
+        }
+        if (run > 0) { out.push_back(uint8_t(0xC0 | (run - 1))); run = 0; }
+
+        const int h = (px.r * 3 + px.g * 5 + px.b * 7 + px.a * 11) % 64;
+        if (index[h].r == px.r && index[h].g == px.g && index[h].b == px.b && index[h].a == px.a) {
+            out.push_back(uint8_t(h));
+        } else {
+            index[h] = px;
+            if (px.a == prev.a) {
+                const int8_t dr = int8_t(px.r - prev.r), dg = int8_t(px.g - prev.g), db = int8_t(px.b - prev.b);
+                const int8_t drg = int8_t(dr - dg), dbg = int8_t(db - dg);
+                if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2) {
+                    out.push_back(uint8_t(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                } else if (drg > -9 && drg < 8 && dg > -33 && dg < 32 && dbg > -9 && dbg < 8) {
+                    out.push_back(uint8_t(0x80 | (dg + 32)));
+                    out.push_back(uint8_t((drg + 8) << 4 | (dbg + 8)));
+                } else {
+                    out.push_back(0xFE); out.push_back(px.r); out.push_back(px.g); out.push_back(px.b);
+                }
+            } else {
+                out.push_back(0xFF); out.push_back(px.r); out.push_back(px.g); out.push_back(px.b); out.push_back(px.a);
+            }
+        }
+        prev = px;
+    }
+    static const uint8_t kEnd[8] = {0,0,0,0,0,0,0,1};
+    out.insert(out.end(), kEnd, kEnd + 8);
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(out.data(), 1, out.size(), f) == out.size();
+    ok = (fclose(f) == 0) && ok;
+    return ok;
+}
+}
@@ -0,0 +1,772 @@
+#include "IndirectScene.hpp"
+#include "GLDebug.hpp"
+#include "Profiler.hpp"
+#include "Renderer.hpp"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace Euclid
+{
+namespace {
+    constexpr uint32_t kPrimitiveBuckets = EUCLID_SHAPE_CUSTOM;   // CUBE..CIRCLE, then one per import
+    constexpr uint32_t kNotDrawn = 0xFFFFFFFFu;
+    constexpr GLuint   kGroupSize = 64;
+    constexpr size_t   kVertexBytes = 6 * sizeof(float);           // position + color, as UploadMesh lays them out
+
+    struct IndirectCommand {   // DrawElementsIndirectCommand
+        uint32_t count, instanceCount, firstIndex;
+        int32_t  baseVertex;
+        uint32_t baseInstance;
+    };
+    struct GpuMeshlet {        // std430 Meshlet, indices absolute in the arena
+        glm::vec4 sphere, cone;
+        uint32_t  count, firstIndex;
+        int32_t   baseVertex;
+        uint32_t  pad;
+    };
+    struct ClusterRef {
+        uint32_t slot, meshlet;
+    };
+
+    // Cull modes
+    constexpr uint32_t kFrustumOnly = 0;   // everything in view -> set 0
+    constexpr uint32_t kLastVisible = 1;   // in view and visible last frame -> set 0
+    constexpr uint32_t kOcclusion   = 2;   // the rest, against the depth pyramid -> set 1; updates flags
+
+    // Both cull passes: world-space frustum test and the depth-pyramid test
+    constexpr const char* kCullCommon =
+    R"(
+    #version 430 core
+    layout (local_size_x = 64) in;
+
+    struct Command { uint count; uint instanceCount; uint firstIndex; int baseVertex; uint baseInstance; };
+
+    layout (std430, binding = 0) readonly buffer Worlds { mat4 uWorld[]; };
+    layout (binding = 0) uniform sampler2D uPyramid;
+
+    uniform vec4  uPlanes[6];
+    uniform uint  uCount;
+    uniform uint  uMode;
+    uniform mat4  uViewProj;
+    uniform ivec2 uViewportPx;
+    uniform int   uLevels;
+
+    // box given as world center + half extents
+    bool Outside(vec3 c, vec3 e)
+    {
+        for (int p = 0; p < 6; ++p)
+            if (dot(uPlanes[p].xyz, c) + uPlanes[p].w < -dot(abs(uPlanes[p].xyz), e)) return true;
+        return false;
+    }
+
+    // Box behind what the depth buffer already holds over its whole screen rect?
+    bool Occluded(vec3 c, vec3 e)
+    {
+        vec2 lo = vec2(1.0), hi = vec2(-1.0);
+        float zmin = 1.0;
+        for (int k = 0; k < 8; ++k) {
+            vec3 s = vec3((k & 1) != 0 ? 1.0 : -1.0, (k & 2) != 0 ? 1.0 : -1.0, (k & 4) != 0 ? 1.0 : -1.0);
+            vec4 p = uViewProj * vec4(c + e * s, 1.0);
+            if (p.w <= 1e-5) return false;   // reaches behind the camera
+            vec3 ndc = p.xyz / p.w;
+            lo = min(lo, ndc.xy); hi = max(hi, ndc.xy); zmin = min(zmin, ndc.z);
+        }
+        ivec2 p0 = clamp(ivec2(floor((lo * 0.5 + 0.5) * vec2(uViewportPx))), ivec2(0), uViewportPx - 1);
+        ivec2 p1 = clamp(ivec2(floor((hi * 0.5 + 0.5) * vec2(uViewportPx))), ivec2(0), uViewportPx - 1);
+
+        // a level-L texel covers 2^(L+1) pixels: take the first level where the rect spans 2x2 texels
+        int L = 0;
+        while (L < uLevels - 1 && any(greaterThan((p1 >> (L + 1)) - (p0 >> (L + 1)), ivec2(1)))) ++L;
+        // level size from the uniform: textureSize with a per-thread lod isn't reliable everywhere
+        ivec2 last = max((uViewportPx / 2) >> L, ivec2(1)) - 1;
+        ivec2 t0 = min(p0 >> (L + 1), last), t1 = min(p1 >> (L + 1), last);
+        float far = 0.0;
+        for (int y = t0.y; y <= t1.y; ++y)
+            for (int x = t0.x; x <= t1.x; ++x)
+                far = max(far, texelFetch(uPyramid, ivec2(x, y), L).r);
+        return zmin * 0.5 + 0.5 > far + 1e-6;
+    }
+    )";
+
+    // One thread per slot. Survivors take the next instance of their mesh's command in
+    // their set; baseInstance is where that mesh's range of the visible list starts.
+    // Clustered objects only leave their verdict for the cluster pass.
+    constexpr const char* kCullCS =
+    R"(
+    struct Info { vec3 center; uint bucket; vec3 extent; uint clustered; };
+
+    layout (std430, binding = 1) readonly  buffer Infos    { Info uInfo[]; };
+    layout (std430, binding = 2)           buffer Commands { Command uCmd[]; };
+    layout (std430, binding = 3) writeonly buffer Visible  { uint uVisible[]; };
+    layout (std430, binding = 4)           buffer Flags    { uint uWasVisible[]; };
+    layout (std430, binding = 5)           buffer Passed   { uint uPassed[]; };
+
+    uniform uint uBuckets;
+
+    void Append(uint bucket, uint set, uint slot)
+    {
+        uint c = bucket + set * uBuckets;
+        uint n = atomicAdd(uCmd[c].instanceCount, 1u);
+        uVisible[uCmd[c].baseInstance + n] = slot;
+    }
+
+    void main()
+    {
+        uint i = gl_GlobalInvocationID.x;
+        if (i >= uCount) return;
+        Info info = uInfo[i];
+        if (info.bucket == 0xFFFFFFFFu) return;
+
+        // local box -> world center + extents (Arvo), same test as the multi-view path
+        mat4 M = uWorld[i];
+        vec3 c = (M * vec4(info.center, 1.0)).xyz;
+        vec3 e = abs(M[0].xyz) * info.extent.x + abs(M[1].xyz) * info.extent.y + abs(M[2].xyz) * info.extent.z;
+        bool inView = !Outside(c, e);
+
+        bool was = uMode != 0u && uWasVisible[i] != 0u;
+        bool draw = inView && (uMode == 0u || was);
+        bool visible = false;
+        if (uMode == 2u) {
+            // drawn already if it was visible; re-test anyway so hidden ones drop out next frame
+            visible = inView && !Occluded(c, e);
+            uWasVisible[i] = visible ? 1u : 0u;
+            draw = visible && !was;
+        }
+        // clustered: bit 0 drawn in set 0, bit 1 visible to the occlusion pass
+        if (info.clustered != 0u) uPassed[i] = uMode == 2u ? (uPassed[i] & 1u) | (visible ? 2u : 0u) : (draw ? 1u : 0u);
+        else if (draw) Append(info.bucket, uMode == 2u ? 1u : 0u, i);
+    }
+    )";
+
+    // One thread per cluster of an object that passed. Same verdicts as the object pass,
+    // plus the backface cone; every cluster rewrites its command with 0 or 1 instances.
+    constexpr const char* kClusterCS =
+    R"(
+    struct Meshlet    { vec4 sphere; vec4 cone; uint count; uint firstIndex; int baseVertex; uint pad; };
+    struct ClusterRef { uint slot; uint meshlet; };
+
+    layout (std430, binding = 1) readonly  buffer Meshlets { Meshlet uMeshlet[]; };
+    layout (std430, binding = 2) writeonly buffer Commands { Command uCmd[]; };
+    layout (std430, binding = 3) readonly  buffer Refs     { ClusterRef uRef[]; };
+    layout (std430, binding = 4)           buffer Flags    { uint uWasVisible[]; };
+    layout (std430, binding = 5) readonly  buffer Passed   { uint uPassed[]; };
+
+    uniform vec4 uEye;     // homogeneous, w >= 0 (0: orthographic)
+    uniform bool uCones;
+
+    // cone test in the mesh's own space, where the cone is valid (see Meshlet)
+    bool FacesAway(mat4 M, Meshlet m)
+    {
+        float det = determinant(mat3(M));
+        if (!uCones || m.cone.w >= 1.0 || abs(det) < 1e-12) return false;
+        vec4 eye = inverse(M) * uEye;
+        vec3 v = m.sphere.xyz * eye.w - eye.xyz;
+        return dot(v, m.cone.xyz) >= m.cone.w * length(v) + m.sphere.w * eye.w;
+    }
+
+    void main()
+    {
+        uint r = gl_GlobalInvocationID.x;
+        if (r >= uCount) return;
+        ClusterRef ref = uRef[r];
+        Meshlet m = uMeshlet[ref.meshlet];
+        uint passed = uPassed[ref.slot];
+        mat4 M = uWorld[ref.slot];
+
+        // sphere -> world, radius by the largest axis scale
+        vec3 c = (M * vec4(m.sphere.xyz, 1.0)).xyz;
+        float rad = m.sphere.w * sqrt(max(dot(M[0].xyz, M[0].xyz), max(dot(M[1].xyz, M[1].xyz), dot(M[2].xyz, M[2].xyz))));
+        bool inView = uMode == 2u ? (passed & 2u) != 0u : passed != 0u;
+        for (int p = 0; p < 6 && inView; ++p)
+            inView = dot(uPlanes[p].xyz, c) + uPlanes[p].w >= -rad * length(uPlanes[p].xyz);
+        inView = inView && !FacesAway(M, m);
+
+        bool was = uMode != 0u && uWasVisible[r] != 0u;
+        bool draw = inView && (uMode == 0u || was);
+        if (uMode == 2u) {
+            bool visible = inView && !Occluded(c, vec3(rad));
+            uWasVisible[r] = visible ? 1u : 0u;
+            draw = visible && !((passed & 1u) != 0u && was);   // not if set 0 had it
+        }
+        uint set = uMode == 2u ? 1u : 0u;
+        uCmd[r + set * uCount] = Command(m.count, draw ? 1u : 0u, m.firstIndex, m.baseVertex, r);
+    }
+    )";
+
+    // Max of each 2x2 block of the level above; the last row/column also takes the odd
+    // one out, so every source texel is covered.
+    constexpr const char* kReduceCS =
+    R"(
+    #version 430 core
+    layout (local_size_x = 8, local_size_y = 8) in;
+
+    layout (binding = 0) uniform sampler2D uSource;   // depth copy for level 0, else the pyramid
+    layout (r32f, binding = 0) writeonly uniform image2D uDest;
+    uniform int uSourceLevel;
+
+    void main()
+    {
+        ivec2 dst = ivec2(gl_GlobalInvocationID.xy);
+        ivec2 size = imageSize(uDest);
+        if (any(greaterThanEqual(dst, size))) return;
+        ivec2 src = textureSize(uSource, uSourceLevel);
+        ivec2 lo = dst * 2;
+        ivec2 hi = ivec2(dst.x == size.x - 1 ? src.x - 1 : lo.x + 1,
+                         dst.y == size.y - 1 ? src.y - 1 : lo.y + 1);
+        hi = min(hi, src - 1);
+        float d = 0.0;
+        for (int y = lo.y; y <= hi.y; ++y)
+            for (int x = lo.x; x <= hi.x; ++x)
+                d = max(d, texelFetch(uSource, ivec2(x, y), uSourceLevel).r);
+        imageStore(uDest, dst, vec4(d));
+    }
+    )";
+
+    // The slot arrives as a per-instance attribute, so baseInstance offsets it for free.
+    // Culling can't change per draw of an MDI, so single-sided discards back faces itself,
+    // the mirrored ones (negative determinant) seen from the other side.
+    constexpr const char* kIndirectVS =
+    R"(
+    #version 430 core
+    layout (location = 0) in vec3 aPos;
+    layout (location = 1) in vec3 aColor;
+    layout (location = 2) in uint aSlot;
+
+    layout (std430, binding = 0) readonly buffer Worlds { mat4 uWorld[]; };
+
+    uniform mat4 uView;
+    uniform mat4 uProjection;
+
+    out vec3 vColor;
+    flat out int vMirrored;
+
+    void main()
+    {
+        gl_Position = uProjection * uView * uWorld[aSlot] * vec4(aPos, 1.0);
+        vColor = aColor;
+        vMirrored = determinant(mat3(uWorld[aSlot])) < 0.0 ? 1 : 0;
+    }
+    )";
+
+    constexpr const char* kIndirectFS =
+    R"(
+    #version 430 core
+    in vec3 vColor;
+    flat in int vMirrored;
+    out vec4 FragColor;
+
+    uniform bool uSingleSided;
+
+    void main()
+    {
+        if (uSingleSided && gl_FrontFacing == (vMirrored != 0)) discard;
+        FragColor = vec4(vColor, 1.0);
+    }
+    )";
+}
+
+bool IndirectScene::Supported() {
+    return GLAD_GL_VERSION_4_3 && glad_glDispatchCompute && glad_glMultiDrawElementsIndirect &&
+           glad_glBindBufferBase && glad_glCopyBufferSubData && glad_glVertexAttribIPointer &&
+           glad_glTexStorage2D && glad_glBindImageTexture && glad_glCopyTexSubImage2D && glad_glClearBufferData;
+}
+
+bool IndirectScene::Init(ProgramCache& cache) {
+    if (mReady) return true;
+    if (!Supported()) return false;
+
+    cache.BuildCompute(mCull, "indirect_cull", (std::string(kCullCommon) + kCullCS).c_str());
+    cache.BuildCompute(mClusterCull, "indirect_cluster_cull", (std::string(kCullCommon) + kClusterCS).c_str());
+    cache.BuildCompute(mReduce, "indirect_reduce", kReduceCS);
+    cache.Build(mDraw, "indirect_draw", kIndirectVS, kIndirectFS);
+    if (!mCull.IsLinked() || !mClusterCull.IsLinked() || !mReduce.IsLinked() || !mDraw.IsLinked()) return false;
+    mPlanesLoc   = glGetUniformLocation(mCull.GetID(), "uPlanes");
+    mCountLoc    = glGetUniformLocation(mCull.GetID(), "uCount");
+    mModeLoc     = glGetUniformLocation(mCull.GetID(), "uMode");
+    mBucketsLoc  = glGetUniformLocation(mCull.GetID(), "uBuckets");
+    mViewProjLoc = glGetUniformLocation(mCull.GetID(), "uViewProj");
+    mViewportLoc = glGetUniformLocation(mCull.GetID(), "uViewportPx");
+    mLevelsLoc   = glGetUniformLocation(mCull.GetID(), "uLevels");
+    mSourceLevelLoc = glGetUniformLocation(mReduce.GetID(), "uSourceLevel");
+    mClusterPlanesLoc   = glGetUniformLocation(mClusterCull.GetID(), "uPlanes");
+    mClusterCountLoc    = glGetUniformLocation(mClusterCull.GetID(), "uCount");
+    mClusterModeLoc     = glGetUniformLocation(mClusterCull.GetID(), "uMode");
+    mClusterViewProjLoc = glGetUniformLocation(mClusterCull.GetID(), "uViewProj");
+    mClusterViewportLoc = glGetUniformLocation(mClusterCull.GetID(), "uViewportPx");
+    mClusterLevelsLoc   = glGetUniformLocation(mClusterCull.GetID(), "uLevels");
+    mEyeLoc             = glGetUniformLocation(mClusterCull.GetID(), "uEye");
+    mConesLoc           = glGetUniformLocation(mClusterCull.GetID(), "uCones");
+    mViewLoc   = glGetUniformLocation(mDraw.GetID(), "uView");
+    mProjLoc   = glGetUniformLocation(mDraw.GetID(), "uProjection");
+    mSingleSidedLoc = glGetUniformLocation(mDraw.GetID(), "uSingleSided");
+
+    unsigned int buffers[13];
+    glGenBuffers(13, buffers);
+    mVBO = buffers[0]; mEBO = buffers[1]; mWorlds = buffers[2]; mInfo = buffers[3];
+    mVisible = buffers[4]; mCommands = buffers[5]; mTemplate = buffers[6]; mFlags = buffers[7];
+    mMeshlets = buffers[8]; mPassed = buffers[9]; mClusterRefs = buffers[10];
+    mClusterCommands = buffers[11]; mClusterFlags = buffers[12];
+
+    // buffer names stay, only their storage is replaced, so the VAO is set up once
+    glGenVertexArrays(1, &mVAO);
+    glBindVertexArray(mVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, (GLsizei)kVertexBytes, (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, (GLsizei)kVertexBytes, (void*)(3 * sizeof(float)));
+    glBindBuffer(GL_ARRAY_BUFFER, mVisible);
+    glEnableVertexAttribArray(2);
+    glVertexAttribIPointer(2, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void*)0);
+    glVertexAttribDivisor(2, 1);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mEBO);
+
+    // same arena, slot from the cluster's (slot, meshlet) entry: baseInstance is the cluster
+    glGenVertexArrays(1, &mClusterVAO);
+    glBindVertexArray(mClusterVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, (GLsizei)kVertexBytes, (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, (GLsizei)kVertexBytes, (void*)(3 * sizeof(float)));
+    glBindBuffer(GL_ARRAY_BUFFER, mClusterRefs);
+    glEnableVertexAttribArray(2);
+    glVertexAttribIPointer(2, 1, GL_UNSIGNED_INT, sizeof(ClusterRef), (void*)0);
+    glVertexAttribDivisor(2, 1);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mEBO);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    GLDebug::Label(GL_VERTEX_ARRAY, mVAO, "Indirect scene");
+    GLDebug::Label(GL_BUFFER, mVBO, "Indirect scene", "vertices");
+    GLDebug::Label(GL_BUFFER, mEBO, "Indirect scene", "indices");
+    GLDebug::Label(GL_BUFFER, mWorlds, "Indirect scene", "worlds");
+    GLDebug::Label(GL_BUFFER, mInfo, "Indirect scene", "bounds");
+    GLDebug::Label(GL_BUFFER, mVisible, "Indirect scene", "visible");
+    GLDebug::Label(GL_BUFFER, mCommands, "Indirect scene", "commands");
+    GLDebug::Label(GL_BUFFER, mTemplate, "Indirect scene", "command template");
+    GLDebug::Label(GL_BUFFER, mFlags, "Indirect scene", "visibility");
+    GLDebug::Label(GL_VERTEX_ARRAY, mClusterVAO, "Indirect scene", "clusters");
+    GLDebug::Label(GL_BUFFER, mMeshlets, "Indirect scene", "meshlets");
+    GLDebug::Label(GL_BUFFER, mPassed, "Indirect scene", "clustered objects");
+    GLDebug::Label(GL_BUFFER, mClusterRefs, "Indirect scene", "clusters");
+    GLDebug::Label(GL_BUFFER, mClusterCommands, "Indirect scene", "cluster commands");
+    GLDebug::Label(GL_BUFFER, mClusterFlags, "Indirect scene", "cluster visibility");
+
+    mMeshVersion = mVersion = 0;
+    mFlagsValid = false;
+    mReady = true;
+    return true;
+}
+
+void IndirectScene::Release() {
+    if (mVAO) { glDeleteVertexArrays(1, &mVAO); mVAO = 0; }
+    if (mClusterVAO) { glDeleteVertexArrays(1, &mClusterVAO); mClusterVAO = 0; }
+    const unsigned int buffers[13] = { mVBO, mEBO, mWorlds, mInfo, mVisible, mCommands, mTemplate, mFlags,
+                                       mMeshlets, mPassed, mClusterRefs, mClusterCommands, mClusterFlags };
+    if (mVBO) glDeleteBuffers(13, buffers);
+    mVBO = mEBO = mWorlds = mInfo = mVisible = mCommands = mTemplate = mFlags = 0;
+    mMeshlets = mPassed = mClusterRefs = mClusterCommands = mClusterFlags = 0;
+    const unsigned int textures[2] = { mDepthTex, mPyramid };
+    if (mDepthTex) glDeleteTextures(2, textures);
+    mDepthTex = mPyramid = 0;
+    mDepthW = mDepthH = mLevels = 0;
+    mBuckets.clear();
+    mCount = mWorldsCap = mClusters = 0;
+    mGeomMem.Set(0);
+    mTableMem.Set(0);
+    mDepthMem.Set(0);
+    mReady = false;
+}
+
+// -------- Sync --------
+void IndirectScene::SyncArena(ObjectStore& objs) {
+    EUCLID_ZONE("Indirect: arena");
+    const size_t buckets = kPrimitiveBuckets + objs.CustomMeshCount();
+    std::vector<const SharedMesh*> meshes(buckets, nullptr);
+    size_t vertices = 0, indices = 0;
+    for (size_t b = 0; b < buckets; ++b) {
+        const SharedMesh* m = b < kPrimitiveBuckets ? objs.BuiltPrimitive((EuclidShapeType)b)
+                                                    : objs.GetCustomMesh(int(b - kPrimitiveBuckets));
+        if (!m || !m->vao || !m->indexCount) continue;
+        meshes[b] = m;
+        vertices += (size_t)m->vertexCount;
+        indices += (size_t)m->indexCount;
+    }
+
+    // every mesh already sits in its own buffers: copy them across on the GPU
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mVBO);
+    glBufferData(GL_COPY_WRITE_BUFFER, std::max<size_t>(vertices, 1) * kVertexBytes, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mEBO);
+    glBufferData(GL_COPY_WRITE_BUFFER, std::max<size_t>(indices, 1) * sizeof(uint32_t), nullptr, GL_STATIC_DRAW);
+
+    mBuckets.assign(buckets, Bucket{});
+    std::vector<uint32_t> sequence;   // non-indexed meshes get 0..n-1
+    uint32_t firstVertex = 0, firstIndex = 0;
+    for (size_t b = 0; b < buckets; ++b) {
+        const SharedMesh* m = meshes[b];
+        if (!m) continue;
+        Bucket& k = mBuckets[b];
+        k.indexCount = (uint32_t)m->indexCount;
+        k.firstIndex = firstIndex;
+        k.baseVertex = (int32_t)firstVertex;
+
+        glBindBuffer(GL_COPY_READ_BUFFER, m->vbo);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, mVBO);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0,
+                            (GLintptr)(firstVertex * kVertexBytes), (GLsizeiptr)(m->vertexCount * kVertexBytes));
+        glBindBuffer(GL_COPY_WRITE_BUFFER, mEBO);
+        if (m->indexed) {
+            glBindBuffer(GL_COPY_READ_BUFFER, m->ebo);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0,
+                                (GLintptr)(firstIndex * sizeof(uint32_t)), (GLsizeiptr)(k.indexCount * sizeof(uint32_t)));
+        } else {
+            sequence.resize(k.indexCount);
+            for (uint32_t i = 0; i < k.indexCount; ++i) sequence[i] = i;
+            glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)(firstIndex * sizeof(uint32_t)),
+                            (GLsizeiptr)(k.indexCount * sizeof(uint32_t)), sequence.data());
+        }
+        firstVertex += (uint32_t)m->vertexCount;
+        firstIndex += k.indexCount;
+    }
+
+    // imports' meshlets, pointing into the arena
+    std::vector<GpuMeshlet> meshlets;
+    for (size_t b = kPrimitiveBuckets; b < buckets; ++b) {
+        const SharedMesh* m = meshes[b];
+        if (!m || !m->indexed || m->meshlets.empty()) continue;
+        Bucket& k = mBuckets[b];
+        k.firstMeshlet = (uint32_t)meshlets.size();
+        k.meshlets = (uint32_t)m->meshlets.size();
+        for (const Meshlet& ml : m->meshlets)
+            meshlets.push_back({ glm::vec4(ml.center, ml.radius), glm::vec4(ml.coneAxis, ml.coneCutoff),
+                                 ml.indexCount, k.firstIndex + ml.firstIndex, k.baseVertex, 0 });
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mMeshlets);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<size_t>(meshlets.size(), 1) * sizeof(GpuMeshlet), meshlets.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    mGeomMem.Set(vertices * kVertexBytes + indices * sizeof(uint32_t) + meshlets.size() * sizeof(GpuMeshlet));
+    mMeshVersion = objs.MeshVersion();
+}
+
+void IndirectScene::SyncObjects(ObjectStore& objs) {
+    EUCLID_ZONE("Indirect: objects");
+    mCount = (uint32_t)objs.Count();
+    const EuclidShapeType* types = objs.Types();
+    const EuclidObjectID* ids = objs.Ids();
+
+    for (Bucket& k : mBuckets) k.objects = 0;
+    mInfoScratch.resize(mCount);
+    for (uint32_t s = 0; s < mCount; ++s) {
+        ObjectInfo& info = mInfoScratch[s];
+        info = ObjectInfo{};
+        info.bucket = kNotDrawn;
+        if (types[s] == EUCLID_SHAPE_GROUP) continue;
+
+        glm::vec3 mn, mx;
+        uint32_t b = (uint32_t)types[s];
+        if (types[s] == EUCLID_SHAPE_CUSTOM) {
+            const Object* o = objs.Get(ids[s]);
+            if (!o || o->customIndex < 0) continue;
+            b = kPrimitiveBuckets + (uint32_t)o->customIndex;
+            mn = o->localMin; mx = o->localMax;
+        } else {
+            objs.ShapeLocalBounds(types[s], mn, mx);
+        }
+        if (b >= mBuckets.size() || !mBuckets[b].indexCount) continue;
+        info.center = 0.5f * (mn + mx);
+        info.extent = 0.5f * (mx - mn);
+        info.bucket = b;
+        info.clustered = mBuckets[b].meshlets ? 1u : 0u;
+        ++mBuckets[b].objects;
+    }
+
+    // each mesh gets a range of the visible list as long as its object count, once per
+    // set (set 1: what the occlusion pass adds); clustered ones draw through their clusters
+    const size_t buckets = mBuckets.size();
+    std::vector<IndirectCommand> commands(std::max<size_t>(2 * buckets, 1), IndirectCommand{});
+    uint32_t base = 0;
+    mSceneTriangles = 0;
+    for (size_t b = 0; b < buckets; ++b) {
+        const Bucket& k = mBuckets[b];
+        commands[b] = { k.indexCount, 0, k.firstIndex, k.baseVertex, base };
+        if (!k.meshlets) base += k.objects;
+        mSceneTriangles += int(k.indexCount / 3 * k.objects);
+    }
+    for (size_t b = 0; b < buckets; ++b) {
+        commands[buckets + b] = commands[b];
+        commands[buckets + b].baseInstance += base;
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mInfo);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<size_t>(mCount, 1) * sizeof(ObjectInfo), mInfoScratch.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mTemplate);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, commands.size() * sizeof(IndirectCommand), commands.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mCommands);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, commands.size() * sizeof(IndirectCommand), nullptr, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mVisible);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<uint32_t>(2 * base, 1) * sizeof(uint32_t), nullptr, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mFlags);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<size_t>(mCount, 1) * sizeof(uint32_t), nullptr, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mPassed);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<size_t>(mCount, 1) * sizeof(uint32_t), nullptr, GL_DYNAMIC_COPY);
+
+    // every meshlet of every clustered object, slot-major
+    std::vector<ClusterRef> refs;
+    for (uint32_t s = 0; s < mCount; ++s) {
+        const ObjectInfo& info = mInfoScratch[s];
+        if (!info.clustered) continue;
+        const Bucket& k = mBuckets[info.bucket];
+        for (uint32_t m = 0; m < k.meshlets; ++m) refs.push_back({ s, k.firstMeshlet + m });
+    }
+    mClusters = (uint32_t)refs.size();
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mClusterRefs);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<size_t>(refs.size(), 1) * sizeof(ClusterRef), refs.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mClusterCommands);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<size_t>(2 * refs.size(), 1) * sizeof(IndirectCommand), nullptr, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mClusterFlags);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<size_t>(refs.size(), 1) * sizeof(uint32_t), nullptr, GL_DYNAMIC_COPY);
+    mFlagsValid = false;   // slots moved around
+
+    // all matrices once; from here on only the ones UpdateWorld touched
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mWorlds);
+    if (mCount > mWorldsCap || mCount < mWorldsCap / 4) {
+        mWorldsCap = std::max<uint32_t>(mCount + mCount / 2, 64);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, mWorldsCap * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+    }
+    if (mCount) glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, mCount * sizeof(glm::mat4), objs.Worlds());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    mTableMem.Set(mWorldsCap * sizeof(glm::mat4) + std::max<size_t>(mCount, 1) * sizeof(ObjectInfo) +
+                  2 * commands.size() * sizeof(IndirectCommand) + std::max<uint32_t>(2 * base, 1) * sizeof(uint32_t) +
+                  2 * std::max<size_t>(mCount, 1) * sizeof(uint32_t) +
+                  std::max<size_t>(refs.size(), 1) * (sizeof(ClusterRef) + 2 * sizeof(IndirectCommand) + sizeof(uint32_t)));
+    objs.TrackWorldChanges(true);   // also drops whatever was listed before
+    mVersion = objs.Version();
+}
+
+void IndirectScene::SyncWorlds(ObjectStore& objs) {
+    const glm::mat4* worlds = objs.Worlds();
+    if (!objs.AllWorldsChanged() && objs.WorldChanges().empty()) return;
+    EUCLID_ZONE("Indirect: upload matrices");
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mWorlds);
+    if (objs.AllWorldsChanged()) {
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, mCount * sizeof(glm::mat4), worlds);
+    } else {
+        // sorted, one upload per run of consecutive slots
+        mRuns.assign(objs.WorldChanges().begin(), objs.WorldChanges().end());
+        std::sort(mRuns.begin(), mRuns.end());
+        mRuns.erase(std::unique(mRuns.begin(), mRuns.end()), mRuns.end());
+        for (size_t i = 0; i < mRuns.size(); ) {
+            size_t j = i + 1;
+            while (j < mRuns.size() && mRuns[j] == mRuns[j - 1] + 1) ++j;
+            glBufferSubData(GL_SHADER_STORAGE_BUFFER, (GLintptr)(mRuns[i] * sizeof(glm::mat4)),
+                            (GLsizeiptr)((j - i) * sizeof(glm::mat4)), worlds + mRuns[i]);
+            i = j;
+        }
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    objs.ClearWorldChanges();
+}
+
+// -------- Occlusion --------
+bool IndirectScene::PrepareDepth() {
+    GLint samples = 0;
+    glGetIntegerv(GL_SAMPLE_BUFFERS, &samples);
+    glGetIntegerv(GL_VIEWPORT, mViewport);
+    if (samples > 0 || mViewport[2] <= 0 || mViewport[3] <= 0) return false;
+    if (mViewport[2] == mDepthW && mViewport[3] == mDepthH) return true;
+
+    const unsigned int old[2] = { mDepthTex, mPyramid };
+    if (mDepthTex) glDeleteTextures(2, old);
+    unsigned int textures[2];
+    glGenTextures(2, textures);
+    mDepthTex = textures[0]; mPyramid = textures[1];
+    mDepthW = mViewport[2]; mDepthH = mViewport[3];
+
+    // immutable storage: complete for texelFetch without touching the filters
+    const int w0 = std::max(1, mDepthW / 2), h0 = std::max(1, mDepthH / 2);
+    mLevels = 1;
+    while ((std::max(w0, h0) >> mLevels) > 0) ++mLevels;
+    glBindTexture(GL_TEXTURE_2D, mDepthTex);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH24_STENCIL8, mDepthW, mDepthH);
+    glBindTexture(GL_TEXTURE_2D, mPyramid);
+    glTexStorage2D(GL_TEXTURE_2D, mLevels, GL_R32F, w0, h0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    GLDebug::Label(GL_TEXTURE, mDepthTex, "Indirect scene", "depth copy");
+    GLDebug::Label(GL_TEXTURE, mPyramid, "Indirect scene", "depth pyramid");
+
+    size_t pyramid = 0;
+    for (int l = 0; l < mLevels; ++l)
+        pyramid += size_t(std::max(1, w0 >> l)) * size_t(std::max(1, h0 >> l)) * sizeof(float);
+    mDepthMem.Set(size_t(mDepthW) * size_t(mDepthH) * 4 + pyramid);
+    return true;
+}
+
+void IndirectScene::BuildPyramid() {
+    // the scene's depth so far, from whatever framebuffer is being drawn to
+    GLint draw = 0, read = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &draw);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read);
+    if (read != draw) glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)draw);
+    glBindTexture(GL_TEXTURE_2D, mDepthTex);
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, mViewport[0], mViewport[1], mDepthW, mDepthH);
+    if (read != draw) glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)read);
+
+    mReduce.Use();
+    const int w0 = std::max(1, mDepthW / 2), h0 = std::max(1, mDepthH / 2);
+    for (int l = 0; l < mLevels; ++l) {
+        if (l > 0) glBindTexture(GL_TEXTURE_2D, mPyramid);
+        glUniform1i(mSourceLevelLoc, l > 0 ? l - 1 : 0);
+        glBindImageTexture(0, mPyramid, l, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        const GLuint w = (GLuint)std::max(1, w0 >> l), h = (GLuint)std::max(1, h0 >> l);
+        glDispatchCompute((w + 7) / 8, (h + 7) / 8, 1);
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+    }
+    glBindTexture(GL_TEXTURE_2D, mPyramid);   // the cull pass samples it
+}
+
+// -------- Draw --------
+void IndirectScene::Cull(uint32_t mode, const glm::mat4& viewProj, const glm::vec4 planes[6]) {
+    mCull.Use();
+    glUniform4fv(mPlanesLoc, 6, glm::value_ptr(planes[0]));
+    glUniform1ui(mCountLoc, mCount);
+    glUniform1ui(mModeLoc, mode);
+    glUniform1ui(mBucketsLoc, (GLuint)mBuckets.size());
+    if (mode == kOcclusion) {
+        glUniformMatrix4fv(mViewProjLoc, 1, GL_FALSE, &viewProj[0][0]);
+        glUniform2i(mViewportLoc, mDepthW, mDepthH);
+        glUniform1i(mLevelsLoc, mLevels);
+    }
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, mWorlds);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, mInfo);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, mCommands);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, mVisible);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, mFlags);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, mPassed);
+    glDispatchCompute((mCount + kGroupSize - 1) / kGroupSize, 1, 1);
+    // commands and visible list are read as draw parameters / vertex attributes, flags by
+    // the next cull; next frame's template copy overwrites what this dispatch wrote
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT |
+                    GL_BUFFER_UPDATE_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void IndirectScene::CullClusters(uint32_t mode, const glm::mat4& viewProj, const glm::vec4 planes[6],
+                                 const glm::vec4& eye, bool cones) {
+    if (!mClusters) return;
+    mClusterCull.Use();
+    glUniform4fv(mClusterPlanesLoc, 6, glm::value_ptr(planes[0]));
+    glUniform1ui(mClusterCountLoc, mClusters);
+    glUniform1ui(mClusterModeLoc, mode);
+    glUniform4fv(mEyeLoc, 1, glm::value_ptr(eye));
+    glUniform1i(mConesLoc, cones ? 1 : 0);
+    if (mode == kOcclusion) {
+        glUniformMatrix4fv(mClusterViewProjLoc, 1, GL_FALSE, &viewProj[0][0]);
+        glUniform2i(mClusterViewportLoc, mDepthW, mDepthH);
+        glUniform1i(mClusterLevelsLoc, mLevels);
+    }
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, mWorlds);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, mMeshlets);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, mClusterCommands);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, mClusterRefs);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, mClusterFlags);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, mPassed);
+    glDispatchCompute((mClusters + kGroupSize - 1) / kGroupSize, 1, 1);
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void IndirectScene::DrawSet(uint32_t set, bool backfaces) {
+    mDraw.Use();
+    glBindVertexArray(mVAO);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mCommands);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (const void*)(set * mBuckets.size() * sizeof(IndirectCommand)),
+                                (GLsizei)mBuckets.size(), 0);
+    ++mDrawn;
+    if (mClusters) {
+        // culled clusters keep their command with zero instances (no draw-count buffer before GL 4.6)
+        if (backfaces) glUniform1i(mSingleSidedLoc, 1);
+        glBindVertexArray(mClusterVAO);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mClusterCommands);
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (const void*)(set * mClusters * sizeof(IndirectCommand)),
+                                    (GLsizei)mClusters, 0);
+        if (backfaces) glUniform1i(mSingleSidedLoc, 0);
+        ++mDrawn;
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void IndirectScene::Draw(ObjectStore& objs, const glm::mat4& view, const glm::mat4& proj, bool occlusion, bool backfaces) {
+    mDrawn = mTriangles = 0;
+    if (!mReady) return;
+
+    if (objs.Version() != mVersion) {
+        // primitives upload on first use; make sure the ones in the scene exist before the arena is built
+        const EuclidShapeType* types = objs.Types();
+        uint32_t seen = 0;
+        for (size_t s = 0, n = objs.Count(); s < n; ++s)
+            if (types[s] < EUCLID_SHAPE_CUSTOM && !(seen & (1u << types[s]))) {
+                seen |= 1u << types[s];
+                objs.MeshFor(types[s]);
+            }
+    }
+    const bool arena = objs.MeshVersion() != mMeshVersion;
+    if (arena) SyncArena(objs);
+    if (arena || objs.Version() != mVersion) SyncObjects(objs);
+    else SyncWorlds(objs);
+    if (!mCount || mBuckets.empty()) return;
+
+    // fresh commands for both sets
+    const GLsizeiptr commandBytes = (GLsizeiptr)(2 * mBuckets.size() * sizeof(IndirectCommand));
+    glBindBuffer(GL_COPY_READ_BUFFER, mTemplate);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mCommands);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, commandBytes);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    const glm::mat4 viewProj = proj * view;
+    glm::vec4 planes[6];
+    FrustumPlanes(viewProj, planes);
+    // eye as a homogeneous point for the cone test, w = 0 for orthographic projections
+    glm::vec4 eye = glm::inverse(viewProj) * glm::vec4(0.0f, 0.0f, -1.0f, 0.0f);
+    if (eye.w < 0.0f) eye = -eye;
+    mDraw.Use();
+    glUniformMatrix4fv(mViewLoc, 1, GL_FALSE, &view[0][0]);
+    glUniformMatrix4fv(mProjLoc, 1, GL_FALSE, &proj[0][0]);
+
+    occlusion = occlusion && PrepareDepth();
+    if (!occlusion) {
+        mFlagsValid = false;   // stale once this frame moves things
+        Cull(kFrustumOnly, viewProj, planes);
+        CullClusters(kFrustumOnly, viewProj, planes, eye, backfaces);
+        DrawSet(0, backfaces);
+    } else {
+        if (!mFlagsValid) {
+            // nothing known yet: the first pass draws everything in view
+            const uint32_t one = 1;
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, mFlags);
+            glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &one);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, mClusterFlags);
+            glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &one);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+            mFlagsValid = true;
+        }
+        // last frame's visible set, then whatever else shows through its depth
+        Cull(kLastVisible, viewProj, planes);
+        CullClusters(kLastVisible, viewProj, planes, eye, backfaces);
+        DrawSet(0, backfaces);
+        BuildPyramid();
+        Cull(kOcclusion, viewProj, planes);
+        CullClusters(kOcclusion, viewProj, planes, eye, backfaces);
+        DrawSet(1, backfaces);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    mTriangles = mSceneTriangles;
+}
+}
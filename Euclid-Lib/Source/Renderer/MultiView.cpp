@@ -0,0 +1,321 @@
+#include "Core.hpp"
+#include "Renderer.hpp"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstring>
+#include <string>
+
+namespace Euclid
+{
+namespace {
+    // Model matrix per instance as a mat4 attribute (locations 2..5, divisor 1).
+    // World matrices are affine, so their bottom row is always (0,0,0,1): the first
+    // element of it carries the pane index and the shader puts the 0 back.
+    constexpr const char* kMultiViewVS =
+    R"(
+    layout (location = 0) in vec3 aPos;
+    layout (location = 1) in vec3 aColor;
+    layout (location = 2) in mat4 aModel;
+
+    uniform mat4 uViewProj[16];
+
+    out vec3 vColor;
+    flat out int vMirrored;
+
+    void main()
+    {
+        mat4 model = aModel;
+        int view = int(model[0][3]);
+        model[0][3] = 0.0;
+    #ifdef EUCLID_VIEWPORT_INDEX
+        gl_ViewportIndex = view;
+    #endif
+        gl_Position = uViewProj[view] * model * vec4(aPos, 1.0);
+        vColor = aColor;
+        vMirrored = determinant(mat3(model)) < 0.0 ? 1 : 0;
+    }
+    )";
+
+    // Instances of one mesh can be mirrored or not, so single-sided imports drop their
+    // back faces here instead of through GL_CULL_FACE
+    constexpr const char* kMultiViewFS =
+    R"(
+    #version 330 core
+    in vec3 vColor;
+    flat in int vMirrored;
+    out vec4 FragColor;
+
+    uniform bool uSingleSided;
+
+    void main()
+    {
+        if (uSingleSided && gl_FrontFacing == (vMirrored != 0)) discard;
+        FragColor = vec4(vColor, 1.0);
+    }
+    )";
+
+    // mesh buckets: one per primitive type (CUBE..CIRCLE), then one per imported mesh
+    constexpr uint32_t kPrimitiveBuckets = EUCLID_SHAPE_CUSTOM;
+
+    struct Frustum { glm::vec4 planes[6]; };
+
+    Frustum FrustumFrom(const glm::mat4& m) {
+        Frustum f;
+        FrustumPlanes(m, f.planes);
+        return f;
+    }
+
+    // box given as world center + half extents
+    bool Outside(const Frustum& f, const glm::vec3& c, const glm::vec3& e) {
+        for (const glm::vec4& p : f.planes) {
+            const glm::vec3 n(p);
+            if (glm::dot(n, c) + p.w < -glm::dot(glm::abs(n), e)) return true;
+        }
+        return false;
+    }
+}
+
+void Core::EnsureMultiView() {
+    if (mShared->multiViewPath) return;
+
+    // gl_ViewportIndex from the vertex shader lets one instanced draw cover every pane
+    const char* ext = nullptr;
+    if (glViewportArrayv) {
+        if      (HasGLExtension("GL_ARB_shader_viewport_layer_array"))  ext = "GL_ARB_shader_viewport_layer_array";
+        else if (HasGLExtension("GL_AMD_vertex_shader_viewport_index")) ext = "GL_AMD_vertex_shader_viewport_index";
+    }
+    if (ext) {
+        const std::string vs = std::string("#version 410 core\n#extension ") + ext +
+                               " : require\n#define EUCLID_VIEWPORT_INDEX 1\n" + kMultiViewVS;
+        mProgramCache.Build(multiViewShader, "multiview_layered", vs.c_str(), kMultiViewFS);
+        if (multiViewShader.IsLinked()) mShared->multiViewPath = kMultiViewLayered;
+    }
+    if (!mShared->multiViewPath) {
+        const std::string vs = std::string("#version 330 core\n") + kMultiViewVS;
+        mProgramCache.Build(multiViewShader, "multiview", vs.c_str(), kMultiViewFS);
+        mShared->multiViewPath = kMultiViewBatched;
+    }
+    glGenBuffers(1, &mShared->multiViewVBO);
+}
+
+void Core::DrawMultiViewRange(const SharedMesh& mesh, uint32_t first, uint32_t count) {
+    glBindVertexArray(mesh.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, mShared->multiViewVBO);
+    for (GLuint c = 0; c < 4; ++c) {
+        glEnableVertexAttribArray(2 + c);
+        glVertexAttribPointer(2 + c, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+                              (void*)(first * sizeof(glm::mat4) + c * sizeof(glm::vec4)));
+        glVertexAttribDivisor(2 + c, 1);
+    }
+    if (mesh.indexed) glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0, (GLsizei)count);
+    else              glDrawArraysInstanced  (GL_TRIANGLES, 0, mesh.indexCount, (GLsizei)count);
+    ++mDraws;
+    mTriangles += mesh.indexCount / 3 * (int)count;
+    // the mesh VAO is shared with the single-view path, which has no instance data
+    for (GLuint c = 0; c < 4; ++c) glDisableVertexAttribArray(2 + c);
+    glBindVertexArray(0);
+}
+
+EuclidResult Core::RenderViewports(const EuclidViewport* vps, int count) {
+    if (!vps || count <= 0 || count > EUCLID_MAX_VIEWPORTS) return EUCLID_ERR_BAD_PARAM;
+    for (int v = 0; v < count; ++v)
+        if (vps[v].width <= 0 || vps[v].height <= 0) return EUCLID_ERR_BAD_PARAM;
+
+    EUCLID_ZONE("RenderViewports");
+    mGpuProfiler.Collect();
+    BeginFrameStats();
+
+    // same frame boundary as Render
+    {
+        EUCLID_ZONE("Apply commands");
+        mCommands.Drain([this](const EuclidCommand& c) { ApplyCommand(c); });
+    }
+    ProcessInput();
+    EnsureMultiView();
+
+    const uint32_t nv = (uint32_t)count;
+    glm::mat4 views[EUCLID_MAX_VIEWPORTS], projs[EUCLID_MAX_VIEWPORTS], viewProjs[EUCLID_MAX_VIEWPORTS];
+    Frustum frusta[EUCLID_MAX_VIEWPORTS];
+    for (uint32_t v = 0; v < nv; ++v) {
+        views[v] = glm::make_mat4(vps[v].view);
+        projs[v] = glm::make_mat4(vps[v].projection);
+        viewProjs[v] = projs[v] * views[v];
+        frusta[v] = FrustumFrom(viewProjs[v]);
+    }
+    {
+        glm::vec3 eyes[EUCLID_MAX_VIEWPORTS];
+        for (uint32_t v = 0; v < nv; ++v) eyes[v] = glm::vec3(glm::inverse(views[v])[3]);
+        UpdateStreaming(eyes, viewProjs, count);
+    }
+
+    // --- one walk: cull each object against every pane, count per (mesh, pane) ---
+    const std::vector<const Object*>& list = mObjs.DrawList();
+    const glm::mat4* worlds = mObjs.Worlds();
+    const uint32_t buckets = kPrimitiveBuckets + (uint32_t)mObjs.CustomMeshCount();
+    uint32_t total = 0;
+    {
+        EUCLID_ZONE("Cull + sort");
+        mMVCounts.assign((size_t)buckets * nv, 0);
+        mMVKeys.resize(list.size());
+        mMVMasks.resize(list.size());
+
+        for (size_t i = 0; i < list.size(); ++i) {
+            const Object& o = *list[i];
+            glm::vec3 mn, mx;
+            if (o.type == EUCLID_SHAPE_CUSTOM) { mn = o.localMin; mx = o.localMax; }
+            else mObjs.ShapeLocalBounds(o.type, mn, mx);
+
+            // local box -> world center + extents (Arvo), cheaper than 8 corners
+            const glm::mat4& M = worlds[o.slot];
+            const glm::vec3 lc = 0.5f * (mn + mx), le = 0.5f * (mx - mn);
+            const glm::vec3 c(M * glm::vec4(lc, 1.0f));
+            const glm::vec3 e = glm::abs(glm::vec3(M[0])) * le.x + glm::abs(glm::vec3(M[1])) * le.y +
+                                glm::abs(glm::vec3(M[2])) * le.z;
+
+            const uint32_t key = (o.type == EUCLID_SHAPE_CUSTOM) ? kPrimitiveBuckets + (uint32_t)o.customIndex : (uint32_t)o.type;
+            if (o.type == EUCLID_SHAPE_CUSTOM && mObjs.GetPagedMesh(o.customIndex)) {   // drawn after, per pane
+                mMVKeys[i] = key;
+                mMVMasks[i] = 0;
+                continue;
+            }
+            uint16_t mask = 0;
+            for (uint32_t v = 0; v < nv; ++v)
+                if (!Outside(frusta[v], c, e)) { mask |= uint16_t(1u << v); ++mMVCounts[key * nv + v]; }
+            mMVKeys[i] = key;
+            mMVMasks[i] = mask;
+        }
+
+        // counts -> start offsets; filling advances each to the next range's start
+        for (uint32_t& n : mMVCounts) { const uint32_t k = n; n = total; total += k; }
+        mMVInstances.resize(total);
+        for (size_t i = 0; i < list.size(); ++i) {
+            if (!mMVMasks[i]) continue;
+            const glm::mat4& M = worlds[list[i]->slot];
+            uint32_t* cursor = &mMVCounts[(size_t)mMVKeys[i] * nv];
+            for (uint32_t v = 0; v < nv; ++v) {
+                if (!(mMVMasks[i] & (1u << v))) continue;
+                glm::mat4& inst = mMVInstances[cursor[v]++];
+                inst = M;
+                inst[0][3] = float(v);
+            }
+        }
+        mMVMem.Set(CapacityBytes(mMVInstances) + CapacityBytes(mMVCounts) + CapacityBytes(mMVKeys) + CapacityBytes(mMVMasks));
+    }
+    auto rangeStart = [&](uint32_t k) { return k ? mMVCounts[k - 1] : 0u; };   // k = bucket * nv + pane
+
+    // --- clear every pane ---
+    glEnable(GL_SCISSOR_TEST);
+    glClearColor(0.05f, 0.05f, 0.05f, 1.0f);
+    for (uint32_t v = 0; v < nv; ++v) {
+        glScissor(vps[v].x, vps[v].y, vps[v].width, vps[v].height);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+    glDisable(GL_SCISSOR_TEST);
+
+    // --- scene: one upload, then per mesh one draw (layered) or one per pane (batched) ---
+    if (total) {
+        EUCLID_GPU_ZONE(mGpuProfiler, "Scene");
+        glBindBuffer(GL_ARRAY_BUFFER, mShared->multiViewVBO);
+        if (!mShared->multiViewMem.Bytes()) GLDebug::Label(GL_BUFFER, mShared->multiViewVBO, "Multi-view instances");
+        glBufferData(GL_ARRAY_BUFFER, total * sizeof(glm::mat4), mMVInstances.data(), GL_STREAM_DRAW);
+        mShared->multiViewMem.Set(total * sizeof(glm::mat4));
+
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_LEQUAL);
+        multiViewShader.Use();
+        glUniformMatrix4fv(glGetUniformLocation(multiViewShader.GetID(), "uViewProj"), (GLsizei)nv, GL_FALSE, &viewProjs[0][0][0]);
+
+        const GLint singleSidedLoc = glGetUniformLocation(multiViewShader.GetID(), "uSingleSided");
+        glUniform1i(singleSidedLoc, 0);
+        auto meshFor = [&](uint32_t b) -> const SharedMesh* {
+            return b < kPrimitiveBuckets ? &mObjs.MeshFor((EuclidShapeType)b) : mObjs.GetCustomMesh(int(b - kPrimitiveBuckets));
+        };
+        auto drawRange = [&](uint32_t b, uint32_t first, uint32_t count) {
+            const SharedMesh* mesh = meshFor(b);
+            if (!mesh) return;
+            const bool single = mBackfaceCulling && b >= kPrimitiveBuckets;   // imports only
+            if (single) glUniform1i(singleSidedLoc, 1);
+            DrawMultiViewRange(*mesh, first, count);
+            if (single) glUniform1i(singleSidedLoc, 0);
+        };
+
+        if (mShared->multiViewPath == kMultiViewLayered) {
+            float rects[EUCLID_MAX_VIEWPORTS * 4];
+            for (uint32_t v = 0; v < nv; ++v) {
+                rects[4*v+0] = (float)vps[v].x;     rects[4*v+1] = (float)vps[v].y;
+                rects[4*v+2] = (float)vps[v].width; rects[4*v+3] = (float)vps[v].height;
+            }
+            glViewportArrayv(0, (GLsizei)nv, rects);
+            for (uint32_t b = 0; b < buckets; ++b) {
+                const uint32_t first = rangeStart(b * nv), end = mMVCounts[b * nv + nv - 1];
+                if (end == first) continue;
+                drawRange(b, first, end - first);
+            }
+        } else {
+            for (uint32_t v = 0; v < nv; ++v) {
+                glViewport(vps[v].x, vps[v].y, vps[v].width, vps[v].height);
+                for (uint32_t b = 0; b < buckets; ++b) {
+                    const uint32_t first = rangeStart(b * nv + v), end = mMVCounts[b * nv + v];
+                    if (end == first) continue;
+                    drawRange(b, first, end - first);
+                }
+            }
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    // --- paged meshes: the single-view path per pane, chunks and proxies cull per view ---
+    if (!mObjs.PagedObjects().empty()) {
+        EUCLID_GPU_ZONE(mGpuProfiler, "Paged meshes");
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_LEQUAL);
+        for (uint32_t v = 0; v < nv; ++v) {
+            glViewport(vps[v].x, vps[v].y, vps[v].width, vps[v].height);
+            for (EuclidObjectID id : mObjs.PagedObjects())
+                if (const Object* o = mObjs.Get(id)) DrawObject(*o, views[v], projs[v]);
+        }
+    }
+
+    // --- grid + gizmo, per pane (full-screen passes, nothing to share) ---
+    const int fullW = mWidth, fullH = mHeight;
+    for (uint32_t v = 0; v < nv; ++v) {
+        EUCLID_GPU_ZONE(mGpuProfiler, "Grid + gizmo");
+        glViewport(vps[v].x, vps[v].y, vps[v].width, vps[v].height);   // also resets the whole viewport array
+        glDepthMask(GL_FALSE);
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_LEQUAL);
+        if (vps[v].draw_grid) DrawGrid(views[v], projs[v]);
+        if (vps[v].draw_gizmo) {
+            glDisable(GL_DEPTH_TEST);
+            mWidth = vps[v].width; mHeight = vps[v].height;   // gizmo sizes are in pane pixels
+            DrawGizmoForSelection(viewProjs[v]);
+        }
+    }
+    mWidth = fullW; mHeight = fullH;
+
+    glUseProgram(0);
+    glBindVertexArray(0);
+    glDepthMask(GL_TRUE);
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LEQUAL);
+    glViewport(0, 0, mWidth, mHeight);
+
+    if (mDragDirty) FlushDragEvent(/*final*/false);
+    if (mCommands.Enabled()) {
+        EUCLID_ZONE("Publish snapshot");
+        mSnapshot.Publish(mObjs);
+    }
+    EndFrameInput();
+    EndFrameStats();
+    return EUCLID_OK;
+}
+
+void Core::GetCameraMatrices(float view[16], float projection[16]) {
+    ProcessInput();
+    const glm::mat4 v = mainCamera.GetViewMatrix();
+    const glm::mat4 p = ProjectionMatrix();
+    std::memcpy(view, &v[0][0], sizeof(v));
+    std::memcpy(projection, &p[0][0], sizeof(p));
+}
+}
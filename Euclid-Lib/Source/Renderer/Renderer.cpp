@@ -1 +1,149 @@
-//Renderer
+#include "Renderer.hpp"
+#include "GLDebug.hpp"
+
+#include <cstring>
+
+namespace Euclid
+{
+bool HasGLExtension(const char* name) {
+    GLint n = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &n);
+    for (GLint i = 0; i < n; ++i) {
+        const char* e = (const char*)glGetStringi(GL_EXTENSIONS, i);
+        if (e && std::strcmp(e, name) == 0) return true;
+    }
+    return false;
+}
+
+void FrustumPlanes(const glm::mat4& m, glm::vec4 out[6]) {
+    const glm::vec4 r0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    const glm::vec4 r1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    const glm::vec4 r2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    const glm::vec4 r3(m[0][3], m[1][3], m[2][3], m[3][3]);
+    out[0] = r3 + r0; out[1] = r3 - r0;
+    out[2] = r3 + r1; out[3] = r3 - r1;
+    out[4] = r3 + r2; out[5] = r3 - r2;
+}
+
+// -------- RenderTarget --------
+bool RenderTarget::Create(int width, int height) {
+    Release();
+    if (width <= 0 || height <= 0) return false;
+
+    GLint prevFbo = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFbo);
+
+    glGenFramebuffers(1, &mFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+    GLDebug::Label(GL_FRAMEBUFFER, mFBO, "Offscreen target");
+
+    glGenRenderbuffers(1, &mColor);
+    glBindRenderbuffer(GL_RENDERBUFFER, mColor);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    GLDebug::Label(GL_RENDERBUFFER, mColor, "Offscreen target", "color");
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, mColor);
+
+    glGenRenderbuffers(1, &mDepth);
+    glBindRenderbuffer(GL_RENDERBUFFER, mDepth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    GLDebug::Label(GL_RENDERBUFFER, mDepth, "Offscreen target", "depth");
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, mDepth);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)prevFbo);
+
+    if (!complete) { Release(); return false; }
+    mWidth = width; mHeight = height;
+    mMem.Set((size_t)width * height * 8);   // RGBA8 + D24S8
+    return true;
+}
+
+void RenderTarget::Release() {
+    if (mDepth) { glDeleteRenderbuffers(1, &mDepth); mDepth = 0; }
+    if (mColor) { glDeleteRenderbuffers(1, &mColor); mColor = 0; }
+    if (mFBO)   { glDeleteFramebuffers(1, &mFBO);    mFBO = 0; }
+    mWidth = mHeight = 0;
+    mMem.Set(0);
+}
+
+RenderTarget::~RenderTarget() {
+    Release();
+}
+
+// -------- ReadbackRing --------
+bool ReadbackRing::Init(int slots, size_t slotBytes) {
+    Release();
+    if (slots <= 0 || slotBytes == 0) return false;
+
+    mSlots.resize(slots);
+    mSlotBytes = slotBytes;
+    for (auto& s : mSlots) {
+        glGenBuffers(1, &s.pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)slotBytes, nullptr, GL_STREAM_READ);
+        GLDebug::Label(GL_BUFFER, s.pbo, "Readback PBO");
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    mMem.Set(mSlots.size() * slotBytes);
+    mHead = mCount = 0;
+    return true;
+}
+
+void ReadbackRing::Release() {
+    for (auto& s : mSlots) {
+        if (s.fence) { glDeleteSync(s.fence); s.fence = nullptr; }
+        if (s.pbo)   { glDeleteBuffers(1, &s.pbo); s.pbo = 0; }
+    }
+    mSlots.clear();
+    mSlotBytes = 0;
+    mMem.Set(0);
+    mHead = mCount = 0;
+}
+
+void ReadbackRing::Enqueue(int x, int y, int w, int h, int tag) {
+    if (Full() || (size_t)w * (size_t)h * 4 > mSlotBytes) return;
+
+    Slot& s = mSlots[(mHead + mCount) % (int)mSlots.size()];
+    s.x = x; s.y = y; s.w = w; s.h = h; s.tag = tag;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, nullptr); // async into PBO
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    s.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    ++mCount;
+}
+
+const uint8_t* ReadbackRing::MapOldest(Slot& info) {
+    if (Empty()) return nullptr;
+    Slot& s = mSlots[mHead];
+
+    if (s.fence) {
+        // first wait flushes, then just keep waiting in 100ms steps
+        GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        while (glClientWaitSync(s.fence, flags, 100000000ull) == GL_TIMEOUT_EXPIRED) flags = 0;
+        glDeleteSync(s.fence);
+        s.fence = nullptr;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+    void* p = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)s.w * s.h * 4, GL_MAP_READ_BIT);
+    info = s;
+    return static_cast<const uint8_t*>(p);
+}
+
+void ReadbackRing::UnmapOldest() {
+    if (Empty()) return;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, mSlots[mHead].pbo);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    mHead = (mHead + 1) % (int)mSlots.size();
+    --mCount;
+}
+
+ReadbackRing::~ReadbackRing() {
+    Release();
+}
+}
@@ -0,0 +1,173 @@
+#include "Core.hpp"
+#include "Renderer.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+namespace Euclid
+{
+namespace {
+    constexpr int kDefaultInFlight = 3;
+    constexpr int kChannels        = 3;   // exports are opaque RGB
+
+    // path_pattern split around its one frame number (%d / %0Nd), %% unescaped. The
+    // caller's string never reaches printf as a format.
+    struct FramePattern {
+        std::string head, tail;
+        int  width = 0;
+        bool zeros = false;
+
+        bool Parse(const char* p) {
+            bool found = false;
+            for (; *p; ++p) {
+                if (*p != '%') { (found ? tail : head) += *p; continue; }
+                if (p[1] == '%') { (found ? tail : head) += '%'; ++p; continue; }
+                if (found) return false;
+                const char* q = p + 1;
+                zeros = *q == '0';
+                if (zeros) ++q;
+                for (; *q >= '0' && *q <= '9'; ++q) {
+                    width = width * 10 + (*q - '0');
+                    if (width > 64) return false;
+                }
+                if (*q != 'd') return false;
+                found = true;
+                p = q;
+            }
+            return found;
+        }
+        std::string Name(int frame) const {
+            std::string digits = std::to_string(frame);
+            if ((int)digits.size() < width) digits.insert(0, size_t(width) - digits.size(), zeros ? '0' : ' ');
+            return head + digits + tail;
+        }
+    };
+}
+
+// Three stages, each on its own resource:
+//   GL thread : render frame N into the offscreen target, queue glReadPixels into a PBO
+//   PBO ring  : frames N-1..N-k still transferring, fenced
+//   ThreadPool: frames older than that being PNG/QOI encoded and written
+// CPU frame buffers come from a fixed pool, so a slow disk back-pressures the render
+// loop instead of growing memory.
+EuclidResult Core::RenderSequence(const EuclidSequenceDesc& d) {
+    EUCLID_ZONE("RenderSequence");
+    if (!d.path_pattern || d.width <= 0 || d.height <= 0 || d.frame_count <= 0) return EUCLID_ERR_BAD_PARAM;
+    if (d.path == EUCLID_CAMERA_PATH_KEYFRAMES && (!d.keys || d.key_count <= 0)) return EUCLID_ERR_BAD_PARAM;
+    FramePattern pattern;
+    if (!pattern.Parse(d.path_pattern)) return EUCLID_ERR_BAD_PARAM;
+
+    GLint maxRb = 0, maxVp[2] = {0, 0};
+    glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &maxRb);
+    glGetIntegerv(GL_MAX_VIEWPORT_DIMS, maxVp);
+    if (d.width > std::min(maxRb, maxVp[0]) || d.height > std::min(maxRb, maxVp[1])) return EUCLID_ERR_BAD_PARAM;
+
+    const int w = d.width, h = d.height;
+    const int inFlight = d.readbacks_in_flight > 0 ? d.readbacks_in_flight : kDefaultInFlight;
+
+    GLint prevFbo = 0, prevVp[4] = {0, 0, 0, 0};
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFbo);
+    glGetIntegerv(GL_VIEWPORT, prevVp);
+
+    RenderTarget target;
+    ReadbackRing ring;
+    if (!target.Create(w, h)) return EUCLID_ERR_INIT;
+    if (!ring.Init(inFlight, (size_t)w * h * 4)) return EUCLID_ERR_INIT;
+
+    // encode buffers + free list (declared before the pool: the pool joins first)
+    std::vector<std::vector<uint8_t>> buffers;
+    std::vector<int> freeList;
+    std::mutex freeMutex;
+    std::condition_variable freeCv;
+    std::atomic<bool> failed{false};
+
+    ThreadPool pool(d.encoder_threads);
+    buffers.resize(pool.Size() + inFlight);
+    for (int i = 0; i < (int)buffers.size(); ++i) freeList.push_back(i);
+
+    // camera path
+    const glm::mat4 proj = glm::perspective(glm::radians(mainCamera.GetZoom()), float(w) / float(h), kNearPlane, kFarPlane);
+    const float sweep = d.orbit_degrees != 0.0f ? d.orbit_degrees : 360.0f;
+    auto frameView = [&](int i) -> glm::mat4 {
+        if (d.path == EUCLID_CAMERA_PATH_KEYFRAMES) {
+            const float u = (d.frame_count > 1) ? float(i) * float(d.key_count - 1) / float(d.frame_count - 1) : 0.0f;
+            const int   k = std::min((int)u, d.key_count - 1);
+            const int   k1 = std::min(k + 1, d.key_count - 1);
+            const float f = u - float(k);
+            const EuclidCameraKey& a = d.keys[k];
+            const EuclidCameraKey& b = d.keys[k1];
+            glm::vec3 pos = glm::mix(glm::vec3(a.position[0], a.position[1], a.position[2]),
+                                     glm::vec3(b.position[0], b.position[1], b.position[2]), f);
+            glm::vec3 tgt = glm::mix(glm::vec3(a.target[0], a.target[1], a.target[2]),
+                                     glm::vec3(b.target[0], b.target[1], b.target[2]), f);
+            return glm::lookAt(pos, tgt, glm::vec3(0, 1, 0));
+        }
+        Camera cam = mainCamera;
+        cam.SetYaw(mainCamera.GetYaw() + sweep * float(i) / float(d.frame_count));
+        return cam.GetViewMatrix();
+    };
+
+    auto drain = [&]() {
+        EUCLID_ZONE("Readback");
+        ReadbackRing::Slot s;
+        const uint8_t* px = ring.MapOldest(s);
+        if (!px) { ring.UnmapOldest(); failed = true; return; }
+
+        int b;
+        {
+            std::unique_lock<std::mutex> lock(freeMutex);
+            freeCv.wait(lock, [&]{ return !freeList.empty(); });
+            b = freeList.back(); freeList.pop_back();
+        }
+        std::vector<uint8_t>& buf = buffers[b];
+        buf.resize((size_t)w * h * kChannels);
+        for (int y = 0; y < h; ++y) {
+            const uint8_t* src = px + (size_t)(h - 1 - y) * w * 4;   // GL is bottom-up
+            uint8_t* dst = buf.data() + (size_t)y * w * kChannels;
+            for (int x = 0; x < w; ++x) {
+                dst[3*x+0] = src[4*x+0];
+                dst[3*x+1] = src[4*x+1];
+                dst[3*x+2] = src[4*x+2];
+            }
+        }
+        ring.UnmapOldest();
+
+        pool.Submit([&, b, file = pattern.Name(s.tag)] {
+            EUCLID_ZONE("Encode frame");
+            const std::vector<uint8_t>& img = buffers[b];
+            const bool ok = (d.format == EUCLID_IMAGE_QOI)
+                ? WriteQOI(file.c_str(), w, h, kChannels, img.data())
+                : WritePNG(file.c_str(), w, h, kChannels, img.data());
+            if (!ok) failed = true;
+            {
+                std::lock_guard<std::mutex> lock(freeMutex);
+                freeList.push_back(b);
+            }
+            freeCv.notify_one();
+        });
+    };
+
+    glBindFramebuffer(GL_FRAMEBUFFER, target.GetFBO());
+    glViewport(0, 0, w, h);
+    for (int i = 0; i < d.frame_count && !failed; ++i) {
+        mGpuProfiler.Collect();
+        const glm::mat4 view = frameView(i);
+        SettleStreaming(view, proj);   // paged meshes: this frame's chunks, not proxies
+        RenderView(view, proj, d.draw_grid != 0, /*drawGizmo*/false);
+        ring.Enqueue(0, 0, w, h, i);
+        if (ring.Full()) drain();
+    }
+    while (!ring.Empty()) drain();
+    pool.Wait();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)prevFbo);
+    glViewport(prevVp[0], prevVp[1], prevVp[2], prevVp[3]);
+
+    return failed ? EUCLID_ERR_INIT : EUCLID_OK;
+}
+}
@@ -0,0 +1,114 @@
+#include "Core.hpp"
+#include "Renderer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Euclid
+{
+namespace {
+    constexpr int    kDefaultTile  = 4096;
+    constexpr int    kReadbackSlots = 3;                  // tiles in flight
+    constexpr size_t kStripBudget  = 64u * 1024u * 1024u; // max bytes of assembled rows
+}
+
+// The full image is one perspective frustum; each tile gets the matching off-center
+// slice of it, renders into a small offscreen target and is read back through a PBO
+// ring while the next tile renders. Tiles go left->right, top->bottom, so once the
+// last tile of a strip lands its rows go straight into the PNG stream.
+EuclidResult Core::RenderTiled(const char* path, int width, int height, int tileSize, bool drawGrid) {
+    EUCLID_ZONE("RenderTiled");
+    if (!path || width <= 0 || height <= 0) return EUCLID_ERR_BAD_PARAM;
+
+    GLint maxTex = 0, maxRb = 0, maxVp[2] = {0, 0};
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTex);
+    glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &maxRb);
+    glGetIntegerv(GL_MAX_VIEWPORT_DIMS, maxVp);
+    const int limit = std::max(1, std::min({maxTex, maxRb, maxVp[0], maxVp[1]}));
+
+    const int tileW = std::min({width, limit, tileSize > 0 ? tileSize : kDefaultTile});
+    const int stripRows = (int)std::max<size_t>(1, kStripBudget / ((size_t)width * 3));
+    const int tileH = std::min({height, tileW, stripRows});
+
+    const int cols  = (width  + tileW - 1) / tileW;
+    const int rows  = (height + tileH - 1) / tileH;
+    const int total = cols * rows;
+
+    // save host bindings, we put them back at the end
+    GLint prevFbo = 0, prevVp[4] = {0, 0, 0, 0};
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFbo);
+    glGetIntegerv(GL_VIEWPORT, prevVp);
+
+    RenderTarget target;
+    ReadbackRing ring;
+    PngWriter    png;
+    if (!target.Create(tileW, tileH)) return EUCLID_ERR_INIT;
+    if (!ring.Init(kReadbackSlots, (size_t)tileW * tileH * 4)) return EUCLID_ERR_INIT;
+    if (!png.Open(path, width, height, 3)) return EUCLID_ERR_BAD_PARAM;
+
+    std::vector<uint8_t> strip((size_t)width * tileH * 3);
+
+    // full-image frustum at the near plane
+    const float aspect = float(width) / float(height);
+    const float top    = kNearPlane * std::tan(glm::radians(mainCamera.GetZoom()) * 0.5f);
+    const float right  = top * aspect;
+    const glm::mat4 view = mainCamera.GetViewMatrix();
+
+    bool ok = true;
+    auto drain = [&]() {
+        ReadbackRing::Slot s;
+        const uint8_t* px = ring.MapOldest(s);
+        const int col = s.tag % cols;
+        const int x0  = col * tileW;
+        if (px) {
+            // GL rows are bottom-up, PNG rows top-down; drop alpha on the way
+            for (int y = 0; y < s.h; ++y) {
+                const uint8_t* src = px + (size_t)(s.h - 1 - y) * s.w * 4;
+                uint8_t* dst = strip.data() + ((size_t)y * width + x0) * 3;
+                for (int x = 0; x < s.w; ++x) {
+                    dst[3*x+0] = src[4*x+0];
+                    dst[3*x+1] = src[4*x+1];
+                    dst[3*x+2] = src[4*x+2];
+                }
+            }
+        } else {
+            ok = false;
+        }
+        ring.UnmapOldest();
+
+        if (col == cols - 1) {
+            for (int y = 0; y < s.h; ++y) ok = png.WriteRow(strip.data() + (size_t)y * width * 3) && ok;
+        }
+    };
+
+    // paged meshes: the whole image's chunks in before the first tile, not proxies
+    SettleStreaming(view, glm::frustum(-right, right, -top, top, kNearPlane, kFarPlane));
+
+    glBindFramebuffer(GL_FRAMEBUFFER, target.GetFBO());
+    for (int t = 0; t < total && ok; ++t) {
+        const int col = t % cols, row = t / cols;
+        const int x0 = col * tileW,              y0 = row * tileH;
+        const int w  = std::min(tileW, width - x0), h = std::min(tileH, height - y0);
+
+        const float l = -right + 2.0f * right * float(x0)     / float(width);
+        const float r = -right + 2.0f * right * float(x0 + w) / float(width);
+        const float tp =  top  - 2.0f * top   * float(y0)     / float(height);
+        const float b  =  top  - 2.0f * top   * float(y0 + h) / float(height);
+        const glm::mat4 proj = glm::frustum(l, r, b, tp, kNearPlane, kFarPlane);
+
+        glViewport(0, 0, w, h);
+        mGpuProfiler.Collect();
+        RenderView(view, proj, drawGrid, /*drawGizmo*/false);
+
+        ring.Enqueue(0, 0, w, h, t);
+        if (ring.Full()) drain();
+    }
+    while (!ring.Empty()) drain();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)prevFbo);
+    glViewport(prevVp[0], prevVp[1], prevVp[2], prevVp[3]);
+
+    ok = png.Close() && ok;
+    return ok ? EUCLID_OK : EUCLID_ERR_INIT;
+}
+}
@@ -3,3 +3,10 @@
 #include "Euclid_Core.h"
 #include "Euclid_Input.h"
 #include "Euclid_Renderer.h"
+#include "Euclid_Events.h"
+#include "Euclid_Commands.h"
+#include "Euclid_Profiler.h"
+#include "Euclid_GLBackend.h"
+#include "Euclid_Record.h"
+#include "Euclid_Memory.h"
+#include "Euclid_Debug.h"
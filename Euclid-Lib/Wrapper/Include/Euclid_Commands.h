@@ -0,0 +1,53 @@
+#pragma once
+#include "Euclid_Export.h"
+#include "Euclid_Types.h"
+#include "Euclid_Core.h"   // EuclidSceneView
+
+// ---- Command queue ----
+// Everything else in the API belongs to the GL thread. These calls don't: any thread
+// can queue scene mutations, and Euclid_Render applies all of them before it draws.
+// Commands from one Euclid_SubmitCommands call are applied together, in order, in the
+// same frame. The queue is bounded and never allocates after Euclid_EnableCommandQueue.
+
+typedef enum {
+    EUCLID_CMD_NONE          = 0,
+    EUCLID_CMD_SET_TRANSFORM = 1,   // id, transform
+    EUCLID_CMD_CREATE_SHAPE  = 2,   // id (from Euclid_ReserveObjectIDs), shape, params, transform, parent
+    EUCLID_CMD_DELETE_OBJECT = 3,   // id (and everything below it)
+    EUCLID_CMD_SET_PARENT    = 4,   // id, parent (0 = root)
+    EUCLID_CMD_SELECT        = 5,   // id (0 = none)
+    EUCLID_CMD_CLEAR_SCENE   = 6
+} EuclidCommandType;
+
+typedef struct {
+    EuclidCommandType type;
+    EuclidShapeType   shape;
+    EuclidObjectID    id;
+    EuclidObjectID    parent;
+    EuclidTransform   transform;
+    int32_t           has_params;
+    uint8_t           params[16];   // bytes of the Euclid*Params struct for shape
+} EuclidCommand;
+
+// Sets up the queue and the scene snapshot (call on the GL thread, before other
+// threads submit). capacity = commands, rounded up to a power of two.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_EnableCommandQueue(EuclidHandle h, uint32_t capacity);
+
+// Any thread. All or nothing: EUCLID_ERR_BUSY when the batch doesn't fit right now.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_SubmitCommands(EuclidHandle h, const EuclidCommand* cmds, size_t count);
+
+// Any thread. Hands out count consecutive ids for EUCLID_CMD_CREATE_SHAPE, so the caller
+// can refer to new objects (parent them, move them) before they exist.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_ReserveObjectIDs(EuclidHandle h, size_t count, EuclidObjectID* out_first);
+
+// ---- Scene snapshot ----
+// A copy of the scene arrays as of the end of the last Euclid_Render, readable from
+// any thread between Acquire and Release (same layout as Euclid_GetSceneView). The
+// engine keeps two copies and never writes one that is acquired; hold it briefly, a
+// snapshot held across frames stops newer ones from being published.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_AcquireSceneSnapshot(EuclidHandle h, EuclidSceneView* out_view, uint32_t* out_token);
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_ReleaseSceneSnapshot(EuclidHandle h, uint32_t token);
@@ -4,15 +4,42 @@
 #include "Euclid_Export.h"
 #include "Euclid_Types.h"
 
+// glad is loaded once per process, so every live instance has to come from the same
+// loader (headless ones use the library's own). Passing a different one while others
+// are alive fails with EUCLID_ERR_INIT.
 EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_Create(const EuclidConfig* cfg, Euclid_GetProcAddr loader, EuclidHandle* out);
 EUCLID_EXTERN_C EUCLID_API void         EUCLID_CALL Euclid_Destroy(EuclidHandle h);
 
+// No host window/context needed: the library creates its own offscreen GL context
+// (EGL surfaceless, works with Mesa llvmpipe on GPU-less Linux). Frames render into an
+// internal cfg->width x cfg->height target; fetch them with Euclid_ReadPixels.
+// The context is current on the creating thread. To drive the instance from another
+// thread, call Euclid_DoneCurrent on the old one and Euclid_MakeCurrent on the new one.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_CreateHeadless(const EuclidConfig* cfg, EuclidHandle* out);
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_MakeCurrent(EuclidHandle h);   // headless only
+EUCLID_EXTERN_C EUCLID_API void         EUCLID_CALL Euclid_DoneCurrent(EuclidHandle h);   // headless only
+
+// Another view on the same scene: objects, selection, shader programs and meshes are
+// shared with shared_with, while camera, size, framebuffer, gizmo mode and input state
+// belong to the view. Render every view on the GL context shared_with was created on
+// (VAOs don't cross contexts); views of a headless instance share its context and get
+// their own offscreen target. Each view is released with Euclid_Destroy, in any order.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_CreateView(EuclidHandle shared_with, const EuclidConfig* cfg, EuclidHandle* out_view);
+
 EUCLID_EXTERN_C EUCLID_API void         EUCLID_CALL Euclid_Resize(EuclidHandle h, int w, int hgt);
 EUCLID_EXTERN_C EUCLID_API void         EUCLID_CALL Euclid_Update(EuclidHandle h, float dt);
 EUCLID_EXTERN_C EUCLID_API void         EUCLID_CALL Euclid_Render(EuclidHandle h);
 
 EUCLID_EXTERN_C EUCLID_API void         EUCLID_CALL Euclid_SetFramebuffer(EuclidHandle h, unsigned int fb);
 
+// Copies the last rendered frame (width*height*4 bytes, RGBA8, top row first)
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_ReadPixels(EuclidHandle h, void* rgba, size_t bytes);
+
+// Where linked shader programs are cached between runs. Applies to instances created
+// afterwards. nullptr = default (EUCLID_SHADER_CACHE env var, else the per-user cache
+// dir), "" = no cache.
+EUCLID_EXTERN_C EUCLID_API void         EUCLID_CALL Euclid_SetShaderCacheDir(const char* dir);
+
 // diagnostics
 EUCLID_EXTERN_C EUCLID_API const char* EUCLID_CALL Euclid_Version();
 EUCLID_EXTERN_C EUCLID_API const char* EUCLID_CALL Euclid_GetLastError();   // thread-local last error string
@@ -24,6 +51,58 @@ EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_ClearScene(EuclidHand
 EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
 Euclid_CreateShape(EuclidHandle h, const EuclidCreateShapeDesc* desc, EuclidObjectID* out_id);
 
+// ---- Batched scene access ----
+// Same as the per-object calls, but one call (one interop transition) for many objects.
+// Creates descs[0..count); out_ids receives the new IDs in the same order. Any desc with
+// a type outside CUBE..GROUP (or CUSTOM) fails the call with EUCLID_ERR_BAD_PARAM and
+// nothing is created.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_CreateShapesBatch(EuclidHandle h, const EuclidCreateShapeDesc* descs, size_t count, EuclidObjectID* out_ids);
+
+// Transform i is at (char*)transforms + i*stride; stride 0 = tightly packed EuclidTransform.
+// Unknown IDs are skipped (Get leaves their slot alone) and the call returns EUCLID_ERR_BAD_PARAM.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_SetTransformsBatch(EuclidHandle h, const EuclidObjectID* ids, size_t count, const void* transforms, size_t stride);
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_GetTransformsBatch(EuclidHandle h, const EuclidObjectID* ids, size_t count, void* transforms, size_t stride);
+
+// ---- Read-only scene view (zero copy) ----
+// The engine's own per-object arrays, all count long and in the same order. Pointers
+// stay valid until version changes (objects added/removed/cleared); re-fetch then.
+// Each object's seqs[i] is the change_seq at its last create/transform edit, so
+// "seqs[i] > what I saw last time" finds every edited object in one pass.
+// Read them on the thread that drives the instance, between Euclid_* calls.
+typedef struct {
+    uint64_t               version;
+    uint64_t               change_seq;
+    size_t                 count;
+    const EuclidObjectID*  ids;
+    const EuclidShapeType* types;
+    const EuclidTransform* transforms;
+    const uint64_t*        seqs;
+    // 16 floats (column-major) per object, parents applied. Worlds are recomputed lazily,
+    // so the values are current as of the last Euclid_GetSceneView/Euclid_Render: after a
+    // transform or parent edit, fetch the view again before reading them.
+    const float*           world_matrices;
+} EuclidSceneView;
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_GetSceneView(EuclidHandle h, EuclidSceneView* out_view);
+
+// ---- Hierarchy ----
+// A child's transform is relative to its parent; moving a parent (one SetObjectTransform)
+// moves the whole subtree. World matrices are only recomputed for subtrees that changed.
+// Use EUCLID_SHAPE_GROUP for a pure transform node. parent 0 makes the object a root.
+// Reparenting keeps the local transform. Cycles are rejected with EUCLID_ERR_BAD_PARAM.
+// Deleting an object deletes everything below it (one OBJECT_DELETED event each).
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_SetParent(EuclidHandle h, EuclidObjectID child, EuclidObjectID parent);
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_SetParentsBatch(EuclidHandle h, const EuclidObjectID* ids, size_t count, EuclidObjectID parent);
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_GetParent(EuclidHandle h, EuclidObjectID id, EuclidObjectID* out_parent);
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_GetWorldMatrix(EuclidHandle h, EuclidObjectID id, float out_matrix[16]);
+
 // ---- Custom mesh import ----
 EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
 Euclid_LoadOBJ(EuclidHandle h, const char* path, EuclidObjectID* out_id, int normalize);
@@ -34,6 +113,34 @@ Euclid_CreateFromRawMesh(EuclidHandle h,
                          const unsigned* indices, size_t indexCount,
                          EuclidObjectID* out_id, int normalize);
 
+// ---- Out-of-core import ----
+// For meshes larger than memory. Euclid_BuildPagedMesh converts an OBJ once into a paged
+// file: the mesh cut into spatial chunks, each with a coarse proxy. It streams the OBJ
+// (temp files next to page_path) and needs no GL; IMPORT_PROGRESS events report it.
+// Euclid_LoadPagedMesh creates an object from such a file with only the chunk table and
+// proxies in memory; chunks then stream onto the GPU as the camera comes near them, within
+// the streaming budget (bytes of chunk geometry, shared by every paged object of the
+// scene). Regions that aren't resident draw as their proxy. The file must stay in place.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_BuildPagedMesh(EuclidHandle h, const char* obj_path, const char* page_path, int normalize);
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_LoadPagedMesh(EuclidHandle h, const char* page_path, EuclidObjectID* out_id);
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_SetStreamingBudget(EuclidHandle h, uint64_t bytes);   // default 256 MB
+
+typedef struct {
+    uint64_t budget_bytes;
+    uint64_t resident_bytes;     // chunk geometry on the GPU
+    uint64_t proxy_bytes;        // always resident
+    uint32_t chunks;
+    uint32_t resident_chunks;
+    uint32_t loading_chunks;     // being read from disk
+    uint64_t loads, evictions;   // since the instance was created
+} EuclidStreamingStats;
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_GetStreamingStats(EuclidHandle h, EuclidStreamingStats* out_stats);
+
 EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
 Euclid_DeleteObject(EuclidHandle h, EuclidObjectID id);
 
@@ -64,5 +171,9 @@ EUCLID_EXTERN_C EUCLID_API EuclidObjectID EUCLID_CALL Euclid_RayPick(EuclidHandl
 EUCLID_EXTERN_C EUCLID_API void           EUCLID_CALL Euclid_SetSelection(EuclidHandle h, EuclidObjectID id);
 EUCLID_EXTERN_C EUCLID_API int            EUCLID_CALL Euclid_IsDraggingGizmo(EuclidHandle h);           // 0/1
 
+// Camera: orbit around the object and back off until its bounds fill the view
+EUCLID_EXTERN_C EUCLID_API EuclidResult   EUCLID_CALL Euclid_FrameObject(EuclidHandle h, EuclidObjectID id);
+EUCLID_EXTERN_C EUCLID_API void           EUCLID_CALL Euclid_SetGridVisible(EuclidHandle h, int visible); // default 1
+
 EUCLID_EXTERN_C EUCLID_API EuclidResult Euclid_DeleteObject(EuclidHandle h, EuclidObjectID id);
 
@@ -0,0 +1,78 @@
+#pragma once
+#include "Euclid_Export.h"
+#include "Euclid_Types.h"
+
+// ---- GL debug output (KHR_debug) ----
+// Driver errors and warnings (implicit syncs, buffer reallocations, shader recompiles,
+// ...) plus Euclid's own shader compile/link failures, collected in one process-wide
+// log. Identical messages are counted, not repeated. Messages are raised synchronously,
+// so each one carries the Euclid zone that was running ("Upload mesh", "Scene", ...),
+// and GL objects are labeled ("Cube vertices", "Readback PBO", ...) so driver text that
+// names an object points back at its owner. Drivers say the most on a debug context.
+
+typedef enum {
+    EUCLID_GL_MSG_SOURCE_API             = 0,
+    EUCLID_GL_MSG_SOURCE_WINDOW_SYSTEM   = 1,
+    EUCLID_GL_MSG_SOURCE_SHADER_COMPILER = 2,
+    EUCLID_GL_MSG_SOURCE_THIRD_PARTY     = 3,
+    EUCLID_GL_MSG_SOURCE_APPLICATION     = 4,
+    EUCLID_GL_MSG_SOURCE_OTHER           = 5,
+    EUCLID_GL_MSG_SOURCE_EUCLID          = 6    // reported by Euclid itself (shader/link logs)
+} EuclidGLMessageSource;
+
+typedef enum {
+    EUCLID_GL_MSG_ERROR       = 0,
+    EUCLID_GL_MSG_DEPRECATED  = 1,
+    EUCLID_GL_MSG_UNDEFINED   = 2,
+    EUCLID_GL_MSG_PORTABILITY = 3,
+    EUCLID_GL_MSG_PERFORMANCE = 4,
+    EUCLID_GL_MSG_MARKER      = 5,
+    EUCLID_GL_MSG_OTHER       = 6
+} EuclidGLMessageType;
+
+typedef enum {
+    EUCLID_GL_SEVERITY_NOTIFICATION = 0,
+    EUCLID_GL_SEVERITY_LOW          = 1,
+    EUCLID_GL_SEVERITY_MEDIUM       = 2,
+    EUCLID_GL_SEVERITY_HIGH         = 3
+} EuclidGLMessageSeverity;
+
+typedef struct {
+    EuclidGLMessageSource   source;
+    EuclidGLMessageType     type;
+    EuclidGLMessageSeverity severity;
+    uint32_t    id;            // driver's message id, 0 for Euclid's own
+    uint64_t    count;         // times received
+    uint64_t    first_frame;   // EuclidGLDebugStats.frame when first / last received
+    uint64_t    last_frame;
+    const char* scope;         // innermost Euclid zone at the time, "" if none
+    const char* text;          // valid until Euclid_ClearGLMessages
+} EuclidGLMessage;
+
+typedef struct {
+    uint64_t frame;              // frames finished (Euclid_Render / Euclid_RenderViewports, all instances)
+    uint64_t total;              // messages received, repeats included
+    uint64_t unique;             // entries in the log
+    uint64_t last_frame;         // received during the last finished frame
+    uint64_t by_severity[4];     // indexed by EuclidGLMessageSeverity, repeats included
+    uint64_t performance;        // EUCLID_GL_MSG_PERFORMANCE, repeats included
+    uint64_t dropped;            // distinct messages that no longer fit in the log
+} EuclidGLDebugStats;
+
+// Turns driver debug output on/off for h's context (GL 4.3 or GL_KHR_debug). Synchronous
+// output slows the driver down a little; leave it off in production.
+// EUCLID_ERR_INIT if the driver has no debug output.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_EnableGLDebug(EuclidHandle h, int enabled);
+
+// Called for the first occurrence of each distinct message at or above min_severity, on
+// the thread (and inside the GL call) that raised it. Don't call into Euclid from it.
+// NULL unregisters. Without a callback, high-severity messages go to stderr once.
+typedef void (EUCLID_CALL *EuclidGLMessageCallback)(const EuclidGLMessage* msg, void* user);
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL
+Euclid_SetGLMessageCallback(EuclidGLMessageCallback cb, void* user, EuclidGLMessageSeverity min_severity);
+
+// Distinct messages, oldest first. Fills up to max and returns how many; out == NULL
+// returns the count.
+EUCLID_EXTERN_C EUCLID_API int          EUCLID_CALL Euclid_GetGLMessages(EuclidGLMessage* out, int max);
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_GetGLDebugStats(EuclidGLDebugStats* out_stats);
+EUCLID_EXTERN_C EUCLID_API void         EUCLID_CALL Euclid_ClearGLMessages(void);
@@ -0,0 +1,54 @@
+#pragma once
+#include "Euclid_Export.h"
+#include "Euclid_Types.h"
+
+// ---- Scene events ----
+// Instead of polling selection/transforms every frame, the host can let the engine
+// publish what changed into a single-producer/single-consumer ring and drain it.
+// Producer = the thread making Euclid_* calls (the GL thread); consumer = any ONE
+// other thread (or the same one). Nothing is published until events are enabled.
+
+typedef enum {
+    EUCLID_EVENT_NONE              = 0,
+    EUCLID_EVENT_SELECTION_CHANGED = 1,   // id = new selection, 0 = none
+    EUCLID_EVENT_TRANSFORM_CHANGED = 2,   // id + transform = new value; dragging = 1 mid gizmo drag
+    EUCLID_EVENT_OBJECT_CREATED    = 3,   // id
+    EUCLID_EVENT_OBJECT_DELETED    = 4,   // id
+    EUCLID_EVENT_SCENE_CLEARED     = 5,   // every object is gone (no per-object DELETED events)
+    EUCLID_EVENT_IMPORT_PROGRESS   = 6,   // progress 0..1; id set once the object exists (progress 1)
+    EUCLID_EVENT_OVERFLOW          = 7    // ring was full and events were lost: re-query scene state
+} EuclidEventType;
+
+typedef struct {
+    EuclidEventType type;
+    int32_t         dragging;
+    EuclidObjectID  id;
+    EuclidTransform transform;
+    float           progress;
+} EuclidEvent;
+
+// Shared memory view of the ring, for hosts that want to read it in place.
+// Indices are free-running; slot = index & (capacity - 1). Events [read_index, write_index)
+// are readable. Load write_index with acquire, copy the events out, then store
+// read_index with release. Only the engine writes write_index/dropped, only the
+// host writes read_index.
+typedef struct {
+    uint32_t     write_index;
+    uint32_t     pad0[15];          // keep producer and consumer on separate cache lines
+    uint32_t     read_index;
+    uint32_t     pad1[15];
+    uint32_t     capacity;          // power of two
+    uint32_t     dropped;           // events lost to a full ring since enabled
+    EuclidEvent* events;            // [capacity]
+} EuclidEventRing;
+
+// capacity is rounded up to a power of two; 0 turns events off. Call it while no
+// other thread is draining.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_EnableEvents(EuclidHandle h, uint32_t capacity);
+
+// Copies up to max events into out and consumes them. Returns the count (0 when idle).
+EUCLID_EXTERN_C EUCLID_API int EUCLID_CALL Euclid_PollEvents(EuclidHandle h, EuclidEvent* out, int max);
+
+// The ring itself (nullptr while events are off). Valid until events are re-enabled
+// or the instance is destroyed.
+EUCLID_EXTERN_C EUCLID_API EuclidEventRing* EUCLID_CALL Euclid_GetEventRing(EuclidHandle h);
@@ -0,0 +1,52 @@
+#pragma once
+#include "Euclid_Export.h"
+#include "Euclid_Types.h"
+#include <stddef.h>
+
+// GL call accounting for performance tests. Every GL call the engine makes goes through
+// glad's entry point table; these swap it for counting hooks, so CPU-side costs (draws,
+// binds, state and uniform churn) can be measured and asserted without a GPU.
+// glad's table is process-wide: change the backend or capture mode only while no
+// other thread is inside Euclid.
+
+// Instance on the null backend: no context, every GL call is counted and does nothing.
+// Rendering, picking and scene edits run their full CPU path; ReadPixels leaves the
+// buffer untouched. It can't live next to instances on a real context: while any of one
+// kind is alive, creating the other fails with EUCLID_ERR_INIT (see Euclid_GetLastError).
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_CreateNull(const EuclidConfig* cfg, EuclidHandle* out);
+
+typedef enum {
+    EUCLID_GL_CAPTURE_OFF    = 0,
+    EUCLID_GL_CAPTURE_COUNT  = 1,   // per-call counters
+    EUCLID_GL_CAPTURE_RECORD = 2    // counters + the command stream
+} EuclidGLCapture;
+
+// Wraps the live driver entry points (real contexts). The null backend always counts;
+// RECORD also records there.
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_SetGLCapture(EuclidGLCapture mode);
+
+typedef struct {
+    uint64_t total_calls;
+    uint64_t draw_calls;        // glDraw*
+    uint64_t binds;             // glBind*, glUseProgram
+    uint64_t state_changes;     // enable/disable, depth, viewport, scissor, vertex attrib setup, ...
+    uint64_t uniform_updates;   // glUniform*
+    uint64_t uploads;           // buffer/texture data, maps, readbacks
+    uint64_t queries;           // glGet*, fence waits, glFinish (potential sync points)
+} EuclidGLCallStats;
+
+// Since the last reset. Typical use: reset, render one frame, assert on the numbers.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_GetGLCallStats(EuclidGLCallStats* out_stats);
+EUCLID_EXTERN_C EUCLID_API uint64_t     EUCLID_CALL Euclid_GetGLCallCount(const char* gl_function);   // e.g. "glBindVertexArray"
+EUCLID_EXTERN_C EUCLID_API void         EUCLID_CALL Euclid_ResetGLCallStats(void);
+
+typedef struct {
+    uint32_t call;        // Euclid_GLCallName(call) -> "glDrawElements"
+    uint32_t arg_count;   // only the first 4 are kept
+    uint64_t args[4];     // integers/enums as is, floats as their IEEE-754 bits, pointers as addresses
+} EuclidGLCommand;
+
+// Copies out and clears the recorded stream (at most 1M commands are kept between
+// calls). Returns the number written; with out == NULL returns how many are pending.
+EUCLID_EXTERN_C EUCLID_API size_t      EUCLID_CALL Euclid_TakeGLCommands(EuclidGLCommand* out, size_t max);
+EUCLID_EXTERN_C EUCLID_API const char* EUCLID_CALL Euclid_GLCallName(uint32_t call);   // NULL if unknown
@@ -2,8 +2,27 @@
 #include "Euclid_Export.h"
 #include "Euclid_Types.h"
 
+// Input calls only queue the event (safe from any thread). The engine applies them at
+// the start of the next Euclid_Render, with consecutive moves collapsed to the latest
+// position, so a 1000 Hz mouse costs one gizmo solve / orbit step per frame.
 EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_OnMouseMove(EuclidHandle h, double x, double y);
 EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_OnMouseButton(EuclidHandle h, EuclidMouseButton b, int down, EuclidMods mods);
 EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_OnScroll(EuclidHandle h, double dx, double dy);
 EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_OnMods(EuclidHandle h, EuclidMods mods);
 
+// Optional: call right after the frame from Euclid_Render is presented (after SwapBuffers).
+// Once it has been called, input latency is measured up to the present instead of to
+// the end of Euclid_Render.
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_FramePresented(EuclidHandle h);
+
+typedef struct {
+    uint64_t events_received;    // Euclid_On* calls
+    uint64_t events_applied;     // after coalescing
+    uint64_t gizmo_solves;       // drag updates actually computed
+    uint64_t frames_with_input;
+    double   last_latency_ms;    // oldest input of a frame -> that frame done (or presented)
+    double   avg_latency_ms;     // moving average over frames with input
+    double   max_latency_ms;
+} EuclidInputStats;
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_GetInputStats(EuclidHandle h, EuclidInputStats* out_stats);
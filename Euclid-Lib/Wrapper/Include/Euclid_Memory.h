@@ -0,0 +1,42 @@
+#pragma once
+#include "Euclid_Export.h"
+#include "Euclid_Types.h"
+
+// ---- Memory accounting ----
+// Every GPU buffer, renderbuffer and readback buffer the engine creates, plus its big
+// CPU containers, is charged to a category when it is allocated or resized and
+// uncharged when it is freed. Totals are process-wide (all instances), in bytes. GPU
+// sizes are what was requested from GL; drivers add their own padding on top.
+
+typedef enum {
+    EUCLID_MEM_GPU_MESHES         = 0,   // primitive and imported vertex/index buffers
+    EUCLID_MEM_GPU_STREAMING      = 1,   // per-frame instance data, gizmo geometry
+    EUCLID_MEM_GPU_RENDER_TARGETS = 2,   // offscreen color + depth (headless, tiles, sequences)
+    EUCLID_MEM_GPU_READBACK       = 3,   // pixel pack buffers
+    EUCLID_MEM_CPU_SCENE          = 4,   // object store: objects, scene arrays, hierarchy
+    EUCLID_MEM_CPU_SNAPSHOTS      = 5,   // published scene snapshots (command queue)
+    EUCLID_MEM_CPU_IMPORT         = 6,   // OBJ / raw mesh staging while importing, paged chunks in flight
+    EUCLID_MEM_CPU_QUEUES         = 7,   // command, event and input queues, session log buffer
+    EUCLID_MEM_CPU_FRAME          = 8,   // per-frame scratch (multi-view sort, readback)
+    EUCLID_MEM_CPU_DIAGNOSTICS    = 9,   // profiler buffers, recorded GL command stream
+    EUCLID_MEM_CATEGORY_COUNT
+} EuclidMemoryCategory;
+
+enum { EUCLID_MEM_FIRST_CPU = EUCLID_MEM_CPU_SCENE };
+
+typedef struct {
+    uint64_t bytes;          // live now
+    uint64_t peak_bytes;     // high-water mark since start or the last reset
+    uint64_t allocations;    // live buffers / containers holding memory
+} EuclidMemoryCategoryStats;
+
+typedef struct {
+    uint64_t gpu_bytes, gpu_peak_bytes;
+    uint64_t cpu_bytes, cpu_peak_bytes;
+    EuclidMemoryCategoryStats categories[EUCLID_MEM_CATEGORY_COUNT];
+} EuclidMemoryStats;
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_GetMemoryStats(EuclidMemoryStats* out_stats);
+// Peaks restart from the current values (e.g. before a workload you want to bound)
+EUCLID_EXTERN_C EUCLID_API void         EUCLID_CALL Euclid_ResetMemoryPeaks(void);
+EUCLID_EXTERN_C EUCLID_API const char*  EUCLID_CALL Euclid_MemoryCategoryName(EuclidMemoryCategory c);
@@ -0,0 +1,29 @@
+#pragma once
+#include "Euclid_Export.h"
+#include "Euclid_Types.h"
+
+// Built-in zone profiler (render passes, picking, imports, ...), process-wide and off by
+// default. CPU zones are recorded per thread; GPU passes also get GL timestamp pairs,
+// shown on a "GPU (...)" track next to the thread that submitted them.
+// Turning it on starts a fresh capture.
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_ProfilerEnable(int enabled);
+
+// Names the calling thread in the trace (e.g. "UI", "Import worker"). Any thread.
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_ProfilerSetThreadName(const char* name);
+
+// Writes everything captured so far as Chrome trace event JSON (open in
+// chrome://tracing or ui.perfetto.dev) and starts a new capture. Any thread.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_ProfilerExportChromeTrace(const char* path);
+
+// ---- Live pass timings ----
+// Per-pass totals of the last frame for one view, for an on-screen perf panel. Works
+// without a trace capture; costs two GL timestamp queries per pass while enabled.
+typedef struct {
+    const char* name;     // "Scene", "Grid", ... (static string)
+    double      cpu_ms;   // issuing the pass on the GL thread
+    double      gpu_ms;   // executing it; arrives a few frames late, 0 until then
+} EuclidPassTiming;
+
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_SetPassTimings(EuclidHandle h, int enabled);
+// Fills up to max entries and returns how many; out == NULL returns the count
+EUCLID_EXTERN_C EUCLID_API int  EUCLID_CALL Euclid_GetPassTimings(EuclidHandle h, EuclidPassTiming* out, int max);
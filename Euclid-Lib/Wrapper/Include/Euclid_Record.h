@@ -0,0 +1,78 @@
+#pragma once
+#include "Euclid_Export.h"
+#include "Euclid_Types.h"
+
+// ---- Session record / replay ----
+// Recording logs every input call and scene/render API call on an instance, with
+// timestamps, to a compact binary file. It starts with a snapshot of the scene, camera,
+// selection and gizmo mode, so a log taken mid-session replays on an empty instance.
+// Replay feeds the log back through the same API (object IDs are remapped) and times
+// every call: field reports become reproducible benchmarks.
+
+typedef enum {
+    EUCLID_REC_NONE                 = 0,
+    EUCLID_REC_RESIZE               = 1,
+    EUCLID_REC_UPDATE               = 2,
+    EUCLID_REC_RENDER               = 3,
+    EUCLID_REC_RENDER_VIEWPORTS     = 4,
+    EUCLID_REC_FRAME_PRESENTED      = 5,
+    EUCLID_REC_MOUSE_MOVE           = 6,
+    EUCLID_REC_MOUSE_BUTTON         = 7,
+    EUCLID_REC_SCROLL               = 8,
+    EUCLID_REC_MODS                 = 9,
+    EUCLID_REC_CLEAR_SCENE          = 10,
+    EUCLID_REC_CREATE_SHAPE         = 11,
+    EUCLID_REC_CREATE_SHAPES_BATCH  = 12,
+    EUCLID_REC_SET_TRANSFORM        = 13,
+    EUCLID_REC_SET_TRANSFORMS_BATCH = 14,
+    EUCLID_REC_DELETE_OBJECT        = 15,
+    EUCLID_REC_SET_PARENT           = 16,
+    EUCLID_REC_SET_PARENTS_BATCH    = 17,
+    EUCLID_REC_LOAD_OBJ             = 18,
+    EUCLID_REC_CREATE_RAW_MESH      = 19,
+    EUCLID_REC_SELECT               = 20,
+    EUCLID_REC_SET_GIZMO_MODE       = 21,
+    EUCLID_REC_HIT_TEST_SELECT      = 22,
+    EUCLID_REC_RAY_PICK             = 23,
+    EUCLID_REC_FRAME_OBJECT         = 24,
+    EUCLID_REC_SET_GRID_VISIBLE     = 25,
+    EUCLID_REC_CAMERA               = 26,   // snapshot only
+    EUCLID_REC_SUBMIT_COMMANDS      = 27,
+    EUCLID_REC_RESERVE_IDS          = 28,
+    EUCLID_REC_LOAD_PAGED_MESH      = 29,
+    EUCLID_REC_OP_COUNT
+} EuclidRecordOp;
+
+// Call on the instance's GL thread (the snapshot reads mesh data back). Input from other
+// threads is recorded in call order. Starting again replaces the previous recording.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_RecordStart(EuclidHandle h, const char* path);
+EUCLID_EXTERN_C EUCLID_API void         EUCLID_CALL Euclid_RecordStop(EuclidHandle h);
+
+typedef struct {
+    int realtime;        // 1: keep the recorded pacing (latency runs), 0: as fast as possible
+    int finish_frames;   // 1: wait for the GPU after every frame so frame times include it
+} EuclidReplayDesc;
+
+typedef struct {
+    uint64_t count;
+    double   total_ms;
+    double   max_ms;
+} EuclidReplayOpStats;
+
+typedef struct {
+    uint64_t events;
+    uint64_t frames;
+    uint64_t unknown_ids;    // references to objects the replay never created
+    double   recorded_ms;    // span of the log
+    double   replay_ms;      // wall time of the replay
+    double   frame_p50_ms, frame_p95_ms, frame_p99_ms, frame_max_ms;
+    EuclidReplayOpStats ops[EUCLID_REC_OP_COUNT];   // time spent inside each call, by op
+} EuclidReplayStats;
+
+// Replays onto h (its scene is cleared first; size comes from the log). desc may be NULL
+// (as fast as possible, frames finished). EUCLID_ERR_BAD_PARAM for unreadable or
+// damaged logs; stats then cover what ran.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_Replay(EuclidHandle h, const char* path, const EuclidReplayDesc* desc, EuclidReplayStats* out_stats);
+
+EUCLID_EXTERN_C EUCLID_API const char* EUCLID_CALL Euclid_RecordOpName(EuclidRecordOp op);
@@ -2,10 +2,125 @@
 #include "Euclid_Export.h"
 #include "Euclid_Types.h"
 
+// Last frame drawn by Euclid_Render / Euclid_RenderViewports (the gizmo is not counted)
 typedef struct {
-    float fps;
+    float fps;          // smoothed, from the time between frames
     int   draw_calls;
     int   triangles;
 } EuclidStats;
 
 EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_GetStats(EuclidHandle h, EuclidStats* out_stats);
+
+// Where startup time went. Gizmo programs/buffers and primitive meshes are created on
+// first use, so their cost shows up later (gizmo_ms once something gets selected).
+typedef struct {
+    double shaders_ms;        // main + grid programs (cache load or compile + link)
+    double init_total_ms;     // all of engine init, shaders included
+    double first_frame_ms;    // Core init start -> first frame finished on the GPU, 0 until then
+    double gizmo_ms;          // deferred gizmo setup, 0 until first selection
+    int    program_cache_hits;
+    int    program_cache_misses;
+    int    parallel_compile;  // 1 if the driver compiles shaders on its own threads
+    int    primitives_built;  // primitive meshes uploaded so far (of 8)
+} EuclidInitStats;
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_GetInitStats(EuclidHandle h, EuclidInitStats* out_stats);
+
+// ---- GPU-driven scene pass ----
+// GL 4.3+: object matrices and bounds stay on the GPU, a compute shader frustum-culls the
+// scene and a single glMultiDrawElementsIndirect draws it, so the CPU side of a frame no
+// longer grows with the object count (only moved objects are uploaded). EuclidStats then
+// counts one draw call. On by default when h was created for GL 4.3 or newer
+// (EuclidConfig gl_major/gl_minor), off for 3.3 contexts. Per view.
+// EUCLID_ERR_INIT if the context has no compute shaders / indirect draws.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_SetGpuDriven(EuclidHandle h, int enabled);
+
+// Occlusion culling for the GPU-driven pass: what was visible last frame is drawn first,
+// then everything else in view is tested against that depth and drawn only if it shows
+// (a second indirect draw). Exact, nothing pops in, so dense assemblies only pay for
+// their visible shell. On by default; ignored on the per-object path and for
+// multisampled targets. Views share last frame's visibility.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_SetOcclusionCulling(EuclidHandle h, int enabled);
+
+// Draws imported meshes single-sided (counter-clockwise front faces). Imports are split
+// into meshlets of up to 128 triangles, each with a normal cone, so whole clusters facing
+// away are skipped before they reach the GPU. Off by default: open scans, or a camera
+// inside a mesh, need the back faces. Clusters outside the view are culled either way.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_SetBackfaceCulling(EuclidHandle h, int enabled);
+
+// ---- Poster / tiled export ----
+// Renders the current camera view at any resolution (beyond GL_MAX_TEXTURE_SIZE)
+// by splitting the frustum into tiles. Rows are streamed to a PNG on disk.
+typedef struct {
+    const char* path;      // output .png
+    int width, height;     // full image size in pixels
+    int tile_size;         // max tile edge in pixels, 0 = driver limit (capped at 4096)
+    int draw_grid;         // 0/1
+} EuclidTiledRenderDesc;
+
+// Must be called on the GL thread; restores the bound framebuffer/viewport afterwards.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_RenderTiled(EuclidHandle h, const EuclidTiledRenderDesc* desc);
+
+// ---- Multi-view (quad view and friends) ----
+// One pane of a multi-view frame. Matrices are column-major (same layout as
+// Euclid_GetWorldMatrix); any projection works, orthographic included.
+typedef struct {
+    int   x, y, width, height;  // pixels in the target framebuffer, origin bottom-left
+    float view[16];
+    float projection[16];
+    int   draw_grid;            // 0/1
+    int   draw_gizmo;           // 0/1, selection gizmo (drawn per pane)
+} EuclidViewport;
+
+enum { EUCLID_MAX_VIEWPORTS = 16 };
+
+// Renders up to EUCLID_MAX_VIEWPORTS panes into h's framebuffer as one frame: the scene
+// is walked and frustum-culled once for all panes and each mesh is drawn once, instanced
+// across the panes it is visible in (gl_ViewportIndex from the vertex shader when the
+// driver has ARB_shader_viewport_layer_array / AMD_vertex_shader_viewport_index, one
+// instanced draw per mesh and pane otherwise). Stands in for Euclid_Render that frame:
+// queued commands are applied and snapshots published the same way. GL thread only.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_RenderViewports(EuclidHandle h, const EuclidViewport* viewports, int count);
+
+// h's camera as matrices for a viewport (projection uses h's size for the aspect),
+// so views from Euclid_CreateView can drive the panes with their own input.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_GetCameraMatrices(EuclidHandle h, float view[16], float projection[16]);
+
+// ---- Image sequence / turntable export ----
+typedef enum {
+    EUCLID_IMAGE_PNG = 0,
+    EUCLID_IMAGE_QOI = 1
+} EuclidImageFormat;
+
+typedef enum {
+    EUCLID_CAMERA_PATH_ORBIT     = 0,  // yaw sweep around the current camera target
+    EUCLID_CAMERA_PATH_KEYFRAMES = 1   // linear interpolation through keys
+} EuclidCameraPathType;
+
+typedef struct {
+    float position[3];
+    float target[3];
+} EuclidCameraKey;
+
+typedef struct {
+    const char*          path_pattern;  // one %d or %0Nd for the frame, e.g. "out/spin_%04d.png"; %% for a literal %
+    EuclidImageFormat    format;
+    int                  width, height; // per frame, must fit GL_MAX_RENDERBUFFER_SIZE
+    int                  frame_count;
+    EuclidCameraPathType path;
+    float                orbit_degrees; // ORBIT: total sweep, 0 = 360
+    const EuclidCameraKey* keys;        // KEYFRAMES: key_count >= 1
+    int                  key_count;
+    int                  readbacks_in_flight; // 0 = 3
+    int                  encoder_threads;     // 0 = hardware concurrency
+    int                  draw_grid;           // 0/1
+} EuclidSequenceDesc;
+
+// Renders frame_count frames offscreen. GPU work, PBO transfers and encoding on a
+// worker pool all overlap; blocks until every file is written. GL thread only.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_RenderSequence(EuclidHandle h, const EuclidSequenceDesc* desc);
+
+// Encodes tightly packed 8-bit pixels (channels 3 = RGB, 4 = RGBA, top row first).
+// No GL involved, safe to call from any thread.
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_WriteImage(const char* path, EuclidImageFormat format,
+                                                                     int width, int height, int channels, const void* pixels);
@@ -38,7 +38,8 @@ typedef enum {
     EUCLID_OK        =  0,
     EUCLID_ERR_INIT  = -1,
     EUCLID_ERR_BAD_PARAM = -2,
-    EUCLID_ERR_GLAD  = -3
+    EUCLID_ERR_GLAD  = -3,
+    EUCLID_ERR_BUSY  = -4    // a bounded queue is full; retry after the next frame
 } EuclidResult;
 
 // =======================
@@ -56,7 +57,8 @@ typedef enum {
     EUCLID_SHAPE_CYLINDER = 5,
     EUCLID_SHAPE_PRISM    = 6,  // regular n-gon prism (n>=3)
     EUCLID_SHAPE_CIRCLE   = 7,
-    EUCLID_SHAPE_CUSTOM   = 8
+    EUCLID_SHAPE_CUSTOM   = 8,
+    EUCLID_SHAPE_GROUP    = 9   // no geometry: a transform node to parent other objects to
 } EuclidShapeType;
 
 typedef enum {
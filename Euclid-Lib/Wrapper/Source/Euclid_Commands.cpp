@@ -0,0 +1,54 @@
+#include "Euclid_Commands.h"
+#include "State.hpp"
+
+// every params struct has to fit the command's inline bytes
+static_assert(sizeof(EuclidTorusParams)    <= sizeof(EuclidCommand::params));
+static_assert(sizeof(EuclidSphereParams)   <= sizeof(EuclidCommand::params));
+static_assert(sizeof(EuclidConeParams)     <= sizeof(EuclidCommand::params));
+static_assert(sizeof(EuclidCylinderParams) <= sizeof(EuclidCommand::params));
+static_assert(sizeof(EuclidPrismParams)    <= sizeof(EuclidCommand::params));
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_EnableCommandQueue(EuclidHandle h, uint32_t capacity)
+{
+    if (!h) return EUCLID_ERR_BAD_PARAM;
+    return ((EuclidState*)h)->core.EnableCommandQueue(capacity);
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_SubmitCommands(EuclidHandle h, const EuclidCommand* cmds, size_t count)
+{
+    if (!h || (count && !cmds)) return EUCLID_ERR_BAD_PARAM;
+    auto* s = (EuclidState*)h;
+    if (!s->core.CommandQueueEnabled()) return EUCLID_ERR_INIT;
+    if (!s->core.SubmitCommands(cmds, count)) return EUCLID_ERR_BUSY;
+    if (auto r = s->recorder.Begin(EUCLID_REC_SUBMIT_COMMANDS)) r.Var(count).Bytes(cmds, count * sizeof(EuclidCommand));
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_ReserveObjectIDs(EuclidHandle h, size_t count, EuclidObjectID* out_first)
+{
+    if (!h || !out_first || count == 0) return EUCLID_ERR_BAD_PARAM;
+    auto* s = (EuclidState*)h;
+    *out_first = s->core.ReserveObjectIDs(count);
+    if (auto r = s->recorder.Begin(EUCLID_REC_RESERVE_IDS)) r.Var(count).Var(*out_first);
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_AcquireSceneSnapshot(EuclidHandle h, EuclidSceneView* out_view, uint32_t* out_token)
+{
+    if (!h || !out_view || !out_token) return EUCLID_ERR_BAD_PARAM;
+    auto* s = (EuclidState*)h;
+    if (!s->core.CommandQueueEnabled()) return EUCLID_ERR_INIT;
+    *out_token = s->core.Snapshot().Acquire(*out_view);
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_ReleaseSceneSnapshot(EuclidHandle h, uint32_t token)
+{
+    if (!h || token > 1) return EUCLID_ERR_BAD_PARAM;
+    ((EuclidState*)h)->core.Snapshot().Release(token);
+    return EUCLID_OK;
+}
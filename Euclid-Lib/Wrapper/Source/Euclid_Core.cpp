@@ -1,8 +1,14 @@
 #include "Euclid_Core.h"
+#include "Euclid_GLBackend.h"
 #include "State.hpp"
+#include "Recording.hpp"
+#include "GLBackend.hpp"
 #include <glad/glad.h>
+#include <cstring>
+#include <mutex>
 #include <new>
 #include <string>
+#include <vector>
 
 static thread_local std::string g_last_error;
 static void set_err(const char* msg) { g_last_error = msg ? msg : ""; }
@@ -10,23 +16,74 @@ static void set_err(const char* msg) { g_last_error = msg ? msg : ""; }
 EUCLID_EXTERN_C EUCLID_API const char* EUCLID_CALL Euclid_GetLastError() { return g_last_error.c_str(); }
 EUCLID_EXTERN_C EUCLID_API const char* EUCLID_CALL Euclid_Version() { return "Euclid 0.1.0"; }
 
+// glad's entry points are process globals: load under a lock, and only swap the loader
+// while no instance is alive, so nobody sees them rewritten mid-frame. All live instances
+// share one loader; a different one is refused until the last of them is destroyed.
+static std::mutex        g_glad_mutex;
+static Euclid_GetProcAddr g_glad_loader = nullptr;
+// Live instances (views too) per kind: [0] on a GL context, [1] on the null backend. The
+// null backend points glad at its hooks, so the kinds can't be alive at the same time:
+// GL instances would draw nothing, null ones would call a driver with no context.
+static int               g_glad_live[2] = { 0, 0 };
+
+static void* EUCLID_CALL headless_loader(const char* name)
+{
+    return Euclid::HeadlessContext::GetProcAddress(name);
+}
+
+static void* EUCLID_CALL null_loader(const char* name)
+{
+    return Euclid::GLBackend::NullProcAddress(name);
+}
+
+// Loads glad for a new instance and counts it; every success pairs with a release_glad
+static EuclidResult claim_glad(Euclid_GetProcAddr loader)
+{
+    const int kind = loader == null_loader ? 1 : 0;
+    std::lock_guard<std::mutex> lock(g_glad_mutex);
+    if (g_glad_live[1 - kind]) {
+        set_err(kind ? "instances on a GL context are alive; the null backend can't run next to them"
+                     : "null-backend instances are alive; destroy them before creating one on a GL context");
+        return EUCLID_ERR_INIT;
+    }
+    if (g_glad_loader != loader && g_glad_live[kind]) {
+        set_err("instances loaded through another GL loader are alive; all instances must share one loader");
+        return EUCLID_ERR_INIT;
+    }
+    if (g_glad_loader != loader) {
+        if (!gladLoadGLLoader((GLADloadproc)loader)) { set_err("gladLoadGLLoader failed"); return EUCLID_ERR_GLAD; }
+        g_glad_loader = loader;
+    }
+    ++g_glad_live[kind];
+    return EUCLID_OK;
+}
+
+static void release_glad(Euclid_GetProcAddr loader)
+{
+    std::lock_guard<std::mutex> lock(g_glad_mutex);
+    --g_glad_live[loader == null_loader ? 1 : 0];
+}
+
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_SetShaderCacheDir(const char* dir)
+{
+    Euclid::ProgramCache::SetDirectory(dir);
+}
+
 EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
 Euclid_Create(const EuclidConfig* cfg, Euclid_GetProcAddr loader, EuclidHandle* out)
 {
     if (!cfg || !loader || !out) { set_err("bad params"); return EUCLID_ERR_BAD_PARAM; }
 
-    if (!gladLoadGLLoader((GLADloadproc)loader)) {
-        set_err("gladLoadGLLoader failed");
-        return EUCLID_ERR_GLAD;
-    }
+    if (const EuclidResult r = claim_glad(loader)) return r;
 
     auto* s = new (std::nothrow) EuclidState();
-    if (!s) { set_err("oom"); return EUCLID_ERR_INIT; }
+    if (!s) { release_glad(loader); set_err("oom"); return EUCLID_ERR_INIT; }
 
     s->fbW = cfg->width; s->fbH = cfg->height;
+    s->loader = loader;
 
-    if (!s->core.Init(cfg->width, cfg->height, cfg->gl_major, cfg->gl_minor)) {
-        delete s; set_err("Core.Init failed"); return EUCLID_ERR_INIT;
+    if (!s->core.Init(cfg->width, cfg->height, cfg->gl_major, cfg->gl_minor, loader)) {
+        delete s; release_glad(loader); set_err("Core.Init failed"); return EUCLID_ERR_INIT;
     }
 
     s->ready = true;
@@ -36,17 +93,115 @@ Euclid_Create(const EuclidConfig* cfg, Euclid_GetProcAddr loader, EuclidHandle*
     return EUCLID_OK;
 }
 
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_CreateHeadless(const EuclidConfig* cfg, EuclidHandle* out)
+{
+    if (!cfg || !out || cfg->width <= 0 || cfg->height <= 0) { set_err("bad params"); return EUCLID_ERR_BAD_PARAM; }
+
+    std::string err;
+    auto ctx = Euclid::HeadlessContext::Create(cfg->gl_major, cfg->gl_minor, err);
+    if (!ctx) { set_err(err.c_str()); return EUCLID_ERR_INIT; }
+    if (!ctx->MakeCurrent()) { set_err("eglMakeCurrent failed"); return EUCLID_ERR_INIT; }
+
+    if (const EuclidResult r = claim_glad(headless_loader)) return r;
+
+    auto* s = new (std::nothrow) EuclidState();
+    if (!s) { release_glad(headless_loader); set_err("oom"); return EUCLID_ERR_INIT; }
+    s->headless = std::move(ctx);
+    s->loader = headless_loader;
+
+    s->fbW = cfg->width; s->fbH = cfg->height;
+    if (!s->offscreen.Create(cfg->width, cfg->height) ||
+        !s->core.Init(cfg->width, cfg->height, cfg->gl_major, cfg->gl_minor, headless_loader)) {
+        delete s; release_glad(headless_loader); set_err("Core.Init failed"); return EUCLID_ERR_INIT;
+    }
+
+    s->ready = true;
+    s->targetFbo = s->offscreen.GetFBO();
+    *out = (EuclidHandle)s;
+    set_err(nullptr);
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_CreateNull(const EuclidConfig* cfg, EuclidHandle* out)
+{
+    if (!cfg || !out || cfg->width <= 0 || cfg->height <= 0) { set_err("bad params"); return EUCLID_ERR_BAD_PARAM; }
+
+    if (const EuclidResult r = claim_glad(null_loader)) return r;
+
+    auto* s = new (std::nothrow) EuclidState();
+    if (!s) { release_glad(null_loader); set_err("oom"); return EUCLID_ERR_INIT; }
+    s->loader = null_loader;
+
+    s->fbW = cfg->width; s->fbH = cfg->height;
+    if (!s->core.Init(cfg->width, cfg->height, cfg->gl_major, cfg->gl_minor, null_loader)) {
+        delete s; release_glad(null_loader); set_err("Core.Init failed"); return EUCLID_ERR_INIT;
+    }
+
+    s->ready = true;
+    s->targetFbo = 0;
+    *out = (EuclidHandle)s;
+    set_err(nullptr);
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_CreateView(EuclidHandle shared_with, const EuclidConfig* cfg, EuclidHandle* out_view)
+{
+    auto* src = (EuclidState*)shared_with;
+    if (!src || !cfg || !out_view || cfg->width <= 0 || cfg->height <= 0) { set_err("bad params"); return EUCLID_ERR_BAD_PARAM; }
+    if (src->headless && !src->headless->MakeCurrent()) { set_err("eglMakeCurrent failed"); return EUCLID_ERR_INIT; }
+
+    if (const EuclidResult r = claim_glad(src->loader)) return r;   // same loader: only counts
+
+    auto* s = new (std::nothrow) EuclidState(src->core.Shared());
+    if (!s) { release_glad(src->loader); set_err("oom"); return EUCLID_ERR_INIT; }
+    s->headless = src->headless;
+    s->loader = src->loader;
+
+    s->fbW = cfg->width; s->fbH = cfg->height;
+    if ((s->headless && !s->offscreen.Create(cfg->width, cfg->height)) ||
+        !s->core.Init(cfg->width, cfg->height, cfg->gl_major, cfg->gl_minor, s->loader)) {
+        delete s; release_glad(src->loader); set_err("Core.Init failed"); return EUCLID_ERR_INIT;
+    }
+
+    s->ready = true;
+    s->targetFbo = s->headless ? s->offscreen.GetFBO() : 0;
+    *out_view = (EuclidHandle)s;
+    set_err(nullptr);
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_MakeCurrent(EuclidHandle h)
+{
+    auto* s = (EuclidState*)h;
+    if (!s || !s->headless) return EUCLID_ERR_BAD_PARAM;
+    return s->headless->MakeCurrent() ? EUCLID_OK : EUCLID_ERR_INIT;
+}
+
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_DoneCurrent(EuclidHandle h)
+{
+    auto* s = (EuclidState*)h;
+    if (s && s->headless) s->headless->DoneCurrent();
+}
+
 EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_Destroy(EuclidHandle h)
 {
     if (!h) return;
     auto* s = (EuclidState*)h;
+    if (s->headless) s->headless->MakeCurrent();   // GL objects are deleted below
+    const Euclid_GetProcAddr loader = s->loader;
     delete s;
+    release_glad(loader);
 }
 
 EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_Resize(EuclidHandle h, int w, int hgt)
 {
     if (auto* s = (EuclidState*)h) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_RESIZE)) r.Var((uint32_t)w).Var((uint32_t)hgt);
         s->fbW = w; s->fbH = hgt;
+        if (s->headless && s->offscreen.Create(w, hgt)) s->targetFbo = s->offscreen.GetFBO();
         s->core.Resize(w, hgt);
     }
 }
@@ -57,14 +212,45 @@ EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_SetFramebuffer(EuclidHandle h
     if (auto* s = (EuclidState*)h) s->targetFbo = fb;
 }
 
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_ReadPixels(EuclidHandle h, void* rgba, size_t bytes)
+{
+    auto* s = (EuclidState*)h;
+    if (!s || !rgba || s->fbW <= 0 || s->fbH <= 0) return EUCLID_ERR_BAD_PARAM;
+    const size_t row = (size_t)s->fbW * 4;
+    if (bytes < row * s->fbH) return EUCLID_ERR_BAD_PARAM;
+
+    GLint prevRead = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevRead);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, s->targetFbo);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, s->fbW, s->fbH, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)prevRead);
+
+    // GL is bottom-up
+    auto* p = static_cast<uint8_t*>(rgba);
+    std::vector<uint8_t> tmp(row);
+    for (int y = 0; y < s->fbH / 2; ++y) {
+        uint8_t* a = p + (size_t)y * row;
+        uint8_t* b = p + (size_t)(s->fbH - 1 - y) * row;
+        std::memcpy(tmp.data(), a, row);
+        std::memcpy(a, b, row);
+        std::memcpy(b, tmp.data(), row);
+    }
+    return EUCLID_OK;
+}
+
 EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_Update(EuclidHandle h, float dt)
 {
-    if (auto* s = (EuclidState*)h) s->core.Update(dt);
+    if (auto* s = (EuclidState*)h) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_UPDATE)) r.F32(dt);
+        s->core.Update(dt);
+    }
 }
 
 EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_Render(EuclidHandle h)
 {
     if (auto* s = (EuclidState*)h) {
+        s->recorder.Begin(EUCLID_REC_RENDER);
         // –»—”≈Ã ¬ Õ”∆Õ€… FBO
         glBindFramebuffer(GL_FRAMEBUFFER, s->targetFbo);
         glViewport(0, 0, s->fbW, s->fbH);
@@ -81,6 +267,7 @@ static inline EuclidResult ok_or(EuclidState* s){ return s ? EUCLID_OK : EUCLID_
 EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
 Euclid_ClearScene(EuclidHandle h) {
     if (auto* s = (EuclidState*)h) {
+        s->recorder.Begin(EUCLID_REC_CLEAR_SCENE);
         s->selected = 0;                    // <-- СБРОС
         return s->core.ClearScene();
     }
@@ -91,23 +278,105 @@ EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
 Euclid_CreateShape(EuclidHandle h, const EuclidCreateShapeDesc* desc, EuclidObjectID* out_id) {
     if (!h || !desc || !out_id) return EUCLID_ERR_BAD_PARAM;
     auto* s = (EuclidState*)h;
-    auto id = s->nextID++; // if you assign ids in wrapper
-
-    Euclid::Object* obj = s->core.CreateObject(desc->type, desc->params, desc->xform, id);
+    // ids come from the store, so shapes and imports share one sequence
+    Euclid::Object* obj = s->core.CreateObject(desc->type, desc->params, desc->xform, 0);
     if (!obj) return EUCLID_ERR_BAD_PARAM;
 
     // DO NOT store obj in s->objects as unique_ptr — Core owns it.
-    *out_id = id;
+    *out_id = obj->id;
+    if (auto r = s->recorder.Begin(EUCLID_REC_CREATE_SHAPE)) { Euclid::Rec::PutShape(r, *desc); r.Var(obj->id); }
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_CreateShapesBatch(EuclidHandle h, const EuclidCreateShapeDesc* descs, size_t count, EuclidObjectID* out_ids) {
+    if (!h || (count && (!descs || !out_ids))) return EUCLID_ERR_BAD_PARAM;
+    auto* s = (EuclidState*)h;
+    const EuclidResult res = s->core.CreateObjects(descs, count, out_ids);
+    if (res == EUCLID_OK) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_CREATE_SHAPES_BATCH)) {
+            r.Var(count);
+            for (size_t i = 0; i < count; ++i) { Euclid::Rec::PutShape(r, descs[i]); r.Var(out_ids[i]); }
+        }
+    }
+    return res;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_SetTransformsBatch(EuclidHandle h, const EuclidObjectID* ids, size_t count, const void* transforms, size_t stride) {
+    if (stride == 0) stride = sizeof(EuclidTransform);
+    if (!h || stride < sizeof(EuclidTransform) || (count && (!ids || !transforms))) return EUCLID_ERR_BAD_PARAM;
+    auto* s = (EuclidState*)h;
+    const EuclidResult res = s->core.SetObjectTransforms(ids, count, transforms, stride);
+    if (res == EUCLID_OK) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_SET_TRANSFORMS_BATCH)) {
+            r.Var(count);
+            const auto* src = static_cast<const uint8_t*>(transforms);
+            for (size_t i = 0; i < count; ++i) r.Var(ids[i]).Bytes(src + i * stride, sizeof(EuclidTransform));
+        }
+    }
+    return res;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_GetTransformsBatch(EuclidHandle h, const EuclidObjectID* ids, size_t count, void* transforms, size_t stride) {
+    if (stride == 0) stride = sizeof(EuclidTransform);
+    if (!h || stride < sizeof(EuclidTransform) || (count && (!ids || !transforms))) return EUCLID_ERR_BAD_PARAM;
+    return ((EuclidState*)h)->core.GetObjectTransforms(ids, count, transforms, stride);
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_GetSceneView(EuclidHandle h, EuclidSceneView* out_view) {
+    if (!h || !out_view) return EUCLID_ERR_BAD_PARAM;
+    ((EuclidState*)h)->core.GetSceneView(*out_view);
     return EUCLID_OK;
 }
 
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_SetParent(EuclidHandle h, EuclidObjectID child, EuclidObjectID parent) {
+    if (!h) return EUCLID_ERR_BAD_PARAM;
+    auto* s = (EuclidState*)h;
+    const EuclidResult res = s->core.SetParents(&child, 1, parent);
+    if (res == EUCLID_OK) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_SET_PARENT)) r.Var(child).Var(parent);
+    }
+    return res;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_SetParentsBatch(EuclidHandle h, const EuclidObjectID* ids, size_t count, EuclidObjectID parent) {
+    if (!h || (count && !ids)) return EUCLID_ERR_BAD_PARAM;
+    auto* s = (EuclidState*)h;
+    const EuclidResult res = s->core.SetParents(ids, count, parent);
+    if (res == EUCLID_OK) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_SET_PARENTS_BATCH)) {
+            r.Var(count).Var(parent);
+            for (size_t i = 0; i < count; ++i) r.Var(ids[i]);
+        }
+    }
+    return res;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_GetParent(EuclidHandle h, EuclidObjectID id, EuclidObjectID* out_parent) {
+    if (!h || !out_parent) return EUCLID_ERR_BAD_PARAM;
+    return ((EuclidState*)h)->core.GetParent(id, *out_parent);
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_GetWorldMatrix(EuclidHandle h, EuclidObjectID id, float out_matrix[16]) {
+    if (!h || !out_matrix) return EUCLID_ERR_BAD_PARAM;
+    return ((EuclidState*)h)->core.GetWorldMatrix(id, out_matrix);
+}
+
 EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
 Euclid_DeleteObject(EuclidHandle h, EuclidObjectID id) {
     if (!h) return EUCLID_ERR_BAD_PARAM;
     auto* s = (EuclidState*)h;
     const EuclidResult r = s->core.DeleteObject(id);
-    if (r == EUCLID_OK && s->selected == id) {
-        s->selected = 0;
+    if (r == EUCLID_OK) {
+        s->selected = 0;   // core drops the selection too (it may have been a child of id)
+        if (auto rec = s->recorder.Begin(EUCLID_REC_DELETE_OBJECT)) rec.Var(id);
     }
     return r;
 }
@@ -116,6 +385,7 @@ EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
 Euclid_SelectObject(EuclidHandle h, EuclidObjectID id) {
     if (auto* s=(EuclidState*)h) {
         // optional: validate id by asking Core or your id set
+        if (auto r = s->recorder.Begin(EUCLID_REC_SELECT)) r.Var(id);
         s->core.SetSelection(id);
         return EUCLID_OK;
     }
@@ -126,7 +396,7 @@ EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
 Euclid_GetSelection(EuclidHandle h, EuclidObjectID* out_id) {
     if (!out_id) return EUCLID_ERR_BAD_PARAM;
     if (auto* s = (EuclidState*)h) {
-        *out_id = s->selected;  
+        *out_id = s->core.GetSelection();   // may have changed through the command queue
         return EUCLID_OK;
     }
     return EUCLID_ERR_BAD_PARAM;
@@ -135,6 +405,7 @@ Euclid_GetSelection(EuclidHandle h, EuclidObjectID* out_id) {
 EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
 Euclid_SetGizmoMode(EuclidHandle h, EuclidGizmoMode mode) {
     if (auto* s=(EuclidState*)h) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_SET_GIZMO_MODE)) r.U8((uint8_t)mode);
         s->gizmoMode = mode;
         s->core.SetGizmoMode(mode);
         return EUCLID_OK;
@@ -152,6 +423,7 @@ EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
 Euclid_HitTestSelect(EuclidHandle h, double x, double y, EuclidObjectID* out_id) {
     if (!out_id) return EUCLID_ERR_BAD_PARAM;
     if (auto* s = (EuclidState*)h) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_HIT_TEST_SELECT)) r.F64(x).F64(y);
         auto id = s->core.RayPick((float)x, (float)y);
         *out_id = id;
         s->selected = id;         
@@ -171,18 +443,26 @@ Euclid_GetObjectTransform(EuclidHandle h, EuclidObjectID id, EuclidTransform* ou
 EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
 Euclid_SetObjectTransform(EuclidHandle h, EuclidObjectID id, const EuclidTransform* tf) {
     if (!tf) return EUCLID_ERR_BAD_PARAM;
-    if (auto* s=(EuclidState*)h) return s->core.SetObjectTransform(id, *tf);
+    if (auto* s=(EuclidState*)h) {
+        const EuclidResult res = s->core.SetObjectTransform(id, *tf);
+        if (res == EUCLID_OK) {
+            if (auto r = s->recorder.Begin(EUCLID_REC_SET_TRANSFORM)) r.Var(id).Bytes(tf, sizeof(*tf));
+        }
+        return res;
+    }
     return EUCLID_ERR_BAD_PARAM;
 }
 EUCLID_EXTERN_C EUCLID_API EuclidObjectID EUCLID_CALL Euclid_RayPick(EuclidHandle h, float x, float y){
     if (!h) return 0;
     auto* s = (EuclidState*)h;
+    if (auto r = s->recorder.Begin(EUCLID_REC_RAY_PICK)) r.F32(x).F32(y);
     return s->core.RayPick(x, y);
 }
 
 EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL
 Euclid_SetSelection(EuclidHandle h, EuclidObjectID id) {
     if (auto* s = (EuclidState*)h) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_SELECT)) r.Var(id);
         s->selected = id;             
         s->core.SetSelection(id);
     }
@@ -194,6 +474,24 @@ EUCLID_EXTERN_C EUCLID_API int EUCLID_CALL Euclid_IsDraggingGizmo(EuclidHandle h
     return s->core.IsDraggingGizmo() ? 1 : 0;
 }
 
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_FrameObject(EuclidHandle h, EuclidObjectID id) {
+    if (auto* s = (EuclidState*)h) {
+        const EuclidResult res = s->core.FrameObject(id);
+        if (res == EUCLID_OK) {
+            if (auto r = s->recorder.Begin(EUCLID_REC_FRAME_OBJECT)) r.Var(id);
+        }
+        return res;
+    }
+    return EUCLID_ERR_BAD_PARAM;
+}
+
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_SetGridVisible(EuclidHandle h, int visible) {
+    if (auto* s = (EuclidState*)h) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_SET_GRID_VISIBLE)) r.U8(visible != 0);
+        s->core.SetGridVisible(visible != 0);
+    }
+}
+
 // ---- Custom mesh import (OBJ / raw) ----
 EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
 Euclid_LoadOBJ(EuclidHandle h, const char* path, EuclidObjectID* out_id, int normalize)
@@ -201,7 +499,11 @@ Euclid_LoadOBJ(EuclidHandle h, const char* path, EuclidObjectID* out_id, int nor
     if (!h || !path || !out_id) return EUCLID_ERR_BAD_PARAM;
     auto* s = (EuclidState*)h;
     // Core must provide these methods; see note below.
-    return s->core.LoadOBJ(path, out_id, normalize != 0);
+    const EuclidResult res = s->core.LoadOBJ(path, out_id, normalize != 0);
+    if (res == EUCLID_OK) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_LOAD_OBJ)) r.Str(path).U8(normalize != 0).Var(*out_id);
+    }
+    return res;
 }
 
 EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
@@ -214,7 +516,52 @@ Euclid_CreateFromRawMesh(EuclidHandle h,
         return EUCLID_ERR_BAD_PARAM;
 
     auto* s = (EuclidState*)h;
-    return s->core.CreateFromRawMesh(positions, vertexCount,
-                                     indices, indexCount,
-                                     out_id, normalize != 0);
+    const EuclidResult res = s->core.CreateFromRawMesh(positions, vertexCount,
+                                                       indices, indexCount,
+                                                       out_id, normalize != 0);
+    if (res == EUCLID_OK) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_CREATE_RAW_MESH)) {
+            r.Var(vertexCount).Bytes(positions, vertexCount * 3 * sizeof(float))
+             .Var(indexCount).Bytes(indices, indexCount * sizeof(unsigned))
+             .U8(normalize != 0).Var(*out_id);
+        }
+    }
+    return res;
+}
+
+// ---- Out-of-core import ----
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_BuildPagedMesh(EuclidHandle h, const char* obj_path, const char* page_path, int normalize)
+{
+    if (!h || !obj_path || !page_path) return EUCLID_ERR_BAD_PARAM;
+    auto* s = (EuclidState*)h;
+    return s->core.BuildPagedMesh(obj_path, page_path, normalize != 0);   // no scene change: not recorded
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_LoadPagedMesh(EuclidHandle h, const char* page_path, EuclidObjectID* out_id)
+{
+    if (!h || !page_path || !out_id) return EUCLID_ERR_BAD_PARAM;
+    auto* s = (EuclidState*)h;
+    const EuclidResult res = s->core.LoadPagedMesh(page_path, out_id);
+    if (res == EUCLID_OK) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_LOAD_PAGED_MESH)) r.Str(page_path).Var(*out_id);
+    }
+    return res;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_SetStreamingBudget(EuclidHandle h, uint64_t bytes)
+{
+    if (!h) return EUCLID_ERR_BAD_PARAM;
+    ((EuclidState*)h)->core.SetStreamingBudget(bytes);
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_GetStreamingStats(EuclidHandle h, EuclidStreamingStats* out_stats)
+{
+    if (!h || !out_stats) return EUCLID_ERR_BAD_PARAM;
+    ((EuclidState*)h)->core.GetStreamingStats(*out_stats);
+    return EUCLID_OK;
 }
@@ -0,0 +1,33 @@
+#include "Euclid_Debug.h"
+#include "GLDebug.hpp"
+#include "State.hpp"
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_EnableGLDebug(EuclidHandle h, int enabled)
+{
+    if (!h) return EUCLID_ERR_BAD_PARAM;
+    return ((EuclidState*)h)->core.EnableGLDebug(enabled != 0) ? EUCLID_OK : EUCLID_ERR_INIT;
+}
+
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL
+Euclid_SetGLMessageCallback(EuclidGLMessageCallback cb, void* user, EuclidGLMessageSeverity min_severity)
+{
+    Euclid::GLDebug::SetCallback(cb, user, min_severity);
+}
+
+EUCLID_EXTERN_C EUCLID_API int EUCLID_CALL Euclid_GetGLMessages(EuclidGLMessage* out, int max)
+{
+    if (max < 0) return 0;
+    return Euclid::GLDebug::Messages(out, max);
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_GetGLDebugStats(EuclidGLDebugStats* out_stats)
+{
+    if (!out_stats) return EUCLID_ERR_BAD_PARAM;
+    Euclid::GLDebug::GetStats(*out_stats);
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_ClearGLMessages(void)
+{
+    Euclid::GLDebug::Clear();
+}
@@ -0,0 +1,20 @@
+#include "Euclid_Events.h"
+#include "State.hpp"
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_EnableEvents(EuclidHandle h, uint32_t capacity)
+{
+    if (!h) return EUCLID_ERR_BAD_PARAM;
+    return ((EuclidState*)h)->core.EnableEvents(capacity);
+}
+
+EUCLID_EXTERN_C EUCLID_API int EUCLID_CALL Euclid_PollEvents(EuclidHandle h, EuclidEvent* out, int max)
+{
+    if (!h || !out || max <= 0) return 0;
+    return (int)((EuclidState*)h)->core.Events().Drain(out, (size_t)max);
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidEventRing* EUCLID_CALL Euclid_GetEventRing(EuclidHandle h)
+{
+    if (!h) return nullptr;
+    return ((EuclidState*)h)->core.Events().Ring();
+}
@@ -0,0 +1,51 @@
+#include "Euclid_GLBackend.h"
+#include "GLBackend.hpp"
+
+
+using Euclid::GLBackend;
+
+static_assert(sizeof(EuclidGLCommand) == sizeof(GLBackend::Command), "EuclidGLCommand must mirror GLBackend::Command");
+
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_SetGLCapture(EuclidGLCapture mode)
+{
+    switch (mode) {
+        case EUCLID_GL_CAPTURE_COUNT:  GLBackend::SetCapture(GLBackend::Capture::Count);  break;
+        case EUCLID_GL_CAPTURE_RECORD: GLBackend::SetCapture(GLBackend::Capture::Record); break;
+        default:                       GLBackend::SetCapture(GLBackend::Capture::Off);    break;
+    }
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_GetGLCallStats(EuclidGLCallStats* out_stats)
+{
+    if (!out_stats) return EUCLID_ERR_BAD_PARAM;
+    out_stats->total_calls     = GLBackend::TotalCount();
+    out_stats->draw_calls      = GLBackend::CategoryCount(GLBackend::kDraw);
+    out_stats->binds           = GLBackend::CategoryCount(GLBackend::kBind);
+    out_stats->state_changes   = GLBackend::CategoryCount(GLBackend::kState);
+    out_stats->uniform_updates = GLBackend::CategoryCount(GLBackend::kUniform);
+    out_stats->uploads         = GLBackend::CategoryCount(GLBackend::kUpload);
+    out_stats->queries         = GLBackend::CategoryCount(GLBackend::kQuery);
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API uint64_t EUCLID_CALL Euclid_GetGLCallCount(const char* gl_function)
+{
+    const int call = GLBackend::FindCall(gl_function);
+    return call >= 0 ? GLBackend::CallCount((uint32_t)call) : 0;
+}
+
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_ResetGLCallStats(void)
+{
+    GLBackend::ResetCounts();
+}
+
+EUCLID_EXTERN_C EUCLID_API size_t EUCLID_CALL Euclid_TakeGLCommands(EuclidGLCommand* out, size_t max)
+{
+    if (!out) return GLBackend::PendingCommands();
+    return GLBackend::TakeCommands(reinterpret_cast<GLBackend::Command*>(out), max);
+}
+
+EUCLID_EXTERN_C EUCLID_API const char* EUCLID_CALL Euclid_GLCallName(uint32_t call)
+{
+    return GLBackend::CallName(call);
+}
@@ -3,17 +3,42 @@
 
 EUCLID_API void Euclid_OnMouseMove(EuclidHandle h, double x, double y)
 {
-    if (auto* s=(EuclidState*)h) s->core.OnMouseMove(x, y);
+    if (auto* s=(EuclidState*)h) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_MOUSE_MOVE)) r.F64(x).F64(y);
+        s->core.OnMouseMove(x, y);
+    }
 }
 EUCLID_API void Euclid_OnMouseButton(EuclidHandle h, EuclidMouseButton b, int down, EuclidMods mods)
 {
-    if (auto* s=(EuclidState*)h) s->core.OnMouseButton((int)b, down!=0, (unsigned)mods);
+    if (auto* s=(EuclidState*)h) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_MOUSE_BUTTON)) r.U8((uint8_t)b).U8(down != 0).U8(mods);
+        s->core.OnMouseButton((int)b, down!=0, (unsigned)mods);
+    }
 }
 EUCLID_API void Euclid_OnScroll(EuclidHandle h, double dx, double dy)
 {
-    if (auto* s=(EuclidState*)h) s->core.OnScroll(dx, dy);
+    if (auto* s=(EuclidState*)h) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_SCROLL)) r.F64(dx).F64(dy);
+        s->core.OnScroll(dx, dy);
+    }
 }
 EUCLID_API void Euclid_OnMods(EuclidHandle h, EuclidMods mods)
 {
-    if (auto* s = (EuclidState*)h) s->core.OnMods((unsigned)mods);
+    if (auto* s = (EuclidState*)h) {
+        if (auto r = s->recorder.Begin(EUCLID_REC_MODS)) r.U8(mods);
+        s->core.OnMods((unsigned)mods);
+    }
+}
+EUCLID_API void Euclid_FramePresented(EuclidHandle h)
+{
+    if (auto* s = (EuclidState*)h) {
+        s->recorder.Begin(EUCLID_REC_FRAME_PRESENTED);
+        s->core.FramePresented();
+    }
+}
+EUCLID_API EuclidResult Euclid_GetInputStats(EuclidHandle h, EuclidInputStats* out_stats)
+{
+    if (!h || !out_stats) return EUCLID_ERR_BAD_PARAM;
+    ((EuclidState*)h)->core.GetInputStats(*out_stats);
+    return EUCLID_OK;
 }
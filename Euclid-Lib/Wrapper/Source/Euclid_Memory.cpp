@@ -0,0 +1,23 @@
+#include "Euclid_Memory.h"
+#include "MemoryStats.hpp"
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_GetMemoryStats(EuclidMemoryStats* out_stats)
+{
+    if (!out_stats) return EUCLID_ERR_BAD_PARAM;
+    Euclid::MemoryStats::Get(*out_stats);
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_ResetMemoryPeaks(void)
+{
+    Euclid::MemoryStats::ResetPeaks();
+}
+
+EUCLID_EXTERN_C EUCLID_API const char* EUCLID_CALL Euclid_MemoryCategoryName(EuclidMemoryCategory c)
+{
+    static const char* const kNames[EUCLID_MEM_CATEGORY_COUNT] = {
+        "gpu_meshes", "gpu_streaming", "gpu_render_targets", "gpu_readback",
+        "cpu_scene", "cpu_snapshots", "cpu_import", "cpu_queues", "cpu_frame", "cpu_diagnostics"
+    };
+    return (c >= 0 && c < EUCLID_MEM_CATEGORY_COUNT) ? kNames[c] : "unknown";
+}
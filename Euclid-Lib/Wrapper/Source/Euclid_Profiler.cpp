@@ -0,0 +1,30 @@
+#include "Euclid_Profiler.h"
+#include "Profiler.hpp"
+#include "State.hpp"
+
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_ProfilerEnable(int enabled)
+{
+    Euclid::Profiler::SetEnabled(enabled != 0);
+}
+
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_ProfilerSetThreadName(const char* name)
+{
+    Euclid::Profiler::SetThreadName(name);
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_ProfilerExportChromeTrace(const char* path)
+{
+    if (!path) return EUCLID_ERR_BAD_PARAM;
+    return Euclid::Profiler::ExportChromeTrace(path) ? EUCLID_OK : EUCLID_ERR_INIT;
+}
+
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_SetPassTimings(EuclidHandle h, int enabled)
+{
+    if (h) ((EuclidState*)h)->core.SetPassTimings(enabled != 0);
+}
+
+EUCLID_EXTERN_C EUCLID_API int EUCLID_CALL Euclid_GetPassTimings(EuclidHandle h, EuclidPassTiming* out, int max)
+{
+    if (!h || max < 0) return 0;
+    return ((EuclidState*)h)->core.PassTimings(out, max);
+}
@@ -0,0 +1,374 @@
+#include "Euclid_Record.h"
+#include "Euclid.h"
+#include "Recording.hpp"
+#include <glad/glad.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Payloads, per op (ids are varints, "shape" is Rec::PutShape):
+//   RESIZE w h | UPDATE f32 dt | RENDER, FRAME_PRESENTED, CLEAR_SCENE: -
+//   RENDER_VIEWPORTS n EuclidViewport[n] | MOUSE_MOVE, SCROLL, HIT_TEST_SELECT: f64 x y
+//   MOUSE_BUTTON u8 button down mods | MODS u8 | CREATE_SHAPE shape id
+//   CREATE_SHAPES_BATCH n (shape id)[n] | SET_TRANSFORM id EuclidTransform
+//   SET_TRANSFORMS_BATCH n (id EuclidTransform)[n] | DELETE_OBJECT, SELECT, FRAME_OBJECT id
+//   SET_PARENT child parent | SET_PARENTS_BATCH n parent id[n] | LOAD_OBJ str path, u8 normalize, id
+//   CREATE_RAW_MESH nv f32[3nv] ni u32[ni] u8 normalize id | SET_GIZMO_MODE, SET_GRID_VISIBLE u8
+//   RAY_PICK f32 x y | CAMERA f32 target[3] radius yaw pitch zoom
+//   SUBMIT_COMMANDS n EuclidCommand[n] | RESERVE_IDS count first | LOAD_PAGED_MESH str path, id
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using Euclid::SessionReader;
+
+const char* const kOpNames[EUCLID_REC_OP_COUNT] = {
+    "none", "resize", "update", "render", "render_viewports", "frame_presented",
+    "mouse_move", "mouse_button", "scroll", "mods", "clear_scene", "create_shape",
+    "create_shapes_batch", "set_transform", "set_transforms_batch", "delete_object",
+    "set_parent", "set_parents_batch", "load_obj", "create_raw_mesh", "select",
+    "set_gizmo_mode", "hit_test_select", "ray_pick", "frame_object", "set_grid_visible",
+    "camera", "submit_commands", "reserve_ids", "load_paged_mesh"
+};
+
+// -------- Snapshot --------
+// Rebuilds the current state as plain calls: size, camera, objects, hierarchy, selection
+void WriteSnapshot(EuclidState& s)
+{
+    if (auto r = s.recorder.Begin(EUCLID_REC_RESIZE)) r.Var((uint32_t)s.fbW).Var((uint32_t)s.fbH);
+
+    const auto cam = s.core.GetCameraState();
+    if (auto r = s.recorder.Begin(EUCLID_REC_CAMERA))
+        r.F32(cam.target[0]).F32(cam.target[1]).F32(cam.target[2]).F32(cam.radius).F32(cam.yaw).F32(cam.pitch).F32(cam.zoom);
+
+    EuclidSceneView v{};
+    s.core.GetSceneView(v);
+    std::vector<float>    positions;
+    std::vector<unsigned> indices;
+    for (size_t i = 0; i < v.count; ++i) {
+        if (v.types[i] != EUCLID_SHAPE_CUSTOM) {
+            const EuclidCreateShapeDesc d{ v.types[i], nullptr, v.transforms[i] };   // params are baked into the scale
+            if (auto r = s.recorder.Begin(EUCLID_REC_CREATE_SHAPE)) { Euclid::Rec::PutShape(r, d); r.Var(v.ids[i]); }
+            continue;
+        }
+        // paged meshes don't fit in memory: the log points at their file instead
+        std::string pagePath;
+        if (s.core.PagedMeshPath(v.ids[i], pagePath) == EUCLID_OK) {
+            if (auto r = s.recorder.Begin(EUCLID_REC_LOAD_PAGED_MESH)) r.Str(pagePath.c_str()).Var(v.ids[i]);
+        } else {
+            if (s.core.ReadCustomMesh(v.ids[i], positions, indices) != EUCLID_OK) continue;
+            if (auto r = s.recorder.Begin(EUCLID_REC_CREATE_RAW_MESH)) {
+                r.Var(positions.size() / 3).Bytes(positions.data(), positions.size() * sizeof(float))
+                 .Var(indices.size()).Bytes(indices.data(), indices.size() * sizeof(unsigned))
+                 .U8(0).Var(v.ids[i]);
+            }
+        }
+        if (auto r = s.recorder.Begin(EUCLID_REC_SET_TRANSFORM)) r.Var(v.ids[i]).Bytes(&v.transforms[i], sizeof(EuclidTransform));
+    }
+    // parents may come after their children in the scene arrays
+    for (size_t i = 0; i < v.count; ++i) {
+        EuclidObjectID parent = 0;
+        if (s.core.GetParent(v.ids[i], parent) == EUCLID_OK && parent) {
+            if (auto r = s.recorder.Begin(EUCLID_REC_SET_PARENT)) r.Var(v.ids[i]).Var(parent);
+        }
+    }
+
+    if (auto r = s.recorder.Begin(EUCLID_REC_SELECT))           r.Var(s.core.GetSelection());
+    if (auto r = s.recorder.Begin(EUCLID_REC_SET_GIZMO_MODE))   r.U8((uint8_t)s.gizmoMode);
+    if (auto r = s.recorder.Begin(EUCLID_REC_SET_GRID_VISIBLE)) r.U8(s.core.GridVisible());
+}
+
+// -------- Replay --------
+// Recorded ids -> ids of the objects the replay created
+struct IdMap {
+    struct Range { EuclidObjectID from, count, to; };
+    std::unordered_map<EuclidObjectID, EuclidObjectID> ids;
+    std::vector<Range> ranges;   // Euclid_ReserveObjectIDs blocks
+    uint64_t unknown = 0;
+
+    void Add(EuclidObjectID from, EuclidObjectID to) { if (from && to) ids[from] = to; }
+    EuclidObjectID operator()(EuclidObjectID id) {
+        if (id == 0) return 0;
+        if (auto it = ids.find(id); it != ids.end()) return it->second;
+        for (const Range& r : ranges)
+            if (id >= r.from && id - r.from < r.count) return r.to + (id - r.from);
+        ++unknown;
+        return 0;
+    }
+};
+
+bool ReadShape(SessionReader& in, EuclidCreateShapeDesc& d, uint8_t (&params)[Euclid::Rec::kMaxParams])
+{
+    d.type = (EuclidShapeType)in.U8();
+    if (const void* p = in.Bytes(sizeof(d.xform))) std::memcpy(&d.xform, p, sizeof(d.xform));
+    const uint8_t n = in.U8();
+    if (n > sizeof(params)) return false;
+    const void* p = in.Bytes(n);
+    if (p && n) std::memcpy(params, p, n);
+    d.params = n ? params : nullptr;
+    return !in.Bad();
+}
+
+template <typename T>
+bool ReadArray(SessionReader& in, size_t count, std::vector<T>& out)
+{
+    if (count > (SIZE_MAX / sizeof(T))) return false;
+    const void* p = in.Bytes(count * sizeof(T));
+    if (!p) return false;
+    out.resize(count);
+    if (count) std::memcpy(out.data(), p, count * sizeof(T));
+    return true;
+}
+
+// One record, through the public API. False on a damaged payload.
+bool ReplayOne(EuclidHandle h, EuclidState& s, EuclidRecordOp op, SessionReader& in, IdMap& ids)
+{
+    uint8_t params[Euclid::Rec::kMaxParams];
+    switch (op) {
+    case EUCLID_REC_RESIZE: {
+        const int w = (int)in.Var(), hgt = (int)in.Var();
+        if (!in.Bad()) Euclid_Resize(h, w, hgt);
+        break;
+    }
+    case EUCLID_REC_UPDATE:          Euclid_Update(h, in.F32()); break;
+    case EUCLID_REC_RENDER:          Euclid_Render(h); break;
+    case EUCLID_REC_FRAME_PRESENTED: Euclid_FramePresented(h); break;
+    case EUCLID_REC_CLEAR_SCENE:     Euclid_ClearScene(h); break;
+    case EUCLID_REC_RENDER_VIEWPORTS: {
+        std::vector<EuclidViewport> vp;
+        if (!ReadArray(in, in.Var(), vp)) return false;
+        Euclid_RenderViewports(h, vp.data(), (int)vp.size());
+        break;
+    }
+    case EUCLID_REC_MOUSE_MOVE: {
+        const double x = in.F64(), y = in.F64();
+        Euclid_OnMouseMove(h, x, y);
+        break;
+    }
+    case EUCLID_REC_MOUSE_BUTTON: {
+        const uint8_t b = in.U8(), down = in.U8(), mods = in.U8();
+        Euclid_OnMouseButton(h, (EuclidMouseButton)b, down, mods);
+        break;
+    }
+    case EUCLID_REC_SCROLL: {
+        const double dx = in.F64(), dy = in.F64();
+        Euclid_OnScroll(h, dx, dy);
+        break;
+    }
+    case EUCLID_REC_MODS: Euclid_OnMods(h, in.U8()); break;
+    case EUCLID_REC_CREATE_SHAPE: {
+        EuclidCreateShapeDesc d{};
+        if (!ReadShape(in, d, params)) return false;
+        const EuclidObjectID recorded = in.Var();
+        EuclidObjectID id = 0;
+        if (Euclid_CreateShape(h, &d, &id) == EUCLID_OK) ids.Add(recorded, id);
+        break;
+    }
+    case EUCLID_REC_CREATE_SHAPES_BATCH: {
+        const uint64_t n = in.Var();
+        std::deque<std::array<uint8_t, Euclid::Rec::kMaxParams>> paramStore;   // stable addresses
+        std::vector<EuclidCreateShapeDesc> descs;
+        std::vector<EuclidObjectID> recorded;
+        for (uint64_t i = 0; i < n && !in.Bad(); ++i) {
+            EuclidCreateShapeDesc d{};
+            if (!ReadShape(in, d, params)) return false;
+            if (d.params) d.params = std::memcpy(paramStore.emplace_back().data(), params, sizeof(params));
+            descs.push_back(d);
+            recorded.push_back(in.Var());
+        }
+        std::vector<EuclidObjectID> out(descs.size(), 0);
+        if (Euclid_CreateShapesBatch(h, descs.data(), descs.size(), out.data()) == EUCLID_OK)
+            for (size_t i = 0; i < out.size(); ++i) ids.Add(recorded[i], out[i]);
+        break;
+    }
+    case EUCLID_REC_SET_TRANSFORM: {
+        const EuclidObjectID id = ids(in.Var());
+        EuclidTransform tf;
+        const void* p = in.Bytes(sizeof(tf));
+        if (!p) return false;
+        std::memcpy(&tf, p, sizeof(tf));
+        Euclid_SetObjectTransform(h, id, &tf);
+        break;
+    }
+    case EUCLID_REC_SET_TRANSFORMS_BATCH: {
+        const uint64_t n = in.Var();
+        std::vector<EuclidObjectID>  batchIds;
+        std::vector<EuclidTransform> tfs;
+        for (uint64_t i = 0; i < n && !in.Bad(); ++i) {
+            batchIds.push_back(ids(in.Var()));
+            const void* p = in.Bytes(sizeof(EuclidTransform));
+            if (!p) return false;
+            tfs.emplace_back();
+            std::memcpy(&tfs.back(), p, sizeof(EuclidTransform));
+        }
+        Euclid_SetTransformsBatch(h, batchIds.data(), batchIds.size(), tfs.data(), 0);
+        break;
+    }
+    case EUCLID_REC_DELETE_OBJECT: Euclid_DeleteObject(h, ids(in.Var())); break;
+    case EUCLID_REC_SELECT:        Euclid_SetSelection(h, ids(in.Var())); break;
+    case EUCLID_REC_FRAME_OBJECT:  Euclid_FrameObject(h, ids(in.Var())); break;
+    case EUCLID_REC_SET_PARENT: {
+        const EuclidObjectID child = ids(in.Var()), parent = ids(in.Var());
+        Euclid_SetParent(h, child, parent);
+        break;
+    }
+    case EUCLID_REC_SET_PARENTS_BATCH: {
+        const uint64_t n = in.Var();
+        const EuclidObjectID parent = ids(in.Var());
+        std::vector<EuclidObjectID> children;
+        for (uint64_t i = 0; i < n && !in.Bad(); ++i) children.push_back(ids(in.Var()));
+        Euclid_SetParentsBatch(h, children.data(), children.size(), parent);
+        break;
+    }
+    case EUCLID_REC_LOAD_OBJ: {
+        const std::string path = in.Str();
+        const int normalize = in.U8();
+        const EuclidObjectID recorded = in.Var();
+        EuclidObjectID id = 0;
+        if (!in.Bad() && Euclid_LoadOBJ(h, path.c_str(), &id, normalize) == EUCLID_OK) ids.Add(recorded, id);
+        break;
+    }
+    case EUCLID_REC_LOAD_PAGED_MESH: {
+        const std::string path = in.Str();
+        const EuclidObjectID recorded = in.Var();
+        EuclidObjectID id = 0;
+        if (!in.Bad() && Euclid_LoadPagedMesh(h, path.c_str(), &id) == EUCLID_OK) ids.Add(recorded, id);
+        break;
+    }
+    case EUCLID_REC_CREATE_RAW_MESH: {
+        std::vector<float>    pos;
+        std::vector<unsigned> idx;
+        const uint64_t nv = in.Var();
+        if (nv > SIZE_MAX / 3 || !ReadArray(in, nv * 3, pos)) return false;
+        if (!ReadArray(in, in.Var(), idx)) return false;
+        const int normalize = in.U8();
+        const EuclidObjectID recorded = in.Var();
+        EuclidObjectID id = 0;
+        if (Euclid_CreateFromRawMesh(h, pos.data(), nv, idx.data(), idx.size(), &id, normalize) == EUCLID_OK)
+            ids.Add(recorded, id);
+        break;
+    }
+    case EUCLID_REC_SET_GIZMO_MODE:   Euclid_SetGizmoMode(h, (EuclidGizmoMode)in.U8()); break;
+    case EUCLID_REC_SET_GRID_VISIBLE: Euclid_SetGridVisible(h, in.U8()); break;
+    case EUCLID_REC_HIT_TEST_SELECT: {
+        const double x = in.F64(), y = in.F64();
+        EuclidObjectID id = 0;
+        Euclid_HitTestSelect(h, x, y, &id);
+        break;
+    }
+    case EUCLID_REC_RAY_PICK: {
+        const float x = in.F32(), y = in.F32();
+        Euclid_RayPick(h, x, y);
+        break;
+    }
+    case EUCLID_REC_CAMERA: {
+        Euclid::Core::CameraState c;
+        for (float& t : c.target) t = in.F32();
+        c.radius = in.F32(); c.yaw = in.F32(); c.pitch = in.F32(); c.zoom = in.F32();
+        if (!in.Bad()) s.core.SetCameraState(c);
+        break;
+    }
+    case EUCLID_REC_SUBMIT_COMMANDS: {
+        std::vector<EuclidCommand> cmds;
+        if (!ReadArray(in, in.Var(), cmds)) return false;
+        for (EuclidCommand& c : cmds) { c.id = ids(c.id); c.parent = ids(c.parent); }
+        // the log doesn't say how the queue was set up; any size that takes the batch will do
+        if (!s.core.CommandQueueEnabled())
+            Euclid_EnableCommandQueue(h, (uint32_t)std::max<size_t>(cmds.size(), 4096));
+        Euclid_SubmitCommands(h, cmds.data(), cmds.size());
+        break;
+    }
+    case EUCLID_REC_RESERVE_IDS: {
+        const uint64_t count = in.Var(), first = in.Var();
+        EuclidObjectID mine = 0;
+        if (!in.Bad() && Euclid_ReserveObjectIDs(h, count, &mine) == EUCLID_OK)
+            ids.ranges.push_back({ first, count, mine });
+        break;
+    }
+    default: return false;
+    }
+    return !in.Bad();
+}
+
+double Percentile(const std::vector<double>& sorted, double q)
+{
+    if (sorted.empty()) return 0.0;
+    return sorted[std::min(sorted.size() - 1, (size_t)(q * (sorted.size() - 1) + 0.5))];
+}
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL Euclid_RecordStart(EuclidHandle h, const char* path)
+{
+    auto* s = (EuclidState*)h;
+    if (!s || !path) return EUCLID_ERR_BAD_PARAM;
+    if (!s->recorder.Open(path, s->fbW, s->fbH)) return EUCLID_ERR_BAD_PARAM;
+    WriteSnapshot(*s);
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL Euclid_RecordStop(EuclidHandle h)
+{
+    if (auto* s = (EuclidState*)h) s->recorder.Close();
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_Replay(EuclidHandle h, const char* path, const EuclidReplayDesc* desc, EuclidReplayStats* out_stats)
+{
+    auto* s = (EuclidState*)h;
+    if (!s || !path) return EUCLID_ERR_BAD_PARAM;
+    const EuclidReplayDesc d = desc ? *desc : EuclidReplayDesc{ 0, 1 };
+
+    SessionReader in;
+    if (!in.Open(path)) return EUCLID_ERR_BAD_PARAM;
+
+    EuclidReplayStats st{};
+    std::vector<double> frames;
+    IdMap ids;
+    Euclid_ClearScene(h);
+
+    const auto start = Clock::now();
+    uint64_t recordedNs = 0;
+    EuclidRecordOp op;
+    uint64_t dtNs;
+    bool ok = true;
+    while (in.Next(op, dtNs)) {
+        recordedNs += dtNs;
+        if (d.realtime) std::this_thread::sleep_until(start + std::chrono::nanoseconds(recordedNs));
+
+        const auto t0 = Clock::now();
+        ok = ReplayOne(h, *s, op, in, ids);
+        const bool frame = op == EUCLID_REC_RENDER || op == EUCLID_REC_RENDER_VIEWPORTS;
+        if (frame && d.finish_frames) glFinish();
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        if (!ok) break;
+
+        ++st.events;
+        auto& o = st.ops[op];
+        ++o.count;
+        o.total_ms += ms;
+        o.max_ms = std::max(o.max_ms, ms);
+        if (frame) frames.push_back(ms);
+    }
+    ok = ok && !in.Bad();
+
+    st.frames      = frames.size();
+    st.unknown_ids = ids.unknown;
+    st.recorded_ms = recordedNs / 1e6;
+    st.replay_ms   = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::sort(frames.begin(), frames.end());
+    st.frame_p50_ms = Percentile(frames, 0.50);
+    st.frame_p95_ms = Percentile(frames, 0.95);
+    st.frame_p99_ms = Percentile(frames, 0.99);
+    st.frame_max_ms = frames.empty() ? 0.0 : frames.back();
+    if (out_stats) *out_stats = st;
+    return ok ? EUCLID_OK : EUCLID_ERR_BAD_PARAM;
+}
+
+EUCLID_EXTERN_C EUCLID_API const char* EUCLID_CALL Euclid_RecordOpName(EuclidRecordOp op)
+{
+    return (op >= 0 && op < EUCLID_REC_OP_COUNT) ? kOpNames[op] : "unknown";
+}
@@ -1 +1,84 @@
-// Bruh
+#include "Euclid_Renderer.h"
+#include "State.hpp"
+
+EUCLID_EXTERN_C EUCLID_API void EUCLID_CALL
+Euclid_GetStats(EuclidHandle h, EuclidStats* out_stats)
+{
+    if (!h || !out_stats) return;
+    ((EuclidState*)h)->core.GetStats(*out_stats);
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_SetGpuDriven(EuclidHandle h, int enabled)
+{
+    if (!h) return EUCLID_ERR_BAD_PARAM;
+    return ((EuclidState*)h)->core.SetGpuDriven(enabled != 0) ? EUCLID_OK : EUCLID_ERR_INIT;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_SetOcclusionCulling(EuclidHandle h, int enabled)
+{
+    if (!h) return EUCLID_ERR_BAD_PARAM;
+    ((EuclidState*)h)->core.SetOcclusionCulling(enabled != 0);
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_SetBackfaceCulling(EuclidHandle h, int enabled)
+{
+    if (!h) return EUCLID_ERR_BAD_PARAM;
+    ((EuclidState*)h)->core.SetBackfaceCulling(enabled != 0);
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_GetInitStats(EuclidHandle h, EuclidInitStats* out_stats)
+{
+    if (!h || !out_stats) return EUCLID_ERR_BAD_PARAM;
+    ((EuclidState*)h)->core.GetInitStats(*out_stats);
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_RenderTiled(EuclidHandle h, const EuclidTiledRenderDesc* desc)
+{
+    if (!h || !desc || !desc->path || desc->width <= 0 || desc->height <= 0) return EUCLID_ERR_BAD_PARAM;
+    auto* s = (EuclidState*)h;
+    return s->core.RenderTiled(desc->path, desc->width, desc->height, desc->tile_size, desc->draw_grid != 0);
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_RenderViewports(EuclidHandle h, const EuclidViewport* viewports, int count)
+{
+    if (!h || !viewports || count <= 0 || count > EUCLID_MAX_VIEWPORTS) return EUCLID_ERR_BAD_PARAM;
+    auto* s = (EuclidState*)h;
+    if (auto r = s->recorder.Begin(EUCLID_REC_RENDER_VIEWPORTS)) r.Var((uint32_t)count).Bytes(viewports, count * sizeof(EuclidViewport));
+    glBindFramebuffer(GL_FRAMEBUFFER, s->targetFbo);
+    return s->core.RenderViewports(viewports, count);
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_GetCameraMatrices(EuclidHandle h, float view[16], float projection[16])
+{
+    if (!h || !view || !projection) return EUCLID_ERR_BAD_PARAM;
+    ((EuclidState*)h)->core.GetCameraMatrices(view, projection);
+    return EUCLID_OK;
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_RenderSequence(EuclidHandle h, const EuclidSequenceDesc* desc)
+{
+    if (!h || !desc || !desc->path_pattern || desc->frame_count <= 0) return EUCLID_ERR_BAD_PARAM;
+    auto* s = (EuclidState*)h;
+    return s->core.RenderSequence(*desc);
+}
+
+EUCLID_EXTERN_C EUCLID_API EuclidResult EUCLID_CALL
+Euclid_WriteImage(const char* path, EuclidImageFormat format, int width, int height, int channels, const void* pixels)
+{
+    if (!path || !pixels || width <= 0 || height <= 0 || (channels != 3 && channels != 4)) return EUCLID_ERR_BAD_PARAM;
+    const auto* px = static_cast<const uint8_t*>(pixels);
+    const bool ok = (format == EUCLID_IMAGE_QOI) ? Euclid::WriteQOI(path, width, height, channels, px)
+                                                 : Euclid::WritePNG(path, width, height, channels, px);
+    return ok ? EUCLID_OK : EUCLID_ERR_INIT;
+}
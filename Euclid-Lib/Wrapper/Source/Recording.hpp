@@ -0,0 +1,28 @@
+#pragma once
+#include "State.hpp"
+
+// Payload pieces shared by the recording hooks and Euclid_Replay (see Euclid_Record.cpp)
+namespace Euclid::Rec {
+
+// Bytes of the params struct that goes with t (0: none)
+inline uint8_t ParamsSize(EuclidShapeType t) {
+    switch (t) {
+        case EUCLID_SHAPE_CUBE:     return sizeof(EuclidCubeParams);
+        case EUCLID_SHAPE_SPHERE:   return sizeof(EuclidSphereParams);
+        case EUCLID_SHAPE_TORUS:    return sizeof(EuclidTorusParams);
+        case EUCLID_SHAPE_PLANE:    return sizeof(EuclidPlaneParams);
+        case EUCLID_SHAPE_CONE:     return sizeof(EuclidConeParams);
+        case EUCLID_SHAPE_CYLINDER: return sizeof(EuclidCylinderParams);
+        case EUCLID_SHAPE_PRISM:    return sizeof(EuclidPrismParams);
+        case EUCLID_SHAPE_CIRCLE:   return sizeof(EuclidCircleParams);
+        default:                    return 0;
+    }
+}
+constexpr uint8_t kMaxParams = 32;
+
+// shape: u8 type, transform, u8 param bytes, params
+inline void PutShape(SessionWriter::Record& r, const EuclidCreateShapeDesc& d) {
+    const uint8_t n = d.params ? ParamsSize(d.type) : 0;
+    r.U8((uint8_t)d.type).Bytes(&d.xform, sizeof(d.xform)).U8(n).Bytes(d.params, n);
+}
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include "Core.hpp"
 #include "Renderer.hpp"
+#include "Headless.hpp"
+#include "SessionLog.hpp"
 #include <unordered_map>
 
 namespace Euclid {
@@ -8,15 +10,25 @@ struct Object; // fwd
 }
 
 struct EuclidState {
+    EuclidState() = default;
+    explicit EuclidState(std::shared_ptr<Euclid::SharedContext> shared) : core(std::move(shared)) {}
+
+    // Set for Euclid_CreateHeadless (shared by its views). Declared first so it is
+    // destroyed last, after everything below has released its GL objects.
+    std::shared_ptr<Euclid::HeadlessContext> headless;
+    Euclid::RenderTarget offscreen;   // headless frames land here
+
     Euclid::Core core;
+    Euclid_GetProcAddr loader = nullptr;   // what core was initialized with, reused by views
     int  fbW = 0, fbH = 0;
     bool ready = false;
     unsigned int targetFbo = 0; // 0 = default/backbuffer
 
     // Scene registry (ID -> Object)
     std::unordered_map<EuclidObjectID, std::unique_ptr<Euclid::Object>> objects;
-    EuclidObjectID nextID = 1;
     EuclidObjectID selected = 0;
 
     EuclidGizmoMode gizmoMode = EUCLID_GIZMO_TRANSLATE;
+
+    Euclid::SessionWriter recorder;   // Euclid_RecordStart
 };
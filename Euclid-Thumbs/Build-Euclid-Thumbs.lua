@@ -0,0 +1,42 @@
+project "Euclid-Thumbs"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++20"
+	targetdir "Binaries/%{cfg.buildcfg}"
+	staticruntime "off"
+	
+files { "Source/**.hpp", "Source/**.cpp", "Source/**.h" }
+
+includedirs { "Source", "../Euclid-Lib/Wrapper/Include" }
+
+links { "Euclid-Lib" }
+
+targetdir ("../Binaries/" .. OutputDir .. "/%{prj.name}")
+objdir ("../Binaries/Intermediates/" .. OutputDir .. "/%{prj.name}")
+
+
+
+filter "system:windows"
+       systemversion "latest"
+       defines { "WINDOWS" }
+
+filter "system:linux"
+       links   { "pthread" }
+filter {}  
+
+filter "configurations:Debug"
+       defines { "DEBUG" }
+       runtime "Debug"
+       symbols "On"
+
+filter "configurations:Release"
+       defines { "RELEASE" }
+       runtime "Release"
+       optimize "On"
+       symbols "On"
+
+filter "configurations:Dist"
+       defines { "DIST" }
+       runtime "Release"
+       optimize "On"
+       symbols "Off"
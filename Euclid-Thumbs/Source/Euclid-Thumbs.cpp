@@ -0,0 +1,223 @@
+// Euclid-Thumbs: batch thumbnailer for OBJ libraries, runs on headless Euclid instances.
+//
+//   Euclid-Thumbs <asset dir> <cache dir> [--size N] [--jobs N] [--qoi] [--force]
+//
+// Every worker thread owns one headless instance and pulls files off a shared counter:
+// hash -> cache hit? skip : import (normalized) -> frame -> render -> encode.
+// Thumbnails are named after a hash of the file contents + render settings, so renamed
+// or moved assets stay cached and edited ones are re-rendered. <cache>/index.tsv maps
+// hashes back to asset paths for the last run.
+
+#include "Euclid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// bump when the look of thumbnails changes (camera, colors, ...) to invalidate caches
+static constexpr uint32_t kThumbVersion = 1;
+
+struct Options {
+    fs::path assets, cache;
+    int  size = 256;
+    int  jobs = 0;        // 0 = hardware concurrency
+    bool qoi = false;
+    bool force = false;
+};
+
+struct Entry {
+    uint64_t hash = 0;
+    bool     ok = false;
+};
+
+// -------- Hashing --------
+static uint64_t Fnv1a(const void* data, size_t len, uint64_t h = 0xcbf29ce484222325ull) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < len; ++i) { h ^= p[i]; h *= 0x100000001b3ull; }
+    return h;
+}
+
+static bool HashFile(const fs::path& path, const Options& opt, uint64_t& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    uint64_t h = 0xcbf29ce484222325ull;
+    std::vector<char> buf(1 << 16);
+    while (in) {
+        in.read(buf.data(), (std::streamsize)buf.size());
+        h = Fnv1a(buf.data(), (size_t)in.gcount(), h);
+    }
+    const uint32_t settings[3] = { kThumbVersion, (uint32_t)opt.size, opt.qoi ? 1u : 0u };
+    out = Fnv1a(settings, sizeof(settings), h);
+    return true;
+}
+
+static std::string HashName(uint64_t h) {
+    char s[17];
+    std::snprintf(s, sizeof(s), "%016llx", (unsigned long long)h);
+    return s;
+}
+
+// -------- Args --------
+static bool ParseArgs(int argc, char** argv, Options& opt) {
+    std::vector<std::string> pos;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if      (a == "--size"  && i + 1 < argc) opt.size = std::atoi(argv[++i]);
+        else if (a == "--jobs"  && i + 1 < argc) opt.jobs = std::atoi(argv[++i]);
+        else if (a == "--qoi")   opt.qoi = true;
+        else if (a == "--force") opt.force = true;
+        else if (a.rfind("--", 0) == 0) return false;
+        else pos.push_back(a);
+    }
+    if (pos.size() != 2 || opt.size <= 0) return false;
+    opt.assets = pos[0];
+    opt.cache  = pos[1];
+    return true;
+}
+
+static std::vector<fs::path> CollectOBJs(const fs::path& root) {
+    std::vector<fs::path> out;
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(root, fs::directory_options::skip_permission_denied, ec);
+         it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (ec) break;
+        if (!it->is_regular_file(ec)) continue;
+        std::string ext = it->path().extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c){ return (char)std::tolower(c); });
+        if (ext == ".obj") out.push_back(it->path());
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+// -------- Worker --------
+struct Shared {
+    const Options* opt = nullptr;
+    const std::vector<fs::path>* files = nullptr;
+    std::vector<Entry>* entries = nullptr;
+    std::atomic<size_t> next{0};
+    std::atomic<int> rendered{0}, cached{0}, failed{0};
+    std::mutex logMutex;
+};
+
+static void Log(Shared& sh, const char* tag, const fs::path& p, const char* extra = "") {
+    std::lock_guard<std::mutex> lock(sh.logMutex);
+    std::fprintf(stderr, "[%s] %s %s\n", tag, p.string().c_str(), extra);
+}
+
+static void Worker(Shared& sh, int index) {
+    const Options& opt = *sh.opt;
+    const char* ext = opt.qoi ? ".qoi" : ".png";
+
+    EuclidConfig cfg{opt.size, opt.size, 3, 3};
+    EuclidHandle h = nullptr;
+    if (Euclid_CreateHeadless(&cfg, &h) != EUCLID_OK) {
+        std::lock_guard<std::mutex> lock(sh.logMutex);
+        std::fprintf(stderr, "worker %d: %s\n", index, Euclid_GetLastError());
+        return;
+    }
+    Euclid_SetGridVisible(h, 0);
+
+    std::vector<uint8_t> rgba((size_t)opt.size * opt.size * 4);
+    std::vector<uint8_t> rgb((size_t)opt.size * opt.size * 3);
+
+    for (size_t i; (i = sh.next.fetch_add(1)) < sh.files->size(); ) {
+        const fs::path& src = (*sh.files)[i];
+        Entry& e = (*sh.entries)[i];
+
+        if (!HashFile(src, opt, e.hash)) { ++sh.failed; Log(sh, "read", src); continue; }
+
+        const fs::path dst = opt.cache / (HashName(e.hash) + ext);
+        std::error_code ec;
+        if (!opt.force && fs::exists(dst, ec)) { e.ok = true; ++sh.cached; continue; }
+
+        EuclidObjectID id = 0;
+        Euclid_ClearScene(h);
+        if (Euclid_LoadOBJ(h, src.string().c_str(), &id, /*normalize*/1) != EUCLID_OK) {
+            ++sh.failed; Log(sh, "import", src); continue;
+        }
+        Euclid_FrameObject(h, id);
+        Euclid_Render(h);
+        Euclid_ReadPixels(h, rgba.data(), rgba.size());
+        for (size_t p = 0, n = (size_t)opt.size * opt.size; p < n; ++p) {
+            rgb[3*p+0] = rgba[4*p+0];
+            rgb[3*p+1] = rgba[4*p+1];
+            rgb[3*p+2] = rgba[4*p+2];
+        }
+
+        // write aside and rename, so an interrupted run never leaves a half file in the cache
+        const fs::path tmp = dst.string() + ".tmp" + std::to_string(index);
+        if (Euclid_WriteImage(tmp.string().c_str(), opt.qoi ? EUCLID_IMAGE_QOI : EUCLID_IMAGE_PNG,
+                              opt.size, opt.size, 3, rgb.data()) != EUCLID_OK) {
+            ++sh.failed; Log(sh, "write", dst); fs::remove(tmp, ec); continue;
+        }
+        fs::rename(tmp, dst, ec);
+        if (ec) { ++sh.failed; Log(sh, "write", dst, ec.message().c_str()); fs::remove(tmp, ec); continue; }
+
+        e.ok = true;
+        ++sh.rendered;
+    }
+
+    Euclid_Destroy(h);
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s <asset dir> <cache dir> [--size N] [--jobs N] [--qoi] [--force]\n", argv[0]);
+        return 2;
+    }
+
+#if defined(__linux__)
+    // One instance per core already fills the machine; keep llvmpipe from also
+    // spawning a rasterizer thread per core inside every instance.
+    setenv("LP_NUM_THREADS", "1", /*overwrite*/0);
+#endif
+
+    std::error_code ec;
+    fs::create_directories(opt.cache, ec);
+    if (ec) { std::fprintf(stderr, "cannot create %s: %s\n", opt.cache.string().c_str(), ec.message().c_str()); return 1; }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const std::vector<fs::path> files = CollectOBJs(opt.assets);
+    std::vector<Entry> entries(files.size());
+
+    int jobs = opt.jobs > 0 ? opt.jobs : (int)std::thread::hardware_concurrency();
+    jobs = std::max(1, std::min<int>(jobs, (int)std::max<size_t>(1, files.size())));
+
+    Shared sh;
+    sh.opt = &opt;
+    sh.files = &files;
+    sh.entries = &entries;
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < jobs; ++i) workers.emplace_back(Worker, std::ref(sh), i);
+    for (auto& w : workers) w.join();
+
+    // hash -> asset path for this run
+    if (FILE* idx = std::fopen((opt.cache / "index.tsv").string().c_str(), "wb")) {
+        for (size_t i = 0; i < files.size(); ++i)
+            if (entries[i].ok) std::fprintf(idx, "%s\t%s\n", HashName(entries[i].hash).c_str(), files[i].string().c_str());
+        std::fclose(idx);
+    }
+
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::printf("%zu meshes: %d rendered, %d cached, %d failed in %.2fs (%d jobs, %.1f/s)\n",
+                files.size(), sh.rendered.load(), sh.cached.load(), sh.failed.load(), secs, jobs,
+                secs > 0.0 ? double(sh.rendered.load() + sh.cached.load()) / secs : 0.0);
+    return sh.failed.load() ? 1 : 0;
+}
@@ -0,0 +1,21 @@
+#!/bin/bash
+# Every gl* call in Euclid-Lib must be in EUCLID_GL_CALLS (GLBackend.cpp): the null
+# backend and the GL call counters only know the entry points listed there.
+
+pushd "$(dirname "$0")/.." > /dev/null
+if [ ! -f Euclid-Lib/Source/Graphics/GLBackend.cpp ]; then
+    echo "Euclid-Lib/Source/Graphics/GLBackend.cpp not found"
+    exit 1
+fi
+used=$(grep -rhoE '\bgl[A-Z][A-Za-z0-9]*[[:space:]]*\(' Euclid-Lib/Source Euclid-Lib/Wrapper \
+        --include=*.cpp --include=*.hpp --include=*.h | sed -E 's/[[:space:]]*\($//' | sort -u)
+listed=$(grep -oE 'X\(gl[A-Za-z0-9]+\)' Euclid-Lib/Source/Graphics/GLBackend.cpp | sed -E 's/X\((.*)\)/\1/' | sort -u)
+missing=$(comm -23 <(echo "$used") <(echo "$listed"))
+popd > /dev/null
+
+if [ -n "$missing" ]; then
+    echo "Not in EUCLID_GL_CALLS (Euclid-Lib/Source/Graphics/GLBackend.cpp):"
+    echo "$missing"
+    exit 1
+fi
+echo "All GL calls are listed."